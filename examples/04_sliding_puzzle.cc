@@ -123,6 +123,7 @@ bool isRelationUnion = 0;
 bool isRelationGroup = 0;
 bool isUptoDistance = 0;
 bool isShowSize = 0;
+bool isFused = 0;
 int concretization = 0;
 bool isTestConcretize = 0;
 
@@ -137,6 +138,9 @@ Forest* forest3;    // MT or EV for set
 bool getRes = 0;
 // time (sec) of exploration
 double timeExplore = 0.0;
+// time (sec) of counting the frontiers and distances
+double timeCount = 0.0;
+timer watch_count;
 // number of reachable states
 long num_states = 0;
 // number of nodes
@@ -805,6 +809,18 @@ std::vector<Func> trans()
     return results;
 }
 
+/* Number of states in "states", the time spent is added to timeCount */
+long countStates(const Func& states)
+{
+    long num = 0;
+    // the timer keeps the sum of the intervals
+    watch_count.reset();
+    apply(CARDINALITY, states, num);
+    watch_count.note_time();
+    timeCount = watch_count.get_last_seconds();
+    return num;
+}
+
 bool SSG_Frontier_upto(const Func& initial, const std::vector<Func>& relations)
 {
     Func curr = initial;
@@ -817,8 +833,7 @@ bool SSG_Frontier_upto(const Func& initial, const std::vector<Func>& relations)
         if (isRelationUnion) {
             std::cout << "Frontier: " << n;
             if (isShowSize) {
-                long num = 0;
-                apply(CARDINALITY, curr, num);
+                long num = countStates(curr);
                 std::cout << " size: " << num;
             }
             std::cout << std::endl;
@@ -826,18 +841,16 @@ bool SSG_Frontier_upto(const Func& initial, const std::vector<Func>& relations)
         } else {
             std::cout << "Frontier: " << n;
             if (isShowSize) {
-                long num = 0;
-                apply(CARDINALITY, curr, num);
+                long num = countStates(curr);
                 std::cout << " size: " << num;
             }
             std::cout << std::endl;
-            Func s_new(forest1);
+            // the images by all relations in one batch, then their union at once
+            std::vector<Func> currs(relations.size(), curr);
+            std::vector<Func> images;
+            apply(POST_IMAGE, currs, relations, images);
             Func next_new(forest1);
-            next_new.constant(0);
-            for (size_t i=0; i< relations.size(); i++) {
-                apply(POST_IMAGE, curr, relations[i], s_new);
-                next_new |= s_new;
-            }
+            apply(UNION, images, next_new);
             next |= next_new;
         }
         if (n==0) {
@@ -862,6 +875,10 @@ bool SSG_Frontier_upto(const Func& initial, const std::vector<Func>& relations)
 
 bool SSG_Frontier(const Func& initial, const std::vector<Func>& relations)
 {
+    // the fused image is for Boolean forests with terminal encoding
+    if ((forest1->getSetting().getEncodeMechanism() != TERMINAL) || (forest1->getSetting().getRangeType() != BOOLEAN)) {
+        isFused = 0;
+    }
     Func curr = initial;
     distance.push_back(curr);
     Func pre(forest1);
@@ -874,32 +891,45 @@ bool SSG_Frontier(const Func& initial, const std::vector<Func>& relations)
         if (isRelationUnion) {
             std::cout << "Frontier: " << n;
             if (isShowSize) {
-                long num = 0;
-                apply(CARDINALITY, curr, num);
+                long num = countStates(curr);
                 std::cout << " size: " << num;
             }
             std::cout << std::endl;
-            apply(POST_IMAGE, curr, relations[0], next);
+            if (isFused) {
+                // every move can be undone, so the previous frontier is the only visited part reachable
+                Func visited = pre;
+                apply(POST_IMAGE_NEW, curr, relations[0], visited, next);
+            } else {
+                apply(POST_IMAGE, curr, relations[0], next);
+            }
         } else {
             std::cout << "Frontier: " << n;
             if (isShowSize) {
-                long num = 0;
-                apply(CARDINALITY, curr, num);
+                long num = countStates(curr);
                 std::cout << " size: " << num;
             }
             std::cout << std::endl;
-            Func s_new(forest1);
             Func next_new(forest1);
-            next_new.constant(0);
-            for (size_t i=0; i< relations.size(); i++) {
-                apply(POST_IMAGE, curr, relations[i], s_new);
-                next_new |= s_new;
+            if (isFused) {
+                Func s_new(forest1);
+                next_new.constant(0);
+                Func visited = pre;
+                for (size_t i=0; i< relations.size(); i++) {
+                    // the states found by the previous relations are visited now, so s_new are disjoint
+                    apply(POST_IMAGE_NEW, curr, relations[i], visited, s_new);
+                    next_new |= s_new;
+                }
+            } else {
+                std::vector<Func> currs(relations.size(), curr);
+                std::vector<Func> images;
+                apply(POST_IMAGE, currs, relations, images);
+                apply(UNION, images, next_new);
             }
             next |= next_new;
         }
         // next |= pre;
         // next = next ^ pre;
-        next = next & !pre;
+        if (!isFused) next = next & !pre;
         distance_permutation.push_back(n);
         // check fix point
         if (next.getEdge().isConstantZero()) break;
@@ -933,8 +963,7 @@ Func BFS_distance(const Func& initial, const std::vector<Func>& relations)
         if (isRelationUnion) {
             std::cout << "BFS: " << n;
             if (isShowSize) {
-                long num = 0;
-                apply(CARDINALITY, curr, num);
+                long num = countStates(curr);
                 std::cout << " size: " << num;
             }
             std::cout << std::endl;
@@ -943,18 +972,15 @@ Func BFS_distance(const Func& initial, const std::vector<Func>& relations)
         } else {
             std::cout << "BFS: " << n;
             if (isShowSize) {
-                long num = 0;
-                apply(CARDINALITY, curr, num);
+                long num = countStates(curr);
                 std::cout << " size: " << num;
             }
             std::cout << std::endl;
-            Func s_new(forest1);
+            std::vector<Func> currs(relations.size(), curr);
+            std::vector<Func> images;
+            apply(POST_IMAGE, currs, relations, images);
             Func next_new(forest1);
-            next_new.constant(SpecialValue::POS_INF);
-            for (size_t i=0; i< relations.size(); i++) {
-                apply(POST_IMAGE, curr, relations[i], s_new);
-                apply(MINIMUM, next_new, s_new, next_new);
-            }
+            apply(MINIMUM, images, next_new);
             apply(PLUS, next_new, one, next);
             // apply(MINIMUM, next, next_new, next);
         }
@@ -1233,7 +1259,7 @@ void compute_Frontier(const Func& target, const std::vector<Func>& relations)
     // compute distribution
     long num_state = 0;
     for (size_t i=0; i<distance.size(); i++) {
-        apply(CARDINALITY, distance[i], num_state);
+        num_state = countStates(distance[i]);
         distribution_state.push_back(num_state);
         distribution_node.push_back(forest1->getNodeManUsed(distance[i]));
         if (isUptoDistance) {
@@ -1299,6 +1325,7 @@ int usage(const char* who)
     out << std::left << std::setw(2*align) << "" << "Select the predefined BMxD type. Default: IBMxD" << std::endl;
     out << std::left << std::setw(2*align) << "" << "Supported: FBMxD, IBMxD" << std::endl;
     out << std::left << std::setw(2*align) << "  -distance, -d" << "Compute distance for each reachable state" << std::endl;
+    out << std::left << std::setw(2*align) << "  -fused" << "Compute each BFS frontier and the visited set in one image operation" << std::endl;
     out << std::left << std::setw(2*align) << "  -concretize, -cz <number>" << std::endl;
     out << std::left << std::setw(2*align) << "" << "Set the concretization heuristics. Default: 0" << std::endl;
     out << std::left << std::setw(2*align) << "" << "Supported: 0: No concretization; 1: Restrict; 2: One-sided-match (OSM); 3: Two-sided-match (TSM)" << std::endl;
@@ -1418,6 +1445,10 @@ bool processArgs(int argc, const char** argv)
                 isShowSize = 1;
                 continue;
             }
+            if (strcmp("-fused", argv[i])==0) {
+                isFused = 1;
+                continue;
+            }
             // option for time out
             if (strcmp("-t", argv[i])==0) {
                 timeLimit = std::stod(argv[i+1]);
@@ -1510,6 +1541,9 @@ void report(std::ostream& out)
 
     out << "=========================| Time |=========================" << std::endl;
     out << std::left << std::setw(align) << explore_alg << timeExplore << std::endl;
+    if (timeCount > 0.0) {
+        out << std::left << std::setw(align) << "Counting" << timeCount << std::endl;
+    }
     out << "----------------------------------------------------------" << std::endl;
     if (concretization != 0) {
         out << std::left << std::setw(align/1.2) << "Concretization (exact)" << std::setw(align/3) << concretization_alg << ((isConvert) ? time_convert_concretized : time_concretized) << std::endl;
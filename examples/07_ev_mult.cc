@@ -0,0 +1,124 @@
+/*
+ * -----------------------------------------------------------------------------
+ *  Multiplicative edge-valued BDDs (EV*BDDs) versus MTBDDs
+ * -----------------------------------------------------------------------------
+ *  Overview:
+ *  This program builds the same real-valued functions in an EV*FBDD forest and
+ *  in an MTBDD forest, then reports their sizes and the time spent:
+ *      - the product distribution  P(x) = prod_k (x_k ? p_k : 1-p_k)
+ *      - the weighted reward       R(x) = sum_k x_k * w_k
+ *      - the expected reward terms P(x) * R(x)
+ *
+ *  A product of independent factors needs one node per level in EV*, while the
+ *  MTBDD has one terminal for each distinct probability and thus grows
+ *  exponentially with the number of variables.
+ *
+ *  Usage: ./07_ev_mult [-n num_vars] [-help]
+ */
+
+#include <cmath>
+#include <iomanip>
+#include "brave_dd.h"
+#include "timer.h"
+
+using namespace BRAVE_DD;
+
+uint16_t numVars = 14;
+
+void usage()
+{
+    std::cout << "Usage: ./07_ev_mult [-n num_vars] [-help]" << std::endl;
+    std::cout << "\t-n:\tnumber of variables (default 14)" << std::endl;
+}
+
+void buildFunctions(Forest* forest, const std::vector<float>& prob, const std::vector<float>& weight,
+                    Func& dist, Func& reward, Func& expect)
+{
+    bool isMult = forest->getSetting().getEncodeMechanism() == EDGE_MULT;
+    dist.trueFunc();
+    if (isMult) {
+        reward.constant(0.0);
+    } else {
+        reward.constant(0.0f);
+    }
+    for (uint16_t k=1; k<=numVars; k++) {
+        Func x(forest), y(forest);
+        if (isMult) {
+            x.variable(k, Value(1.0 - (double)prob[k]), Value((double)prob[k]));
+            y.variable(k, Value(0.0), Value((double)weight[k]));
+        } else {
+            x.variable(k, Value(1.0f - prob[k]), Value(prob[k]));
+            y.variable(k, Value(0.0f), Value(weight[k]));
+        }
+        apply(MULTIPLY, dist, x, dist);
+        apply(PLUS, reward, y, reward);
+    }
+    apply(MULTIPLY, dist, reward, expect);
+}
+
+void report(const std::string& name, Func& dist, Func& reward, Func& expect, double seconds)
+{
+    std::cout << std::left << std::setw(10) << name
+              << std::right << std::setw(12) << dist.numNodes()
+              << std::setw(12) << reward.numNodes()
+              << std::setw(12) << expect.numNodes()
+              << std::setw(14) << std::fixed << std::setprecision(4) << seconds << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    for (int i=1; i<argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "-n") && (i+1 < argc)) {
+            numVars = atoi(argv[++i]);
+        } else {
+            usage();
+            return 0;
+        }
+    }
+
+    std::vector<float> prob(numVars+1), weight(numVars+1);
+    for (uint16_t k=1; k<=numVars; k++) {
+        prob[k] = 0.5f / (float)(k + 1);
+        weight[k] = (float)(k % 5 + 1);
+    }
+
+    std::cout << "Number of variables: " << numVars << std::endl;
+    std::cout << std::left << std::setw(10) << "Forest"
+              << std::right << std::setw(12) << "P nodes"
+              << std::setw(12) << "R nodes"
+              << std::setw(12) << "P*R nodes"
+              << std::setw(14) << "time (sec)" << std::endl;
+
+    // EV*FBDD
+    ForestSetting evSetting(PredefForest::EVSTARFBDD, numVars);
+    Forest* evForest = new Forest(evSetting);
+    Func evDist(evForest), evReward(evForest), evExpect(evForest);
+    timer evWatch;
+    buildFunctions(evForest, prob, weight, evDist, evReward, evExpect);
+    evWatch.note_time();
+    report("EV*FBDD", evDist, evReward, evExpect, evWatch.get_last_seconds());
+
+    // MTBDD with float terminals
+    ForestSetting mtSetting(PredefForest::MTBDD, numVars);
+    mtSetting.setValType(FLOAT);
+    mtSetting.setRangeType(RangeType::NNREAL);
+    Forest* mtForest = new Forest(mtSetting);
+    Func mtDist(mtForest), mtReward(mtForest), mtExpect(mtForest);
+    timer mtWatch;
+    buildFunctions(mtForest, prob, weight, mtDist, mtReward, mtExpect);
+    mtWatch.note_time();
+    report("MTBDD", mtDist, mtReward, mtExpect, mtWatch.get_last_seconds());
+
+    // agree on the all-ones assignment
+    std::vector<bool> assignment(numVars+1, 1);
+    double evVal = 0.0, mtVal = 0.0;
+    evExpect.evaluate(assignment).getValueTo(&evVal, DOUBLE);
+    mtExpect.evaluate(assignment).getValueTo(&mtVal, DOUBLE);
+    std::cout << std::scientific << std::setprecision(6);
+    std::cout << "P*R at all-ones: EV* " << evVal << ", MTBDD " << mtVal << std::endl;
+
+    delete evForest;
+    delete mtForest;
+    return 0;
+}
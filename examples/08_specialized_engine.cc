@@ -0,0 +1,148 @@
+/*
+ * -----------------------------------------------------------------------------
+ *  Specialized versus generic reduction engines
+ * -----------------------------------------------------------------------------
+ *  Overview:
+ *  Forests whose setting is exactly one of the predefined types REXBDD, FBDD,
+ *  CFBDD, ESRBDD or QBMXD reduce nodes with an engine where the setting checks
+ *  are resolved at compile time. This program builds the same functions with
+ *  that engine and with the generic one, and reports the time spent by each:
+ *      - set forests:      the N-Queens constraints on an N*N board
+ *      - relation forest:  the transition relation of an M-bit counter
+ *
+ *  Both engines must give the same number of nodes.
+ *
+ *  Usage: ./08_specialized_engine [-n board_size] [-m counter_bits] [-r repeats] [-help]
+ */
+
+#include <iomanip>
+#include "brave_dd.h"
+#include "timer.h"
+
+using namespace BRAVE_DD;
+
+int N = 6;
+int M = 24;
+int repeats = 3;
+
+void usage()
+{
+    std::cout << "Usage: ./08_specialized_engine [-n board_size] [-m counter_bits] [-r repeats] [-help]" << std::endl;
+    std::cout << "\t-n:\tboard size of the N-Queens constraints (default 6)" << std::endl;
+    std::cout << "\t-m:\tnumber of bits of the counter relation (default 24)" << std::endl;
+    std::cout << "\t-r:\tnumber of runs, the fastest one is reported (default 3)" << std::endl;
+}
+
+/* N-Queens constraints, with variable i*N+j+1 for cell (i, j) */
+Func buildQueens(Forest* forest)
+{
+    std::vector<std::vector<Func> > board(N, std::vector<Func>(N, Func(forest)));
+    for (int i=0; i<N; i++) {
+        for (int j=0; j<N; j++) {
+            board[i][j].variable(i * N + j + 1);
+        }
+    }
+    Func solution(forest);
+    solution.trueFunc();
+    for (int i=0; i<N; i++) {
+        Func row(forest), col(forest);
+        row.falseFunc();
+        col.falseFunc();
+        for (int j=0; j<N; j++) {
+            row |= board[i][j];
+            col |= board[j][i];
+            for (int k=j+1; k<N; k++) {
+                solution &= !(board[i][j] & board[i][k]);
+                solution &= !(board[j][i] & board[k][i]);
+            }
+        }
+        solution &= row & col;
+    }
+    for (int i=0; i<N; i++) {
+        for (int j=0; j<N; j++) {
+            for (int r=i+1, c=j+1; r<N && c<N; r++, c++) solution &= !(board[i][j] & board[r][c]);
+            for (int r=i+1, c=j-1; r<N && c>=0; r++, c--) solution &= !(board[i][j] & board[r][c]);
+        }
+    }
+    return solution;
+}
+
+/* Relation x' = x + 1 (mod 2^M), bit k at level k */
+Func buildCounter(Forest* forest)
+{
+    Func relation(forest), carry(forest);
+    relation.trueFunc();
+    carry.trueFunc();
+    for (int k=1; k<=M; k++) {
+        Func x(forest), y(forest);
+        x.variable(k, false);
+        y.variable(k, true);
+        Func next = (x & (!carry)) | ((!x) & carry);
+        relation &= (y & next) | ((!y) & (!next));
+        carry &= x;
+    }
+    return relation;
+}
+
+/* Fastest of the runs, each in a new forest so that no cache is shared */
+double measure(const ForestSetting& setting, bool isGeneric, uint64_t& nodes)
+{
+    double best = -1.0;
+    for (int run=0; run<repeats; run++) {
+        Forest* forest = new Forest(setting);
+        if (isGeneric) forest->useGenericEngine();
+        timer watch;
+        Func result = setting.isRelation() ? buildCounter(forest) : buildQueens(forest);
+        watch.note_time();
+        nodes = forest->getNodeManUsed(result);
+        if ((best < 0) || (watch.get_last_seconds() < best)) best = watch.get_last_seconds();
+        delete forest;
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    for (int i=1; i<argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "-n") && (i+1 < argc)) {
+            N = atoi(argv[++i]);
+        } else if ((arg == "-m") && (i+1 < argc)) {
+            M = atoi(argv[++i]);
+        } else if ((arg == "-r") && (i+1 < argc)) {
+            repeats = atoi(argv[++i]);
+        } else {
+            usage();
+            return 0;
+        }
+    }
+
+    std::cout << "N-Queens board size: " << N << ", counter bits: " << M << std::endl;
+    std::cout << std::left << std::setw(10) << "Forest"
+              << std::right << std::setw(12) << "nodes"
+              << std::setw(14) << "generic (s)"
+              << std::setw(14) << "special (s)"
+              << std::setw(10) << "speedup" << std::endl;
+
+    PredefForest types[] = {PredefForest::REXBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                            PredefForest::ESRBDD, PredefForest::QBMXD};
+    bool isSame = 1;
+    for (PredefForest type : types) {
+        ForestSetting setting(type, (PredefForest::QBMXD == type) ? M : N*N);
+        uint64_t genericNodes = 0, specialNodes = 0;
+        double genericTime = measure(setting, 1, genericNodes);
+        double specialTime = measure(setting, 0, specialNodes);
+        if (genericNodes != specialNodes) isSame = 0;
+        std::cout << std::left << std::setw(10) << setting.getName()
+                  << std::right << std::setw(12) << specialNodes
+                  << std::setw(14) << std::fixed << std::setprecision(4) << genericTime
+                  << std::setw(14) << specialTime
+                  << std::setw(9) << std::setprecision(2) << ((specialTime > 0) ? genericTime / specialTime : 0.0)
+                  << "x" << std::endl;
+    }
+    if (!isSame) {
+        std::cout << "The engines gave different numbers of nodes!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * -----------------------------------------------------------------------------
+ *  Relational product versus conjoin-then-quantify
+ * -----------------------------------------------------------------------------
+ *  Overview:
+ *  The states are M-bit numbers x, with x_k at level 2k and its next value x'_k
+ *  at level 2k-1. The set S of states is a union of K random cubes, and the
+ *  relation T is x' = x + a (mod 2^M). The image of S is (exists x. S & T),
+ *  which this program computes
+ *      - by AND_EXISTS, in one pass without building S & T
+ *      - by building S & T, then EQUANTIFY
+ *  and reports the time and the nodes created by each.
+ *
+ *  Both must give the same function.
+ *
+ *  Usage: ./09_and_exists [-m bits] [-k cubes] [-r repeats] [-help]
+ */
+
+#include <iomanip>
+#include <random>
+#include "brave_dd.h"
+#include "timer.h"
+
+using namespace BRAVE_DD;
+
+int M = 24;
+int K = 200;
+int repeats = 3;
+const unsigned long ADDEND = 0x5A5A5A5UL;
+
+void usage()
+{
+    std::cout << "Usage: ./09_and_exists [-m bits] [-k cubes] [-r repeats] [-help]" << std::endl;
+    std::cout << "\t-m:\tnumber of bits of the states (default 24)" << std::endl;
+    std::cout << "\t-k:\tnumber of random cubes in the set of states (default 200)" << std::endl;
+    std::cout << "\t-r:\tnumber of runs, the fastest one is reported (default 3)" << std::endl;
+}
+
+/* The set of states, each cube fixes about 2/3 of the bits; the same cubes for every forest */
+Func buildStates(Forest* forest)
+{
+    std::mt19937 gen(20240101);
+    std::uniform_int_distribution<int> literal(0, 2);
+    Func states(forest);
+    states.falseFunc();
+    for (int c=0; c<K; c++) {
+        Func cube(forest);
+        cube.trueFunc();
+        for (int k=1; k<=M; k++) {
+            int lit = literal(gen);
+            if (lit == 2) continue;
+            Func x(forest);
+            x.variable(2*k);
+            cube &= (lit) ? x : !x;
+        }
+        states |= cube;
+    }
+    return states;
+}
+
+/* The relation x' = x + ADDEND (mod 2^M), by a ripple carry */
+Func buildAdder(Forest* forest)
+{
+    Func relation(forest), carry(forest);
+    relation.trueFunc();
+    carry.falseFunc();
+    for (int k=1; k<=M; k++) {
+        Func x(forest), y(forest);
+        x.variable(2*k);
+        y.variable(2*k-1);
+        bool bit = (ADDEND >> ((k-1) % 32)) & 0x01;
+        Func sum = (bit) ? !(x ^ carry) : (x ^ carry);
+        relation &= !(y ^ sum);
+        carry = (bit) ? (x | carry) : (x & carry);
+    }
+    return relation;
+}
+
+/* Fastest of the runs, each in a new forest so that no cache is shared */
+double measure(const ForestSetting& setting, bool isFused, uint64_t& created, uint64_t& nodes)
+{
+    std::vector<uint16_t> vars;
+    for (int k=1; k<=M; k++) vars.push_back(2*k);
+    double best = -1.0;
+    for (int run=0; run<repeats; run++) {
+        Forest* forest = new Forest(setting);
+        Func states = buildStates(forest);
+        Func relation = buildAdder(forest);
+        Func image(forest);
+        uint64_t before = forest->getNodeManUsed();
+        timer watch;
+        if (isFused) {
+            apply(AND_EXISTS, states, relation, vars, image);
+        } else {
+            Func conj = states & relation;
+            apply(EQUANTIFY, conj, vars, image);
+        }
+        watch.note_time();
+        created = forest->getNodeManUsed() - before;
+        nodes = forest->getNodeManUsed(image);
+        if ((best < 0) || (watch.get_last_seconds() < best)) best = watch.get_last_seconds();
+        delete forest;
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    for (int i=1; i<argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "-m") && (i+1 < argc)) {
+            M = atoi(argv[++i]);
+        } else if ((arg == "-k") && (i+1 < argc)) {
+            K = atoi(argv[++i]);
+        } else if ((arg == "-r") && (i+1 < argc)) {
+            repeats = atoi(argv[++i]);
+        } else {
+            usage();
+            return 0;
+        }
+    }
+
+    std::cout << "State bits: " << M << ", cubes: " << K << std::endl;
+    std::cout << std::left << std::setw(10) << "Forest"
+              << std::right << std::setw(10) << "image"
+              << std::setw(14) << "conj+exists"
+              << std::setw(12) << "created"
+              << std::setw(14) << "and-exists"
+              << std::setw(12) << "created"
+              << std::setw(10) << "speedup" << std::endl;
+
+    PredefForest types[] = {PredefForest::REXBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                            PredefForest::ESRBDD, PredefForest::ZBDD};
+    bool isSame = 1;
+    for (PredefForest type : types) {
+        ForestSetting setting(type, 2*M);
+        uint64_t twoStepCreated = 0, fusedCreated = 0, twoStepNodes = 0, fusedNodes = 0;
+        double twoStepTime = measure(setting, 0, twoStepCreated, twoStepNodes);
+        double fusedTime = measure(setting, 1, fusedCreated, fusedNodes);
+        if (twoStepNodes != fusedNodes) isSame = 0;
+        std::cout << std::left << std::setw(10) << setting.getName()
+                  << std::right << std::setw(10) << fusedNodes
+                  << std::setw(14) << std::fixed << std::setprecision(4) << twoStepTime
+                  << std::setw(12) << twoStepCreated
+                  << std::setw(14) << fusedTime
+                  << std::setw(12) << fusedCreated
+                  << std::setw(9) << std::setprecision(2) << ((fusedTime > 0) ? twoStepTime / fusedTime : 0.0)
+                  << "x" << std::endl;
+    }
+    if (!isSame) {
+        std::cout << "The two methods gave different images!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
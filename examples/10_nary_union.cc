@@ -0,0 +1,121 @@
+/*
+ * -----------------------------------------------------------------------------
+ *  N-ary union versus folding the binary union
+ * -----------------------------------------------------------------------------
+ *  Overview:
+ *  The union of K functions over N variables, each a random cube, is computed
+ *      - by folding the binary union over the list, as in (f1 | f2) | f3 ...
+ *      - by the n-ary union, apply(UNION, list, res), recursing on all the
+ *        functions at once
+ *  and the time and the nodes created by each are reported. Nodes are not
+ *  recycled during the computation, so the nodes created are the peak growth
+ *  of the forest.
+ *
+ *  Both must give the same function.
+ *
+ *  Usage: ./10_nary_union [-n vars] [-k functions] [-help]
+ */
+
+#include <iomanip>
+#include <random>
+#include "brave_dd.h"
+#include "timer.h"
+
+using namespace BRAVE_DD;
+
+int N = 40;
+int K = 500;
+
+void usage()
+{
+    std::cout << "Usage: ./10_nary_union [-n vars] [-k functions] [-help]" << std::endl;
+    std::cout << "\t-n:\tnumber of variables (default 40)" << std::endl;
+    std::cout << "\t-k:\tnumber of functions in the union (default 500)" << std::endl;
+}
+
+/* The random cubes, the same ones for every forest */
+std::vector<Func> buildCubes(Forest* forest)
+{
+    std::mt19937 gen(20240101);
+    std::uniform_int_distribution<int> literal(0, 2);
+    std::vector<Func> cubes;
+    for (int c=0; c<K; c++) {
+        Func cube(forest);
+        cube.trueFunc();
+        for (int k=1; k<=N; k++) {
+            int lit = literal(gen);
+            if (lit == 2) continue;
+            Func x(forest);
+            x.variable(k);
+            cube &= (lit) ? x : !x;
+        }
+        cubes.push_back(cube);
+    }
+    return cubes;
+}
+
+/* Time and nodes created by one method, in a new forest so that no cache is shared */
+double measure(const ForestSetting& setting, bool isNary, uint64_t& created, uint64_t& nodes)
+{
+    Forest* forest = new Forest(setting);
+    std::vector<Func> cubes = buildCubes(forest);
+    Func result(forest);
+    result.falseFunc();
+    uint64_t before = forest->getNodeManUsed();
+    timer watch;
+    if (isNary) {
+        apply(UNION, cubes, result);
+    } else {
+        for (size_t i=0; i<cubes.size(); i++) result |= cubes[i];
+    }
+    watch.note_time();
+    created = forest->getNodeManUsed() - before;
+    nodes = forest->getNodeManUsed(result);
+    delete forest;
+    return watch.get_last_seconds();
+}
+
+int main(int argc, char** argv)
+{
+    for (int i=1; i<argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "-n") && (i+1 < argc)) {
+            N = atoi(argv[++i]);
+        } else if ((arg == "-k") && (i+1 < argc)) {
+            K = atoi(argv[++i]);
+        } else {
+            usage();
+            return 0;
+        }
+    }
+
+    std::cout << "Variables: " << N << ", functions: " << K << std::endl;
+    std::cout << std::left << std::setw(10) << "Forest"
+              << std::right << std::setw(10) << "union"
+              << std::setw(12) << "fold"
+              << std::setw(12) << "created"
+              << std::setw(12) << "n-ary"
+              << std::setw(12) << "created" << std::endl;
+
+    PredefForest types[] = {PredefForest::REXBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                            PredefForest::ESRBDD, PredefForest::ZBDD};
+    bool isSame = 1;
+    for (PredefForest type : types) {
+        ForestSetting setting(type, N);
+        uint64_t foldCreated = 0, naryCreated = 0, foldNodes = 0, naryNodes = 0;
+        double foldTime = measure(setting, 0, foldCreated, foldNodes);
+        double naryTime = measure(setting, 1, naryCreated, naryNodes);
+        if (foldNodes != naryNodes) isSame = 0;
+        std::cout << std::left << std::setw(10) << setting.getName()
+                  << std::right << std::setw(10) << naryNodes
+                  << std::setw(12) << std::fixed << std::setprecision(4) << foldTime
+                  << std::setw(12) << foldCreated
+                  << std::setw(12) << naryTime
+                  << std::setw(12) << naryCreated << std::endl;
+    }
+    if (!isSame) {
+        std::cout << "The two methods gave different unions!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ * -----------------------------------------------------------------------------
+ *  Lazy expressions versus the operators on Funcs
+ * -----------------------------------------------------------------------------
+ *  Overview:
+ *  The constraints of the N-queens problem (one queen per row and per column,
+ *  at most one per diagonal) are built
+ *      - by the operators on Funcs, as in 02_queens, where every subexpression
+ *        such as !(x & y) is a Func in the forest
+ *      - by Expressions, which record the whole constraint and compute it in
+ *        one traversal when converted to a Func
+ *  and the time and the nodes created by each are reported. Nodes are not
+ *  recycled during the computation, so the nodes created are the peak growth
+ *  of the forest.
+ *
+ *  The conjunctions of the constraints must be the same.
+ *
+ *  Usage: ./11_lazy_expression [-n size] [-help]
+ */
+
+#include <iomanip>
+#include "brave_dd.h"
+#include "timer.h"
+
+using namespace BRAVE_DD;
+
+int N = 8;
+
+void usage()
+{
+    std::cout << "Usage: ./11_lazy_expression [-n size] [-help]" << std::endl;
+    std::cout << "\t-n:\tsize of the board (default 8)" << std::endl;
+}
+
+/* The cells on a line of the board, from (i, j) by steps of (di, dj) */
+std::vector<std::pair<int, int> > line(int i, int j, int di, int dj)
+{
+    std::vector<std::pair<int, int> > cells;
+    for (; (i >= 0) && (i < N) && (j >= 0) && (j < N); i += di, j += dj) cells.push_back(std::make_pair(i, j));
+    return cells;
+}
+
+/* At most one queen on the cells, and at least one if isExact */
+Func eagerConstraint(Forest* forest, const std::vector<std::vector<Func> >& board,
+                     const std::vector<std::pair<int, int> >& cells, bool isExact)
+{
+    Func atMost(forest), atLeast(forest);
+    atMost.trueFunc();
+    atLeast.falseFunc();
+    for (size_t a=0; a<cells.size(); a++) {
+        const Func& x = board[cells[a].first][cells[a].second];
+        for (size_t b=a+1; b<cells.size(); b++) {
+            atMost &= !(x & board[cells[b].first][cells[b].second]);
+        }
+        atLeast |= x;
+    }
+    return (isExact) ? (atMost & atLeast) : atMost;
+}
+
+Func lazyConstraint(const std::vector<std::vector<Expression> >& board,
+                    const std::vector<std::pair<int, int> >& cells, bool isExact)
+{
+    // there is no constant Expression: start from the first pair and the first cell
+    Expression atMost = !(board[cells[0].first][cells[0].second] & board[cells[1].first][cells[1].second]);
+    Expression atLeast = board[cells[0].first][cells[0].second];
+    for (size_t a=0; a<cells.size(); a++) {
+        const Expression& x = board[cells[a].first][cells[a].second];
+        for (size_t b=a+1; b<cells.size(); b++) {
+            if ((a > 0) || (b > 1)) atMost = atMost & !(x & board[cells[b].first][cells[b].second]);
+        }
+        if (a > 0) atLeast = atLeast | x;
+    }
+    return (isExact) ? (atMost & atLeast) : atMost;
+}
+
+/* Time and nodes created by one method, in a new forest so that no cache is shared */
+double measure(const ForestSetting& setting, bool isLazy, uint64_t& created, uint64_t& nodes)
+{
+    Forest* forest = new Forest(setting);
+    std::vector<std::vector<Func> > board(N, std::vector<Func>(N, Func(forest)));
+    std::vector<std::vector<Expression> > cells;
+    for (int i=0; i<N; i++) {
+        cells.push_back(std::vector<Expression>());
+        for (int j=0; j<N; j++) {
+            board[i][j].variable(i*N+j+1);
+            cells[i].push_back(Expression(board[i][j]));
+        }
+    }
+    // rows, columns, and the diagonals of at least two cells
+    std::vector<std::vector<std::pair<int, int> > > lines;
+    std::vector<bool> isExact;
+    for (int k=0; k<N; k++) {
+        lines.push_back(line(k, 0, 0, 1));
+        lines.push_back(line(0, k, 1, 0));
+        isExact.push_back(1);
+        isExact.push_back(1);
+    }
+    for (int k=0; k<N-1; k++) {
+        lines.push_back(line(k, 0, 1, 1));
+        lines.push_back(line(N-1-k, 0, -1, 1));
+        isExact.push_back(0);
+        isExact.push_back(0);
+        if (k == 0) continue;
+        lines.push_back(line(0, k, 1, 1));
+        lines.push_back(line(N-1, k, -1, 1));
+        isExact.push_back(0);
+        isExact.push_back(0);
+    }
+    uint64_t before = forest->getNodeManUsed();
+    timer watch;
+    std::vector<Func> constraints;
+    for (size_t l=0; l<lines.size(); l++) {
+        if (lines[l].size() < 2) continue;
+        constraints.push_back((isLazy) ? lazyConstraint(cells, lines[l], isExact[l])
+                                       : eagerConstraint(forest, board, lines[l], isExact[l]));
+    }
+    watch.note_time();
+    created = forest->getNodeManUsed() - before;
+    Func solutions(forest);
+    apply(INTERSECTION, constraints, solutions);
+    nodes = forest->getNodeManUsed(solutions);
+    delete forest;
+    return watch.get_last_seconds();
+}
+
+int main(int argc, char** argv)
+{
+    for (int i=1; i<argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "-n") && (i+1 < argc)) {
+            N = atoi(argv[++i]);
+        } else {
+            usage();
+            return 0;
+        }
+    }
+    if (N < 2) {
+        usage();
+        return 0;
+    }
+
+    std::cout << "Board: " << N << "x" << N << std::endl;
+    std::cout << std::left << std::setw(10) << "Forest"
+              << std::right << std::setw(12) << "nodes"
+              << std::setw(12) << "eager"
+              << std::setw(12) << "created"
+              << std::setw(12) << "lazy"
+              << std::setw(12) << "created" << std::endl;
+
+    PredefForest types[] = {PredefForest::REXBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                            PredefForest::ESRBDD, PredefForest::ZBDD};
+    bool isSame = 1;
+    for (PredefForest type : types) {
+        ForestSetting setting(type, N*N);
+        uint64_t eagerCreated = 0, lazyCreated = 0, eagerNodes = 0, lazyNodes = 0;
+        double eagerTime = measure(setting, 0, eagerCreated, eagerNodes);
+        double lazyTime = measure(setting, 1, lazyCreated, lazyNodes);
+        if (eagerNodes != lazyNodes) isSame = 0;
+        std::cout << std::left << std::setw(10) << setting.getName()
+                  << std::right << std::setw(12) << lazyNodes
+                  << std::setw(12) << std::fixed << std::setprecision(4) << eagerTime
+                  << std::setw(12) << eagerCreated
+                  << std::setw(12) << lazyTime
+                  << std::setw(12) << lazyCreated << std::endl;
+    }
+    if (!isSame) {
+        std::cout << "The two methods gave different constraints!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * -----------------------------------------------------------------------------
+ *  Frozen Funcs versus Func::evaluate
+ * -----------------------------------------------------------------------------
+ *  Overview:
+ *  The constraints of the N-queens problem, as in 02_queens, are evaluated on
+ *  random assignments
+ *      - by Func::evaluate, which decodes every node it visits from the
+ *        node manager of the forest
+ *      - by a FrozenFunc, which decodes the nodes once into an array
+ *  and the time of each is reported, with the time to freeze the Func.
+ *
+ *  The two must give the same values.
+ *
+ *  Usage: ./12_frozen_evaluate [-n size] [-a assignments] [-help]
+ */
+
+#include <iomanip>
+#include "brave_dd.h"
+#include "timer.h"
+
+using namespace BRAVE_DD;
+
+int N = 6;
+int A = 1000000;
+
+void usage()
+{
+    std::cout << "Usage: ./12_frozen_evaluate [-n size] [-a assignments] [-help]" << std::endl;
+    std::cout << "\t-n:\tsize of the board (default 6)" << std::endl;
+    std::cout << "\t-a:\tnumber of random assignments (default 1000000)" << std::endl;
+}
+
+/* One queen per row and per column, at most one per diagonal */
+Func queens(Forest* forest)
+{
+    std::vector<std::vector<Func> > board(N, std::vector<Func>(N, Func(forest)));
+    for (int i=0; i<N; i++) {
+        for (int j=0; j<N; j++) board[i][j].variable(i*N+j+1);
+    }
+    Func solutions(forest);
+    solutions.trueFunc();
+    for (int i=0; i<N; i++) {
+        Func row(forest), col(forest);
+        row.falseFunc();
+        col.falseFunc();
+        for (int j=0; j<N; j++) {
+            row |= board[i][j];
+            col |= board[j][i];
+        }
+        solutions &= row & col;
+    }
+    for (int i=0; i<N; i++) {
+        for (int j=0; j<N; j++) {
+            for (int k=1; k<N; k++) {
+                // the cells attacked on the row, the column and the diagonals below
+                int cells[4][2] = {{i, j+k}, {i+k, j}, {i+k, j+k}, {i+k, j-k}};
+                for (int c=0; c<4; c++) {
+                    int a = cells[c][0], b = cells[c][1];
+                    if ((a >= N) || (b < 0) || (b >= N)) continue;
+                    solutions &= !(board[i][j] & board[a][b]);
+                }
+            }
+        }
+    }
+    return solutions;
+}
+
+int main(int argc, char** argv)
+{
+    for (int i=1; i<argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "-n") && (i+1 < argc)) {
+            N = atoi(argv[++i]);
+        } else if ((arg == "-a") && (i+1 < argc)) {
+            A = atoi(argv[++i]);
+        } else {
+            usage();
+            return 0;
+        }
+    }
+    if ((N < 1) || (A < 1)) {
+        usage();
+        return 0;
+    }
+
+    // random assignments, with one queen per row so that some are solutions
+    srand(1);
+    std::vector<std::vector<bool> > assignments(A, std::vector<bool>(N*N+1, 0));
+    for (int a=0; a<A; a++) {
+        for (int i=0; i<N; i++) assignments[a][i*N + rand()%N + 1] = 1;
+    }
+
+    std::cout << "Board: " << N << "x" << N << ", " << A << " assignments" << std::endl;
+    std::cout << std::left << std::setw(10) << "Forest"
+              << std::right << std::setw(12) << "nodes"
+              << std::setw(12) << "solutions"
+              << std::setw(12) << "evaluate"
+              << std::setw(12) << "freeze"
+              << std::setw(12) << "frozen" << std::endl;
+
+    PredefForest types[] = {PredefForest::REXBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                            PredefForest::ESRBDD, PredefForest::ZBDD};
+    bool isSame = 1;
+    for (PredefForest type : types) {
+        ForestSetting setting(type, N*N);
+        Forest* forest = new Forest(setting);
+        Func solutions = queens(forest);
+
+        timer evaluateWatch;
+        std::vector<Value> values(A);
+        for (int a=0; a<A; a++) values[a] = solutions.evaluate(assignments[a]);
+        evaluateWatch.note_time();
+
+        timer freezeWatch;
+        FrozenFunc frozen(solutions);
+        freezeWatch.note_time();
+
+        timer frozenWatch;
+        int count = 0;
+        for (int a=0; a<A; a++) {
+            Value val = frozen.evaluate(assignments[a]);
+            if (val != values[a]) isSame = 0;
+            int v = 0;
+            val.getValueTo(&v, INT);
+            count += v;
+        }
+        frozenWatch.note_time();
+
+        std::cout << std::left << std::setw(10) << setting.getName()
+                  << std::right << std::setw(12) << frozen.getNumNodes()
+                  << std::setw(12) << count
+                  << std::setw(12) << std::fixed << std::setprecision(4) << evaluateWatch.get_last_seconds()
+                  << std::setw(12) << freezeWatch.get_last_seconds()
+                  << std::setw(12) << frozenWatch.get_last_seconds() << std::endl;
+        delete forest;
+    }
+    if (!isSame) {
+        std::cout << "The frozen Funcs gave different values!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
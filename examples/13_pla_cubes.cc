@@ -0,0 +1,141 @@
+/*
+ * -----------------------------------------------------------------------------
+ *  Building the cubes of a PLA
+ * -----------------------------------------------------------------------------
+ *  Overview:
+ *  The cubes of a PLA file (the lines with a nonzero output), or K random
+ *  cubes over N variables, are united
+ *      - by building each cube as the conjunction of its literals, with
+ *        variable() and &, and folding the binary union over them
+ *      - by building each cube directly with Func::cube, in one node per
+ *        level, and uniting them at once with Func::unionCubes
+ *  and the time of each is reported, with the nodes of the union.
+ *
+ *  Both must give the same number of members.
+ *
+ *  Usage: ./13_pla_cubes [-f file.pla] [-n vars] [-k cubes] [-help]
+ */
+
+#include <iomanip>
+#include <random>
+#include "brave_dd.h"
+#include "timer.h"
+
+using namespace BRAVE_DD;
+
+int N = 40;
+int K = 1000;
+
+void usage()
+{
+    std::cout << "Usage: ./13_pla_cubes [-f file.pla] [-n vars] [-k cubes] [-help]" << std::endl;
+    std::cout << "\t-f:\tthe PLA file to read the cubes from (default: random cubes)" << std::endl;
+    std::cout << "\t-n:\tnumber of variables of the random cubes (default 40)" << std::endl;
+    std::cout << "\t-k:\tnumber of random cubes (default 1000)" << std::endl;
+}
+
+/* The cubes of the lines with a nonzero output */
+std::vector<Cube> readCubes(const std::string& path)
+{
+    ParserPla parser(path);
+    parser.readHeader();
+    N = parser.getInBits();
+    std::vector<Cube> cubes;
+    Cube c;
+    int out = 0;
+    while (parser.readCube(c, out)) {
+        if (out) cubes.push_back(c);
+    }
+    return cubes;
+}
+
+/* Random cubes, about a third of the variables being don't-cares */
+std::vector<Cube> randomCubes()
+{
+    std::mt19937 gen(20240101);
+    std::uniform_int_distribution<int> literal(0, 2);
+    std::vector<Cube> cubes;
+    for (int c=0; c<K; c++) {
+        cubes.push_back(Cube(N));
+        for (int k=1; k<=N; k++) {
+            int lit = literal(gen);
+            if (lit < 2) cubes.back().set(k, lit);
+        }
+    }
+    return cubes;
+}
+
+/* Time of one method, in a new forest so that no cache is shared */
+double measure(const ForestSetting& setting, const std::vector<Cube>& cubes, bool isDirect, double& card, uint64_t& nodes)
+{
+    Forest* forest = new Forest(setting);
+    Func result(forest);
+    result.falseFunc();
+    timer watch;
+    if (isDirect) {
+        result.unionCubes(cubes);
+    } else {
+        for (size_t i=0; i<cubes.size(); i++) {
+            Func cube(forest);
+            cube.trueFunc();
+            for (int k=1; k<=N; k++) {
+                if (cubes[i].isDontCare(k)) continue;
+                Func x(forest);
+                x.variable(k);
+                cube &= (cubes[i].get(k)) ? x : !x;
+            }
+            result |= cube;
+        }
+    }
+    watch.note_time();
+    apply(CARDINALITY, result, card);
+    nodes = forest->getNodeManUsed(result);
+    delete forest;
+    return watch.get_last_seconds();
+}
+
+int main(int argc, char** argv)
+{
+    std::string path;
+    for (int i=1; i<argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "-f") && (i+1 < argc)) {
+            path = argv[++i];
+        } else if ((arg == "-n") && (i+1 < argc)) {
+            N = atoi(argv[++i]);
+        } else if ((arg == "-k") && (i+1 < argc)) {
+            K = atoi(argv[++i]);
+        } else {
+            usage();
+            return 0;
+        }
+    }
+    std::vector<Cube> cubes = (path.empty()) ? randomCubes() : readCubes(path);
+
+    std::cout << "Variables: " << N << ", cubes: " << cubes.size() << std::endl;
+    std::cout << std::left << std::setw(10) << "Forest"
+              << std::right << std::setw(10) << "union"
+              << std::setw(12) << "literals"
+              << std::setw(12) << "cubes" << std::endl;
+
+    PredefForest types[] = {PredefForest::REXBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                            PredefForest::ESRBDD, PredefForest::ZBDD};
+    bool isSame = 1;
+    for (PredefForest type : types) {
+        ForestSetting setting(type, N);
+        double foldCard = 0.0, directCard = 0.0;
+        uint64_t foldNodes = 0, directNodes = 0;
+        double foldTime = measure(setting, cubes, 0, foldCard, foldNodes);
+        double directTime = measure(setting, cubes, 1, directCard, directNodes);
+        if (foldCard != directCard) isSame = 0;
+        std::cout << std::left << std::setw(10) << setting.getName()
+                  << std::right << std::setw(10) << directNodes
+                  << std::setw(12) << std::fixed << std::setprecision(4) << foldTime
+                  << std::setw(12) << directTime << std::endl;
+    }
+    if (!isSame) {
+        std::cout << "The two methods gave different unions!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
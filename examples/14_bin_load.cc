@@ -0,0 +1,108 @@
+/*
+ * -----------------------------------------------------------------------------
+ *  Saving and loading a large set in text and in binary BDDX
+ * -----------------------------------------------------------------------------
+ *  Overview:
+ *  The union of K random cubes over N variables is saved with BddxMaker
+ *      - as text, with buildBddx, and loaded with ParserBddx
+ *      - as binary, with buildBin, and loaded with ParserBin, which maps the
+ *        file and inserts the nodes level by level
+ *  into a new forest each, and the time of each save and load is reported.
+ *
+ *  Both loads must give the same number of members.
+ *
+ *  Usage: ./14_bin_load [-n vars] [-k cubes] [-help]
+ */
+
+#include <iomanip>
+#include <random>
+#include "brave_dd.h"
+#include "timer.h"
+
+using namespace BRAVE_DD;
+
+int N = 64;
+int K = 2000;
+
+void usage()
+{
+    std::cout << "Usage: ./14_bin_load [-n vars] [-k cubes] [-help]" << std::endl;
+    std::cout << "\t-n:\tnumber of variables (default 64)" << std::endl;
+    std::cout << "\t-k:\tnumber of random cubes (default 2000)" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    for (int i=1; i<argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "-n") && (i+1 < argc)) {
+            N = atoi(argv[++i]);
+        } else if ((arg == "-k") && (i+1 < argc)) {
+            K = atoi(argv[++i]);
+        } else {
+            usage();
+            return 0;
+        }
+    }
+    ForestSetting setting(PredefForest::REXBDD, N);
+    Forest* forest = new Forest(setting);
+    std::mt19937 gen(20240101);
+    std::uniform_int_distribution<int> literal(0, 2);
+    std::vector<Cube> cubes;
+    for (int c=0; c<K; c++) {
+        cubes.push_back(Cube(N));
+        for (int k=1; k<=N; k++) {
+            int lit = literal(gen);
+            if (lit < 2) cubes.back().set(k, lit);
+        }
+    }
+    Func set(forest);
+    set.falseFunc();
+    set.unionCubes(cubes);
+    double card = 0.0;
+    apply(CARDINALITY, set, card);
+    std::cout << "Variables: " << N << ", cubes: " << K
+              << ", nodes: " << forest->getNodeManUsed(set) << std::endl;
+
+    BddxMaker maker(forest);
+    timer textSaveWatch;
+    maker.buildBddx(set, "14_bin_load");
+    textSaveWatch.note_time();
+    timer binSaveWatch;
+    maker.buildBin(set, "14_bin_load");
+    binSaveWatch.note_time();
+
+    Forest* textForest = new Forest(setting);
+    ParserBddx text("14_bin_load.bddx");
+    timer textLoadWatch;
+    text.parse(textForest);
+    textLoadWatch.note_time();
+    double textCard = 0.0;
+    apply(CARDINALITY, text.getRoot(), textCard);
+
+    Forest* binForest = new Forest(setting);
+    ParserBin bin("14_bin_load.bin");
+    timer binLoadWatch;
+    bin.parse(binForest);
+    binLoadWatch.note_time();
+    double binCard = 0.0;
+    apply(CARDINALITY, bin.getRoot(), binCard);
+
+    std::cout << std::left << std::setw(10) << "Format"
+              << std::right << std::setw(12) << "save" << std::setw(12) << "load" << std::endl;
+    std::cout << std::left << std::setw(10) << "text" << std::right << std::fixed << std::setprecision(4)
+              << std::setw(12) << textSaveWatch.get_last_seconds() << std::setw(12) << textLoadWatch.get_last_seconds() << std::endl;
+    std::cout << std::left << std::setw(10) << "binary" << std::right
+              << std::setw(12) << binSaveWatch.get_last_seconds() << std::setw(12) << binLoadWatch.get_last_seconds() << std::endl;
+
+    remove("14_bin_load.bddx");
+    remove("14_bin_load.bin");
+    delete binForest;
+    delete textForest;
+    delete forest;
+    if ((textCard != card) || (binCard != card)) {
+        std::cout << "The loaded sets differ from the saved one!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -39,6 +39,8 @@ class BRAVE_DD::FileReader {
         return x;
     }
     inline char getFormat() { return format; }
+    inline char getCompress() { return compress; }
+    inline FILE* getFile() { return infile; }
     inline std::string getFileName() { return filename; }
 
     /*-------------------------------------------------------------*/
@@ -1,182 +1,452 @@
 #include "out_bddx.h"
 #include "../forest.h"
-#include <unordered_map>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 using namespace BRAVE_DD;
+// ******************************************************************
+// *                                                                *
+// *                       BddxWriter class                         *
+// *                                                                *
+// ******************************************************************
+/**
+ * Formatted text gathered in a block, written to the stream (or the pipe of a compressor) when
+ * it holds BLOCK_SIZE bytes, and by flush(), which throws COULDNT_WRITE if the write fails.
+ */
+class BRAVE_DD::BddxWriter {
+    public:
+    BddxWriter(std::ostream& out) : outfile(&out), pipe(nullptr) {block.reserve(BLOCK_SIZE + 256);}
+    BddxWriter(FILE* out) : outfile(nullptr), pipe(out) {block.reserve(BLOCK_SIZE + 256);}
+
+    inline BddxWriter& operator<<(const char* str) {block.append(str); return check();}
+    inline BddxWriter& operator<<(const std::string& str) {block.append(str); return check();}
+    inline BddxWriter& operator<<(const char ch) {block.push_back(ch); return check();}
+    inline BddxWriter& operator<<(const int num) {
+        if (num < 0) block.push_back('-');
+        return *this << (unsigned long)((num < 0) ? -(long)num : num);
+    }
+    inline BddxWriter& operator<<(const unsigned num) {return *this << (unsigned long)num;}
+    inline BddxWriter& operator<<(const unsigned short num) {return *this << (unsigned long)num;}
+    inline BddxWriter& operator<<(unsigned long num) {
+        char digits[20];
+        int n = 0;
+        do {
+            digits[n++] = '0' + (num % 10);
+            num /= 10;
+        } while (num);
+        while (n) block.push_back(digits[--n]);
+        return check();
+    }
+    void flush() {
+        if (block.empty()) return;
+        bool isWritten;
+        if (outfile) {
+            isWritten = (bool)outfile->write(block.data(), block.size());
+        } else {
+            isWritten = (fwrite(block.data(), 1, block.size(), pipe) == block.size());
+        }
+        block.clear();
+        if (!isWritten) {
+            std::cout << "[BRAVE_DD] Error!\t BddxMaker::buildBddx(): Could not write the file!" << std::endl;
+            throw error(ErrCode::COULDNT_WRITE, __FILE__, __LINE__);
+        }
+    }
+    private:
+    static const size_t BLOCK_SIZE = 1 << 16;
+    inline BddxWriter& check() {
+        if (block.size() >= BLOCK_SIZE) flush();
+        return *this;
+    }
+    std::ostream*   outfile;
+    FILE*           pipe;
+    std::string     block;
+};
+
+namespace {
+/**
+ * The compressor "zip -c", run with its output in fileName, opened here so that the name never
+ * goes through a shell, and the pipe to its input. SIGPIPE is blocked in this thread while the
+ * pipe is open: if the compressor exits early (or is not found), the writes fail with EPIPE
+ * instead of killing the process. The destructor closes the pipe and reaps the compressor if
+ * finish() was not reached, e.g., when the writing throws.
+ */
+class Compressor {
+    public:
+    Compressor(const char* zip, const std::string& fileName);
+    ~Compressor() {if (pipe) finish();}
+    inline FILE* input() const {return pipe;}
+    /// Close the input and wait for the compressor: true if all the input was compressed.
+    bool finish();
+    private:
+    FILE*       pipe;
+    pid_t       pid;
+    sigset_t    oldMask;
+};
+
+Compressor::Compressor(const char* zip, const std::string& fileName) : pipe(nullptr), pid(-1)
+{
+    int fd = open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cout << "[BRAVE_DD] Error!\t BddxMaker::buildBddx(): Could not open or create the file: "<< fileName << std::endl;
+        throw error(ErrCode::COULDNT_WRITE, __FILE__, __LINE__);
+    }
+    int ends[2];
+    if (::pipe(ends) != 0) {
+        close(fd);
+        throw error(ErrCode::COULDNT_WRITE, __FILE__, __LINE__);
+    }
+    sigset_t sigpipe;
+    sigemptyset(&sigpipe);
+    sigaddset(&sigpipe, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigpipe, &oldMask);
+    pid = fork();
+    if (pid == 0) {
+        pthread_sigmask(SIG_SETMASK, &oldMask, nullptr);
+        dup2(ends[0], STDIN_FILENO);
+        dup2(fd, STDOUT_FILENO);
+        close(ends[0]);
+        close(ends[1]);
+        close(fd);
+        execlp(zip, zip, "-c", (char*)nullptr);
+        _exit(127);
+    }
+    close(ends[0]);
+    close(fd);
+    if (pid >= 0) pipe = fdopen(ends[1], "w");
+    if (!pipe) {
+        close(ends[1]);
+        if (pid > 0) waitpid(pid, nullptr, 0);
+        pthread_sigmask(SIG_SETMASK, &oldMask, nullptr);
+        std::cout << "[BRAVE_DD] Error!\t BddxMaker::buildBddx(): Could not run " << zip << std::endl;
+        throw error(ErrCode::COULDNT_WRITE, __FILE__, __LINE__);
+    }
+}
+
+bool Compressor::finish()
+{
+    bool isDone = (fclose(pipe) == 0);
+    pipe = nullptr;
+    int status = 0;
+    isDone = (waitpid(pid, &status, 0) == pid) && WIFEXITED(status) && (WEXITSTATUS(status) == 0) && isDone;
+    // discard the SIGPIPE of a failed write before unblocking it
+    sigset_t pending;
+    sigpending(&pending);
+    if (sigismember(&pending, SIGPIPE) && !sigismember(&oldMask, SIGPIPE)) {
+        sigset_t sigpipe;
+        sigemptyset(&sigpipe);
+        sigaddset(&sigpipe, SIGPIPE);
+        int sig;
+        sigwait(&sigpipe, &sig);
+    }
+    pthread_sigmask(SIG_SETMASK, &oldMask, nullptr);
+    return isDone;
+}
+
+} // end of anonymous namespace
+
 // ******************************************************************
 // *                                                                *
 // *                      BddxMaker methods                         *
 // *                                                                *
 // ******************************************************************
 
-void BddxMaker::buildBddx(const Func& func, const std::string fn)
+void BddxMaker::buildBddx(const Func& func, const std::string fn, const char compress)
+{
+    buildBddx(std::vector<Func>(1, func), fn, compress);
+}
+
+void BddxMaker::buildBddx(const std::vector<Func>& func, const std::string fn, const char compress)
 {
     if (fn == "") {
-        buildBddx(func, std::cout);
-    } else {
+        BddxWriter out(std::cout);
+        buildBddx(func, out);
+    } else if (compress == ' ') {
         std::string fileName = fn+".bddx";
-        std::ofstream out;
-        out.open(fileName);
-        if (!out) {
+        std::ofstream outfile;
+        outfile.open(fileName);
+        if (!outfile) {
             std::cout << "[BRAVE_DD] Error!\t BddxMaker::buildBddx(): Could not open or create the file: "<< fileName << std::endl;
-            exit(1);
+            throw error(ErrCode::COULDNT_WRITE, __FILE__, __LINE__);
         }
+        BddxWriter out(outfile);
         buildBddx(func, out);
-        out.close();
-    }
-}
-
-void BddxMaker::buildBddx(const std::vector<Func>& func, const std::string fn)
-{
-    if (fn == "") {
-        buildBddx(func, std::cout);
+        outfile.close();
+        if (!outfile) {
+            std::cout << "[BRAVE_DD] Error!\t BddxMaker::buildBddx(): Could not write the file: "<< fileName << std::endl;
+            throw error(ErrCode::COULDNT_WRITE, __FILE__, __LINE__);
+        }
     } else {
+        const char* zip = nullptr;
         std::string fileName = fn+".bddx";
-        std::ofstream out;
-        out.open(fileName);
-        if (!out) {
-            std::cout << "[BRAVE_DD] Error!\t BddxMaker::buildBddx(): Could not open or create the file: "<< fileName << std::endl;
-            exit(1);
+        switch (compress)
+        {
+            case 'x': zip = "xz";       fileName += ".xz";  break;
+            case 'g': zip = "gzip";     fileName += ".gz";  break;
+            case 'b': zip = "bzip2";    fileName += ".bz2"; break;
+            default:
+                std::cout << "[BRAVE_DD] Error!\t BddxMaker::buildBddx(): Unknown compress: "<< compress << std::endl;
+                throw error(ErrCode::INVALID_ARGUMENT, __FILE__, __LINE__);
         }
+        Compressor zipper(zip, fileName);
+        BddxWriter out(zipper.input());
         buildBddx(func, out);
-        out.close();
+        if (!zipper.finish()) {
+            std::cout << "[BRAVE_DD] Error!\t BddxMaker::buildBddx(): Could not compress the file: "<< fileName << std::endl;
+            throw error(ErrCode::COULDNT_WRITE, __FILE__, __LINE__);
+        }
+    }
+}
+
+void BddxMaker::makeHeader(BddxWriter& out)
+{
+    out << "FOREST {\n";
+    out << "\tTYPE " << parent->getSetting().getName() << "\n";
+    out << "\tREDUCED true\n";
+    out << "\tLVLS " << parent->getSetting().getNumVars() << " * " << (parent->getSetting().isRelation() ? 2 : 1) << "\n";
+    out << "\tRANGE " << rangeType2String(parent->getSetting().getRangeType()) << "\n";
+}
+
+void BddxMaker::collectNodes(const std::vector<Func>& func)
+{
+    Level numVars = parent->getSetting().getNumVars();
+    nodes.assign(numVars+1, std::vector<NodeHandle>());
+    index.resize(numVars+1);
+    for (Level l=1; l<=numVars; l++) index[l].assign(parent->nodeMan->chunks[l-1].firstUnalloc, 0);
+    for (size_t i=0; i<func.size(); i++) {
+        const Edge& edge = func[i].getEdge();
+        if (edge.getNodeLevel() > 0) collectNodes(edge.getNodeLevel(), edge.getNodeHandle());
+    }
+    // in the order of the handles, as they are stored
+    for (Level l=1; l<=numVars; l++) {
+        std::sort(nodes[l].begin(), nodes[l].end());
+        for (size_t i=0; i<nodes[l].size(); i++) index[l][nodes[l][i]] = (uint32_t)i;
     }
 }
 
-void BddxMaker::makeHeader(std::ostream& outfile)
+void BddxMaker::collectNodes(const Level lvl, const NodeHandle handle)
 {
-    outfile << "FOREST {\n";
-    outfile << "\tTYPE " << parent->getSetting().getName() << "\n";
-    outfile << "\tREDUCED true\n";
-    outfile << "\tLVLS " << parent->getSetting().getNumVars() << " * " << (parent->getSetting().isRelation() ? 2 : 1) << "\n";
-    outfile << "\tRANGE " << rangeType2String(parent->getSetting().getRangeType()) << "\n";
+    // nonzero once visited, until the positions are given
+    if (index[lvl][handle]) return;
+    index[lvl][handle] = 1;
+    nodes[lvl].push_back(handle);
+    bool isMxd = parent->getSetting().isRelation();
+    bool hasLevelInfo = parent->getSetting().getReductionSize() > 0;
+    int numChild = (isMxd) ? 4 : 2;
+    const Node& node = parent->getNode(lvl, handle);
+    for (int c=0; c<numChild; c++) {
+        Level childLvl = (hasLevelInfo) ? node.childNodeLevel(c, isMxd) : lvl-1;
+        if (childLvl > 0) collectNodes(childLvl, node.childNodeHandle(c, isMxd));
+    }
 }
 
-void BddxMaker::buildBddx(const Func& func, std::ostream& outfile)
+void BddxMaker::buildBddx(const std::vector<Func>& func, BddxWriter& out)
 {
+    collectNodes(func);
+    Level numVars = parent->getSetting().getNumVars();
+    // the global index of the first node at each level, from 1
+    std::vector<uint64_t> first(numVars+1, 1);
+    for (Level l=2; l<=numVars; l++) first[l] = first[l-1] + nodes[l-1].size();
+    uint64_t numNodes = (numVars > 0) ? first[numVars] + nodes[numVars].size() - 1 : 0;
     // header
-    makeHeader(outfile);
-    outfile << "\tNNUM " << parent->getNodeManUsed(func) << "\n";
-    outfile << "\tRNUM 1\n";
-    outfile << "}\n";
-
-    // nodes map for global index
-    struct pairHash
-    {
-        std::size_t operator()(const std::pair<Level, NodeHandle>& p) const noexcept {
-            return (static_cast<std::size_t>(p.first) << 32) ^ p.second;
-        }
-    };
-    std::unordered_map<std::pair<Level, NodeHandle>, uint64_t, pairHash> nodeMap(parent->getNodeManUsed(func));
+    makeHeader(out);
+    out << "\tNNUM " << numNodes << "\n";
+    out << "\tRNUM " << func.size() << "\n";
+    out << "}\n";
+
     // nodes
     bool isMxd = parent->getSetting().isRelation();
     bool hasLevelInfo = parent->getSetting().getReductionSize() > 0;
     int numChild = (isMxd) ? 4 : 2;
-    outfile << "NODES {\n";
-    parent->markNodes(func);
-    uint64_t nodeIndex = 1;
-    for (Level l=1; l<=parent->getSetting().getNumVars(); l++) {
-        for (uint32_t i=1; i<parent->nodeMan->chunks[l-1].firstUnalloc; i++) {
-            Node node = parent->nodeMan->chunks[l-1].nodes[i];
-            if (node.isMarked()) {
-                // node header
-                outfile << "\tN"<< nodeIndex << " L " << l << ": ";
-                // save map
-                nodeMap[{l, i}] = nodeIndex;
-                nodeIndex++;
-                // print child edges
-                for (int c=0; c<numChild; c++) {
-                    outfile << c << ":<" << rule2String(node.edgeRule(c, isMxd))
-                            << "," << (int)node.edgeComp(c, isMxd)
-                            << "," << (int)node.edgeSwap(c, 0, isMxd);
-                    Level childLvl = (hasLevelInfo) ? node.childNodeLevel(c, isMxd) : l-1;
-                    outfile << "," << ((childLvl == 0) ? "T" : "")
-                            << ((childLvl == 0) ? node.childNodeHandle(c, isMxd) : nodeMap[{childLvl, node.childNodeHandle(c, isMxd)}])
-                            << ">";
-                    if (c < numChild-1) {
-                        outfile << ",";
-                    } else {
-                        outfile << "\n";
-                    }
+    out << "NODES {\n";
+    for (Level l=1; l<=numVars; l++) {
+        for (size_t i=0; i<nodes[l].size(); i++) {
+            const Node& node = parent->getNode(l, nodes[l][i]);
+            // node header
+            out << "\tN" << first[l] + i << " L " << l << ": ";
+            // print child edges
+            for (int c=0; c<numChild; c++) {
+                out << c << ":<" << rule2String(node.edgeRule(c, isMxd))
+                    << "," << (int)node.edgeComp(c, isMxd)
+                    << "," << (int)node.edgeSwap(c, 0, isMxd);
+                Level childLvl = (hasLevelInfo) ? node.childNodeLevel(c, isMxd) : l-1;
+                NodeHandle target = node.childNodeHandle(c, isMxd);
+                if (childLvl == 0) {
+                    out << ",T" << target << ">";
+                } else {
+                    out << "," << first[childLvl] + index[childLvl][target] << ">";
                 }
+                out << ((c < numChild-1) ? ',' : '\n');
             }
-        } // end for subnodeman
-    } // end for level
-    outfile << "}\n";
+        }
+    }
+    out << "}\n";
 
     // roots
-    outfile << "ROOTS {\n";
-    outfile << "\tr1 <" << rule2String(func.getEdge().getRule()) 
-            << "," << (int)func.getEdge().getComp()
-            << "," << (int)func.getEdge().getSwap(0)
-            << "," << ((func.getEdge().getNodeLevel() == 0) ? "T" : "")
-            << ((func.getEdge().getNodeLevel() == 0) ? func.getEdge().getNodeHandle() : nodeMap[{func.getEdge().getNodeLevel(), func.getEdge().getNodeHandle()}])
-            << ">\n";
-    outfile << "}\n";
+    out << "ROOTS {\n";
+    for (size_t i=0; i<func.size(); i++) {
+        const Edge& edge = func[i].getEdge();
+        out << "\tr" << i+1 << " <" << rule2String(edge.getRule())
+            << "," << (int)edge.getComp()
+            << "," << (int)edge.getSwap(0);
+        if (edge.getNodeLevel() == 0) {
+            out << ",T" << edge.getNodeHandle() << ">\n";
+        } else {
+            out << "," << first[edge.getNodeLevel()] + index[edge.getNodeLevel()][edge.getNodeHandle()] << ">\n";
+        }
+    }
+    out << "}\n";
+    out.flush();
 }
 
-void BddxMaker::buildBddx(const std::vector<Func>& func, std::ostream& outfile)
+void BddxMaker::buildBin(const Func& func, const std::string fn)
 {
+    buildBin(std::vector<Func>(1, func), fn);
+}
+
+void BddxMaker::buildBin(const std::vector<Func>& func, const std::string fn)
+{
+    std::string fileName = fn+".bin";
+    std::ofstream out;
+    out.open(fileName, std::ios::out | std::ios::binary);
+    if (!out) {
+        std::cout << "[BRAVE_DD] Error!\t BddxMaker::buildBin(): Could not open or create the file: "<< fileName << std::endl;
+        throw error(ErrCode::COULDNT_WRITE, __FILE__, __LINE__);
+    }
+    buildBin(func, out);
+    out.close();
+    if (!out) {
+        std::cout << "[BRAVE_DD] Error!\t BddxMaker::buildBin(): Could not write the file: "<< fileName << std::endl;
+        throw error(ErrCode::COULDNT_WRITE, __FILE__, __LINE__);
+    }
+}
+
+void BddxMaker::buildBin(const std::vector<Func>& func, std::ostream& outfile)
+{
+    const ForestSetting& setting = parent->getSetting();
+    Level numVars = setting.getNumVars();
+    bool isMxd = setting.isRelation();
+    bool hasLevelInfo = setting.getReductionSize() > 0;
+    bool isPooled = (setting.getValType() == LONG) || (setting.getValType() == DOUBLE);
+    int numChild = (isMxd) ? 4 : 2;
+    int nodeSize = setting.nodeSize();
+    // the nodes to write, and the pooled terminal values used
+    collectNodes(func);
+    std::vector<uint64_t> count(numVars, 0);
+    std::vector<NodeHandle> pooled;
+    for (Level l=1; l<=numVars; l++) {
+        count[l-1] = nodes[l].size();
+        for (size_t i=0; isPooled && (i<nodes[l].size()); i++) {
+            const Node& node = parent->getNode(l, nodes[l][i]);
+            for (int c=0; c<numChild; c++) {
+                Level childLvl = (hasLevelInfo) ? node.childNodeLevel(c, isMxd) : l-1;
+                if ((childLvl == 0) && !node.isChildTerminalSpecial(c)) pooled.push_back(node.childNodeHandle(c, isMxd));
+            }
+        }
+    }
+    for (size_t r=0; r<func.size(); r++) {
+        if (isTerminalPooled(func[r].getEdge().getEdgeHandle())) pooled.push_back(func[r].getEdge().getNodeHandle());
+    }
+    std::sort(pooled.begin(), pooled.end());
+    pooled.erase(std::unique(pooled.begin(), pooled.end()), pooled.end());
+
     // header
-    makeHeader(outfile);
-    outfile << "\tNNUM " << parent->getNodeManUsed(func) << "\n";
-    outfile << "\tRNUM " << func.size() << "\n";
-    outfile << "}\n";
-
-    // nodes map for global index
-    struct pairHash
-    {
-        std::size_t operator()(const std::pair<Level, NodeHandle>& p) const noexcept {
-            return (static_cast<std::size_t>(p.first) << 32) ^ p.second;
+    BinHeader header;
+    memset(&header, 0, sizeof(header));
+    strncpy(header.magic, "BRAVEDD", sizeof(header.magic));
+    header.version = BIN_VERSION;
+    header.byteOrder = BIN_BYTE_ORDER;
+    strncpy(header.forest, setting.getName().c_str(), sizeof(header.forest)-1);
+    header.numVars = numVars;
+    header.nodeSize = nodeSize;
+    for (Level l=1; l<=numVars; l++) header.numNodes += count[l-1];
+    header.numRoots = func.size();
+    header.numPooled = pooled.size();
+    outfile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    outfile.write(reinterpret_cast<const char*>(count.data()), count.size()*sizeof(uint64_t));
+    for (size_t p=0; p<pooled.size(); p++) {
+        // the raw bits of the value, as the pool stores them
+        uint64_t bits = 0;
+        EdgeHandle terminal = POOL_VALUE_FLAG_MASK;
+        packTarget(terminal, pooled[p]);
+        Value val = getTerminalValue(terminal);
+        if (val.getType() == LONG) {
+            long v;
+            val.getValueTo(&v, LONG);
+            memcpy(&bits, &v, sizeof(bits));
+        } else {
+            double v;
+            val.getValueTo(&v, DOUBLE);
+            memcpy(&bits, &v, sizeof(bits));
         }
-    };
-    std::unordered_map<std::pair<Level, NodeHandle>, uint64_t, pairHash> nodeMap(parent->getNodeManUsed(func));
-    // nodes
-    bool isMxd = parent->getSetting().isRelation();
-    bool hasLevelInfo = parent->getSetting().getReductionSize() > 0;
-    int numChild = (isMxd) ? 4 : 2;
-    outfile << "NODES {\n";
-    parent->markNodes(func);
-    uint64_t nodeIndex = 1;
-    for (Level l=1; l<=parent->getSetting().getNumVars(); l++) {
-        for (uint32_t i=1; i<parent->nodeMan->chunks[l-1].firstUnalloc; i++) {
-            Node node = parent->nodeMan->chunks[l-1].nodes[i];
-            if (node.isMarked()) {
-                // node header
-                outfile << "\tN"<< nodeIndex << " L " << l << ": ";
-                // save map
-                nodeMap[{l, i}] = nodeIndex;
-                nodeIndex++;
-                // print child edges
-                for (int c=0; c<numChild; c++) {
-                    outfile << c << ":<" << rule2String(node.edgeRule(c, isMxd))
-                            << "," << (int)node.edgeComp(c, isMxd)
-                            << "," << (int)node.edgeSwap(c, 0, isMxd);
-                    Level childLvl = (hasLevelInfo) ? node.childNodeLevel(c, isMxd) : l-1;
-
-                    outfile << "," << ((childLvl == 0) ? "T" : "")
-                            << ((childLvl == 0) ? node.childNodeHandle(c, isMxd) : nodeMap[{childLvl, node.childNodeHandle(c, isMxd)}])
-                            << ">";
-                    if (c < numChild-1) {
-                        outfile << ",";
-                    } else {
-                        outfile << "\n";
-                    }
+        outfile.write(reinterpret_cast<const char*>(&bits), sizeof(bits));
+    }
+
+    // nodes, a level at a time
+    std::vector<uint32_t> records;
+    for (Level l=1; l<=numVars; l++) {
+        records.resize(nodes[l].size() * (nodeSize-1));
+        for (size_t i=0; i<nodes[l].size(); i++) {
+            const Node& node = parent->getNode(l, nodes[l][i]);
+            uint32_t* record = records.data() + i * (nodeSize-1);
+            memcpy(record, node.info.data()+1, (nodeSize-1) * sizeof(uint32_t));
+            record[0] &= ~MARK_MASK;
+            for (int c=0; c<numChild; c++) {
+                Level childLvl = (hasLevelInfo) ? node.childNodeLevel(c, isMxd) : l-1;
+                NodeHandle target = node.childNodeHandle(c, isMxd);
+                if (childLvl > 0) {
+                    record[1+c] = index[childLvl][target];
+                } else if (isPooled && !node.isChildTerminalSpecial(c)) {
+                    record[1+c] = (uint32_t)(std::lower_bound(pooled.begin(), pooled.end(), target) - pooled.begin());
                 }
             }
-        } // end for subnodeman
-    } // end for level
-    outfile << "}\n";
+        }
+        outfile.write(reinterpret_cast<const char*>(records.data()), records.size()*sizeof(uint32_t));
+    }
 
     // roots
-    outfile << "ROOTS {\n";
-    for (size_t i=0; i<func.size(); i++) {
-        outfile << "\tr" << i+1 << " <" << rule2String(func[i].getEdge().getRule()) 
-            << "," << (int)func[i].getEdge().getComp()
-            << "," << (int)func[i].getEdge().getSwap(0)
-            << "," << ((func[i].getEdge().getNodeLevel() == 0) ? "T" : "")
-            << ((func[i].getEdge().getNodeLevel() == 0) ? func[i].getEdge().getNodeHandle() : nodeMap[{func[i].getEdge().getNodeLevel(), func[i].getEdge().getNodeHandle()}])
-            << ">\n";
-    }
-    outfile << "}\n";
+    for (size_t r=0; r<func.size(); r++) {
+        const Edge& edge = func[r].getEdge();
+        BinRoot root;
+        memset(&root, 0, sizeof(root));
+        root.handle = edge.getEdgeHandle();
+        if (edge.getNodeLevel() > 0) {
+            packTarget(root.handle, index[edge.getNodeLevel()][edge.getNodeHandle()]);
+        } else if (isTerminalPooled(edge.getEdgeHandle())) {
+            packTarget(root.handle, (NodeHandle)(std::lower_bound(pooled.begin(), pooled.end(), edge.getNodeHandle()) - pooled.begin()));
+        }
+        // the edge value, widened to 64 bits
+        Value val = edge.getValue();
+        root.valueType = val.getType();
+        int64_t i64 = 0;
+        double d64 = 0.0;
+        if (val.getType() == INT) {
+            int v;
+            val.getValueTo(&v, INT);
+            i64 = v;
+        } else if (val.getType() == LONG) {
+            long v;
+            val.getValueTo(&v, LONG);
+            i64 = v;
+        } else if (val.getType() == FLOAT) {
+            float v;
+            val.getValueTo(&v, FLOAT);
+            d64 = v;
+        } else if (val.getType() == DOUBLE) {
+            val.getValueTo(&d64, DOUBLE);
+        } else {
+            SpecialValue v;
+            val.getValueTo(&v, VOID);
+            i64 = (int64_t)v;
+        }
+        if ((val.getType() == FLOAT) || (val.getType() == DOUBLE)) {
+            memcpy(&root.value, &d64, sizeof(root.value));
+        } else {
+            memcpy(&root.value, &i64, sizeof(root.value));
+        }
+        outfile.write(reinterpret_cast<const char*>(&root), sizeof(root));
+    }
 }
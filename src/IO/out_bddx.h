@@ -5,9 +5,41 @@
 
 namespace BRAVE_DD {
     class BddxMaker;
+    class BddxWriter;
     class Forest;
     class Func;
     class Edge;
+
+    /**
+     * The binary BDDX format (".bin"), version BIN_VERSION, in the byte order of the writer:
+     *      BinHeader
+     *      uint64_t    the number of nodes at each level, from level 1 to numVars
+     *      uint64_t    numPooled LONG/DOUBLE terminal values (raw bits), for the forests of such values
+     *      uint32_t    the nodes, level by level from level 1: each is info[1, nodeSize) of a Node,
+     *                  whose child handles are the indices of the child nodes among the nodes of their
+     *                  level, or the terminal values (the index in the pooled values if pooled)
+     *      BinRoot     numRoots root edges
+     * A file can only be loaded in a forest of the same type and number of variables.
+     */
+    static const uint32_t BIN_VERSION = 1;
+    static const uint32_t BIN_BYTE_ORDER = 0x01020304;
+    struct BinHeader {
+        char        magic[8];       // "BRAVEDD"
+        uint32_t    version;
+        uint32_t    byteOrder;      // BIN_BYTE_ORDER
+        char        forest[32];     // the name of the forest setting
+        uint32_t    numVars;
+        uint32_t    nodeSize;       // uint32_t slots of a node
+        uint64_t    numNodes;
+        uint64_t    numRoots;
+        uint64_t    numPooled;
+    };
+    struct BinRoot {
+        uint64_t    handle;         // EdgeHandle, whose target is the node index (or terminal value)
+        uint64_t    value;          // raw bits of the edge value, as int64_t or double
+        uint32_t    valueType;      // ValueType of the edge value
+        uint32_t    unused;
+    };
 } // end of namespace
 
 // ******************************************************************
@@ -24,16 +56,29 @@ class BRAVE_DD::BddxMaker {
     }
     ~BddxMaker() {}
 
-    void buildBddx(const Func& func, const std::string fn="");
-    void buildBddx(const std::vector<Func>& func, const std::string fn="");
+    /**
+     * The text format, in the file fn+".bddx", or on std::cout if fn is empty. With compress 'x',
+     * 'g' or 'b', the file fn+".bddx.xz" (".gz", ".bz2") is written through xz (gzip, bzip2), as
+     * FileReader reads them back.
+     */
+    void buildBddx(const Func& func, const std::string fn="", const char compress=' ');
+    void buildBddx(const std::vector<Func>& func, const std::string fn="", const char compress=' ');
+    // the binary format, in the file fn+".bin"
+    void buildBin(const Func& func, const std::string fn);
+    void buildBin(const std::vector<Func>& func, const std::string fn);
     /*-------------------------------------------------------------*/
     private:
     /*-------------------------------------------------------------*/
-    void makeHeader(std::ostream& outfile);
-    void buildBddx(const Func& func, std::ostream& outfile);
-    void buildBddx(const std::vector<Func>& func, std::ostream& outfile);
+    void makeHeader(BddxWriter& out);
+    void buildBddx(const std::vector<Func>& func, BddxWriter& out);
+    void buildBin(const std::vector<Func>& func, std::ostream& outfile);
+    /* The nodes reachable from the funcs, and their index among the nodes of their level */
+    void collectNodes(const std::vector<Func>& func);
+    void collectNodes(const Level lvl, const NodeHandle handle);
 
-    const Forest* parent;
+    const Forest*                       parent;
+    std::vector<std::vector<NodeHandle> > nodes;    // nodes[l]: the handles at level l, increasing
+    std::vector<std::vector<uint32_t> > index;      // index[l][handle]: the position in nodes[l]
 };
 
 #endif
\ No newline at end of file
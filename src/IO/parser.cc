@@ -1,5 +1,8 @@
 #include "parser.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 using namespace BRAVE_DD;
 
 // ******************************************************************
@@ -105,6 +108,37 @@ bool ParserPla::readAssignment(std::vector<bool>& inputs, int& out)
     out = t;
     return true;
 }
+bool ParserPla::readCube(Cube& inputs, int& out)
+{
+    int c;
+    while (true) {
+        c = get();
+        if (c == EOF) return false;
+        if (c == '.') {
+            skipUntil('\n');
+        } else {
+            break;
+        }
+    }
+    // read inputs
+    inputs = Cube((Level)inbits);
+    for (unsigned n=0; n<inbits; n++) {
+        if (n > 0) c = get();
+        if (c == EOF) {
+            std::cout << "[BRAVE_DD] ERROR!\t ParserPla::readCube(): Unexpected EOF.\n";
+            return false;
+        }
+        if (c != '-') inputs.set(n+1, static_cast<bool>(c-'0'));
+    }
+    // read out
+    int t = 0;
+    while ((c = get()) != '\n' && c != EOF) {
+        if (c == '1') t = (t << 1) | 1;
+        else if (c == '~') t <<= 1;
+    }
+    out = t;
+    return true;
+}
 
 
 // ******************************************************************
@@ -244,7 +278,8 @@ bool BRAVE_DD::ParserBddx::parseEdge(Forest* forest, const Level& beginLvl, Edge
         edge.setRule(rule);
         edge.setComp(comp);
         edge.setSwap(swap, (forest->getSetting().getSwapType() == TO || forest->getSetting().getSwapType() == FROM_TO));
-        edge = forest->normalizeEdge(beginLvl, edge);
+        // the edges of a reduced file are already those of the nodes
+        if (!isReduced) edge = forest->normalizeEdge(beginLvl, edge);
     } else if (lexer.match(TokenType::INT_LIT)) {
         // nonterminal node
         nodeId = std::stoull(token);
@@ -434,3 +469,216 @@ bool BRAVE_DD::ParserBddx::parse(Forest* forest)
     }
     return 0;
 }
+
+// ******************************************************************
+// *                                                                *
+// *                       ParserBin methods                        *
+// *                                                                *
+// ******************************************************************
+BRAVE_DD::ParserBin::ParserBin(const std::string& inpath) : reader(inpath)
+{
+    if (reader.getFormat() != 'b') {
+        std::cout << "[BRAVE_DD] ERROR!\t ParserBin(): Unexpected file format.\n";
+        exit(1);
+    }
+    data = nullptr;
+    length = 0;
+    offset = 0;
+    isMapped = 0;
+    memset(&header, 0, sizeof(header));
+    // map the file if it is not compressed
+    if ((reader.getCompress() == ' ') && (inpath != "")) {
+        int fd = fileno(reader.getFile());
+        struct stat st;
+        if ((fstat(fd, &st) == 0) && (st.st_size > 0)) {
+            void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                madvise(p, st.st_size, MADV_SEQUENTIAL);
+                data = static_cast<const char*>(p);
+                length = st.st_size;
+                isMapped = 1;
+            }
+        }
+    }
+    if (!isMapped) {
+        std::string chunk(1 << 20, '\0');
+        for (;;) {
+            size_t num = reader.readInBuffer(chunk, chunk.size());
+            if (num == 0) break;
+            buffer.append(chunk, 0, num);
+        }
+        data = buffer.data();
+        length = buffer.size();
+    }
+}
+
+BRAVE_DD::ParserBin::~ParserBin()
+{
+    if (isMapped) munmap(const_cast<char*>(data), length);
+}
+
+bool BRAVE_DD::ParserBin::parseHeader(Forest* forest)
+{
+    const char* p = take(1, sizeof(BinHeader));
+    if (!p) {
+        std::cerr << "[BRAVE_DD] Error: ParserBin::parse(): missing header in file: " << reader.getFileName() << std::endl;
+        return 1;
+    }
+    memcpy(&header, p, sizeof(BinHeader));
+    const ForestSetting& setting = forest->getSetting();
+    if ((strncmp(header.magic, "BRAVEDD", sizeof(header.magic)) != 0) || (header.byteOrder != BIN_BYTE_ORDER)) {
+        std::cerr << "[BRAVE_DD] Error: ParserBin::parse(): not a binary BDDX file, or of another byte order: "
+                    << reader.getFileName() << std::endl;
+        return 1;
+    }
+    if (header.version != BIN_VERSION) {
+        std::cerr << "[BRAVE_DD] Error: ParserBin::parse(): unsupported version " << header.version
+                    << " in file: " << reader.getFileName() << std::endl;
+        return 1;
+    }
+    header.forest[sizeof(header.forest)-1] = '\0';
+    if ((setting.getName() != header.forest) || (setting.getNumVars() != header.numVars)) {
+        std::cerr << "[BRAVE_DD] Error: ParserBin::parse(): the file was written from a " << header.forest
+                    << " forest of " << header.numVars << " variables, not compatible with the target "
+                    << setting.getName() << " forest of " << setting.getNumVars() << " variables" << std::endl;
+        return 1;
+    }
+    // the records are copied into the nodes of the target forest, so they must have its size
+    if ((uint32_t)setting.nodeSize() != header.nodeSize) {
+        std::cerr << "[BRAVE_DD] Error: ParserBin::parse(): nodes of " << header.nodeSize
+                    << " slots, not the " << setting.nodeSize() << " of the target forest, in file: "
+                    << reader.getFileName() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+bool BRAVE_DD::ParserBin::parse(Forest* forest)
+{
+    if (!forest) {
+        std::cerr << "[BRAVE_DD] Error: ParserBin::parse(): invalid target Forest" << std::endl;
+        return 1;
+    }
+    if (parseHeader(forest)) return 1;
+    const ForestSetting& setting = forest->getSetting();
+    Level numVars = setting.getNumVars();
+    bool isMxd = setting.isRelation();
+    bool hasLevelInfo = setting.getReductionSize() > 0;
+    ValueType valType = setting.getValType();
+    bool isPooled = (valType == LONG) || (valType == DOUBLE);
+    int numChild = (isMxd) ? 4 : 2;
+    size_t recordSize = (header.nodeSize - 1) * sizeof(uint32_t);
+
+    const char* p = take(numVars, sizeof(uint64_t));
+    const char* q = take(header.numPooled, sizeof(uint64_t));
+    if (!p || !q) {
+        std::cerr << "[BRAVE_DD] Error: ParserBin::parse(): truncated file: " << reader.getFileName() << std::endl;
+        return 1;
+    }
+    std::vector<uint64_t> count(numVars);
+    memcpy(count.data(), p, numVars * sizeof(uint64_t));
+    // the counts must add up to the nodes of the header, each of them bounded by it
+    uint64_t numNodes = 0;
+    for (Level l=1; l<=numVars; l++) {
+        if (count[l-1] > header.numNodes - numNodes) {
+            numNodes = header.numNodes + 1;
+            break;
+        }
+        numNodes += count[l-1];
+    }
+    if ((numNodes != header.numNodes) || (!isPooled && (header.numPooled > 0))) {
+        std::cerr << "[BRAVE_DD] Error: ParserBin::parse(): inconsistent node or value counts in file: "
+                    << reader.getFileName() << std::endl;
+        return 1;
+    }
+    // the pooled terminal values, interned in this process
+    std::vector<NodeHandle> pool(header.numPooled);
+    for (size_t i=0; i<pool.size(); i++) {
+        uint64_t bits;
+        memcpy(&bits, q + i*sizeof(uint64_t), sizeof(uint64_t));
+        if (valType == LONG) {
+            long v;
+            memcpy(&v, &bits, sizeof(v));
+            pool[i] = unpackTarget(makeTerminal(v));
+        } else {
+            double v;
+            memcpy(&v, &bits, sizeof(v));
+            pool[i] = unpackTarget(makeTerminal(v));
+        }
+    }
+
+    /* nodes, bottom-up: the children of a node are already in the handles of their level */
+    std::vector<std::vector<NodeHandle> > handles(numVars+1);
+    Node node(setting);
+    for (Level l=1; l<=numVars; l++) {
+        p = take(count[l-1], recordSize);
+        if (!p) {
+            std::cerr << "[BRAVE_DD] Error: ParserBin::parse(): truncated nodes at level " << l
+                        << " in file: " << reader.getFileName() << std::endl;
+            return 1;
+        }
+        handles[l].resize(count[l-1]);
+        for (uint64_t i=0; i<count[l-1]; i++) {
+            node.info[0] = 0;
+            memcpy(&node.info[1], p + i*recordSize, recordSize);
+            for (int c=0; c<numChild; c++) {
+                Level childLvl = (hasLevelInfo) ? node.childNodeLevel(c, isMxd) : l-1;
+                NodeHandle target = node.childNodeHandle(c, isMxd);
+                if (childLvl > 0) {
+                    if ((childLvl >= l) || (target >= handles[childLvl].size())) {
+                        std::cerr << "[BRAVE_DD] Error: ParserBin::parse(): invalid child of node " << i << " at level " << l
+                                    << " in file: " << reader.getFileName() << std::endl;
+                        return 1;
+                    }
+                    node.setChildNodeHandle(c, handles[childLvl][target], isMxd);
+                } else if (isPooled && !node.isChildTerminalSpecial(c)) {
+                    if (target >= pool.size()) {
+                        std::cerr << "[BRAVE_DD] Error: ParserBin::parse(): invalid terminal of node " << i << " at level " << l
+                                    << " in file: " << reader.getFileName() << std::endl;
+                        return 1;
+                    }
+                    node.setChildNodeHandle(c, pool[target], isMxd);
+                }
+            }
+            handles[l][i] = forest->insertNode(l, node);
+        }
+    }
+
+    // roots
+    roots.clear();
+    for (uint64_t r=0; r<header.numRoots; r++) {
+        p = take(1, sizeof(BinRoot));
+        if (!p) {
+            std::cerr << "[BRAVE_DD] Error: ParserBin::parse(): truncated roots in file: " << reader.getFileName() << std::endl;
+            return 1;
+        }
+        BinRoot root;
+        memcpy(&root, p, sizeof(BinRoot));
+        EdgeHandle handle = root.handle;
+        Level lvl = unpackLevel(handle);
+        NodeHandle target = unpackTarget(handle);
+        if ((lvl > numVars) || ((lvl > 0) && (target >= handles[lvl].size()))
+            || ((lvl == 0) && isTerminalPooled(handle) && (target >= pool.size()))) {
+            std::cerr << "[BRAVE_DD] Error: ParserBin::parse(): invalid root " << r+1
+                        << " in file: " << reader.getFileName() << std::endl;
+            return 1;
+        }
+        if (lvl > 0) packTarget(handle, handles[lvl][target]);
+        else if (isTerminalPooled(handle)) packTarget(handle, pool[target]);
+        Edge edge;
+        edge.setEdgeHandle(handle);
+        int64_t i64;
+        double d64;
+        memcpy(&i64, &root.value, sizeof(i64));
+        memcpy(&d64, &root.value, sizeof(d64));
+        switch ((ValueType)root.valueType) {
+            case INT:       edge.setValue(Value((int)i64));             break;
+            case LONG:      edge.setValue(Value((long)i64));            break;
+            case FLOAT:     edge.setValue(Value((float)d64));           break;
+            case DOUBLE:    edge.setValue(Value(d64));                  break;
+            default:        edge.setValue(Value((SpecialValue)i64));
+        }
+        roots.push_back(Func(forest, edge));
+    }
+    return 0;
+}
@@ -3,13 +3,14 @@
 
 #include "../defines.h"
 #include "lexer.h"
+#include "out_bddx.h"
 #include "../forest.h"
 
 namespace BRAVE_DD{
     class Parser;
     class ParserPla;
     class ParserBddx;
-    class ParserBin;        // TBD
+    class ParserBin;
 } // end of namespace
 
 // ******************************************************************
@@ -76,6 +77,8 @@ class BRAVE_DD::ParserPla : public Parser {
     virtual void readHeader() override;
     bool readAssignment(std::vector<bool>& inputs, char& out);
     bool readAssignment(std::vector<bool>& inputs, int& out);
+    // the inputs '-' are don't-cares; inputs.get(n+1) is the input n
+    bool readCube(Cube& inputs, int& out);
     // get bits info
     inline unsigned getInBits() { return inbits; }
     inline unsigned getOutBits() { return outbits; }
@@ -154,6 +157,56 @@ class BRAVE_DD::ParserBddx {
 
 };
 
-// more parsers for BIN
+// ******************************************************************
+// *                                                                *
+// *                       ParserBin class                          *
+// *                                                                *
+// ******************************************************************
+/**
+ * @brief Loader of the binary BDDX format written by BddxMaker::buildBin (see BinHeader).
+ *
+ * An uncompressed file is mapped in memory, a compressed one is read through FileReader. The
+ * nodes are inserted in the unique table level by level from the bottom, their children being
+ * found by index in the arrays of handles of the levels below, without parsing or hashing ids.
+ */
+class BRAVE_DD::ParserBin {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    ParserBin(const std::string& inpath);
+    ~ParserBin();
+
+    /* Build all nodes and roots in the given forest; 1 if failed, as ParserBddx::parse */
+    bool parse(Forest* forest);
+
+    // get bdd info
+    inline uint64_t getNumNodes() { return header.numNodes; }
+    inline uint64_t getNumRoots() { return header.numRoots; }
+    inline Level getNumVars() { return (Level)header.numVars; }
+    inline Func getRoot(size_t id=1) { return roots[id-1]; }
+    inline std::vector<Func> getAllRoots() { return roots; }
+
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    /* The next "num" elements of "size" bytes of the data, or null past its end */
+    inline const char* take(uint64_t num, size_t size) {
+        // compared by division: num comes from the file, and num*size may wrap
+        if ((size > 0) && (num > (length - offset) / size)) return nullptr;
+        const char* p = data + offset;
+        offset += num * size;
+        return p;
+    }
+    bool parseHeader(Forest* forest);
+
+    FileReader          reader;         // input file reader
+    const char*         data;           // the content of the file
+    size_t              length;         // its size in bytes
+    size_t              offset;         // position of the next read
+    bool                isMapped;       // data is mapped, else it is in buffer
+    std::string         buffer;         // the content of a compressed file
+    BinHeader           header;
+    std::vector<Func>   roots;
+};
 
 #endif
\ No newline at end of file
@@ -24,6 +24,8 @@
 #include "function.h"
 #include "forest.h"
 #include "operators.h"
+#include "expression.h"
+#include "sampler.h"
 #include "operations/apply.h"
 #include "IO/out_dot.h"
 #include "IO/out_bddx.h"
@@ -120,6 +120,8 @@ namespace BRAVE_DD {
     const uint64_t FLOAT_VALUE_FLAG_MASK = ((uint64_t)0x01<<63);
     const uint64_t INT_VALUE_FLAG_MASK = ((uint64_t)0x01<<62);
     const uint64_t SPECIAL_VALUE_FLAG_MASK = ((uint64_t)0x01<<61);
+    /* Both float and int flags: LONG or DOUBLE terminal, nodeIdx is its index in the terminal pool */
+    const uint64_t POOL_VALUE_FLAG_MASK = FLOAT_VALUE_FLAG_MASK | INT_VALUE_FLAG_MASK;
     const uint64_t RULE_MASK = (uint64_t)(0x0F) << 51;
     const uint64_t LEVEL_MASK = (uint64_t)0xFFFF << 32;
     const uint64_t COMP_MASK = (uint64_t)(0x01) << 48;
@@ -127,6 +129,18 @@ namespace BRAVE_DD {
     const uint64_t SWAP_TO_MASK = (uint64_t)(0x01) << 49;
     const uint64_t NODE_MASK = 0xFFFFFFFF;
     const uint64_t LABEL_MASK = (uint64_t)(0xFF) << 48;
+    /* Header, level and nodeIdx: what identifies a terminal, ignoring rule and flags */
+    const uint64_t TERMINAL_VALUE_MASK = POOL_VALUE_FLAG_MASK | SPECIAL_VALUE_FLAG_MASK | LEVEL_MASK | NODE_MASK;
+    /* Plain terminal handles of the constants; LONG/DOUBLE 0 and 1 are the first entries of the terminal pool */
+    const uint64_t TERMINAL_INT_ZERO = INT_VALUE_FLAG_MASK;
+    const uint64_t TERMINAL_INT_ONE = INT_VALUE_FLAG_MASK | 0x01;
+    const uint64_t TERMINAL_FLOAT_ZERO = FLOAT_VALUE_FLAG_MASK;
+    const uint64_t TERMINAL_FLOAT_NEG_ZERO = FLOAT_VALUE_FLAG_MASK | 0x80000000;
+    const uint64_t TERMINAL_FLOAT_ONE = FLOAT_VALUE_FLAG_MASK | 0x3F800000;
+    const uint64_t TERMINAL_LONG_ZERO = POOL_VALUE_FLAG_MASK | 0x00;
+    const uint64_t TERMINAL_LONG_ONE = POOL_VALUE_FLAG_MASK | 0x01;
+    const uint64_t TERMINAL_DOUBLE_ZERO = POOL_VALUE_FLAG_MASK | 0x02;
+    const uint64_t TERMINAL_DOUBLE_ONE = POOL_VALUE_FLAG_MASK | 0x03;
 
     
     /* Methods of EdgeHandle */
@@ -207,7 +221,9 @@ namespace BRAVE_DD {
         std::string value = "";
         if (unpackLevel(handle) == 0) {
             NodeHandle target = unpackTarget(handle);
-            if (handle & FLOAT_VALUE_FLAG_MASK) {
+            if ((handle & POOL_VALUE_FLAG_MASK) == POOL_VALUE_FLAG_MASK) {
+                value = "#" + std::to_string(target);
+            } else if (handle & FLOAT_VALUE_FLAG_MASK) {
                 value = std::to_string(*reinterpret_cast<float*>(&target));
             } else if (handle & INT_VALUE_FLAG_MASK) {
                 value = std::to_string(target);
@@ -262,6 +278,8 @@ class BRAVE_DD::Value {
     Value(const Value& val);
 
     ValueType getType() const { return valueType; }
+    /// Get the value converted to T (int, long, float or double), chosen at compile time.
+    template <typename T> inline T getValueAs() const;
     inline void getValueTo(void* p, ValueType type) const {
         switch (type) {
             case VOID:
@@ -378,6 +396,24 @@ class BRAVE_DD::Value {
             return *this;
         }
     }
+    inline Value operator*(const Value& val) const {
+        // this is INF
+        if ((valueType == VOID) && ((special == SpecialValue::POS_INF) || (special == SpecialValue::NEG_INF))) {
+            return *this;
+        // val is INF
+        } else if ((val.valueType == VOID) && ((val.special == SpecialValue::POS_INF) || (val.special == SpecialValue::NEG_INF))) {
+            return val;
+        } else if (valueType == val.valueType) {
+            if (valueType == INT) return intValue * val.getIntValue();
+            if (valueType == FLOAT) return floatValue * val.getFloatValue();
+            if (valueType == LONG) return longValue * val.getLongValue();
+            if (valueType == DOUBLE) return doubleValue * val.getDoubleValue();
+            // both special: omega times omega, undef times undef
+            if ((valueType == VOID) && (special == val.special)) return *this;
+        }
+        std::cout << "[BRAVE_DD] ERROR!\t Value*: multiply values with different type!" << std::endl;
+        throw error(BRAVE_DD::ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+    }
     inline Value operator%(const int& mod) const {
         if ((valueType != INT) && (valueType != LONG)) {
             std::cout << "[BRAVE_DD] ERROR!\t only mod values with INT or LONG type!" << std::endl;
@@ -392,18 +428,32 @@ class BRAVE_DD::Value {
     /*-------------------------------------------------------------*/
     inline int getIntValue() const {
         if (valueType != INT) {
+            if (valueType == LONG) return static_cast<int>(longValue);
+            if (valueType == DOUBLE) return static_cast<int>(doubleValue);
             return static_cast<int>(floatValue);
         }
         return intValue;
     }
-    inline long getLongValue() const { return longValue;}
+    inline long getLongValue() const {
+        if (valueType == INT) return static_cast<long>(intValue);
+        if (valueType == FLOAT) return static_cast<long>(floatValue);
+        if (valueType == DOUBLE) return static_cast<long>(doubleValue);
+        return longValue;
+    }
     inline float getFloatValue() const { 
         if (valueType != FLOAT) {
+            if (valueType == LONG) return static_cast<float>(longValue);
+            if (valueType == DOUBLE) return static_cast<float>(doubleValue);
             return static_cast<float>(intValue);
         }
         return floatValue;
     }
-    inline double getDoubleValue() const { return doubleValue;}
+    inline double getDoubleValue() const {
+        if (valueType == INT) return static_cast<double>(intValue);
+        if (valueType == LONG) return static_cast<double>(longValue);
+        if (valueType == FLOAT) return static_cast<double>(floatValue);
+        return doubleValue;
+    }
     inline SpecialValue getSpecialValue() const { return special;}
     // inline void setVoid() {valueType = VOID;}
     inline void setInt(const void *p) {
@@ -482,6 +532,8 @@ class BRAVE_DD::Value {
     /*-------------------------------------------------------------*/
     friend class Func;
     friend class ExplictFunc;
+    friend class FrozenFunc;
+    friend class FuncIterator;
     /// Values
     union {
         int             intValue;
@@ -492,6 +544,13 @@ class BRAVE_DD::Value {
     ValueType valueType;
     SpecialValue special;
 };
+namespace BRAVE_DD {
+    template <> inline int Value::getValueAs<int>() const {return getIntValue();}
+    template <> inline long Value::getValueAs<long>() const {return getLongValue();}
+    template <> inline float Value::getValueAs<float>() const {return getFloatValue();}
+    template <> inline double Value::getValueAs<double>() const {return getDoubleValue();}
+};
+
 // ******************************************************************
 // *                                                                *
 // *                                                                *
@@ -0,0 +1,405 @@
+#include "expression.h"
+#include "forest.h"
+#include "operators.h"
+#include "hash_stream.h"
+#include "error.h"
+
+#include <unordered_map>
+
+using namespace BRAVE_DD;
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                       Evaluation struct                        *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+struct Expression::Evaluation {
+    struct Step {
+        ExprType    type;
+        size_t      left;       // the leaf index for LEAF, the step of the (first) operand otherwise
+        size_t      right;      // the step of the second operand
+    };
+    struct EdgesHash {
+        inline size_t operator()(const std::vector<Edge>& edges) const {
+            hash_stream hs;
+            hs.start();
+            for (size_t i=0; i<edges.size(); i++) {
+                hs.push((unsigned)(edges[i].getEdgeHandle() >> 32));
+                hs.push((unsigned)edges[i].getEdgeHandle());
+            }
+            return (size_t)hs.finish64();
+        }
+    };
+    std::vector<Step>   steps;          // the operands before the operators, the root last
+    std::vector<Func>   leaves;         // the Funcs, the leftmost first
+    Forest*             forest;
+    // results per level for the edges of the leaves; the steps are the same for the whole
+    // computation, so the edges are the whole key
+    std::vector<std::unordered_map<std::vector<Edge>, Edge, EdgesHash> >    cache;
+};
+
+namespace {
+/* What the edges of the leaves at one level tell of a step */
+struct Partial {
+    enum Kind {
+        ZERO,
+        ONE,
+        LEAF,       // the leaf, or its complement
+        UNKNOWN
+    };
+    Kind    kind;
+    size_t  leaf;
+    bool    comp;
+};
+
+inline Partial makePartial(Partial::Kind kind, size_t leaf = 0, bool comp = 0)
+{
+    Partial p;
+    p.kind = kind;
+    p.leaf = leaf;
+    p.comp = comp;
+    return p;
+}
+
+inline Partial notPartial(const Partial& p)
+{
+    if (p.kind == Partial::ZERO) return makePartial(Partial::ONE);
+    if (p.kind == Partial::ONE) return makePartial(Partial::ZERO);
+    if (p.kind == Partial::LEAF) return makePartial(Partial::LEAF, p.leaf, !p.comp);
+    return p;
+}
+
+inline bool isSameLeaf(const Partial& p1, const Partial& p2)
+{
+    return (p1.kind == Partial::LEAF) && (p2.kind == Partial::LEAF) && (p1.leaf == p2.leaf);
+}
+
+/* AND, then OR and XOR through complements */
+Partial andPartial(const Partial& p1, const Partial& p2)
+{
+    if ((p1.kind == Partial::ZERO) || (p2.kind == Partial::ZERO)) return makePartial(Partial::ZERO);
+    if (p1.kind == Partial::ONE) return p2;
+    if (p2.kind == Partial::ONE) return p1;
+    if (isSameLeaf(p1, p2)) return (p1.comp == p2.comp) ? p1 : makePartial(Partial::ZERO);
+    return makePartial(Partial::UNKNOWN);
+}
+
+Partial xorPartial(const Partial& p1, const Partial& p2)
+{
+    if (p1.kind == Partial::ZERO) return p2;
+    if (p2.kind == Partial::ZERO) return p1;
+    if (p1.kind == Partial::ONE) return notPartial(p2);
+    if (p2.kind == Partial::ONE) return notPartial(p1);
+    if (isSameLeaf(p1, p2)) return makePartial((p1.comp == p2.comp) ? Partial::ZERO : Partial::ONE);
+    return makePartial(Partial::UNKNOWN);
+}
+
+} // end of anonymous namespace
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                       Expression methods                       *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+Expression::Expression(const Func& f)
+{
+    std::shared_ptr<Node> node = std::make_shared<Node>();
+    node->type = ExprType::LEAF;
+    node->leaf = f;
+    root = node;
+}
+Expression::Expression(ExprType type, const Expression& e1, const Expression& e2)
+{
+    std::shared_ptr<Node> node = std::make_shared<Node>();
+    node->type = type;
+    node->left = e1.root;
+    if (type != ExprType::NOT) node->right = e2.root;
+    root = node;
+}
+Expression::~Expression()
+{
+    //
+}
+
+Forest* Expression::getForest() const
+{
+    const Node* node = root.get();
+    while (node->type != ExprType::LEAF) node = node->left.get();
+    return node->leaf.getForest();
+}
+
+size_t Expression::size() const
+{
+    Evaluation eval;
+    flatten(eval);
+    return eval.steps.size();
+}
+
+Expression::operator Func() const
+{
+    Evaluation eval;
+    flatten(eval);
+    eval.forest = eval.leaves[0].getForest();
+    const ForestSetting& setting = eval.forest->getSetting();
+    // copy the Funcs of other forests
+    for (size_t i=1; i<eval.leaves.size(); i++) {
+        if (eval.leaves[i].getForest() == eval.forest) continue;
+        if (eval.leaves[i].getForest()->getSetting().isRelation() != setting.isRelation()) {
+            throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+        }
+        Func copied(eval.forest);
+        apply(COPY, eval.leaves[i], copied);
+        eval.leaves[i] = copied;
+    }
+    if ((setting.getRangeType() != BOOLEAN) || (setting.getEncodeMechanism() != TERMINAL)) {
+        return computeEach(eval);
+    }
+    std::vector<Edge> edges(eval.leaves.size());
+    for (size_t i=0; i<edges.size(); i++) edges[i] = eval.leaves[i].getEdge();
+    Level numVars = setting.getNumVars();
+    eval.cache.resize(numVars+1);
+    return Func(eval.forest, compute(eval, numVars, edges));
+}
+
+void Expression::flatten(Evaluation& eval) const
+{
+    // post-order, the left operands first; shared subexpressions become one step
+    std::unordered_map<const Node*, size_t> index;
+    std::vector<std::pair<const Node*, bool> > stack(1, std::make_pair(root.get(), false));
+    while (!stack.empty()) {
+        const Node* node = stack.back().first;
+        bool isExpanded = stack.back().second;
+        stack.pop_back();
+        if (index.count(node)) continue;
+        if ((node->type != ExprType::LEAF) && !isExpanded) {
+            stack.push_back(std::make_pair(node, true));
+            if (node->right) stack.push_back(std::make_pair(node->right.get(), false));
+            stack.push_back(std::make_pair(node->left.get(), false));
+            continue;
+        }
+        Evaluation::Step step;
+        step.type = node->type;
+        step.left = 0;
+        step.right = 0;
+        if (node->type == ExprType::LEAF) {
+            step.left = eval.leaves.size();
+            eval.leaves.push_back(node->leaf);
+        } else {
+            step.left = index[node->left.get()];
+            if (node->right) step.right = index[node->right.get()];
+        }
+        index[node] = eval.steps.size();
+        eval.steps.push_back(step);
+    }
+}
+
+Func Expression::computeEach(const Evaluation& eval) const
+{
+    std::vector<Func> results(eval.steps.size());
+    for (size_t s=0; s<eval.steps.size(); s++) {
+        const Evaluation::Step& step = eval.steps[s];
+        switch (step.type) {
+            case ExprType::LEAF:
+                results[s] = eval.leaves[step.left];
+                break;
+            case ExprType::NOT:
+                results[s] = !results[step.left];
+                break;
+            case ExprType::AND:
+                results[s] = results[step.left] & results[step.right];
+                break;
+            case ExprType::OR:
+                results[s] = results[step.left] | results[step.right];
+                break;
+            case ExprType::XOR:
+                results[s] = results[step.left] ^ results[step.right];
+                break;
+        }
+    }
+    return results.back();
+}
+
+Edge Expression::compute(Evaluation& eval, const Level lvl, const std::vector<Edge>& leaves) const
+{
+    Forest* forest = eval.forest;
+    const ForestSetting& setting = forest->getSetting();
+    auto constant = [forest, lvl](bool one) {
+        Edge e;
+        EdgeHandle handle = forest->makeBoolTerminal(one);
+        packRule(handle, RULE_X);
+        e.setEdgeHandle(handle);
+        return forest->normalizeEdge(lvl, e);
+    };
+    // the leaves: constants, or the first leaf with the same edge or its complement
+    std::vector<Edge> opnds(leaves.size());
+    std::vector<Partial> known(leaves.size());
+    for (size_t i=0; i<leaves.size(); i++) {
+        opnds[i] = forest->normalizeEdge(lvl, leaves[i]);
+        if (opnds[i].isConstantZero()) {
+            known[i] = makePartial(Partial::ZERO);
+            continue;
+        }
+        if (opnds[i].isConstantOne()) {
+            known[i] = makePartial(Partial::ONE);
+            continue;
+        }
+        known[i] = makePartial(Partial::LEAF, i);
+        for (size_t j=0; j<i; j++) {
+            if (known[j].kind != Partial::LEAF) continue;
+            if (opnds[j] == opnds[i]) {
+                known[i] = known[j];
+                break;
+            }
+            if ((setting.getCompType() != NO_COMP) && opnds[j].isComplementTo(opnds[i])) {
+                known[i] = notPartial(known[j]);
+                break;
+            }
+        }
+    }
+    // the steps
+    std::vector<Partial> values(eval.steps.size());
+    for (size_t s=0; s<eval.steps.size(); s++) {
+        const Evaluation::Step& step = eval.steps[s];
+        switch (step.type) {
+            case ExprType::LEAF:
+                values[s] = known[step.left];
+                break;
+            case ExprType::NOT:
+                values[s] = notPartial(values[step.left]);
+                break;
+            case ExprType::AND:
+                values[s] = andPartial(values[step.left], values[step.right]);
+                break;
+            case ExprType::OR:
+                values[s] = notPartial(andPartial(notPartial(values[step.left]), notPartial(values[step.right])));
+                break;
+            case ExprType::XOR:
+                values[s] = xorPartial(values[step.left], values[step.right]);
+                break;
+        }
+    }
+    // Base case: a constant, a leaf, or its complement when allowed on the edges
+    const Partial& result = values.back();
+    if (result.kind == Partial::ZERO) return constant(0);
+    if (result.kind == Partial::ONE) return constant(1);
+    if ((result.kind == Partial::LEAF) && !result.comp) return opnds[result.leaf];
+    if ((result.kind == Partial::LEAF) && (setting.getCompType() != NO_COMP)) {
+        Edge ans = opnds[result.leaf];
+        ans.complement();
+        if (!setting.hasReductionRule(ans.getRule())) ans = forest->normalizeEdge(lvl, ans);
+        return ans;
+    }
+    // the leaves the result depends on; the others are set to constants that keep the known
+    // steps, so that they do not split the cache entries
+    std::vector<bool> isLive(leaves.size(), 0);
+    if (result.kind == Partial::LEAF) {
+        isLive[result.leaf] = 1;
+    } else {
+        std::vector<bool> isVisited(eval.steps.size(), 0);
+        std::vector<size_t> stack(1, eval.steps.size()-1);
+        while (!stack.empty()) {
+            size_t s = stack.back();
+            stack.pop_back();
+            if (isVisited[s]) continue;
+            isVisited[s] = 1;
+            if (values[s].kind == Partial::LEAF) {
+                isLive[values[s].leaf] = 1;
+            } else if ((values[s].kind == Partial::UNKNOWN) && (eval.steps[s].type != ExprType::LEAF)) {
+                stack.push_back(eval.steps[s].left);
+                if (eval.steps[s].type != ExprType::NOT) stack.push_back(eval.steps[s].right);
+            }
+        }
+    }
+    for (size_t i=0; i<leaves.size(); i++) {
+        if ((known[i].kind == Partial::LEAF) && !isLive[known[i].leaf]) opnds[i] = constant(known[i].comp);
+    }
+
+    bool isRel = setting.isRelation();
+    Level m = 0;
+    for (size_t i=0; i<opnds.size(); i++) m = MAX(m, opnds[i].getNodeLevel());
+    if (m < lvl) {
+        // the skipped levels are redundant in every leaf, so are they in the result; otherwise,
+        // the rules are taken apart one level at a time
+        bool isSkip = 1;
+        for (size_t i=0; isSkip && (i<opnds.size()); i++) isSkip = (opnds[i].getRule() == RULE_X);
+        if (isSkip) {
+            Edge ans = compute(eval, m, opnds);
+            EdgeLabel incoming = 0;
+            packRule(incoming, RULE_X);
+            return forest->mergeEdge(lvl, m, incoming, ans);
+        }
+        m = lvl;
+    }
+    // assertion: m == lvl > 0
+    std::vector<Edge> key = opnds;
+    for (size_t i=0; i<key.size(); i++) {
+        if (key[i].getNodeLevel() == m) key[i].setRule(RULE_X);
+    }
+    std::unordered_map<std::vector<Edge>, Edge, Evaluation::EdgesHash>::const_iterator it = eval.cache[m].find(key);
+    if (it != eval.cache[m].end()) return it->second;
+    std::vector<Edge> child((isRel) ? 4 : 2);
+    std::vector<Edge> cofacts(opnds.size());
+    for (size_t c=0; c<child.size(); c++) {
+        for (size_t i=0; i<opnds.size(); i++) cofacts[i] = forest->cofact(m, opnds[i], (char)c);
+        child[c] = compute(eval, m-1, cofacts);
+    }
+    EdgeLabel label = 0;
+    packRule(label, RULE_X);
+    Edge ans = forest->reduceEdge(m, label, m, child);
+    eval.cache[m][key] = ans;
+    return ans;
+}
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                           Operators                            *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+namespace BRAVE_DD {
+    Expression operator&(const Expression &e1, const Expression &e2)
+    {
+        return Expression(Expression::ExprType::AND, e1, e2);
+    }
+    Expression operator&(const Expression &e1, const Func &f2)
+    {
+        return e1 & Expression(f2);
+    }
+    Expression operator&(const Func &f1, const Expression &e2)
+    {
+        return Expression(f1) & e2;
+    }
+    Expression operator|(const Expression &e1, const Expression &e2)
+    {
+        return Expression(Expression::ExprType::OR, e1, e2);
+    }
+    Expression operator|(const Expression &e1, const Func &f2)
+    {
+        return e1 | Expression(f2);
+    }
+    Expression operator|(const Func &f1, const Expression &e2)
+    {
+        return Expression(f1) | e2;
+    }
+    Expression operator^(const Expression &e1, const Expression &e2)
+    {
+        return Expression(Expression::ExprType::XOR, e1, e2);
+    }
+    Expression operator^(const Expression &e1, const Func &f2)
+    {
+        return e1 ^ Expression(f2);
+    }
+    Expression operator^(const Func &f1, const Expression &e2)
+    {
+        return Expression(f1) ^ e2;
+    }
+    Expression operator!(const Expression &e)
+    {
+        return Expression(Expression::ExprType::NOT, e, e);
+    }
+}
@@ -0,0 +1,96 @@
+#ifndef BRAVE_DD_EXPRESSION_H
+#define BRAVE_DD_EXPRESSION_H
+
+#include "defines.h"
+#include "edge.h"
+#include "function.h"
+
+#include <memory>
+
+namespace BRAVE_DD {
+    class Expression;
+    class Forest;
+
+    Expression operator&(const Expression &e1, const Expression &e2);
+    Expression operator&(const Expression &e1, const Func &f2);
+    Expression operator&(const Func &f1, const Expression &e2);
+    Expression operator|(const Expression &e1, const Expression &e2);
+    Expression operator|(const Expression &e1, const Func &f2);
+    Expression operator|(const Func &f1, const Expression &e2);
+    Expression operator^(const Expression &e1, const Expression &e2);
+    Expression operator^(const Expression &e1, const Func &f2);
+    Expression operator^(const Func &f1, const Expression &e2);
+    Expression operator!(const Expression &e);
+};
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                       Expression class                         *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/**
+ * @brief A lazy Boolean expression over Funcs.
+ *
+ * The operators on Funcs compute their result at once, so every subexpression is a reduced
+ * Func in the forest. Starting with Expression(f) instead, the operators &, |, ^ and ! only
+ * record the expression; it is computed when converted to a Func, by one traversal of all its
+ * Funcs at once, so that the intermediate results are never built:
+ *
+ *      Func f = (Expression(a) & b) | (c & !Expression(d));
+ *
+ * Subexpressions are shared, not copied, so an Expression is cheap to copy and to reuse.
+ */
+class BRAVE_DD::Expression {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    Expression(const Func& f);
+    ~Expression();
+
+    /* The forest of the result: the forest of the leftmost Func */
+    Forest* getForest() const;
+    /* The number of distinct Funcs and operators in the expression */
+    size_t size() const;
+
+    /**
+     * @brief Compute the expression in the forest of its leftmost Func; the other Funcs are
+     * copied there first. Forests with a Boolean range and terminal encoding use one traversal;
+     * the others apply the operators one at a time.
+     */
+    operator Func() const;
+
+    friend Expression operator&(const Expression &e1, const Expression &e2);
+    friend Expression operator|(const Expression &e1, const Expression &e2);
+    friend Expression operator^(const Expression &e1, const Expression &e2);
+    friend Expression operator!(const Expression &e);
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    enum class ExprType {
+        LEAF,
+        NOT,
+        AND,
+        OR,
+        XOR
+    };
+    struct Node {
+        ExprType                        type;
+        Func                            leaf;       // for LEAF only
+        std::shared_ptr<const Node>     left;       // the operand of NOT, or the first operand
+        std::shared_ptr<const Node>     right;      // the second operand
+    };
+    /* An expression flattened for its computation, defined in expression.cc */
+    struct Evaluation;
+
+    Expression(ExprType type, const Expression& e1, const Expression& e2);
+
+    void flatten(Evaluation& eval) const;
+    Func computeEach(const Evaluation& eval) const;
+    Edge compute(Evaluation& eval, const Level lvl, const std::vector<Edge>& leaves) const;
+
+    std::shared_ptr<const Node> root;
+};
+
+#endif
@@ -17,9 +17,26 @@ Forest::Forest(const ForestSetting& s):setting(s)
     /* Check consistency */
     checkCompatibility();
     nodeSize = setting.nodeSize();
+    engine = specializedEngine(setting);
+    /* Constant terminals of the value type */
+    ValueType valType = setting.getValType();
+    if (valType == FLOAT) {
+        terminalZero = TERMINAL_FLOAT_ZERO;
+        terminalOne = TERMINAL_FLOAT_ONE;
+    } else if (valType == LONG) {
+        terminalZero = TERMINAL_LONG_ZERO;
+        terminalOne = TERMINAL_LONG_ONE;
+    } else if (valType == DOUBLE) {
+        terminalZero = TERMINAL_DOUBLE_ZERO;
+        terminalOne = TERMINAL_DOUBLE_ONE;
+    } else {
+        terminalZero = TERMINAL_INT_ZERO;
+        terminalOne = TERMINAL_INT_ONE;
+    }
     nodeMan = new NodeManager(this);
     uniqueTable = new UniqueTable(this);
     stats = new Statistics();
+    if ((valType == LONG) || (valType == DOUBLE)) terminalPool().attach();
 }
 Forest::~Forest()
 {
@@ -29,6 +46,11 @@ Forest::~Forest()
     // find and remove all related operations
     UOPs.remove(this);
     BOPs.remove(this);
+    TOPs.remove(this);
+    SOPs.remove(this);
+    // the last forest of pooled values gives the pool back
+    ValueType valType = setting.getValType();
+    if ((valType == LONG) || (valType == DOUBLE)) terminalPool().detach();
 }
 /***************************** Cardinality **********************/
 uint64_t Forest::count(Func func, int val)
@@ -47,7 +69,8 @@ void Forest::importForest(std::istream& in)
     //
 }
 /************************* Reduction ****************************/
-Edge Forest::normalizeNode(const Level nodeLevel, const std::vector<Edge>& down)
+template <typename P>
+Edge Forest::normalizeNodeT(const P& policy, const Level nodeLevel, const std::vector<Edge>& down)
 {
     // assuming all child edges are reduced and legal
     /* copy the child info */
@@ -65,12 +88,12 @@ Edge Forest::normalizeNode(const Level nodeLevel, const std::vector<Edge>& down)
     ans.setRule(RULE_X);    // short
     Node node(setting);
     bool comp = 0, swap = 0, swapTo = 0;
-    EncodeMechanism em = setting.getEncodeMechanism();
+    EncodeMechanism em = policy.getEncodeMechanism();
     /* =================================================================================================
     * BDD for "Set" (Terminal encoding)
     * ================================================================================================*/
-    if (!setting.isRelation() && (em == TERMINAL)) {
-        if (setting.getSwapType() == ONE) {
+    if (!policy.isRelation() && (em == TERMINAL)) {
+        if (policy.getSwapType() == ONE) {
             // swap-one logic
             if (child[0].getNodeLevel() != child[1].getNodeLevel()) {
                 swap = child[0].getNodeLevel() > child[1].getNodeLevel();
@@ -85,7 +108,7 @@ Edge Forest::normalizeNode(const Level nodeLevel, const std::vector<Edge>& down)
                 swap = rule0 > rule1;
             }
             if (swap) SWAP(child[0], child[1]);
-        } else if (setting.getSwapType() == ALL) {
+        } else if (policy.getSwapType() == ALL) {
             // swap-all logic
             if (child[0].getNodeLevel() != child[1].getNodeLevel()) {
                 swap = child[0].getNodeLevel() > child[1].getNodeLevel();
@@ -109,11 +132,11 @@ Edge Forest::normalizeNode(const Level nodeLevel, const std::vector<Edge>& down)
                 useless1 = isSwapAllUseless(child[1]);
                 if (useless0 == 1) child[0].setSwap(0, 0);
                 if (useless1 == 1) child[1].setSwap(0, 0);
-                if ((useless0 == 2) && (setting.getCompType() == COMP)) {
+                if ((useless0 == 2) && (policy.getCompType() == COMP)) {
                     child[0].setSwap(0, 0);
                     child[0].setComp(!child[0].getComp());
                 }
-                if ((useless1 == 2) && (setting.getCompType() == COMP)) {
+                if ((useless1 == 2) && (policy.getCompType() == COMP)) {
                     child[1].setSwap(0, 0);
                     child[1].setComp(!child[1].getComp());
                 }
@@ -132,15 +155,15 @@ Edge Forest::normalizeNode(const Level nodeLevel, const std::vector<Edge>& down)
         std::cout << std::endl;
 #endif
 
-        bool hasLvl = setting.getReductionSize() > 0;
+        bool hasLvl = policy.getReductionSize() > 0;
         node.setChildEdge(0, child[0].getEdgeHandle(), 0, hasLvl);
         node.setChildEdge(1, child[1].getEdgeHandle(), 0, hasLvl);
     /* =================================================================================================
     * BDD for "Set" (Edge value encoding)
     * ================================================================================================*/
-    } else if(!setting.isRelation() && em == EDGE_PLUS) {
+    } else if(!policy.isRelation() && em == EDGE_PLUS) {
         // swap logic
-        if (setting.getSwapType() == ONE) {
+        if (policy.getSwapType() == ONE) {
             // swap-one
             if (child[0].getNodeLevel() != child[1].getNodeLevel()) {
                 swap = child[0].getNodeLevel() > child[1].getNodeLevel();
@@ -155,10 +178,10 @@ Edge Forest::normalizeNode(const Level nodeLevel, const std::vector<Edge>& down)
                 swap = rule0 > rule1;
             }
             if (swap) SWAP(child[0], child[1]);
-        } else if (setting.getSwapType() == ALL) {
+        } else if (policy.getSwapType() == ALL) {
             // swap-all
         }
-        bool hasLvl = setting.getReductionSize() > 0;
+        bool hasLvl = policy.getReductionSize() > 0;
         /* 
          * One is special terminal value, or both but different, check this first
          */
@@ -180,42 +203,15 @@ Edge Forest::normalizeNode(const Level nodeLevel, const std::vector<Edge>& down)
             // here 0 child must be Omega terminal or nonterminal
             ans.setValue(child[0].getValue());
         } else {
-            if (setting.getValType() == INT) {
-                int ev0, ev1, min;
-                Value normalized;
-                child[0].getValue().getValueTo(&ev0, INT);
-                child[1].getValue().getValueTo(&ev1, INT);
-                // normalize then mode
-                if (ev0 < ev1) {
-                    min = ev0;
-                    normalized = (ev1 - ev0);
-                    node.setEdgeValue(1, normalized);
-                } else {
-                    min = ev1;
-                    normalized = (ev0 - ev1);
-                    node.setEdgeValue(0, normalized);
-                }
-                ans.setValue(min);
-            } else if (setting.getValType() == LONG) {
-                long ev0, ev1, min;
-                Value normalized;
-                child[0].getValue().getValueTo(&ev0, LONG);
-                child[1].getValue().getValueTo(&ev1, LONG);
-                if (ev0 < ev1) {
-                    min = ev0;
-                    normalized = (ev1 - ev0);
-                    node.setEdgeValue(1, normalized);
-                } else {
-                    min = ev1;
-                    normalized = ev0 - ev1;
-                    node.setEdgeValue(0, normalized);
-                }
-                ans.setValue(Value(min));
-            } else if (setting.getValType() == FLOAT) {
+            if (policy.getValType() == INT) {
+                normalizeEvPlus<int>(node, child, ans);
+            } else if (policy.getValType() == LONG) {
+                normalizeEvPlus<long>(node, child, ans);
+            } else if (policy.getValType() == FLOAT) {
                 //TODO: implement setting values in node
-            } else if (setting.getValType() == DOUBLE) {
+            } else if (policy.getValType() == DOUBLE) {
                 //TODO: implement setting values in node
-            } else if (setting.getValType() == VOID) {
+            } else if (policy.getValType() == VOID) {
                 // TODO: Talk to Lichuan about this
                 // When would be the setting be VOID beside the constant inf func
             }
@@ -223,8 +219,8 @@ Edge Forest::normalizeNode(const Level nodeLevel, const std::vector<Edge>& down)
     /* =================================================================================================
     * BDD for "Set" (Edge value mod encoding)
     * ================================================================================================*/
-    } else if (!setting.isRelation() && em == EDGE_PLUSMOD) {
-        bool hasLvl = setting.getReductionSize() > 0;
+    } else if (!policy.isRelation() && em == EDGE_PLUSMOD) {
+        bool hasLvl = policy.getReductionSize() > 0;
         unsigned long maxRange = (em == EDGE_PLUS) ? 0 : setting.getMaxRange();
         /* 
          * One is special terminal value, or both but different, check this first
@@ -234,12 +230,12 @@ Edge Forest::normalizeNode(const Level nodeLevel, const std::vector<Edge>& down)
         node.setChildEdge(0, child0, 0, hasLvl);
         node.setChildEdge(1, child1, 0, hasLvl);
 
-        if (setting.getValType() == INT 
+        if (policy.getValType() == INT 
             && (maxRange > static_cast<unsigned long>(std::numeric_limits<int>::max()))) {
                 std::cout << "[BRAVE_DD] ERROR!\t maxRange overflows valType specified" << std::endl;
                 exit(0);
         }
-        if (setting.getValType() == LONG 
+        if (policy.getValType() == LONG 
             && (maxRange > static_cast<unsigned long>(std::numeric_limits<long>::max()))) {
                 std::cout << "[BRAVE_DD] ERROR!\t maxRange overflows valType specified" << std::endl;
                 exit(0);
@@ -259,39 +255,46 @@ Edge Forest::normalizeNode(const Level nodeLevel, const std::vector<Edge>& down)
             // here 0 child must be Omega terminal or nonterminal
             ans.setValue(child[0].getValue());
         } else {
-            if (setting.getValType() == INT) {
-                int ev0, ev1, mod;
-                mod = static_cast<int>(maxRange);
-                Value normalized;
-                child[0].getValue().getValueTo(&ev0, INT);
-                child[1].getValue().getValueTo(&ev1, INT);
-                normalized = Value(((((ev1 - ev0) % mod) + mod) % mod));
-                node.setEdgeValue(1, normalized);
-                ans.setValue(ev0);
-            } else if (setting.getValType() == LONG) {
-                long ev0, ev1, mod;
-                mod = static_cast<long>(maxRange);
-                Value normalized;
-                child[0].getValue().getValueTo(&ev0, LONG);
-                child[1].getValue().getValueTo(&ev1, LONG);
-                normalized = Value(((((ev1 - ev0) % mod) + mod) % mod));
-                node.setEdgeValue(1, normalized);
-                ans.setValue(ev0);
-            } else if (setting.getValType() == FLOAT) {
+            if (policy.getValType() == INT) {
+                normalizeEvMod<int>(node, child, static_cast<int>(maxRange), ans);
+            } else if (policy.getValType() == LONG) {
+                normalizeEvMod<long>(node, child, static_cast<long>(maxRange), ans);
+            } else if (policy.getValType() == FLOAT) {
                 //TODO: implement setting values in node
-            } else if (setting.getValType() == DOUBLE) {
+            } else if (policy.getValType() == DOUBLE) {
                 //TODO: implement setting values in node
-            } else if (setting.getValType() == VOID) {
+            } else if (policy.getValType() == VOID) {
                 // TODO: Talk to Lichuan about this
                 // When would be the setting be VOID beside the constant inf func
             }
         }    
     /* =================================================================================================
+    * BDD for "Set" (Edge multiply encoding)
+    * ================================================================================================*/
+    } else if (!policy.isRelation() && em == EDGE_MULT) {
+        bool hasLvl = policy.getReductionSize() > 0;
+        node.setChildEdge(0, child[0].getEdgeHandle(), 0, hasLvl);
+        node.setChildEdge(1, child[1].getEdgeHandle(), 0, hasLvl);
+        /*
+         * Divide both weights by the first nonzero one, so that child 0 has weight 1 unless it is 0;
+         * the normalizer goes to the incoming edge. Both weights 0 means the node encodes 0.
+         */
+        double ev0 = multWeight(child[0].getValue());
+        double ev1 = multWeight(child[1].getValue());
+        double norm = (ev0 != 0.0) ? ev0 : ev1;
+        if (norm != 0.0) {
+            ev0 = ev0 / norm;
+            ev1 = ev1 / norm;
+        }
+        node.setEdgeMultValue(0, multValue(ev0), 0);
+        node.setEdgeMultValue(1, multValue(ev1), 0);
+        ans.setValue(multValue(norm));
+    /* =================================================================================================
     * BDD for "Relation" (Terminal encoding)
     * ================================================================================================*/
-    } else if (setting.isRelation() && em == TERMINAL){
+    } else if (policy.isRelation() && em == TERMINAL){
         // for relation BDD TBD
-        bool hasLvl = setting.getReductionSize() > 0;
+        bool hasLvl = policy.getReductionSize() > 0;
         node.setChildEdge(0, child[0].getEdgeHandle(), 1, hasLvl);
         node.setChildEdge(1, child[1].getEdgeHandle(), 1, hasLvl);
         node.setChildEdge(2, child[2].getEdgeHandle(), 1, hasLvl);
@@ -299,7 +302,7 @@ Edge Forest::normalizeNode(const Level nodeLevel, const std::vector<Edge>& down)
     /* =================================================================================================
     * BDD for "Relation" (Edge value encoding)
     * ================================================================================================*/
-    } else if(setting.isRelation() && (em == EDGE_PLUS)) {
+    } else if(policy.isRelation() && (em == EDGE_PLUS)) {
     } else {
         // others, TBD
     }
@@ -315,7 +318,8 @@ Edge Forest::normalizeNode(const Level nodeLevel, const std::vector<Edge>& down)
     return ans;
 }
 
-Edge Forest::normalizeEdge(const Level level, const Edge& edge)
+template <typename P>
+Edge Forest::normalizeEdgeT(const P& policy, const Level level, const Edge& edge)
 {
 #ifdef BRAVE_DD_FOREST_TRACE
     std::cout << "normalize edge from level: " << level << "; ";
@@ -327,7 +331,7 @@ Edge Forest::normalizeEdge(const Level level, const Edge& edge)
     // double ev;
     // edge.getValue().getValueTo(&ev, DOUBLE);
     // std::cout << "edge value : "<< ev << std::endl; 
-    bool isCompAllowed = (setting.getCompType() != NO_COMP);
+    bool isCompAllowed = (policy.getCompType() != NO_COMP);
     ReductionRule rule = edge.getRule();
     bool comp = edge.getComp();
     Level targetLvl = edge.getNodeLevel();
@@ -339,15 +343,7 @@ Edge Forest::normalizeEdge(const Level level, const Edge& edge)
     }
     /* case 1: AL/AH edges but only skip 1 level, normalize it to EL/EH */
     if (level - targetLvl == 1) {
-        if ((rule == RULE_AL0) && setting.hasReductionRule(RULE_EL0)) {
-            normalized.setRule(RULE_EL0);
-        } else if ((rule == RULE_AL1) && setting.hasReductionRule(RULE_EL1)) {
-            normalized.setRule(RULE_EL1);
-        } else if ((rule == RULE_AH0) && setting.hasReductionRule(RULE_EH0)) {
-            normalized.setRule(RULE_EH0);
-        } else if ((rule == RULE_AH1) && setting.hasReductionRule(RULE_EH1)) {
-            normalized.setRule(RULE_EH1);
-        }
+        normalized.setRule(policy.getOneLevelRule(rule));
     }
     /* Case 2: target to terminal node */
     if (targetLvl == 0) {
@@ -361,7 +357,7 @@ Edge Forest::normalizeEdge(const Level level, const Edge& edge)
         normalized.setSwap(0,0);
         normalized.setSwap(0,1);
         // rule 2: forbidding terminal value > N/2, if complement flag allowed
-        if (setting.getCompType() != NO_COMP) {
+        if (policy.getCompType() != NO_COMP) {
             if (termVal.getType() == INT) {
                 termVal.getValueTo(&valInt, INT);
                 if ((setting.getMaxRange() - valInt) <= (double)(setting.getMaxRange())/2) {
@@ -421,15 +417,9 @@ Edge Forest::normalizeEdge(const Level level, const Edge& edge)
             || (level - targetLvl == 0)) {
             // it should be a long X anyway
             normalized.setRule(RULE_X);
-            if (!setting.hasReductionRule(RULE_X) && (level - targetLvl > 0)) {
-                // long X is not allowed, try to find a legal reduction rule
-                for (int r=0; r<11; r++){
-                    if (setting.hasReductionRule((ReductionRule)r)
-                        && ((normalized.getComp()^isTermOne) == hasRuleTerminalOne((ReductionRule)r))) {
-                        normalized.setRule((ReductionRule)r);
-                        break;
-                    }
-                }
+            if (!policy.hasReductionRule(RULE_X) && (level - targetLvl > 0)) {
+                // long X is not allowed, use the legal reduction rule if any
+                normalized.setRule(policy.getConstantRule(normalized.getComp()^isTermOne));
             }
         }
         // rule 4: EH edge at level 1 target to terminal 0 or 1, changed to EL
@@ -437,28 +427,16 @@ Edge Forest::normalizeEdge(const Level level, const Edge& edge)
             && isRuleEH(normalized.getRule())
             && (hasRuleTerminalOne(normalized.getRule()) != (normalized.getComp()^isTermOne))
             && (isTermOne || isTermZero)) {
-            if ((normalized.getRule() == RULE_EH0) && setting.hasReductionRule(RULE_EL1)) {
-                if (termVal.getType() == INT) {
-                    normalized.handle = makeTerminal(INT, 0);
-                } else {
-                    normalized.handle = makeTerminal(FLOAT, 0.0f);
-                }
+            if ((normalized.getRule() == RULE_EH0) && policy.hasReductionRule(RULE_EL1)) {
+                normalized.handle = makeBoolTerminal(0);
                 normalized.setRule(RULE_EL1);
                 normalized.setComp(0);
-            } else if ((normalized.getRule() == RULE_EH1) && setting.hasReductionRule(RULE_EL0)) {
+            } else if ((normalized.getRule() == RULE_EH1) && policy.hasReductionRule(RULE_EL0)) {
                 if (isCompAllowed) {
-                    if (termVal.getType() == INT) {
-                        normalized.handle = makeTerminal(INT, 0);
-                    } else {
-                        normalized.handle = makeTerminal(FLOAT, 0.0f);
-                    }
+                    normalized.handle = makeBoolTerminal(0);
                     normalized.setComp(1);
                 } else{
-                    if (termVal.getType() == INT) {
-                        normalized.handle = makeTerminal(INT, 1);
-                    } else {
-                        normalized.handle = makeTerminal(FLOAT, 1.0f);
-                    }
+                    normalized.handle = makeBoolTerminal(1);
                     normalized.setComp(0);
                 }
                 normalized.setRule(RULE_EL0);
@@ -468,9 +446,9 @@ Edge Forest::normalizeEdge(const Level level, const Edge& edge)
     /* Case 3: long edge with reduction rule that is not allowed */
     rule = normalized.getRule();
     comp = normalized.getComp();
-    if ((level - targetLvl > 0) && !setting.hasReductionRule(rule)) {
+    if ((level - targetLvl > 0) && !policy.hasReductionRule(rule)) {
         std::vector<Edge> childEdges;
-        if (setting.isRelation()) {
+        if (policy.isRelation()) {
             childEdges = std::vector<Edge>(4);
         } else {
             childEdges = std::vector<Edge>(2);
@@ -482,24 +460,21 @@ Edge Forest::normalizeEdge(const Level level, const Edge& edge)
                 for (size_t i=0; i<childEdges.size(); i++) {
                     childEdges[i] = temp;
                 }
-                temp = reduceNode(k, childEdges);
+                temp = reduceNodeT(policy, k, childEdges);
             }
         } else if (isRuleEL(rule) || isRuleEH(rule) || isRuleAL(rule) || isRuleAH(rule)) {
             bool child = (isRuleEL(rule) || isRuleAL(rule)) ? 0 : 1;
-            childEdges[child].handle = makeTerminal(INT,(int)hasRuleTerminalOne(rule));
-            if (setting.getValType() == FLOAT) {
-                childEdges[child].handle = makeTerminal(FLOAT,(float)hasRuleTerminalOne(rule));
-            }
+            childEdges[child].handle = makeBoolTerminal(hasRuleTerminalOne(rule));
             childEdges[child].setRule(RULE_X);
             childEdges[!child] = temp;
             childEdges[!child].setRule(RULE_X);
             for (Level k=targetLvl+1; k<=level; k++) {
-                childEdges[0] = normalizeEdge(k-1, childEdges[0]);
-                childEdges[1] = normalizeEdge(k-1, childEdges[1]);
-                temp = reduceNode(k, childEdges);
+                childEdges[0] = normalizeEdgeT(policy, k-1, childEdges[0]);
+                childEdges[1] = normalizeEdgeT(policy, k-1, childEdges[1]);
+                temp = reduceNodeT(policy, k, childEdges);
                 childEdges[(isRuleEH(rule) || isRuleAL(rule))?0:1] = temp;
             }
-        } else if (isRuleI(rule)) {
+        } else if (policy.isRelation() && isRuleI(rule)) {   // identity rules only in relations
             childEdges[0] = temp;
             childEdges[3] = temp;
             childEdges[1].handle = makeTerminal(INT,(int)hasRuleTerminalOne(rule));
@@ -507,11 +482,11 @@ Edge Forest::normalizeEdge(const Level level, const Edge& edge)
             childEdges[2].handle = makeTerminal(INT,(int)hasRuleTerminalOne(rule));
             childEdges[2].setRule(RULE_X);
             for (Level k=targetLvl+1; k<=level; k++) {
-                childEdges[0] = normalizeEdge(k-1, childEdges[0]);
-                childEdges[1] = normalizeEdge(k-1, childEdges[1]);
-                childEdges[2] = normalizeEdge(k-1, childEdges[2]);
-                childEdges[3] = normalizeEdge(k-1, childEdges[3]);
-                temp = normalizeNode(k, childEdges);
+                childEdges[0] = normalizeEdgeT(policy, k-1, childEdges[0]);
+                childEdges[1] = normalizeEdgeT(policy, k-1, childEdges[1]);
+                childEdges[2] = normalizeEdgeT(policy, k-1, childEdges[2]);
+                childEdges[3] = normalizeEdgeT(policy, k-1, childEdges[3]);
+                temp = normalizeNodeT(policy, k, childEdges);
                 childEdges[0] = temp;
                 childEdges[3] = temp;
             }
@@ -522,12 +497,13 @@ Edge Forest::normalizeEdge(const Level level, const Edge& edge)
     return normalized;
 }
 
-Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
+template <typename P>
+Edge Forest::reduceNodeT(const P& policy, const Level nodeLevel, const std::vector<Edge>& down)
 {
     /* copy the child info , then normalize them */
     std::vector<Edge> child = down;
     for (size_t i=0; i<child.size(); i++) {
-        child[i] = normalizeEdge(nodeLevel-1, child[i]);
+        child[i] = normalizeEdgeT(policy, nodeLevel-1, child[i]);
     }
 #ifdef BRAVE_DD_FOREST_TRACE
     std::cout << "reduce node: \n";
@@ -537,23 +513,21 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
     std::cout << std::endl;
 #endif
     /* setting info */
-    bool isCompAllowed = (setting.getCompType() != NO_COMP);
-    // bool isSwapAllowed = (setting.getSwapType() != NO_SWAP);
+    bool isCompAllowed = (policy.getCompType() != NO_COMP);
+    // bool isSwapAllowed = (policy.getSwapType() != NO_SWAP);
     /* The final answer, initialized */
     Edge reduced;
-    if (setting.getValType() == INT || setting.getValType() == LONG) {
-        reduced.handle = makeTerminal(INT, 0);
-    } else if (setting.getValType() == FLOAT || setting.getValType() == DOUBLE) {
-        reduced.handle = makeTerminal(FLOAT, 0.0f);
-    } else {
+    if (policy.getValType() == VOID) {
         reduced.handle = makeTerminal(VOID, SpecialValue::OMEGA);
+    } else {
+        reduced.handle = makeBoolTerminal(0);
     }
-    EncodeMechanism em = setting.getEncodeMechanism();
+    EncodeMechanism em = policy.getEncodeMechanism();
     /* check if the node matches an illegal pattern */
     /* =================================================================================================
     * BDD for "Set" (Terminal encoding)
     * ================================================================================================*/
-    if (!setting.isRelation() && (em == TERMINAL)) {
+    if (!policy.isRelation() && (em == TERMINAL)) {
         // flag for checking if match any allowed meta-reduction rule
         bool isMatch = 0;
         /* ---------------------------------------------------------------------------------------------
@@ -571,19 +545,16 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
                 && ((isTermOne0 || isTermZero0) && (isTermOne1 || isTermZero1))
                 && ((child[0].getComp() ^ isTermOne0) == (child[1].getComp() ^ isTermOne1))
                 && (nodeLevel >= 1)) {
-                if (setting.hasReductionRule(RULE_X)) {
+                if (policy.hasReductionRule(RULE_X)) {
                     reduced = child[0];
                     isMatch = 1;
                 } else {
-                    // enumerate from EL0 to AH1 to check if it's allowed
-                    for (int r=0; r<8; r++){
-                        if (setting.hasReductionRule((ReductionRule)r)
-                            && ((child[0].getComp()^isTermOne0) == hasRuleTerminalOne((ReductionRule)r))) {
-                            reduced = child[0];
-                            reduced.setRule((ReductionRule)r);
-                            isMatch = 1;
-                            break;
-                        }
+                    // the first allowed rule from EL0 to AH1, if any
+                    ReductionRule r = policy.getConstantRule(child[0].getComp()^isTermOne0);
+                    if (r < RULE_I0) {
+                        reduced = child[0];
+                        reduced.setRule(r);
+                        isMatch = 1;
                     }
                 }
             /* Meta-edge: Constant <C, 0, c, n>, n>1; complement bit TBD */
@@ -598,23 +569,12 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
                         && ((child[0].getComp()^isTermOne0) != (child[1].getComp()^isTermOne1))
                         && (isTermOne0 || isTermZero0)
                         && (isTermOne1 || isTermZero1)) {
-                // enumerate from EL0 to AH1 to check if it's allowed
-                for (int r=0; r<8; r++){
-                    if (setting.hasReductionRule((ReductionRule)r)
-                        && (r < 4)    // EL or AL
-                        && ((child[0].getComp()^isTermOne0) == hasRuleTerminalOne((ReductionRule)r))) {
-                        reduced = child[1];
-                        reduced.setRule((ReductionRule)r);
-                        isMatch = 1;
-                        break;
-                    } else if (setting.hasReductionRule((ReductionRule)r)
-                        && (r >= 4)   // EH or AH
-                        && ((child[1].getComp()^isTermOne1) == hasRuleTerminalOne((ReductionRule)r))) {
-                        reduced = child[0];
-                        reduced.setRule((ReductionRule)r);
-                        isMatch = 1;
-                        break;
-                    }
+                // the first allowed rule from EL0 to AH1, if any
+                ReductionRule r = policy.getBottomRule(child[0].getComp()^isTermOne0);
+                if (r < RULE_I0) {
+                    reduced = (r < RULE_EH0) ? child[1] : child[0];    // EL/AL keep high, EH/AH keep low
+                    reduced.setRule(r);
+                    isMatch = 1;
                 }
             /* Meta-edge: anD (conjunction) <D, 0, c, 0> */
             } else if (((child[0].getRule() == RULE_X) || (hasRuleTerminalOne(child[0].getRule()) == (child[0].getComp() ^ isTermOne0)))
@@ -629,35 +589,27 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
                         && (isTermOne0 || isTermZero0)
                         && (isTermOne1 || isTermZero1)) {
                 if ((child[0].getComp()^isTermOne0) == 0) {
-                    if (setting.hasReductionRule(RULE_EL0)) {
+                    if (policy.hasReductionRule(RULE_EL0)) {
                         if (!isCompAllowed) {
                             // make terminal one
-                            if (setting.getValType() == INT || setting.getValType() == LONG) {
-                                reduced.handle = makeTerminal(INT, 1);
-                            } else if (setting.getValType() == FLOAT || setting.getValType() == DOUBLE) {
-                                reduced.handle = makeTerminal(FLOAT, 1.0f);
-                            }
+                            reduced.handle = makeBoolTerminal(1);
                         } else {
                             reduced.setComp(1);
                         }
                         reduced.setRule(RULE_EL0);
                         isMatch = 1;
-                    } else if (setting.hasReductionRule(RULE_AH1)) {
+                    } else if (policy.hasReductionRule(RULE_AH1)) {
                         reduced.setRule(RULE_AH1);
                         isMatch = 1;
                     }
                 } else {
-                    if (setting.hasReductionRule(RULE_EL1)) {
+                    if (policy.hasReductionRule(RULE_EL1)) {
                         reduced.setRule(RULE_EL1);
                         isMatch = 1;
-                    } else if (setting.hasReductionRule(RULE_AH0)) {
+                    } else if (policy.hasReductionRule(RULE_AH0)) {
                         if (!isCompAllowed) {
                             // make terminal one
-                            if (setting.getValType() == INT || setting.getValType() == LONG) {
-                                reduced.handle = makeTerminal(INT, 1);
-                            } else if (setting.getValType() == FLOAT || setting.getValType() == DOUBLE) {
-                                reduced.handle = makeTerminal(FLOAT, 1.0f);
-                            }
+                            reduced.handle = makeBoolTerminal(1);
                         } else {
                             reduced.setComp(1);
                         }
@@ -678,35 +630,27 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
                         && (isTermOne0 || isTermZero0)
                         && (isTermOne1 || isTermZero1)) {
                 if ((child[1].getComp()^isTermOne1) == 0) {
-                    if (setting.hasReductionRule(RULE_EH0)) {
+                    if (policy.hasReductionRule(RULE_EH0)) {
                         if (!isCompAllowed) {
                             // make terminal one
-                            if (setting.getValType() == INT || setting.getValType() == LONG) {
-                                reduced.handle = makeTerminal(INT, 1);
-                            } else if (setting.getValType() == FLOAT || setting.getValType() == DOUBLE) {
-                                reduced.handle = makeTerminal(FLOAT, 1.0f);
-                            }
+                            reduced.handle = makeBoolTerminal(1);
                         } else {
                             reduced.setComp(1);
                         }
                         reduced.setRule(RULE_EH0);
                         isMatch = 1;
-                    } else if (setting.hasReductionRule(RULE_AL1)) {
+                    } else if (policy.hasReductionRule(RULE_AL1)) {
                         reduced.setRule(RULE_AL1);
                         isMatch = 1;
                     }
                 } else {
-                    if (setting.hasReductionRule(RULE_EH1)) {
+                    if (policy.hasReductionRule(RULE_EH1)) {
                         reduced.setRule(RULE_EH1);
                         isMatch = 1;
-                    } else if (setting.hasReductionRule(RULE_AL0)) {
+                    } else if (policy.hasReductionRule(RULE_AL0)) {
                         if (!isCompAllowed) {
                             // make terminal one
-                            if (setting.getValType() == INT || setting.getValType() == LONG) {
-                                reduced.handle = makeTerminal(INT, 1);
-                            } else if (setting.getValType() == FLOAT || setting.getValType() == DOUBLE) {
-                                reduced.handle = makeTerminal(FLOAT, 1.0f);
-                            }
+                            reduced.handle = makeBoolTerminal(1);
                         } else {
                             reduced.setComp(1);
                         }
@@ -716,7 +660,7 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
                 }
             } else {
                 // here means this is not a forbidden node pattern, then normalize and insert node
-                return normalizeNode(nodeLevel, child);
+                return normalizeNodeT(policy, nodeLevel, child);
             }
         /* ---------------------------------------------------------------------------------------------
         * Forbidden patterns of nodes with Low edge to terminal 0 and High edge to nonterminal
@@ -732,7 +676,7 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
                 && (isTermOne0 || isTermZero0)
                 && (((rule1 == RULE_X)
                         && (nodeLevel - child[1].getNodeLevel() == 1)
-                        && (setting.hasReductionRule((isTermOne0^comp0)? RULE_EL1 : RULE_EL0)))
+                        && (policy.hasReductionRule((isTermOne0^comp0)? RULE_EL1 : RULE_EL0)))
                     || (isRuleEL(rule1)
                         && (nodeLevel - child[1].getNodeLevel() > 1)
                         && (hasRuleTerminalOne(rule1) == (isTermOne0^comp0)))) ) {
@@ -741,7 +685,7 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
                     isMatch = 1;
             } else {
                 // here means this is not a forbidden node pattern, then normalize and insert node
-                return normalizeNode(nodeLevel, child);
+                return normalizeNodeT(policy, nodeLevel, child);
             }
         /* ---------------------------------------------------------------------------------------------
         * Forbidden patterns of nodes with High edge to terminal 0 and Low edge to nonterminal
@@ -756,7 +700,7 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
                 && (isTermOne1 || isTermZero1)
                 && (((rule0 == RULE_X)
                         && (nodeLevel - child[0].getNodeLevel() == 1)
-                        && (setting.hasReductionRule((isTermOne1^comp1)? RULE_EH1 : RULE_EH0)))
+                        && (policy.hasReductionRule((isTermOne1^comp1)? RULE_EH1 : RULE_EH0)))
                     || (isRuleEH(rule0)
                         && (nodeLevel - child[0].getNodeLevel() > 1)
                         && (hasRuleTerminalOne(rule0) == (isTermOne1^comp1) )))) {
@@ -765,7 +709,7 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
                     isMatch = 1;
             } else {
                 // here means this is not a forbidden node pattern, then normalize and insert node
-                return normalizeNode(nodeLevel, child);
+                return normalizeNodeT(policy, nodeLevel, child);
             }
         /* ---------------------------------------------------------------------------------------------
         * Forbidden patterns of nodes with both edges to the same nonterminal
@@ -778,7 +722,7 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
                 /* X reduction rule */
                 if ((child[0].getRule() == child[1].getRule())
                     && (child[0].getRule() == RULE_X)
-                    && setting.hasReductionRule(RULE_X)) {
+                    && policy.hasReductionRule(RULE_X)) {
                     reduced = child[0];
                     isMatch = 1;
                 /* AL reduction rule */
@@ -787,7 +731,7 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
                                     && (nodeLevel - child[0].getNodeLevel() == 1))
                                 || (isRuleAL(child[0].getRule())
                                     && (nodeLevel - child[0].getNodeLevel() > 1)))
-                            && (setting.hasReductionRule((hasRuleTerminalOne(child[0].getRule())) ? RULE_AL1 : RULE_AL0)) ) {
+                            && (policy.hasReductionRule((hasRuleTerminalOne(child[0].getRule())) ? RULE_AL1 : RULE_AL0)) ) {
                     reduced = child[0];
                     reduced.setRule((hasRuleTerminalOne(child[0].getRule())) ? RULE_AL1 : RULE_AL0);
                     isMatch = 1;
@@ -797,41 +741,41 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
                                     && (nodeLevel - child[1].getNodeLevel() == 1))
                                 || (isRuleAH(child[1].getRule())
                                     && (nodeLevel - child[1].getNodeLevel() > 1)))
-                            && (setting.hasReductionRule((hasRuleTerminalOne(child[1].getRule())) ? RULE_AH1 : RULE_AH0)) ) {
+                            && (policy.hasReductionRule((hasRuleTerminalOne(child[1].getRule())) ? RULE_AH1 : RULE_AH0)) ) {
                     reduced = child[1];
                     reduced.setRule((hasRuleTerminalOne(child[1].getRule())) ? RULE_AH1 : RULE_AH0);
                     isMatch = 1;
                 }
             } else {
                 // here means this is not a forbidden node pattern, then normalize and insert node
-                return normalizeNode(nodeLevel, child);
+                return normalizeNodeT(policy, nodeLevel, child);
             }
             
         }
         // here means the forbidden node pattern found but its equivalent edge rules are not allowed
-        if (!isMatch) return normalizeNode(nodeLevel, child);
+        if (!isMatch) return normalizeNodeT(policy, nodeLevel, child);
 
     /* =================================================================================================
     * BDD for "Set" (Edge value encoding)
     * ================================================================================================*/
-    } else if (!setting.isRelation() && em == EDGE_PLUS){
+    } else if (!policy.isRelation() && em == EDGE_PLUS){
         bool isMatch = 0;
         /* ---------------------------------------------------------------------------------------------
         * Redundant X
         * --------------------------------------------------------------------------------------------*/ 
-       if ((child[0] == child[1]) && setting.hasReductionRule(RULE_X)) {
+       if ((child[0] == child[1]) && policy.hasReductionRule(RULE_X)) {
             reduced = child[0];
             isMatch = 1;
        }        
-        if (!isMatch) return normalizeNode(nodeLevel, child);
+        if (!isMatch) return normalizeNodeT(policy, nodeLevel, child);
     
-    } else if (!setting.isRelation() && em == EDGE_PLUSMOD) {
+    } else if (!policy.isRelation() && em == EDGE_PLUSMOD) {
         bool isMatch = 0;
         /* ---------------------------------------------------------------------------------------------
         * Redundant X
         * --------------------------------------------------------------------------------------------*/ 
         unsigned long maxRange = setting.getMaxRange();
-        if (setting.getValType() == INT) {
+        if (policy.getValType() == INT) {
             int ev0, ev1, mod;
             if (maxRange > static_cast<unsigned long>(std::numeric_limits<int>::max())) {
                 std::cout << "[BRAVE_DD] ERROR!\t maxRange overflows valType specified" << std::endl;
@@ -844,13 +788,13 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
             ev1 = mod ? ev1 % mod : ev0;
             if(((child[0].getEdgeHandle() == child[1].getEdgeHandle())
             && (ev0 == ev1)
-            && setting.hasReductionRule(RULE_X))) {
+            && policy.hasReductionRule(RULE_X))) {
             child[0].setValue(ev0 % mod);
             reduced = child[0];
             isMatch = 1;
             }
             
-        } else if (setting.getValType() == LONG) {
+        } else if (policy.getValType() == LONG) {
             long ev0, ev1, mod;
             if (maxRange > static_cast<unsigned long>(std::numeric_limits<long>::max())) {
                 std::cout << "[BRAVE_DD] ERROR!\t maxRange overflows valType specified" << std::endl;
@@ -863,18 +807,47 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
             ev1 = mod ? ev1 % mod : ev0;
             if(((child[0].getEdgeHandle() == child[1].getEdgeHandle())
             && (ev0 == ev1)
-            && setting.hasReductionRule(RULE_X))) {
+            && policy.hasReductionRule(RULE_X))) {
             child[0].setValue(ev0 % mod);
             reduced = child[0];
             isMatch = 1;
             }
         }
         
-        if (!isMatch) return normalizeNode(nodeLevel, child);
+        if (!isMatch) return normalizeNodeT(policy, nodeLevel, child);
+    /* =================================================================================================
+    * BDD for "Set" (Edge multiply encoding)
+    * ================================================================================================*/
+    } else if (!policy.isRelation() && em == EDGE_MULT) {
+        bool isMatch = 0;
+        /* ---------------------------------------------------------------------------------------------
+        * Zero weights: the target is meaningless, so use the unique zero edge. A node with both
+        * weights 0 is the zero edge itself (when quasi reduced), nothing to replace.
+        * --------------------------------------------------------------------------------------------*/
+        for (size_t i=0; i<child.size(); i++) {
+            if (multWeight(child[i].getValue()) != 0.0) continue;
+            if (child[i].getNodeLevel() > 0) {
+                Edge c0 = getChildEdge(child[i].getNodeLevel(), child[i].getNodeHandle(), 0);
+                Edge c1 = getChildEdge(child[i].getNodeLevel(), child[i].getNodeHandle(), 1);
+                if ((multWeight(c0.getValue()) == 0.0) && (multWeight(c1.getValue()) == 0.0)) {
+                    child[i].setValue(multValue(0.0));
+                    continue;
+                }
+            }
+            child[i] = multZeroEdge(nodeLevel-1);
+        }
+        /* ---------------------------------------------------------------------------------------------
+        * Redundant X
+        * --------------------------------------------------------------------------------------------*/
+        if ((child[0] == child[1]) && policy.hasReductionRule(RULE_X)) {
+            reduced = child[0];
+            isMatch = 1;
+        }
+        if (!isMatch) return normalizeNodeT(policy, nodeLevel, child);
     /* =================================================================================================
     * BMXD for "Relation" (Terminal encoding)
     * ================================================================================================*/
-    } else if (setting.isRelation() && em == TERMINAL) {
+    } else if (policy.isRelation() && em == TERMINAL) {
         bool isMatch = 0;
         bool isConstOne1, isConstOne2;
         bool isConstZero1, isConstZero2;
@@ -889,7 +862,7 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
             && (child[1].getEdgeHandle() == child[2].getEdgeHandle())
             && (child[2].getEdgeHandle() == child[3].getEdgeHandle())
             && (child[0].getRule() == RULE_X)
-            && setting.hasReductionRule(RULE_X)) {
+            && policy.hasReductionRule(RULE_X)) {
             reduced = child[0];
             isMatch = 1;
         /* ---------------------------------------------------------------------------------------------
@@ -898,17 +871,17 @@ Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
         } else if ((child[0].getEdgeHandle() == child[3].getEdgeHandle()) && (isRuleI(child[0].getRule()) || (nodeLevel - child[0].getNodeLevel() == 1))
                     && (isConstOne1 || isConstZero1) && (isConstOne2 || isConstZero2) && (isConstOne1 == isConstOne2)
                     && ((nodeLevel - child[0].getNodeLevel() == 1) || (hasRuleTerminalOne(child[0].getRule()) == isConstOne1))
-                    && setting.hasReductionRule((isConstOne1)?RULE_I1:RULE_I0)) {
+                    && policy.hasReductionRule((isConstOne1)?RULE_I1:RULE_I0)) {
                 reduced = child[0];
                 reduced.setRule((isConstOne1)?RULE_I1:RULE_I0);
                 isMatch = 1;            
         }
         // here means the forbidden node pattern found but its equivalent edge rules are not allowed
-        if (!isMatch) return normalizeNode(nodeLevel, child);
+        if (!isMatch) return normalizeNodeT(policy, nodeLevel, child);
     /* =================================================================================================
     * BMXD for "Relation" (Edge value encoding)
     * ================================================================================================*/
-    } else if (setting.isRelation() && em == EDGE_PLUS) {
+    } else if (policy.isRelation() && em == EDGE_PLUS) {
         // TBD
     }
 
@@ -940,8 +913,7 @@ Edge Forest::mergeEdge(const Level beginLevel, const Level mergeLevel, const Edg
     *       
     *       The "merged" edge is set to be the "reduced" edge.
     * --------------------------------------------------------------------------------------------*/
-    if (((incomingRule == reducedRule) && (incomingSkip > 0) && (reducedSkip > 0)
-            && (isRuleEL(reducedRule) || isRuleEH(reducedRule) || isRuleI(reducedRule) || (reducedRule == RULE_X)))
+    if (((incomingRule == reducedRule) && (incomingSkip > 0) && (reducedSkip > 0) && isRuleMergeable(reducedRule))
         || (incomingSkip == 0)) {
         merged.setEdgeHandle(reduced.getEdgeHandle());
         if (setting.getEncodeMechanism() == EDGE_PLUS) {
@@ -949,6 +921,12 @@ Edge Forest::mergeEdge(const Level beginLevel, const Level mergeLevel, const Edg
         } else if (setting.getEncodeMechanism() == EDGE_PLUSMOD) {
             int mod = static_cast<int>(setting.getMaxRange());
             merged.setValue((reduced.getValue() + value) % mod);
+        } else if (setting.getEncodeMechanism() == EDGE_MULT) {
+            // the default (INT) incoming value means no incoming weight
+            merged.setValue(reduced.getValue());
+            if ((value.getType() == FLOAT) || (value.getType() == DOUBLE)) {
+                merged.setValue(multValue(multWeight(reduced.getValue()) * multWeight(value)));
+            }
         }
         return normalizeEdge(beginLevel, merged);
     }
@@ -972,6 +950,9 @@ Edge Forest::mergeEdge(const Level beginLevel, const Level mergeLevel, const Edg
             merged =reduced;
             merged.setRule(incomingRule);
         }
+        if ((setting.getEncodeMechanism() == EDGE_MULT) && ((value.getType() == FLOAT) || (value.getType() == DOUBLE))) {
+            merged.setValue(multValue(multWeight(reduced.getValue()) * multWeight(value)));
+        }
         return normalizeEdge(beginLevel, merged);
     }
     /* ---------------------------------------------------------------------------------------------
@@ -1011,12 +992,8 @@ Edge Forest::mergeEdge(const Level beginLevel, const Level mergeLevel, const Edg
                     childEdges[0].setRule(RULE_X);
                     childEdges[3].setRule(RULE_X);
                 }
-                childEdges[1].handle = makeTerminal(INT, (int)hasRuleTerminalOne(reducedRule));
-                childEdges[2].handle = makeTerminal(INT, (int)hasRuleTerminalOne(reducedRule));
-                if (setting.getValType() == FLOAT || setting.getValType() == DOUBLE) {
-                    childEdges[1].handle = makeTerminal(FLOAT, (float)hasRuleTerminalOne(reducedRule));
-                    childEdges[2].handle = makeTerminal(FLOAT, (float)hasRuleTerminalOne(reducedRule));
-                }
+                childEdges[1].handle = makeBoolTerminal(hasRuleTerminalOne(reducedRule));
+                childEdges[2].handle = makeBoolTerminal(hasRuleTerminalOne(reducedRule));
                 for (size_t i=0; i<childEdges.size(); i++) {
                     childEdges[i] = normalizeEdge(mergeLevel, childEdges[i]);
                 }
@@ -1029,13 +1006,7 @@ Edge Forest::mergeEdge(const Level beginLevel, const Level mergeLevel, const Edg
         } else {
             // TBD
         }
-    } else if ((isRuleEH(incomingRule)
-                && (!isRuleEH(reducedRule) 
-                    || (hasRuleTerminalOne(incomingRule) != hasRuleTerminalOne(reducedRule))))
-                ||
-                (isRuleEL(incomingRule)
-                && (!isRuleEL(reducedRule) 
-                    || (hasRuleTerminalOne(incomingRule) != hasRuleTerminalOne(reducedRule))))) {
+    } else if ((isRuleEH(incomingRule) || isRuleEL(incomingRule)) && (incomingRule != reducedRule)) {
         if (mt == PUSH_UP) {
             // merge a constant edge to terminal
             if (reduced.isConstantZero() || reduced.isConstantOne()) {
@@ -1047,10 +1018,7 @@ Edge Forest::mergeEdge(const Level beginLevel, const Level mergeLevel, const Edg
             bool child = isRuleEH(incomingRule) ? 0 : 1;
             std::vector<Edge> childEdges(2);
             childEdges[child] = reduced;
-            childEdges[!child].handle = makeTerminal(INT, (int)hasRuleTerminalOne(incomingRule));
-            if (setting.getValType() == FLOAT || setting.getValType() == DOUBLE) {
-                childEdges[!child].handle = makeTerminal(FLOAT, (float)hasRuleTerminalOne(incomingRule));
-            }
+            childEdges[!child].handle = makeBoolTerminal(hasRuleTerminalOne(incomingRule));
             childEdges[!child].setRule(RULE_X);
             childEdges[!child] = normalizeEdge(mergeLevel, childEdges[!child]);
             merged = normalizeNode(mergeLevel+1, childEdges);
@@ -1071,10 +1039,7 @@ Edge Forest::mergeEdge(const Level beginLevel, const Level mergeLevel, const Edg
             // push-up all
             std::vector<Edge> childEdges(2);
             bool child = (isRuleAL(incomingRule)) ? 0 : 1;
-            childEdges[child].handle = makeTerminal(INT, (int)hasRuleTerminalOne(incomingRule));
-            if (setting.getValType() == FLOAT || setting.getValType() == DOUBLE) {
-                childEdges[child].handle = makeTerminal(FLOAT, (float)hasRuleTerminalOne(incomingRule));
-            }
+            childEdges[child].handle = makeBoolTerminal(hasRuleTerminalOne(incomingRule));
             childEdges[child].setRule(RULE_X);
             EdgeLabel locLabel = 0;
             packRule(locLabel, RULE_X);
@@ -1096,12 +1061,8 @@ Edge Forest::mergeEdge(const Level beginLevel, const Level mergeLevel, const Edg
             std::vector<Edge> childEdges(4);
             childEdges[0] = reduced;
             childEdges[3] = reduced;
-            childEdges[1].handle = makeTerminal(INT, (int)hasRuleTerminalOne(incomingRule));
-            childEdges[2].handle = makeTerminal(INT, (int)hasRuleTerminalOne(incomingRule));
-            if (setting.getValType() == FLOAT || setting.getValType() == DOUBLE) {
-                childEdges[1].handle = makeTerminal(FLOAT, (float)hasRuleTerminalOne(incomingRule));
-                childEdges[2].handle = makeTerminal(FLOAT, (float)hasRuleTerminalOne(incomingRule));
-            }
+            childEdges[1].handle = makeBoolTerminal(hasRuleTerminalOne(incomingRule));
+            childEdges[2].handle = makeBoolTerminal(hasRuleTerminalOne(incomingRule));
             for (size_t i=0; i<childEdges.size(); i++) {
                 childEdges[i] = normalizeEdge(mergeLevel, childEdges[i]);
             }
@@ -1120,7 +1081,8 @@ Edge Forest::mergeEdge(const Level beginLevel, const Level mergeLevel, const Edg
     return merged;
 }
 
-Edge Forest::reduceEdge(const Level beginLevel, const EdgeLabel label, const Level nodeLevel, const std::vector<Edge>& down, const Value& value)
+template <typename P>
+Edge Forest::reduceEdgeT(const P& policy, const Level beginLevel, const EdgeLabel label, const Level nodeLevel, const std::vector<Edge>& down, const Value& value)
 {
     /* check level */
     if (beginLevel < nodeLevel) {
@@ -1128,7 +1090,7 @@ Edge Forest::reduceEdge(const Level beginLevel, const EdgeLabel label, const Lev
         exit(0);
     }
     /* check number of child */
-    if ((setting.isRelation() && down.size() != 4) || (!setting.isRelation() && down.size() != 2)) {
+    if ((policy.isRelation() && down.size() != 4) || (!policy.isRelation() && down.size() != 2)) {
         std::cout << "[BRAVE_DD] ERROR!\t reduceEdge(): Incorrect number of child edges!" << std::endl;
         exit(0);
     }
@@ -1142,12 +1104,12 @@ Edge Forest::reduceEdge(const Level beginLevel, const EdgeLabel label, const Lev
     }
 #endif
     /* push the flags or value down */
-    CompSet ct = setting.getCompType();
+    CompSet ct = policy.getCompType();
     if (ct == COMP && unpackComp(label)) {                          // complement
         for (size_t i=0; i<child.size(); i++) child[i].complement();
     }
-    SwapSet st = setting.getSwapType();
-    if (!setting.isRelation() && unpackSwap(label)) {           // set: swap-one or swap-all
+    SwapSet st = policy.getSwapType();
+    if (!policy.isRelation() && unpackSwap(label)) {           // set: swap-one or swap-all
         if (st == ONE) {                                            // swap-one
             SWAP(child[0], child[1]);
         } else if (st == ALL) {                                     // swap-all
@@ -1155,7 +1117,7 @@ Edge Forest::reduceEdge(const Level beginLevel, const EdgeLabel label, const Lev
             child[0].swap();
             child[1].swap();
         }
-    } else if (setting.isRelation()) {                          // relation: swap-from, swap-to, swap-from_to
+    } else if (policy.isRelation()) {                          // relation: swap-from, swap-to, swap-from_to
         if ((st == FROM || st == FROM_TO) && unpackSwap(label)) {   // swap "from"
             SWAP(child[0], child[2]);
             SWAP(child[1], child[3]);
@@ -1168,7 +1130,7 @@ Edge Forest::reduceEdge(const Level beginLevel, const EdgeLabel label, const Lev
     }
     /* reduce node */
     Edge reduced;
-    reduced = reduceNode(nodeLevel, child);    // this will take care of value on edge
+    reduced = reduceNodeT(policy, nodeLevel, child);    // this will take care of value on edge
 #ifdef BRAVE_DD_FOREST_TRACE
     std::cout << "after reduce node:" << std::endl;
     reduced.print(std::cout);
@@ -1178,7 +1140,7 @@ Edge Forest::reduceEdge(const Level beginLevel, const EdgeLabel label, const Lev
     EdgeLabel mergeLabel = 0;
     packRule(mergeLabel, unpackRule(label));
     /* merge incoming edge with reduced node */
-    if (setting.getEncodeMechanism() == TERMINAL) {
+    if (policy.getEncodeMechanism() == TERMINAL) {
         reduced = mergeEdge(beginLevel, nodeLevel, mergeLabel, reduced);
     } else {
         reduced = mergeEdge(beginLevel, nodeLevel, mergeLabel, reduced, value);
@@ -1191,6 +1153,79 @@ Edge Forest::reduceEdge(const Level beginLevel, const EdgeLabel label, const Lev
     return reduced;
 }
 
+/*
+ * The engine is fixed in the constructor: forests whose setting is exactly one of the
+ * specialized PredefForest types run the reduction with a StaticPolicy, so that their
+ * rule/flag checks are folded at compile time; any other forest uses DynamicPolicy.
+ */
+Edge Forest::normalizeNode(const Level nodeLevel, const std::vector<Edge>& down)
+{
+    switch (engine) {
+        case ForestEngine::REXBDD:  return normalizeNodeT(RexBDDPolicy(), nodeLevel, down);
+        case ForestEngine::FBDD:    return normalizeNodeT(FBDDPolicy(), nodeLevel, down);
+        case ForestEngine::CFBDD:   return normalizeNodeT(CFBDDPolicy(), nodeLevel, down);
+        case ForestEngine::ESRBDD:  return normalizeNodeT(ESRBDDPolicy(), nodeLevel, down);
+        case ForestEngine::QBMXD:   return normalizeNodeT(QBMXDPolicy(), nodeLevel, down);
+        default:                    return normalizeNodeT(DynamicPolicy(setting), nodeLevel, down);
+    }
+}
+
+Edge Forest::normalizeEdge(const Level level, const Edge& edge)
+{
+    switch (engine) {
+        case ForestEngine::REXBDD:  return normalizeEdgeT(RexBDDPolicy(), level, edge);
+        case ForestEngine::FBDD:    return normalizeEdgeT(FBDDPolicy(), level, edge);
+        case ForestEngine::CFBDD:   return normalizeEdgeT(CFBDDPolicy(), level, edge);
+        case ForestEngine::ESRBDD:  return normalizeEdgeT(ESRBDDPolicy(), level, edge);
+        case ForestEngine::QBMXD:   return normalizeEdgeT(QBMXDPolicy(), level, edge);
+        default:                    return normalizeEdgeT(DynamicPolicy(setting), level, edge);
+    }
+}
+
+Edge Forest::reduceNode(const Level nodeLevel, const std::vector<Edge>& down)
+{
+    switch (engine) {
+        case ForestEngine::REXBDD:  return reduceNodeT(RexBDDPolicy(), nodeLevel, down);
+        case ForestEngine::FBDD:    return reduceNodeT(FBDDPolicy(), nodeLevel, down);
+        case ForestEngine::CFBDD:   return reduceNodeT(CFBDDPolicy(), nodeLevel, down);
+        case ForestEngine::ESRBDD:  return reduceNodeT(ESRBDDPolicy(), nodeLevel, down);
+        case ForestEngine::QBMXD:   return reduceNodeT(QBMXDPolicy(), nodeLevel, down);
+        default:                    return reduceNodeT(DynamicPolicy(setting), nodeLevel, down);
+    }
+}
+
+Edge Forest::reduceEdge(const Level beginLevel, const EdgeLabel label, const Level nodeLevel, const std::vector<Edge>& down, const Value& value)
+{
+    switch (engine) {
+        case ForestEngine::REXBDD:  return reduceEdgeT(RexBDDPolicy(), beginLevel, label, nodeLevel, down, value);
+        case ForestEngine::FBDD:    return reduceEdgeT(FBDDPolicy(), beginLevel, label, nodeLevel, down, value);
+        case ForestEngine::CFBDD:   return reduceEdgeT(CFBDDPolicy(), beginLevel, label, nodeLevel, down, value);
+        case ForestEngine::ESRBDD:  return reduceEdgeT(ESRBDDPolicy(), beginLevel, label, nodeLevel, down, value);
+        case ForestEngine::QBMXD:   return reduceEdgeT(QBMXDPolicy(), beginLevel, label, nodeLevel, down, value);
+        default:                    return reduceEdgeT(DynamicPolicy(setting), beginLevel, label, nodeLevel, down, value);
+    }
+}
+
+ForestEngine Forest::specializedEngine(const ForestSetting& s)
+{
+    if (RexBDDPolicy::matches(s)) return ForestEngine::REXBDD;
+    if (FBDDPolicy::matches(s)) return ForestEngine::FBDD;
+    if (CFBDDPolicy::matches(s)) return ForestEngine::CFBDD;
+    if (ESRBDDPolicy::matches(s)) return ForestEngine::ESRBDD;
+    if (QBMXDPolicy::matches(s)) return ForestEngine::QBMXD;
+    return ForestEngine::GENERIC;
+}
+
+Edge Forest::multZeroEdge(const Level level)
+{
+    Edge zero;
+    zero.handle = makeTerminal(VOID, SpecialValue::OMEGA);
+    packRule(zero.handle, RULE_X);
+    zero.setValue(multValue(0.0));
+    // long X edge will be built if not allowed, i.e., quasi reduced
+    return normalizeEdge(level, zero);
+}
+
 void Forest::markSweep()
 {
     // sweep unique table
@@ -1198,7 +1233,10 @@ void Forest::markSweep()
     // sweep computing table (cache) related to this forest
     UOPs.sweepCache(this);
     BOPs.sweepCache(this);
+    TOPs.sweepCache(this);
     SOPs.sweepCache(this);
+    // pooled terminals, while the nodes in use are marked
+    sweepTerminalPool();
 
     // sweep
     nodeMan->sweep();
@@ -1206,6 +1244,37 @@ void Forest::markSweep()
     unmark();
 }
 
+void Forest::sweepTerminalPool()
+{
+    ValueType valType = setting.getValType();
+    if ((valType != LONG) && (valType != DOUBLE)) return;
+    std::vector<bool> used(terminalPool().capacity(), 0);
+    for (size_t i=0; i<markedPooled.size(); i++) {
+        if (markedPooled[i] < used.size()) used[markedPooled[i]] = 1;
+    }
+    bool isRel = setting.isRelation();
+    bool hasLevelInfo = setting.getReductionSize() > 0;
+    int numChild = (isRel) ? 4 : 2;
+    for (Level l=1; l<=setting.getNumVars(); l++) {
+        for (NodeHandle h=1; h<nodeMan->numAlloc(l); h++) {
+            const Node& node = getNode(l, h);
+            if (!node.isMarked()) continue;
+            for (int c=0; c<numChild; c++) {
+                Level childLvl = (hasLevelInfo) ? node.childNodeLevel(c, isRel) : l-1;
+                if ((childLvl > 0) || node.isChildTerminalSpecial(c)) continue;
+                NodeHandle target = node.childNodeHandle(c, isRel);
+                if (target < used.size()) used[target] = 1;
+            }
+        }
+    }
+    // the caches of all forests may keep pooled terminals of this one
+    UOPs.markPooled(used);
+    BOPs.markPooled(used);
+    TOPs.markPooled(used);
+    SOPs.markPooled(used);
+    terminalPool().sweep(used);
+}
+
 void Forest::reportNodesNum(std::ostream& out) const
 {
     uint64_t total = 0;
@@ -1221,6 +1290,12 @@ void Forest::reportNodesNum(std::ostream& out) const
 bool Forest::checkCompatibility() const
 {
     bool ans = 1;
+    // EV* weights are normalized by division, so they must be real
+    if ((setting.getEncodeMechanism() == EDGE_MULT)
+        && (setting.getValType() != FLOAT) && (setting.getValType() != DOUBLE)) {
+        std::cout << "[BRAVE_DD] Error!\t The value type of EV* forests must be FLOAT or DOUBLE!"<< std::endl;
+        throw error(ErrCode::TYPE_MISMATCH, __FILE__, __LINE__);
+    }
     // TBD
     if (!ans) {
         std::cout << "[BRAVE_DD] Error!\t The ForestSetting consistency check failed!"<< std::endl;
@@ -1334,6 +1409,7 @@ Edge Forest::buildUmb(const Level beginLvl, const Level endLvl, const Edge& e1,
 void Forest::markNodes(const Edge& edge) const
 {
     char numChild = (setting.isRelation()) ? 4 : 2;
+    if (isTerminalPooled(edge.getEdgeHandle())) markedPooled.push_back(edge.getNodeHandle());
     if (edge.getNodeLevel() > 0) {
         if (!getNode(edge).isMarked()) {
 #ifdef BRAVE_DD_FOREST_TRACE
@@ -1341,7 +1417,9 @@ void Forest::markNodes(const Edge& edge) const
 #endif
             getNode(edge).mark();
             for (char i=0; i<numChild; i++) {
-                markNodes(getChildEdge(edge.getNodeLevel(), edge.getNodeHandle(), i));
+                // the terminals of the nodes are found by markSweep, only the roots are recorded
+                Edge child = getChildEdge(edge.getNodeLevel(), edge.getNodeHandle(), i);
+                if (child.getNodeLevel() > 0) markNodes(child);
             }
         }
     }
@@ -1351,6 +1429,7 @@ void Forest::markNodes(const EdgeHandle& edge) const
 {
     char numChild = (setting.isRelation()) ? 4 : 2;
     Level level = unpackLevel(edge);
+    if (isTerminalPooled(edge)) markedPooled.push_back(unpackTarget(edge));
     if (level > 0) {
         NodeHandle target = unpackTarget(edge);
         if (!getNode(level, target).isMarked()) {
@@ -1359,7 +1438,8 @@ void Forest::markNodes(const EdgeHandle& edge) const
 #endif
             getNode(edge).mark();
             for (char i=0; i<numChild; i++) {
-                markNodes(getChildEdgeHandle(level, target, i));
+                EdgeHandle child = getChildEdgeHandle(level, target, i);
+                if (unpackLevel(child) > 0) markNodes(child);
             }
         }
     }
@@ -10,6 +10,7 @@
 #include "node_manager.h"
 #include "unique_table.h"
 #include "statistics.h"
+#include "settings/forest_policy.h"
 
 namespace BRAVE_DD {
     class Forest;
@@ -197,9 +198,11 @@ class BRAVE_DD::Forest {
                 // special terminal value, then update the "header"
                 ans |= SPECIAL_VALUE_FLAG_MASK;
             } else {
-                // terminal value should be INT or FLOAT
+                // terminal value should be INT or FLOAT, or LONG/DOUBLE index in the terminal pool
                 ValueType valType = setting.getValType();
-                if (valType == INT || valType == LONG) {
+                if (valType == LONG || valType == DOUBLE) {
+                    ans |= POOL_VALUE_FLAG_MASK;
+                } else if (valType == INT) {
                     ans |= INT_VALUE_FLAG_MASK;
                 } else {
                     ans |= FLOAT_VALUE_FLAG_MASK;
@@ -214,7 +217,12 @@ class BRAVE_DD::Forest {
     inline Edge getChildEdge(const Level level, const NodeHandle handle, const char child) const {
         Edge ans;
         ans.handle = getChildEdgeHandle(level, handle, child);
-        if ((setting.getEncodeMechanism() != TERMINAL)) {
+        if (setting.getEncodeMechanism() == EDGE_MULT) {
+            // every child edge has its own weight
+            Value val = multValue(0.0);
+            getNode(level, handle).edgeMultValue(child, val, setting.isRelation());
+            ans.setValue(val);
+        } else if ((setting.getEncodeMechanism() != TERMINAL)) {
             // get the valid value, TBD
             Value val;
             Node node = getNode(level, handle);
@@ -264,12 +272,9 @@ class BRAVE_DD::Forest {
             } else if (valType == FLOAT) {
                 float value = *reinterpret_cast<float*>(&data);
                 val.setValue(&value, FLOAT);
-            } else if (valType == LONG) {
-                long value = *reinterpret_cast<long*>(&data);
-                val.setValue(&value, LONG);
-            } else if (valType == DOUBLE) {
-                double value = *reinterpret_cast<double*>(&data);
-                val.setValue(&value, DOUBLE);
+            } else if (valType == LONG || valType == DOUBLE) {
+                // index in the terminal pool
+                val = terminalPool().value(data);
             }
         }
         return val;
@@ -323,6 +328,10 @@ class BRAVE_DD::Forest {
             Edge ans = getChildEdge(lvl, edge.getNodeHandle(), childIndex);
             if (edge.getComp()) ans.complement();
             if ((setting.getSwapType() == ALL) && edge.getSwap(0)) ans.swap();
+            if (setting.getEncodeMechanism() == EDGE_MULT) {
+                ans.value = ans.value * edge.value; // push the weight down
+                return ans;
+            }
             if (!ans.isConstantPosInf() && !ans.isConstantNegInf()) ans.value = ans.value + edge.value; // push the value down
             if (setting.getEncodeMechanism() == EDGE_PLUSMOD) ans.value = ans.value % setting.getMaxRange();
             return ans;
@@ -333,10 +342,7 @@ class BRAVE_DD::Forest {
             || (isRuleAL(rule) && (lvl - edge.getNodeLevel() == 1) && (index == 0))
             || (isRuleAH(rule) && (lvl - edge.getNodeLevel() == 1) && (index == 1))
             || (isRuleI(rule) && ((index == 1) || (index == 2)))) {
-            EdgeHandle childH = makeTerminal(INT, (int)hasRuleTerminalOne(rule));
-            if (setting.getValType() == FLOAT) {
-                childH = makeTerminal(FLOAT, (float)hasRuleTerminalOne(rule));
-            }
+            EdgeHandle childH = makeBoolTerminal(hasRuleTerminalOne(rule));
             packRule(childH, RULE_X);
             ans.setEdgeHandle(childH);
             ans = normalizeEdge(lvl-1, ans);
@@ -374,7 +380,10 @@ class BRAVE_DD::Forest {
      * for counting the marked nodes or sweeping the unmarked nodes.
      * 
      */
-    inline void unmark() const {nodeMan->unmark();}
+    inline void unmark() const {
+        nodeMan->unmark();
+        markedPooled.clear();
+    }
 
     /**
      * @brief Mark all the nonterminal nodes reachable from the given Func edge
@@ -472,7 +481,10 @@ class BRAVE_DD::Forest {
     inline void sweepNodeMan(Level level) {nodeMan->sweep(level);}
     /**
      * @brief Assuming the necessary nodes are marked, 
-     * the unmarked nodes will be removed and the marked nodes will be unmarked
+     * the unmarked nodes will be removed and the marked nodes will be unmarked.
+     * In a LONG/DOUBLE forest, the pooled terminal values that are neither reached
+     * from the marked nodes and Funcs nor held by an operation cache are reclaimed,
+     * if no other such forest exists.
      * 
      */
     void markSweep();
@@ -541,6 +553,16 @@ class BRAVE_DD::Forest {
      */
     inline const ForestSetting& getSetting() const {return setting;}
     inline void exportSetting(std::ostream out, int format) const {setting.output(out, format);}
+    /**
+     * @brief Get the reduction engine of this forest: a specialized one if the setting is
+     * exactly a supported PredefForest type, GENERIC otherwise.
+     */
+    inline ForestEngine getEngine() const {return engine;}
+    /**
+     * @brief Use the generic reduction engine even if a specialized one exists.
+     * The results are the same; this is used for comparison.
+     */
+    inline void useGenericEngine() {engine = ForestEngine::GENERIC;}
 
     /*************************** Reordering *************************/
     void shiftUp(unsigned lvl);
@@ -601,6 +623,24 @@ class BRAVE_DD::Forest {
      */
     Edge mergeEdge(const Level beginLevel, const Level mergeLevel, const EdgeLabel label, const Edge& reduced, const Value& value = Value());
 
+    /**
+     * @brief The bodies of normalizeNode, normalizeEdge, reduceNode and reduceEdge, where
+     * the setting queries go through policy P (DynamicPolicy or a StaticPolicy).
+     */
+    template <typename P>
+    Edge normalizeNodeT(const P& policy, const Level nodeLevel, const std::vector<Edge>& down);
+    template <typename P>
+    Edge normalizeEdgeT(const P& policy, const Level level, const Edge& edge);
+    template <typename P>
+    Edge reduceNodeT(const P& policy, const Level nodeLevel, const std::vector<Edge>& down);
+    template <typename P>
+    Edge reduceEdgeT(const P& policy, const Level beginLevel, const EdgeLabel label, const Level nodeLevel, const std::vector<Edge>& down, const Value& value);
+
+    /**
+     * @brief Find the specialized reduction engine for the given setting, GENERIC if none.
+     */
+    static ForestEngine specializedEngine(const ForestSetting& s);
+
     /**
      * @brief Check if the swap-all bit is useless, by giving the parent forest and edge
      * 
@@ -610,6 +650,131 @@ class BRAVE_DD::Forest {
      */
     char isSwapAllUseless(Edge& e);
 
+    /**
+     * @brief Normalize the edge values of an EV+ node: the smaller value goes to the incoming edge,
+     * and the difference is stored in the node. T is the value type of the forest (int or long).
+     * 
+     * @param node          The node to be stored.
+     * @param child         The child edges, with their values.
+     * @param ans           Output: the incoming edge, its value is set.
+     */
+    template <typename T>
+    inline void normalizeEvPlus(Node& node, const std::vector<Edge>& child, Edge& ans) const {
+        const T ev0 = child[0].getValue().getValueAs<T>();
+        const T ev1 = child[1].getValue().getValueAs<T>();
+        if (ev0 < ev1) {
+            node.setEdgeValue(1, static_cast<T>(ev1 - ev0));
+            ans.setValue(Value(ev0));
+        } else {
+            node.setEdgeValue(0, static_cast<T>(ev0 - ev1));
+            ans.setValue(Value(ev1));
+        }
+    }
+
+    /**
+     * @brief Normalize the edge values of an EV% node: the 0-child value goes to the incoming edge,
+     * and the difference modulo "mod" is stored in the node. T is the value type of the forest (int or long).
+     * 
+     * @param node          The node to be stored.
+     * @param child         The child edges, with their values.
+     * @param mod           The modulus, i.e., the max range.
+     * @param ans           Output: the incoming edge, its value is set.
+     */
+    template <typename T>
+    inline void normalizeEvMod(Node& node, const std::vector<Edge>& child, const T mod, Edge& ans) const {
+        const T ev0 = child[0].getValue().getValueAs<T>();
+        const T ev1 = child[1].getValue().getValueAs<T>();
+        node.setEdgeValue(1, static_cast<T>((((ev1 - ev0) % mod) + mod) % mod));
+        ans.setValue(Value(ev0));
+    }
+
+    /**
+     * @brief Get the weight of an EV* edge value as double, whatever its value type is.
+     * 
+     * @param v             The given edge value.
+     * @return double       - Output: the weight.
+     */
+    inline double multWeight(const Value& v) const {
+        double w = 0.0;
+        if (v.getType() == DOUBLE) {
+            v.getValueTo(&w, DOUBLE);
+        } else if (v.getType() == FLOAT) {
+            float f;
+            v.getValueTo(&f, FLOAT);
+            w = f;
+        } else if (v.getType() == LONG) {
+            long l;
+            v.getValueTo(&l, LONG);
+            w = static_cast<double>(l);
+        } else if (v.getType() == INT) {
+            int i;
+            v.getValueTo(&i, INT);
+            w = i;
+        }
+        return w;
+    }
+
+    /**
+     * @brief Make an EV* edge value with the value type of this forest.
+     * 
+     * @param w             The weight.
+     * @return Value        - Output: the edge value, FLOAT or DOUBLE.
+     */
+    inline Value multValue(const double w) const {
+        // no negative zero, so that equal weights have equal bits in nodes
+        double v = (w == 0.0) ? 0.0 : w;
+        if (setting.getValType() == FLOAT) return Value(static_cast<float>(v));
+        return Value(v);
+    }
+
+    /**
+     * @brief Make a plain terminal handle for the constant 0 or 1, with the value type of this forest.
+     * LONG and DOUBLE terminals are pooled.
+     * 
+     * @param one           1: constant one; 0: constant zero.
+     * @return EdgeHandle   - Output: the terminal handle without rule or flags.
+     */
+    inline EdgeHandle makeBoolTerminal(const bool one) const {
+        return one ? terminalOne : terminalZero;
+    }
+
+    /**
+     * @brief Make a plain terminal handle for the given value, converted to the value type of this forest.
+     * Special values are kept as they are.
+     * 
+     * @param v             The terminal value.
+     * @return EdgeHandle   - Output: the terminal handle without rule or flags.
+     */
+    inline EdgeHandle makeValueTerminal(const Value& v) const {
+        ValueType valType = setting.getValType();
+        if ((v.getType() == VOID) || (valType == VOID) || (v.getType() == valType)) return makeTerminal(v);
+        if (valType == INT) {
+            int term;
+            v.getValueTo(&term, INT);
+            return makeTerminal(INT, term);
+        } else if (valType == LONG) {
+            long term;
+            v.getValueTo(&term, LONG);
+            return makeTerminal(LONG, term);
+        } else if (valType == FLOAT) {
+            float term;
+            v.getValueTo(&term, FLOAT);
+            return makeTerminal(FLOAT, term);
+        }
+        double term;
+        v.getValueTo(&term, DOUBLE);
+        return makeTerminal(DOUBLE, term);
+    }
+
+    /**
+     * @brief Get the unique EV* edge encoding the constant 0 function, starting from the given level.
+     * Any edge with weight 0 should be replaced by this one to keep canonicity.
+     * 
+     * @param level         The start level.
+     * @return Edge         - Output: the zero edge.
+     */
+    Edge multZeroEdge(const Level level);
+
     Edge unreduceEdge(const Level level, const Edge& edge);
 
     // these are only used by BDDs operations
@@ -620,25 +785,35 @@ class BRAVE_DD::Forest {
     /* Marker */
     void markNodes(const Edge& edge) const;
     void markNodes(const EdgeHandle& edge) const;
+    /// Reclaim the pooled terminals not used by the marked nodes and roots, or the caches.
+    void sweepTerminalPool();
 
     /// =============================================================
     friend class NodeManager;
     friend class UniqueTable;
     friend class Func;
     friend class ExplictFunc;
+    friend class FuncIterator;
     friend class UnaryOperation;
     friend class BinaryOperation;
+    friend class TernaryOperation;
     friend class SaturationOperation;
+    friend class Expression;
     friend class BddxMaker;
     friend class ParserBddx;
+    friend class ParserBin;
 
     ForestSetting               setting;        // Specification setting of this forest.
     NodeManager*                nodeMan;        // Node manager.
     UniqueTable*                uniqueTable;    // Unique table.
     std::vector<Func>           funcs;          // Registry of Func edges.
     std::vector<EdgeHandle>     protectedEdges; // Registry of protected edges, used for GC
+    mutable std::vector<NodeHandle> markedPooled; // Pooled terminals marked as roots, kept by markSweep.
     Statistics*                 stats;          // Performance measurement.
     int                         nodeSize;       // Number of uint32 slots for one Node storage.
+    EdgeHandle                  terminalZero;   // Plain terminal handle of 0 in the forest value type.
+    EdgeHandle                  terminalOne;    // Plain terminal handle of 1 in the forest value type.
+    ForestEngine                engine;         // Reduction engine chosen for the setting.
 };
 
 
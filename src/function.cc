@@ -2,6 +2,10 @@
 #include "forest.h"
 #include "node.h"
 #include "operations/operation.h"
+#include "operations/apply.h"
+
+#include <cstring>
+#include <unordered_map>
 
 using namespace BRAVE_DD;
 // ******************************************************************
@@ -42,11 +46,13 @@ void Func::trueFunc()
 {
     if (parent->setting.getEncodeMechanism() == TERMINAL) {
         /* Don't care the value on edge */
-        edge.handle = makeTerminal(INT, 1);
-        if (parent->setting.getValType() == FLOAT) {
-            edge.handle = makeTerminal(FLOAT, 1.0f);
-        }
+        edge.handle = parent->makeBoolTerminal(1);
+        packRule(edge.handle, RULE_X);
+        edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
+    } else if (parent->setting.getEncodeMechanism() == EDGE_MULT) {
+        edge.handle = makeTerminal(VOID, SpecialValue::OMEGA);
         packRule(edge.handle, RULE_X);
+        edge.value = parent->multValue(1.0);
         edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
     } else {
         edge.handle = makeTerminal(VOID, SpecialValue::OMEGA);
@@ -58,12 +64,11 @@ void Func::trueFunc()
 void Func::falseFunc()
 {
     if (parent->setting.getEncodeMechanism() == TERMINAL) {
-    edge.handle = makeTerminal(INT, 0);
-        if (parent->setting.getValType() == FLOAT) {
-            edge.handle = makeTerminal(FLOAT, 0.0f);
-        }
+        edge.handle = parent->makeBoolTerminal(0);
         packRule(edge.handle, RULE_X);
         edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
+    } else if (parent->setting.getEncodeMechanism() == EDGE_MULT) {
+        edge = parent->multZeroEdge(parent->setting.getNumVars());
     } else {
         edge.handle = makeTerminal(VOID, SpecialValue::OMEGA);
         packRule(edge.handle, RULE_X);
@@ -75,7 +80,7 @@ void Func::falseFunc()
 void Func::constant(int val)
 {
     if (parent->setting.getEncodeMechanism() == TERMINAL) {
-        edge.handle = makeTerminal(INT, val);
+        edge.handle = parent->makeValueTerminal(Value(val));
         packRule(edge.handle, RULE_X);
         edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
     } else if (parent->setting.getEncodeMechanism() == EDGE_PLUS || parent->setting.getEncodeMechanism() == EDGE_PLUSMOD) {
@@ -83,6 +88,15 @@ void Func::constant(int val)
         packRule(edge.handle, RULE_X);
         edge.setValue(Value(val));
         edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
+    } else if (parent->setting.getEncodeMechanism() == EDGE_MULT) {
+        if (val == 0) {
+            edge = parent->multZeroEdge(parent->setting.getNumVars());
+            return;
+        }
+        edge.handle = makeTerminal(VOID, SpecialValue::OMEGA);
+        packRule(edge.handle, RULE_X);
+        edge.setValue(parent->multValue(static_cast<double>(val)));
+        edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
     } else {
         // TBD
     }
@@ -90,7 +104,7 @@ void Func::constant(int val)
 void Func::constant(long val)
 {
     if (parent->setting.getEncodeMechanism() == TERMINAL) {
-        edge.handle = makeTerminal(LONG, val);
+        edge.handle = parent->makeValueTerminal(Value(val));
         packRule(edge.handle, RULE_X);
         edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
     } else if (parent->setting.getEncodeMechanism() == EDGE_PLUS || parent->setting.getEncodeMechanism() == EDGE_PLUSMOD) {
@@ -98,6 +112,15 @@ void Func::constant(long val)
         packRule(edge.handle, RULE_X);
         edge.setValue(Value(val));
         edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
+    } else if (parent->setting.getEncodeMechanism() == EDGE_MULT) {
+        if (val == 0) {
+            edge = parent->multZeroEdge(parent->setting.getNumVars());
+            return;
+        }
+        edge.handle = makeTerminal(VOID, SpecialValue::OMEGA);
+        packRule(edge.handle, RULE_X);
+        edge.setValue(parent->multValue(static_cast<double>(val)));
+        edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
     } else {
         // TBD
     }
@@ -105,7 +128,7 @@ void Func::constant(long val)
 void Func::constant(float val)
 {
     if (parent->setting.getEncodeMechanism() == TERMINAL) {
-        edge.handle = makeTerminal(FLOAT, val);
+        edge.handle = parent->makeValueTerminal(Value(val));
         packRule(edge.handle, RULE_X);
         edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
     } else if (parent->setting.getEncodeMechanism() == EDGE_PLUS || parent->setting.getEncodeMechanism() == EDGE_PLUSMOD) {
@@ -113,6 +136,15 @@ void Func::constant(float val)
         packRule(edge.handle, RULE_X);
         edge.setValue(Value(val));
         edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
+    } else if (parent->setting.getEncodeMechanism() == EDGE_MULT) {
+        if (val == 0) {
+            edge = parent->multZeroEdge(parent->setting.getNumVars());
+            return;
+        }
+        edge.handle = makeTerminal(VOID, SpecialValue::OMEGA);
+        packRule(edge.handle, RULE_X);
+        edge.setValue(parent->multValue(static_cast<double>(val)));
+        edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
     } else {
         // TBD
     }
@@ -120,7 +152,7 @@ void Func::constant(float val)
 void Func::constant(double val)
 {
     if (parent->setting.getEncodeMechanism() == TERMINAL) {
-        edge.handle = makeTerminal(FLOAT, val);
+        edge.handle = parent->makeValueTerminal(Value(val));
         packRule(edge.handle, RULE_X);
         edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
     } else if (parent->setting.getEncodeMechanism() == EDGE_PLUS || parent->setting.getEncodeMechanism() == EDGE_PLUSMOD) {
@@ -128,6 +160,15 @@ void Func::constant(double val)
         packRule(edge.handle, RULE_X);
         edge.setValue(Value(val));
         edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
+    } else if (parent->setting.getEncodeMechanism() == EDGE_MULT) {
+        if (val == 0) {
+            edge = parent->multZeroEdge(parent->setting.getNumVars());
+            return;
+        }
+        edge.handle = makeTerminal(VOID, SpecialValue::OMEGA);
+        packRule(edge.handle, RULE_X);
+        edge.setValue(parent->multValue(static_cast<double>(val)));
+        edge = parent->normalizeEdge(parent->setting.getNumVars(), edge);
     } else {
         // TBD
     }
@@ -145,10 +186,7 @@ void Func::identity(std::vector<bool> dependance)
     Level top = 0;
     std::vector<Edge> child(4);
     Edge reduced;
-    reduced.handle = makeTerminal(1);
-    if ((parent->getSetting().getValType() == FLOAT) || (parent->getSetting().getValType() == DOUBLE)) {
-        reduced.handle = makeTerminal(1.0f);
-    }
+    reduced.handle = parent->makeBoolTerminal(1);
     reduced.setRule(RULE_I0);
     EdgeLabel root  = 0;
     packRule(root, RULE_I0);
@@ -171,14 +209,16 @@ void Func::variable(Level lvl)
 {
     std::vector<Edge> child(2);
     if (parent->setting.getEncodeMechanism() == TERMINAL) {
-        child[0].handle = makeTerminal(INT, 0);
-        child[1].handle = makeTerminal(INT, 1);
-        if ((parent->getSetting().getValType() == FLOAT) || (parent->getSetting().getValType() == DOUBLE)) {
-            child[0].handle = makeTerminal(FLOAT, 0.0f);
-            child[1].handle = makeTerminal(FLOAT, 1.0f);
+        child[0].handle = parent->makeBoolTerminal(0);
+        child[1].handle = parent->makeBoolTerminal(1);
+        for (size_t i=0; i<child.size(); i++) {
+            packRule(child[i].handle, RULE_X);
         }
+    } else if (parent->setting.getEncodeMechanism() == EDGE_MULT) {
         for (size_t i=0; i<child.size(); i++) {
+            child[i].handle = makeTerminal(VOID, SpecialValue::OMEGA);
             packRule(child[i].handle, RULE_X);
+            child[i].value = parent->multValue((double)i);
         }
     } else {
         for (size_t i=0; i<child.size(); i++) {
@@ -195,11 +235,19 @@ void Func::variable(Level lvl, Value low, Value high)
 {
     std::vector<Edge> child(2);
     if (parent->setting.getEncodeMechanism() == TERMINAL) {
-        child[0].handle = makeTerminal(low);
-        child[1].handle = makeTerminal(high);
+        child[0].handle = parent->makeValueTerminal(low);
+        child[1].handle = parent->makeValueTerminal(high);
+        for (size_t i=0; i<child.size(); i++) {
+            packRule(child[i].handle, RULE_X);
+        }
+    } else if (parent->setting.getEncodeMechanism() == EDGE_MULT) {
         for (size_t i=0; i<child.size(); i++) {
+            child[i].handle = makeTerminal(Value(SpecialValue::OMEGA));
             packRule(child[i].handle, RULE_X);
         }
+        // weights in the forest value type
+        child[0].value = parent->multValue(parent->multWeight(low));
+        child[1].value = parent->multValue(parent->multWeight(high));
     } else {
         if (low.getType() == VOID) {
             child[0].handle = makeTerminal(low);
@@ -226,16 +274,10 @@ void Func::variable(Level lvl, Value low, Value high)
 void Func::variable(Level lvl, bool isPrime)
 {
     std::vector<Edge> child(4);
-    child[0].handle = makeTerminal(INT, 0);
-    child[1].handle = makeTerminal(INT, isPrime?1:0);
-    child[2].handle = makeTerminal(INT, isPrime?0:1);
-    child[3].handle = makeTerminal(INT, 1);
-    if ((parent->getSetting().getValType() == FLOAT) || (parent->getSetting().getValType() == DOUBLE)) {
-        child[0].handle = makeTerminal(FLOAT, 0.0f);
-        child[1].handle = makeTerminal(INT, isPrime?1.0f:0.0f);
-        child[2].handle = makeTerminal(INT, isPrime?0.0f:1.0f);
-        child[3].handle = makeTerminal(FLOAT, 1.0f);
-    }
+    child[0].handle = parent->makeBoolTerminal(0);
+    child[1].handle = parent->makeBoolTerminal(isPrime);
+    child[2].handle = parent->makeBoolTerminal(!isPrime);
+    child[3].handle = parent->makeBoolTerminal(1);
     for (size_t i=0; i<child.size(); i++) {
         packRule(child[i].handle, RULE_X);
     }
@@ -247,6 +289,36 @@ void Func::variable(Level lvl, bool isPrime, Value low, Value high)
 {
     // TBD
 }
+void Func::cube(const Cube& c)
+{
+    const ForestSetting& setting = parent->getSetting();
+    if ((setting.getEncodeMechanism() != TERMINAL) || setting.isRelation()) {
+        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+    }
+    Level numVars = setting.getNumVars();
+    if (c.getNumVars() != numVars) {
+        throw error(ErrCode::MISCELLANEOUS, __FILE__, __LINE__);
+    }
+    std::vector<Edge> child(2);
+    Edge one, zero;
+    one.handle = parent->makeBoolTerminal(1);
+    zero.handle = parent->makeBoolTerminal(0);
+    packRule(one.handle, RULE_X);
+    packRule(zero.handle, RULE_X);
+    EdgeLabel root = 0;
+    packRule(root, RULE_X);
+    /*
+     * One node per level, bottom-up: a don't-care is a redundant node and a fixed variable a node
+     * with a child to terminal 0, so that reduceEdge turns the runs of either into long edges with
+     * the rules of the forest.
+     */
+    edge = one;
+    for (Level k=1; k<=numVars; k++) {
+        child[0] = (c.get(k) == 1) ? zero : edge;
+        child[1] = (c.get(k) == 0) ? zero : edge;
+        edge = parent->reduceEdge(k, root, k, child);
+    }
+}
 
 /*************************** Statistics *************************/
 uint64_t Func::numNodes()
@@ -352,6 +424,11 @@ Value Func::evaluate(const std::vector<bool>& assignment) const
         Value cv = current.getValue();
         if (targetLvl == 0) return cv;
         ans = Value(cv);
+    } else if (encode == EDGE_MULT) {
+        Value cv = current.getValue();
+        // weight 0 is absorbing
+        if ((targetLvl == 0) || (parent->multWeight(cv) == 0.0)) return cv;
+        ans = Value(cv);
     }
     while (true) {
 #ifdef BRAVE_DD_TRACE
@@ -389,8 +466,9 @@ Value Func::evaluate(const std::vector<bool>& assignment) const
                 std::cout << "[BRAVE_DD] ERROR!\t evaluate(): Illegal patterns for EVBDD!" << std::endl;
                 exit(0);
             } else if (encode == EDGE_MULT) {
-                // edge values multiply
-                // TBD
+                // edge values multiply, only long X edges are legal
+                std::cout << "[BRAVE_DD] ERROR!\t evaluate(): Illegal patterns for EV*BDD!" << std::endl;
+                exit(0);
             }
         }
         if (targetLvl > 0) {
@@ -413,6 +491,9 @@ Value Func::evaluate(const std::vector<bool>& assignment) const
                 Value cv = current.getValue();
                 if (vt == INT) ans = Value(ans.getIntValue() + cv.getIntValue());
                 else if (vt == LONG) ans = Value(ans.getLongValue() + cv.getLongValue());
+            } else if (encode == EDGE_MULT) {
+                ans = ans * current.getValue();
+                if (parent->multWeight(ans) == 0.0) return ans;
             }
 #ifdef BRAVE_DD_TRACE
             std::cout<<"next currt: k="<< k <<", targetlvl=" << targetLvl << "; ";
@@ -439,7 +520,7 @@ Value Func::evaluate(const std::vector<bool>& assignment) const
                     // TBD
                 }
             }
-            if(encode == EDGE_PLUS) {
+            if ((encode == EDGE_PLUS) || (encode == EDGE_MULT)) {
                 // only special terminal check here
                 if( isTerminalSpecial(current.getEdgeHandle()) 
                     && !isTerminalSpecial(SpecialValue::OMEGA, current.getEdgeHandle())) {
@@ -533,8 +614,9 @@ Value Func::evaluate(const std::vector<bool>& aFrom, const std::vector<bool>& aT
                 // edge values plus and modulo
                 // TBD
             } else if (encode == EDGE_MULT) {
-                // edge values multiply
-                // TBD
+                // edge values multiply, only long X edges are legal
+                std::cout << "[BRAVE_DD] ERROR!\t evaluate(): Illegal patterns for EV*BDD!" << std::endl;
+                exit(0);
             }
         }
         if (targetLvl > 0) {
@@ -559,166 +641,278 @@ Value Func::evaluate(const std::vector<bool>& aFrom, const std::vector<bool>& aT
             continue;
         }
         // not reach the terminal cases of reduction rules, or got the next edge
-        if (targetLvl == 0) {
-            // value type INT, FLOAT, or VOID (special value)
-            ans = getTerminalValue(current.handle);
-            if (current.getComp() && ct != NO_COMP) {
-                if (ans.valueType == INT) {
-                    int terminalVal = *reinterpret_cast<int*>(&targetHandle);
-                    terminalVal = parent->getSetting().getMaxRange() - terminalVal; // complement if needed
-                    ans.setValue(terminalVal, INT);
-                } else if (ans.valueType == FLOAT) {
-                    float terminalVal = *reinterpret_cast<float*>(&targetHandle);
-                    terminalVal = parent->getSetting().getMaxRange() - terminalVal; // complement if needed
-                    ans.setValue(terminalVal, FLOAT);
-                } else if (ans.valueType == VOID) {
-                    // special value: NegInf => PosInf?
-                    // TBD
-                }
-            }
-            return ans;
-        }
+        if (targetLvl == 0) return terminalValue(current);
         k--;
     }
     return ans;
 }
 
-void Func::unionAssignments(const ExplictFunc& assignments) {
-    try {
-        // Check if function is attached to a forest
-        if (!parent) {
-            std::cerr << "[BRAVE_DD] ERROR! unionAssignments: Function not attached to a forest" << std::endl;
-            return;
-        }
+void Func::evaluate(const std::vector<std::vector<uint64_t> >& assignments, const size_t num,
+                    std::vector<Value>& values) const
+{
+    evaluateBatch(assignments, nullptr, num, values);
+}
 
-        // Get the number of assignments
-        size_t numAssignments = assignments.size();
-        if (numAssignments == 0) {
-            // Nothing to do, return the original function
-            return;
+void Func::evaluate(const std::vector<std::vector<uint64_t> >& aFrom, const std::vector<std::vector<uint64_t> >& aTo,
+                    const size_t num, std::vector<Value>& values) const
+{
+    evaluateBatch(aFrom, &aTo, num, values);
+}
+
+Value Func::terminalValue(const Edge& terminal) const
+{
+    // value type INT, FLOAT, or VOID (special value)
+    Value ans = getTerminalValue(terminal.handle);
+    NodeHandle targetHandle = terminal.getNodeHandle();
+    if (terminal.getComp() && parent->getSetting().getCompType() != NO_COMP) {
+        if (ans.valueType == INT) {
+            int terminalVal;
+            memcpy(&terminalVal, &targetHandle, sizeof(terminalVal));
+            terminalVal = parent->getSetting().getMaxRange() - terminalVal; // complement if needed
+            ans.setValue(terminalVal, INT);
+        } else if (ans.valueType == FLOAT) {
+            float terminalVal;
+            memcpy(&terminalVal, &targetHandle, sizeof(terminalVal));
+            terminalVal = parent->getSetting().getMaxRange() - terminalVal; // complement if needed
+            ans.setValue(terminalVal, FLOAT);
+        } else if (ans.valueType == VOID) {
+            // special value: NegInf => PosInf?
+            // TBD
         }
+    }
+    return ans;
+}
+
+Edge Func::childEdge(const Edge& source, const char c) const
+{
+    SwapSet st = parent->getSetting().getSwapType();
+    bool isComp = (parent->getSetting().getCompType() == COMP) && source.getComp();
+    Edge child;
+    if (parent->getSetting().isRelation()) {
+        bool isSwapF = (st == FROM || st == FROM_TO) && source.getSwap(0);
+        bool isSwapT = (st == TO || st == FROM_TO) && source.getSwap(1);
+        child = parent->getChildEdge(source.getNodeLevel(), source.getNodeHandle(), ((isSwapF ^ (c >> 1)) << 1) + (isSwapT ^ (c & 0x01)));
+        if (isComp) child.complement();
+        return child;
+    }
+    bool isSwap = (st == ONE || st == ALL) && source.getSwap(0);
+    child = parent->getChildEdge(source.getNodeLevel(), source.getNodeHandle(), isSwap ^ c);
+    if (isComp) child.complement();
+    if (isSwap && (st == ALL)) child.swap();  // for swap-all
+    return child;
+}
 
-        // Get the number of bits to process (skip the 0th element)
-        int numBits = assignments.getNumBits();
-        if (numBits <= 0) {
-            throw error(ErrCode::MISCELLANEOUS, __FILE__, __LINE__);
+void Func::evaluateBatch(const std::vector<std::vector<uint64_t> >& aFrom, const std::vector<std::vector<uint64_t> >* aTo,
+                         const size_t num, std::vector<Value>& values) const
+{
+    Level numVars = parent->getSetting().getNumVars();
+    bool isRel = (aTo != nullptr);
+    /* check the level and the number of words */
+    size_t numWords = (num + 63) / 64;
+    bool isValid = (aFrom.size() == (size_t)numVars+1) && (!isRel || (aTo->size() == (size_t)numVars+1));
+    for (Level k=1; isValid && (k<=numVars); k++) {
+        isValid = (aFrom[k].size() >= numWords) && (!isRel || ((*aTo)[k].size() >= numWords));
+    }
+    if (!isValid) {
+        std::cout << "[BRAVE_DD] ERROR!\t Func::evaluate(): Variable number check failed in batch evaluation! It was "
+        << aFrom.size()-1 << ", it should be " << numVars << ", with " << numWords << " words per variable" << std::endl;
+        exit(0);
+    }
+    values.assign(num, Value(0));
+    auto bit = [](const std::vector<uint64_t>& words, uint32_t n) {
+        return (bool)((words[n >> 6] >> (n & 63)) & 0x01);
+    };
+    EncodeMechanism encode = parent->getSetting().getEncodeMechanism();
+    if (encode != TERMINAL) {
+        // the edge values are summed per assignment: one at a time
+        std::vector<bool> from(numVars+1, 0), to(numVars+1, 0);
+        for (uint32_t n=0; n<num; n++) {
+            for (Level k=1; k<=numVars; k++) {
+                from[k] = bit(aFrom[k], n);
+                if (isRel) to[k] = bit((*aTo)[k], n);
+            }
+            values[n] = (isRel) ? evaluate(from, to) : evaluate(from);
         }
-        
-        // Create a full new BDD instead of trying to modify the existing one
-        Func resultFunc(parent);
-        resultFunc.falseFunc();  // Start with a false function
-        
-        // Process each assignment individually
-        for (size_t i = 0; i < numAssignments; i++) {
-            const std::vector<bool>& assignment = assignments.getAssignment(i);
-            // const Value& outcome = assignments.getOutcome(i);
-            
-            // Create a path for this assignment
-            // For simplicity, build each path level by level from the bottom up
-            Level numVars = parent->getSetting().getNumVars();
-            
-            // Start with a terminal 1 node
-            Edge terminalOneEdge, terminalZeroEdge;
-            EdgeHandle constOne = makeTerminal(INT, 1), constZero = makeTerminal(INT, 0);
-            packRule(constOne, RULE_X);
-            packRule(constZero, RULE_X);
-            Value v(0);
-            terminalOneEdge.setEdgeHandle(constOne);
-            terminalZeroEdge.setEdgeHandle(constZero);
-            
-            // Build the path from the bottom up
-            Edge currentEdge = terminalOneEdge;
-            
-            for (Level level = 1; level <= numVars; level++) {
-                Level varIndex = numVars - level + 1;  // Variable index (1-based)
-                
-                // Create a node at this level
-                std::vector<Edge> children(2);
-                
-                // Connect the path based on the assignment
-                if (assignment[varIndex]) {
-                    // Variable is 1 in the assignment
-                    children[0] = terminalZeroEdge;  // 0-child
-                    children[1] = currentEdge;       // 1-child
-                } else {
-                    // Variable is 0 in the assignment
-                    children[0] = currentEdge;       // 0-child
-                    children[1] = terminalZeroEdge;  // 1-child
+        return;
+    }
+    /* edge flags type */
+    SwapSet st = parent->getSetting().getSwapType();
+    CompSet ct = parent->getSetting().getCompType();
+    ValueType vt = (parent->getSetting().getValType() == INT
+                    || parent->getSetting().getValType() == LONG) ? INT : FLOAT;
+    /* the assignments grouped by the edge they follow, at the level where the edge begins */
+    std::vector<std::unordered_map<EdgeHandle, std::vector<uint32_t> > > groups(numVars+1);
+    std::vector<uint32_t>& all = groups[numVars][edge.handle];
+    all.resize(num);
+    for (uint32_t n=0; n<num; n++) all[n] = n;
+    std::vector<std::vector<uint32_t> > byChild((isRel) ? 4 : 2);
+    for (int k=numVars; k>=0; k--) {
+        for (std::pair<const EdgeHandle, std::vector<uint32_t> >& group : groups[k]) {
+            Edge current;
+            current.setEdgeHandle(group.first);
+            std::vector<uint32_t>& lanes = group.second;
+            Level targetLvl = current.getNodeLevel();
+            ReductionRule incoming = current.getRule();
+            /* if incoming edge skips levels, some assignments end at the terminal of its rule */
+            if ((targetLvl < k) && (incoming != RULE_X)) {
+                Value ruleValue;
+                if (vt == INT) ruleValue.setValue(hasRuleTerminalOne(incoming)?1:0, INT);
+                else ruleValue.setValue(hasRuleTerminalOne(incoming)?1.0f:0.0f, FLOAT);
+                size_t kept = 0;
+                for (uint32_t n : lanes) {
+                    bool isEnd = 0;
+                    if (isRel) {
+                        bool isIdent = 1;
+                        for (Level i=k; i>targetLvl; i--) {
+                            if (bit(aFrom[i], n) != bit((*aTo)[i], n)) isIdent = 0;
+                        }
+                        isEnd = (!isIdent) && isRuleI(incoming);
+                    } else {
+                        bool allOne = 1, existOne = 0;
+                        for (Level i=k; i>targetLvl; i--) {
+                            allOne &= bit(aFrom[i], n);
+                            existOne |= bit(aFrom[i], n);
+                        }
+                        isEnd = (allOne && isRuleAH(incoming))
+                                || ((!allOne) && isRuleEL(incoming))
+                                || (existOne && isRuleEH(incoming))
+                                || ((!existOne) && isRuleAL(incoming));
+                    }
+                    if (isEnd) {
+                        values[n] = ruleValue;
+                    } else {
+                        lanes[kept++] = n;
+                    }
                 }
-                
-                // Create the node
-                EdgeLabel label = 0;
-                packRule(label, RULE_X);
-                currentEdge = parent->reduceEdge(numVars, label, varIndex, children);
+                lanes.resize(kept);
             }
-            
-            // Now we have a BDD path for this assignment
-            // Add it to the result function using union operation
-            try {
-                BinaryOperation* bop = BOPs.find(BinaryOperationType::BOP_UNION, parent, parent, parent);
-                if (!bop) {
-                    bop = BOPs.add(new BinaryOperation(BinaryOperationType::BOP_UNION, parent, parent, parent));
-                }
-                
-                Func pathFunc(parent, currentEdge);
-                
-                // Union the current result with this path
-                if (i == 0) {
-                    resultFunc = pathFunc;  // First assignment - just use the path
+            if (lanes.empty()) continue;
+            if (targetLvl == 0) {
+                Value ans = terminalValue(current);
+                for (uint32_t n : lanes) values[n] = ans;
+                continue;
+            }
+            /* split the assignments by the child they follow */
+            NodeHandle targetHandle = current.getNodeHandle();
+            bool isComp = (ct==COMP) ? current.getComp() : 0;
+            bool isSwapF = 0, isSwapT = 0;
+            if (isRel) {
+                isSwapF = (st==FROM || st==FROM_TO) ? current.getSwap(0) : 0;
+                isSwapT = (st==TO || st==FROM_TO) ? current.getSwap(1) : 0;
+            } else {
+                isSwapF = (st==ONE || st==ALL) ? current.getSwap(0) : 0;
+            }
+            for (size_t c=0; c<byChild.size(); c++) byChild[c].clear();
+            for (uint32_t n : lanes) {
+                if (isRel) {
+                    byChild[((isSwapF^bit(aFrom[targetLvl], n))<<1) + (isSwapT^bit((*aTo)[targetLvl], n))].push_back(n);
                 } else {
-                    Func temp(parent);
-                    bop->compute(resultFunc, pathFunc, temp);
-                    resultFunc = temp;
+                    byChild[isSwapF^bit(aFrom[targetLvl], n)].push_back(n);
                 }
-            } catch (const std::exception& e) {
-                std::cerr << "[BRAVE_DD] ERROR in unionAssignments union operation: " << e.what() << std::endl;
             }
+            for (size_t c=0; c<byChild.size(); c++) {
+                if (byChild[c].empty()) continue;
+                Edge child = parent->getChildEdge(targetLvl, targetHandle, (char)c);
+                if (isComp) child.complement();
+                if (!isRel && isSwapF && st==ALL) child.swap();  // for swap-all
+                std::vector<uint32_t>& next = groups[targetLvl-1][child.handle];
+                next.insert(next.end(), byChild[c].begin(), byChild[c].end());
+            }
+            std::vector<uint32_t>().swap(lanes);
         }
-        
-        // Set the final result
-        edge = resultFunc.getEdge();
-        
-        // Ensure the result has proper type flags
-        // edge = ensureTerminalTypeFlags(parent, edge);
+        groups[k].clear();
     }
-    catch (const std::exception& e) {
-        std::cerr << "[BRAVE_DD] ERROR in unionAssignments: " << e.what() << std::endl;
+}
+
+void Func::unionAssignments(const ExplictFunc& assignments) {
+    // Check if function is attached to a forest
+    if (!parent) {
+        std::cerr << "[BRAVE_DD] ERROR! unionAssignments: Function not attached to a forest" << std::endl;
+        return;
+    }
+    // the assignments become members of a set, relations TBD
+    const ForestSetting& setting = parent->getSetting();
+    if ((setting.getEncodeMechanism() != TERMINAL) || setting.isRelation()) {
+        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
     }
-    catch (...) {
-        std::cerr << "[BRAVE_DD] UNKNOWN ERROR in unionAssignments" << std::endl;
+    if (assignments.size() == 0) return;
+    // numVars+1 bits with the first one unused, as for evaluate; or numVars bits, as for buildFunc
+    int shift = assignments.getNumBits() - setting.getNumVars();
+    if ((shift != 0) && (shift != 1)) {
+        throw error(ErrCode::MISCELLANEOUS, __FILE__, __LINE__);
     }
+    // the rows in the order of their bits, partitioned level by level
+    std::vector<size_t> order(assignments.size());
+    for (size_t i=0; i<order.size(); i++) order[i] = i;
+    edge = unionAssignmentRecursive(setting.getNumVars(), edge, assignments, shift, order, 0, order.size());
 }
 
-/* Expert function for union assignments TBD */
-Edge Func::unionAssignmentRecursive(Level n, Edge& root, ExplictFunc assignments)
+/*
+ *  The union of the edge (from level lvl) with the rows order[start, start+size); bit lvl-1+shift
+ *  of a row is the variable level lvl. The rows are partitioned by their bit at each level, and
+ *  the edge is expanded into its cofactors only where some rows go: the other parts of the
+ *  diagram are kept as they are. The nodes on the way are rebuilt bottom-up.
+ */
+Edge Func::unionAssignmentRecursive(Level lvl, const Edge& root, const ExplictFunc& assignments, int shift,
+                                    std::vector<size_t>& order, size_t start, size_t size)
 {
-    /* declare the final answer */
-    Edge ans;
-    /* terminal case */
-    if (n==0) {
-        // return the edge pointing to terminal node
+    if (size == 0) return root;
+    // already true below
+    bool isOne = (root.getNodeLevel() == 0) && (root.getRule() == RULE_X)
+                    && (root.getComp() ^ isTerminalOne(root.getEdgeHandle()));
+    if (isOne) return root;
+    if (lvl == 0) {
+        Edge ans;
+        ans.handle = parent->makeBoolTerminal(1);
+        packRule(ans.handle, RULE_X);
+        return ans;
     }
-    /*
-     * here means the root edge can not capture the assignment,
-     * then we do it recursively!
-     *      we need to expand root edge if it's a long edge
-     */
-    Level skipLvl;
-    skipLvl = n - unpackLevel(root.handle);
-    /* determine the down edges */
+    size_t left = assignments.partition(order, start, size, lvl-1+shift);
+    std::vector<Edge> child(2);
+    child[0] = unionAssignmentRecursive(lvl-1, parent->cofact(lvl, root, 0), assignments, shift, order, start, left-start);
+    child[1] = unionAssignmentRecursive(lvl-1, parent->cofact(lvl, root, 1), assignments, shift, order, left, size-left+start);
+    EdgeLabel label = 0;
+    packRule(label, RULE_X);
+    return parent->reduceEdge(lvl, label, lvl, child);
+}
+
+void Func::unionCubes(const std::vector<Cube>& cubes)
+{
+    std::vector<Func> args(1, *this);
+    args.reserve(cubes.size() + 1);
+    for (size_t i=0; i<cubes.size(); i++) {
+        args.push_back(Func(parent));
+        args.back().cube(cubes[i]);
+    }
+    apply(UNION, args, *this);
+}
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                          Cube  methods                         *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+const char Cube::DONT_CARE;
+
+Cube::Cube(Level numVars)
+:literals(numVars+1, DONT_CARE)
+{
     //
-    if (skipLvl == 0) {
-        // it is a short edge, they are the child edges of root target node
-    } else {
-        // it is a long edge, expand based on its reduction rule if needed <==== helper function?
+}
+Cube::Cube(const std::vector<char>& values)
+:literals(values)
+{
+    //
+}
+Cube::Cube(const std::string& line)
+:literals(line.size()+1, DONT_CARE)
+{
+    for (size_t i=0; i<line.size(); i++) {
+        if (line[i] == '0') set(i+1, 0);
+        else if (line[i] == '1') set(i+1, 1);
     }
-    /*
-     * build new node at level n, child edges are down edges or recursive calls based on assignment[n]
-     */
-    // temporary node information 
-    /* reduce */
-    // parent->reduceEdge
-    return ans;
 }
 
 // ******************************************************************
@@ -731,6 +925,8 @@ Edge Func::unionAssignmentRecursive(Level n, Edge& root, ExplictFunc assignments
 ExplictFunc::ExplictFunc()
 {
     defaultVal.setValue(0, INT);
+    numBits = 0;
+    numWords = 0;
 }
 
 ExplictFunc::~ExplictFunc()
@@ -740,12 +936,50 @@ ExplictFunc::~ExplictFunc()
 
 void ExplictFunc::addAssignment(const std::vector<bool>& assignment, const Value& outcome)
 {
-    assignments.push_back(assignment);
+    if (outcomes.empty() && rows.empty()) {
+        numBits = static_cast<int>(assignment.size());
+        numWords = (assignment.size() + 63) / 64;
+    }
+    if (static_cast<int>(assignment.size()) != numBits) {
+        std::cerr << "[BRAVE_DD] ERROR! ExplictFunc::addAssignment: Number of bits does not match" << std::endl;
+        throw error(ErrCode::INVALID_ARGUMENT, __FILE__, __LINE__);
+    }
+    for (int w=0; w<static_cast<int>(numWords); w++) {
+        uint64_t word = 0;
+        for (int b=64*w; (b<64*(w+1)) && (b<numBits); b++) {
+            if (assignment[b]) word |= uint64_t(1) << (b%64);
+        }
+        rows.push_back(word);
+    }
+    outcomes.push_back(outcome);
+}
+
+void ExplictFunc::addAssignment(const uint64_t* packed, const Value& outcome)
+{
+    if (numWords == 0) {
+        std::cerr << "[BRAVE_DD] ERROR! ExplictFunc::addAssignment: Number of bits unknown" << std::endl;
+        throw error(ErrCode::INVALID_ARGUMENT, __FILE__, __LINE__);
+    }
+    rows.insert(rows.end(), packed, packed + numWords);
+    // the bits beyond numBits are not part of the assignment
+    if (numBits % 64) rows.back() &= (uint64_t(1) << (numBits % 64)) - 1;
     outcomes.push_back(outcome);
 }
 
-const std::vector<std::vector<bool>>& ExplictFunc::getAssignments() const
+void ExplictFunc::reserve(size_t num, int bits)
 {
+    if (outcomes.empty()) {
+        numBits = bits;
+        numWords = (bits + 63) / 64;
+    }
+    rows.reserve(num * numWords);
+    outcomes.reserve(num);
+}
+
+std::vector<std::vector<bool>> ExplictFunc::getAssignments() const
+{
+    std::vector<std::vector<bool>> assignments(outcomes.size());
+    for (size_t i=0; i<outcomes.size(); i++) assignments[i] = getAssignment(static_cast<int>(i));
     return assignments;
 }
 
@@ -766,25 +1000,26 @@ void ExplictFunc::setDefaultValue(const Value& val)
 
 size_t ExplictFunc::size() const
 {
-    return assignments.size();
+    return outcomes.size();
 }
 
 int ExplictFunc::getNumBits() const
 {
-    if (assignments.empty()) {
+    if (outcomes.empty()) {
         return 0;
     }
-    return static_cast<int>(assignments[0].size());
+    return numBits;
 }
 
-const std::vector<bool>& ExplictFunc::getAssignment(int idx) const
+std::vector<bool> ExplictFunc::getAssignment(int idx) const
 {
-    if (idx < 0 || idx >= static_cast<int>(assignments.size())) {
-        static std::vector<bool> empty;
+    if (idx < 0 || idx >= static_cast<int>(outcomes.size())) {
         std::cerr << "[BRAVE_DD] ERROR! ExplictFunc::getAssignment: Index out of bounds" << std::endl;
-        return empty;
+        return std::vector<bool>();
     }
-    return assignments[idx];
+    std::vector<bool> assignment(numBits);
+    for (int b=0; b<numBits; b++) assignment[b] = getBit(idx, b);
+    return assignment;
 }
 
 const Value& ExplictFunc::getOutcome(int idx) const
@@ -799,26 +1034,26 @@ const Value& ExplictFunc::getOutcome(int idx) const
 
 char** ExplictFunc::getAllAssignmentsAsCharArray() const
 {
-    size_t numAssignments = assignments.size();
+    size_t numAssignments = outcomes.size();
     if (numAssignments == 0) {
         return nullptr;
     }
 
     // Get the number of bits
-    size_t numBits = assignments[0].size() - 1; // Skip the 0th element
+    size_t numChars = numBits - 1; // Skip the 0th element
     
     // Allocate memory for the char** array
     char** result = new char*[numAssignments];
     
     // Convert each assignment to a char array
     for (size_t i = 0; i < numAssignments; i++) {
-        result[i] = new char[numBits + 1]; // +1 for null terminator
+        result[i] = new char[numChars + 1]; // +1 for null terminator
         
         // Skip the 0th element in assignments
-        for (size_t j = 0; j < numBits; j++) {
-            result[i][j] = assignments[i][j+1] ? '1' : '0';
+        for (size_t j = 0; j < numChars; j++) {
+            result[i][j] = getBit(i, j+1) ? '1' : '0';
         }
-        result[i][numBits] = '\0'; // Null terminate
+        result[i][numChars] = '\0'; // Null terminate
     }
     
     return result;
@@ -833,22 +1068,52 @@ Func ExplictFunc::buildFunc(Forest* forest) const
     }
     // the final answer
     Func ans(forest);
-    // copy the ExplictFunc
-    ExplictFunc EF = *this;
-    Edge edge = EF.buildEdge(forest, getNumBits(), 0, size());
+    // the rows in the order of their bits, partitioned level by level
+    std::vector<size_t> order(size());
+    for (size_t i=0; i<order.size(); i++) order[i] = i;
+    Edge edge = buildEdge(forest, getNumBits(), order, 0, size());
     // passing to final answer
     ans.setEdge(edge);
     return ans;
 }
 
-Edge ExplictFunc::buildEdge(Forest* forest, Level lvl, size_t start, size_t size)
+size_t ExplictFunc::partition(std::vector<size_t>& order, size_t start, size_t size, int bit) const
+{
+    // two-finger algorithm to sort 0,1 values in position bit
+    size_t left = start;
+    size_t right = start + size - 1;
+    for (;;) {
+        // move left to first 1 value
+        for ( ; left < right; left++) {
+            if (getBit(order[left], bit) == 1) break;
+        }
+        // move right to first 0 value
+        for ( ; left < right; right--) {
+            if (getBit(order[right], bit) == 0) break;
+        }
+        // stop?
+        if (left >= right) break;
+        // we have a 1 before a 0, swap them;
+        SWAP(order[left], order[right]);
+        // for sure we can move them one spot
+        ++left;
+        --right;
+    }
+    if ((left < (size + start)) && (getBit(order[left], bit) == 0)) left++;
+    return left;
+}
+
+Edge ExplictFunc::buildEdge(Forest* forest, Level lvl, std::vector<size_t>& order, size_t start, size_t size) const
 {
     // the edge to return
     Edge ans;
     // empty size or terminal by level, build constant edge to default value or outcome value
     if ((size == 0) || (lvl == 0)) {
         EncodeMechanism em = forest->getSetting().getEncodeMechanism();
-        Value val = (size == 0) ? defaultVal : outcomes[start];
+        // equal assignments: the one added last
+        size_t last = (size == 0) ? 0 : order[start];
+        for (size_t i=start+1; i<start+size; i++) last = (order[i] > last) ? order[i] : last;
+        Value val = (size == 0) ? defaultVal : outcomes[last];
         ValueType valTP = val.getType();
         if (em == TERMINAL) {
                 ans.handle = makeTerminal(val);
@@ -864,33 +1129,12 @@ Edge ExplictFunc::buildEdge(Forest* forest, Level lvl, size_t start, size_t size
         // return (size == 0) ? forest->normalizeEdge(lvl, ans) : ans;
         return ans;
     }
-    // two-finger algorithm to sort 0,1 values in position lvl
-    size_t left = start;
-    size_t right = start + size - 1;
-    for (;;) {
-        // move left to first 1 value
-        for ( ; left < right; left++) {
-            if (assignments[left][lvl-1] == 1) break;
-        }
-        // move right to first 0 value
-        for ( ; left < right; right--) {
-            if (assignments[right][lvl-1] == 0) break;
-        }
-        // stop?
-        if (left >= right) break;
-        // we have a 1 before a 0, swap them;
-        SWAP(assignments[left], assignments[right]);
-        SWAP(outcomes[left], outcomes[right]);
-        // for sure we can move them one spot
-        ++left;
-        --right;
-    }
-    if ((left < (size + start)) && (assignments[left][lvl-1] == 0)) left++;
+    size_t left = partition(order, start, size, lvl-1);
 
     // build a ndoe and recursively call
     std::vector<Edge> child(2);
-    child[0] = buildEdge(forest, lvl-1, start, left-start);
-    child[1] = buildEdge(forest, lvl-1, left, size-left+start);
+    child[0] = buildEdge(forest, lvl-1, order, start, left-start);
+    child[1] = buildEdge(forest, lvl-1, order, left, size-left+start);
     EdgeLabel root = 0;
     packRule(root, RULE_X);
     return forest->reduceEdge(lvl, root, lvl, child);
@@ -906,4 +1150,457 @@ void ExplictFunc::freeCharArray(char** array, int size) const
         delete[] array[i];
     }
     delete[] array;
-} 
\ No newline at end of file
+} 
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                       FrozenFunc methods                       *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/* The weight of an EV* value, as Forest::multWeight */
+static inline double weightOf(const Value& v)
+{
+    double w = 0.0;
+    if (v.getType() == DOUBLE) {
+        v.getValueTo(&w, DOUBLE);
+    } else if (v.getType() == FLOAT) {
+        float f;
+        v.getValueTo(&f, FLOAT);
+        w = f;
+    } else if (v.getType() == LONG) {
+        long l;
+        v.getValueTo(&l, LONG);
+        w = static_cast<double>(l);
+    } else if (v.getType() == INT) {
+        int i;
+        v.getValueTo(&i, INT);
+        w = i;
+    }
+    return w;
+}
+
+FrozenFunc::FrozenFunc(const Func& func)
+{
+    Forest* forest = func.getForest();
+    const ForestSetting& setting = forest->getSetting();
+    numVars = setting.getNumVars();
+    isRel = setting.isRelation();
+    numChild = (isRel) ? 4 : 2;
+    encode = setting.getEncodeMechanism();
+    valType = setting.getValType();
+    maxRange = setting.getMaxRange();
+    if ((valType == INT) || (valType == LONG)) {
+        ruleValue[0] = Value(0);
+        ruleValue[1] = Value(1);
+    } else {
+        ruleValue[0] = Value(0.0f);
+        ruleValue[1] = Value(1.0f);
+    }
+    SwapSet st = setting.getSwapType();
+    CompSet ct = setting.getCompType();
+    // the flags of an edge, as Func::evaluate uses them: complement, swap (from), swap to
+    auto flagsOf = [&](const Edge& e) {
+        uint64_t flags = 0;
+        if ((ct == COMP) && e.getComp()) flags |= 0x01;
+        if (isRel) {
+            if ((st == FROM || st == FROM_TO) && e.getSwap(0)) flags |= 0x02;
+            if ((st == TO || st == FROM_TO) && e.getSwap(1)) flags |= 0x04;
+        } else if ((st == ONE || st == ALL) && e.getSwap(0)) {
+            flags |= 0x02;
+        }
+        return flags;
+    };
+    // a node with the flags of its incoming edge; the level first, for the topological order
+    auto keyOf = [&](const Edge& e) {
+        return ((uint64_t)e.getNodeLevel() << 40) | (flagsOf(e) << 32) | e.getNodeHandle();
+    };
+    // the child followed by the assignment c, with the flags of the node pushed down
+    auto childOf = [&](uint64_t key, char c) {
+        Level lvl = (Level)(key >> 40);
+        bool isComp = (key >> 32) & 0x01;
+        bool isSwapF = (key >> 33) & 0x01;
+        bool isSwapT = (key >> 34) & 0x01;
+        char index = (isRel) ? (char)(((isSwapF ^ (c >> 1)) << 1) + (isSwapT ^ (c & 0x01))) : (char)(isSwapF ^ c);
+        Edge child = forest->getChildEdge(lvl, (NodeHandle)key, index);
+        if (isComp) child.complement();
+        if (!isRel && isSwapF && (st == ALL)) child.swap();  // for swap-all
+        return child;
+    };
+
+    // the nodes reachable from the root
+    std::unordered_map<uint64_t, uint32_t> index;
+    std::vector<uint64_t> keys;
+    Edge top = func.getEdge();
+    if (top.getNodeLevel() > 0) {
+        index[keyOf(top)] = 0;
+        keys.push_back(keyOf(top));
+    }
+    for (size_t i=0; i<keys.size(); i++) {
+        for (char c=0; c<numChild; c++) {
+            Edge child = childOf(keys[i], c);
+            if ((child.getNodeLevel() == 0) || index.count(keyOf(child))) continue;
+            index[keyOf(child)] = 0;
+            keys.push_back(keyOf(child));
+        }
+    }
+    // higher levels first
+    std::sort(keys.begin(), keys.end(), std::greater<uint64_t>());
+    for (size_t i=0; i<keys.size(); i++) index[keys[i]] = (uint32_t)i;
+
+    std::unordered_map<EdgeHandle, uint32_t> terminalIndex;
+    auto arcOf = [&](const Edge& e) {
+        Arc arc;
+        arc.level = e.getNodeLevel();
+        arc.rule = e.getRule();
+        arc.value = e.getValue();
+        if (arc.level > 0) {
+            arc.target = index[keyOf(e)];
+            return arc;
+        }
+        EdgeHandle terminal = e.getEdgeHandle();
+        packRule(terminal, RULE_X);
+        std::unordered_map<EdgeHandle, uint32_t>::const_iterator it = terminalIndex.find(terminal);
+        if (it != terminalIndex.end()) {
+            arc.target = it->second;
+            return arc;
+        }
+        arc.target = (uint32_t)terminals.size();
+        terminalIndex[terminal] = arc.target;
+        if (encode == TERMINAL) {
+            terminals.push_back(func.terminalValue(e));
+            isEnd.push_back(1);
+        } else {
+            // the special terminals other than omega end the evaluation of EV forests
+            terminals.push_back(getTerminalValue(terminal));
+            isEnd.push_back(isTerminalSpecial(terminal) && !isTerminalSpecial(SpecialValue::OMEGA, terminal));
+        }
+        return arc;
+    };
+    arcs.resize(keys.size() * numChild);
+    for (size_t i=0; i<keys.size(); i++) {
+        for (char c=0; c<numChild; c++) arcs[i*numChild + c] = arcOf(childOf(keys[i], c));
+    }
+    root = arcOf(top);
+}
+FrozenFunc::~FrozenFunc()
+{
+    //
+}
+
+Value FrozenFunc::evaluate(const std::vector<bool>& assignment) const
+{
+    /* check the level */
+    if (numVars != (assignment.size()-1)) {
+        std::cout << "[BRAVE_DD] ERROR!\t FrozenFunc::evaluate(): Variable number check failed in evaluation! It was "<<assignment.size()-1
+        <<", it should be "<< numVars << std::endl;
+        exit(0);
+    }
+    const Arc* current = &root;
+    Level k = numVars;
+    /* initialized edge value for EV forests */
+    Value ans(0);
+    if (encode != TERMINAL) {
+        if ((current->level == 0) || ((encode == EDGE_MULT) && (weightOf(current->value) == 0.0))) return current->value;
+        ans = current->value;
+    }
+    while (true) {
+        /* if incoming edge skips levels */
+        if ((current->level < k) && (current->rule != RULE_X)) {
+            ReductionRule incoming = current->rule;
+            if (encode == TERMINAL) {
+                bool allOne = 1, existOne = 0;
+                for (Level i=k; i>current->level; i--) {
+                    allOne &= assignment[i];
+                    existOne |= assignment[i];
+                }
+                if ((allOne && isRuleAH(incoming))
+                    || ((!allOne) && isRuleEL(incoming))
+                    || (existOne && isRuleEH(incoming))
+                    || ((!existOne) && isRuleAL(incoming))) {
+                    return ruleValue[hasRuleTerminalOne(incoming)];
+                }
+            } else if ((encode != EDGE_MULT) && (current->level == 0) && isEnd[current->target]) {
+                return terminals[current->target];
+            } else {
+                std::cout << "[BRAVE_DD] ERROR!\t FrozenFunc::evaluate(): Illegal patterns for EV forests!" << std::endl;
+                exit(0);
+            }
+        }
+        if (current->level > 0) {
+            Level lvl = current->level;
+            k = lvl-1;
+            current = &arcs[current->target*numChild + assignment[lvl]];
+            /* cumulate the edge values */
+            if ((encode == EDGE_PLUS) || (encode == EDGE_PLUSMOD)) {
+                if (valType == INT) ans = Value(ans.getIntValue() + current->value.getIntValue());
+                else if (valType == LONG) ans = Value(ans.getLongValue() + current->value.getLongValue());
+            } else if (encode == EDGE_MULT) {
+                ans = ans * current->value;
+                if (weightOf(ans) == 0.0) return ans;
+            }
+            continue;
+        }
+        /* terminal */
+        if (isEnd[current->target]) return terminals[current->target];
+        if (encode == EDGE_PLUSMOD) {
+            if ((valType == INT) && (maxRange > static_cast<unsigned long>(std::numeric_limits<int>::max()))) {
+                std::cout << "[BRAVE_DD] ERROR!\t maxRange overflows valType specified" << std::endl;
+                exit(0);
+            } else if ((valType == LONG) && (maxRange > static_cast<unsigned long>(std::numeric_limits<long>::max()))) {
+                std::cout << "[BRAVE_DD] ERROR!\t maxRange overflows valType specified" << std::endl;
+                exit(0);
+            }
+            if (valType == INT) return Value(ans.getIntValue() % static_cast<int>(maxRange));
+            if (valType == LONG) return Value(ans.getLongValue() % static_cast<long>(maxRange));
+        }
+        return ans;
+    }
+}
+
+Value FrozenFunc::evaluate(const std::vector<bool>& aFrom, const std::vector<bool>& aTo) const
+{
+    /* check the level */
+    if ((numVars != (aFrom.size()-1)) || (aFrom.size() != aTo.size())) {
+        std::cout << "[BRAVE_DD] ERROR!\t FrozenFunc::evaluate(): Variable number check failed in evaluation! It was "<<aFrom.size()-1
+        <<", it should be "<< numVars << std::endl;
+        exit(0);
+    }
+    const Arc* current = &root;
+    Level k = numVars;
+    while (true) {
+        /* if incoming edge skips levels */
+        if ((current->level < k) && (current->rule != RULE_X)) {
+            if (encode == TERMINAL) {
+                bool isIdent = 1;
+                for (Level i=k; i>current->level; i--) {
+                    if (aFrom[i] != aTo[i]) isIdent = 0;
+                }
+                if ((!isIdent) && isRuleI(current->rule)) return ruleValue[hasRuleTerminalOne(current->rule)];
+            } else if (encode == EDGE_MULT) {
+                std::cout << "[BRAVE_DD] ERROR!\t FrozenFunc::evaluate(): Illegal patterns for EV*!" << std::endl;
+                exit(0);
+            }
+        }
+        if (current->level > 0) {
+            Level lvl = current->level;
+            k = lvl-1;
+            current = &arcs[current->target*numChild + (aFrom[lvl]<<1) + aTo[lvl]];
+            continue;
+        }
+        return terminals[current->target];
+    }
+}
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                      FuncIterator methods                      *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+const char FuncIterator::DONT_CARE;
+const char FuncIterator::SAME;
+const char FuncIterator::DIFF;
+
+FuncIterator::FuncIterator(const Func& f, bool minterms, bool all)
+:func(f)
+{
+    forest = func.getForest();
+    const ForestSetting& setting = forest->getSetting();
+    numVars = setting.getNumVars();
+    isRel = setting.isRelation();
+    numChild = (isRel) ? 4 : 2;
+    encode = setting.getEncodeMechanism();
+    isMinterm = minterms;
+    isAll = all;
+    if ((setting.getValType() == INT) || (setting.getValType() == LONG)) {
+        ruleValue[0] = Value(0);
+        ruleValue[1] = Value(1);
+    } else {
+        ruleValue[0] = Value(0.0f);
+        ruleValue[1] = Value(1.0f);
+    }
+    cube.assign(numVars+1, DONT_CARE);
+    cubeTo.assign((isRel) ? numVars+1 : 0, DONT_CARE);
+    minterm.assign(cube.size(), 0);
+    mintermTo.assign(cubeTo.size(), 0);
+    hasMinterm = 0;
+    // one frame per level at most: the frames are never moved
+    stack.reserve(numVars+1);
+    Edge root = func.getEdge();
+    stack.push_back(Frame{root, numVars, root.getValue(), 0, -1});
+}
+FuncIterator::~FuncIterator()
+{
+    //
+}
+
+bool FuncIterator::next()
+{
+    /* the remaining minterms of the current cube */
+    if (isMinterm && nextMinterm()) return 1;
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        Level lvl = frame.edge.getNodeLevel();
+        if (frame.child < 0) {
+            if (frame.pattern == numPatterns(frame)) {
+                stack.pop_back();
+                continue;
+            }
+            bool isEnd = setPattern(frame, frame.pattern++);
+            bool isAbsorbed = (encode == EDGE_MULT) && (forest->multWeight(frame.value) == 0.0);
+            if (isEnd || isAbsorbed || (lvl == 0)) {
+                /* the value does not depend on the levels below */
+                setAny(lvl, 1);
+                if (isEnd) value = ruleValue[hasRuleTerminalOne(frame.edge.getRule())];
+                else value = (isAbsorbed) ? frame.value : endValue(frame);
+                if (isAll || !isSkipped(value)) {
+                    if (isMinterm) firstMinterm();
+                    return 1;
+                }
+                continue;
+            }
+            frame.child = 0;
+        }
+        if (frame.child == numChild) {
+            frame.child = -1;
+            continue;
+        }
+        char c = frame.child++;
+        if (isRel) {
+            cube[lvl] = c >> 1;
+            cubeTo[lvl] = c & 0x01;
+        } else {
+            cube[lvl] = c;
+        }
+        Edge child = func.childEdge(frame.edge, c);
+        /* cumulate the edge values */
+        Value acc = frame.value;
+        if ((encode == EDGE_PLUS) || (encode == EDGE_PLUSMOD)) {
+            if (acc.getType() == INT) acc = Value(acc.getIntValue() + child.getValue().getIntValue());
+            else if (acc.getType() == LONG) acc = Value(acc.getLongValue() + child.getValue().getLongValue());
+        } else if (encode == EDGE_MULT) {
+            acc = acc * child.getValue();
+        }
+        stack.push_back(Frame{child, (Level)(lvl-1), acc, 0, -1});
+    }
+    return 0;
+}
+
+void FuncIterator::getAssignment(std::vector<bool>& assignment) const
+{
+    const std::vector<char>& from = getCube();
+    assignment.assign(numVars+1, 0);
+    for (Level k=1; k<=numVars; k++) assignment[k] = (from[k] == 1);
+}
+
+void FuncIterator::getAssignment(std::vector<bool>& aFrom, std::vector<bool>& aTo) const
+{
+    getAssignment(aFrom);
+    const std::vector<char>& to = getCubeTo();
+    aTo.assign(numVars+1, 0);
+    for (Level k=1; (k<=numVars) && isRel; k++) {
+        aTo[k] = (to[k] == 1) || ((to[k] == SAME) && aFrom[k]) || ((to[k] == DIFF) && !aFrom[k]);
+    }
+}
+
+/*
+ *  The skipped levels of a long edge with rule EL, EH, AL or AH are all equal to some value v
+ *  (pattern 0), or equal to v down to the first level i that is not (pattern p, i = top-p+1),
+ *  the levels below i being don't-cares. One of the two reaches the target, the other the
+ *  terminal of the rule. For rule I on relations, v means "from and to are the same".
+ */
+int FuncIterator::numPatterns(const Frame& frame) const
+{
+    Level skipped = frame.top - frame.edge.getNodeLevel();
+    ReductionRule rule = frame.edge.getRule();
+    if ((skipped == 0) || (rule == RULE_X) || (encode != TERMINAL)) return 1;
+    if (isRel) return (isRuleI(rule)) ? skipped+1 : 1;
+    return skipped+1;
+}
+
+bool FuncIterator::setPattern(const Frame& frame, int p)
+{
+    Level bottom = frame.edge.getNodeLevel() + 1;
+    ReductionRule rule = frame.edge.getRule();
+    if (numPatterns(frame) == 1) {
+        setAny(frame.top, bottom);
+        return 0;
+    }
+    Level diff = (p == 0) ? 0 : frame.top - p + 1;
+    if (isRel) {
+        for (Level k=frame.top; k>=bottom; k--) {
+            cube[k] = DONT_CARE;
+            cubeTo[k] = (k > diff) ? SAME : (k == diff) ? DIFF : DONT_CARE;
+        }
+        return p > 0;
+    }
+    char v = (isRuleEL(rule) || isRuleAH(rule)) ? 1 : 0;
+    for (Level k=frame.top; k>=bottom; k--) cube[k] = (k > diff) ? v : (k == diff) ? !v : DONT_CARE;
+    // AL and AH reach their terminal when all the levels are equal, EL and EH otherwise
+    return (p == 0) == (isRuleAL(rule) || isRuleAH(rule));
+}
+
+void FuncIterator::setAny(Level top, Level bottom)
+{
+    for (Level k=top; k>=bottom; k--) {
+        cube[k] = DONT_CARE;
+        if (isRel) cubeTo[k] = DONT_CARE;
+    }
+}
+
+/* The value at a terminal, as Func::evaluate gives it */
+Value FuncIterator::endValue(const Frame& frame) const
+{
+    if (encode == TERMINAL) return func.terminalValue(frame.edge);
+    // the root edge to a terminal
+    if (stack.size() == 1) return frame.value;
+    EdgeHandle terminal = frame.edge.getEdgeHandle();
+    if (isTerminalSpecial(terminal) && !isTerminalSpecial(SpecialValue::OMEGA, terminal)) return getTerminalValue(terminal);
+    if (encode == EDGE_PLUSMOD) {
+        unsigned long mod = forest->getSetting().getMaxRange();
+        if (frame.value.getType() == INT) return Value(frame.value.getIntValue() % static_cast<int>(mod));
+        if (frame.value.getType() == LONG) return Value(frame.value.getLongValue() % static_cast<long>(mod));
+    }
+    return frame.value;
+}
+
+bool FuncIterator::isSkipped(const Value& val) const
+{
+    if ((encode == EDGE_PLUS) || (encode == EDGE_PLUSMOD)) return val.getType() == VOID;
+    return (val.getType() != VOID) && (forest->multWeight(val) == 0.0);
+}
+
+void FuncIterator::firstMinterm()
+{
+    freeLevels.clear();
+    for (Level k=1; k<=numVars; k++) {
+        if (cube[k] == DONT_CARE) freeLevels.push_back(2*k);
+        if (isRel && (cubeTo[k] == DONT_CARE)) freeLevels.push_back(2*k+1);
+        minterm[k] = (cube[k] == 1);
+        if (isRel) mintermTo[k] = (cubeTo[k] == 1) || ((cubeTo[k] == SAME) && minterm[k]) || ((cubeTo[k] == DIFF) && !minterm[k]);
+    }
+    hasMinterm = 1;
+}
+
+bool FuncIterator::nextMinterm()
+{
+    if (!hasMinterm) return 0;
+    /* binary increment over the don't-cares */
+    size_t i = 0;
+    for (; i<freeLevels.size(); i++) {
+        char& bit = (freeLevels[i] & 0x01) ? mintermTo[freeLevels[i]/2] : minterm[freeLevels[i]/2];
+        bit = !bit;
+        if (bit) break;
+    }
+    if (i == freeLevels.size()) {
+        hasMinterm = 0;
+        return 0;
+    }
+    for (Level k=1; (k<=numVars) && isRel; k++) {
+        if (cubeTo[k] == SAME) mintermTo[k] = minterm[k];
+        else if (cubeTo[k] == DIFF) mintermTo[k] = !minterm[k];
+    }
+    return 1;
+}
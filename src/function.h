@@ -8,6 +8,9 @@
 namespace BRAVE_DD {
     class Func;
     class ExplictFunc;
+    class Cube;
+    class FrozenFunc;
+    class FuncIterator;
 };
 
 // ******************************************************************
@@ -59,6 +62,9 @@ class BRAVE_DD::Func {
     /* For dimention of 2 (Relation) */
     void variable(Level lvl, bool isPrime);
     void variable(Level lvl, bool isPrime, Value low, Value high);
+    // Cube Func
+    /* The conjunction of the literals of a cube, built bottom-up in O(levels) */
+    void cube(const Cube& c);
 
     /*************************** Statistics *************************/
     /* Count the number of nodes used */
@@ -88,9 +94,25 @@ class BRAVE_DD::Func {
      */
     Value evaluate(const std::vector<bool>& assignment) const;
     Value evaluate(const std::vector<bool>& aFrom, const std::vector<bool>& aTo) const;
+    /** Compute the values of "num" assignments at once, walking the diagram level by level with
+     *  the assignments grouped by the node they reach. The assignments are bit-packed by variable:
+     *  bit (n % 64) of word (n / 64) in assignments[k] is the variable k of the n-th assignment.
+     *  Note: the first element (assignments[0]) is not used!
+     */
+    void evaluate(const std::vector<std::vector<uint64_t> >& assignments, const size_t num,
+                  std::vector<Value>& values) const;
+    void evaluate(const std::vector<std::vector<uint64_t> >& aFrom, const std::vector<std::vector<uint64_t> >& aTo,
+                  const size_t num, std::vector<Value>& values) const;
 
-    // ExplictFunc including info of assignments, outcomes, 
+    /** Add the assignments of an ExplictFunc to the set of this Func (their outcomes are not used),
+     *  descending the diagram once for all of them. The assignments have numVars+1 bits with the
+     *  first one unused, as for evaluate, or numVars bits where bit k-1 is the variable k.
+     */
     void unionAssignments(const ExplictFunc& assignments);
+    /** Add the cubes to the set of this Func: each one is built by cube(), then all of them and
+     *  this Func are united at once by the n-ary union.
+     */
+    void unionCubes(const std::vector<Cube>& cubes);
 
     uint64_t countNodes(Func func);
 
@@ -110,16 +132,63 @@ class BRAVE_DD::Func {
             (edge.handle == f.edge.handle) &&
             (edge.value.getType());
     }
-    Edge unionAssignmentRecursive(Level num, Edge& root, ExplictFunc assignments);
+    /// The union of the rows order[start, start+size) of the assignments into an edge from level lvl.
+    Edge unionAssignmentRecursive(Level lvl, const Edge& root, const ExplictFunc& assignments, int shift,
+                                  std::vector<size_t>& order, size_t start, size_t size);
+    /// The value of a terminal edge, complemented if needed.
+    Value terminalValue(const Edge& terminal) const;
+    /// The child c of the target node of an edge, with the flags of the edge applied, as evaluate follows it.
+    Edge childEdge(const Edge& source, const char c) const;
+    /// The batched evaluation of sets (aTo is null) and relations.
+    void evaluateBatch(const std::vector<std::vector<uint64_t> >& aFrom, const std::vector<std::vector<uint64_t> >* aTo,
+                       const size_t num, std::vector<Value>& values) const;
 
 
     // ========================================================
     friend class Forest;
+    friend class FrozenFunc;
+    friend class FuncIterator;
+    friend class FuncSampler;
     Forest*     parent;     // parent forest
     Edge        edge;       // edge information
     std::string name;       // Optional, only used for I/O; defaults to empty string
 };
 
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                          Cube class                            *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/**
+ * @brief A cube of a set: each variable is 0, 1 or don't-care (DONT_CARE, as for FuncIterator).
+ *
+ * The variable k is at index k, the first element (index 0) is not used. A string of '0', '1'
+ * and '-' gives the variables 1, 2, ... in order, as the inputs of a PLA line.
+ */
+class BRAVE_DD::Cube {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    static const char DONT_CARE = 2;
+
+    // All the variables are don't-care
+    Cube(Level numVars = 0);
+    // From the cubes of FuncIterator::getCube
+    Cube(const std::vector<char>& values);
+    Cube(const std::string& line);
+
+    inline Level getNumVars() const {return (Level)(literals.size() - 1);}
+    inline char get(Level k) const {return literals[k];}
+    inline void set(Level k, char value) {literals[k] = value;}
+    inline bool isDontCare(Level k) const {return literals[k] == DONT_CARE;}
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    std::vector<char>   literals;
+};
+
 // ******************************************************************
 // *                                                                *
 // *                                                                *
@@ -127,6 +196,14 @@ class BRAVE_DD::Func {
 // *                                                                *
 // *                                                                *
 // ******************************************************************
+/**
+ * @brief Assignments with their outcomes, to be built into a Func.
+ *
+ * The assignments are stored bit-packed, one row of 64-bit words each, so that tens of millions
+ * of them fit in memory. buildFunc partitions an array of row indices by the bit of each level,
+ * from the top; the rows themselves are never copied or moved. Equal assignments end in the same
+ * partition, where the one added last gives the outcome.
+ */
 class BRAVE_DD::ExplictFunc {
     /*-------------------------------------------------------------*/
     public:
@@ -134,11 +211,15 @@ class BRAVE_DD::ExplictFunc {
     ExplictFunc();
     ~ExplictFunc();
 
-    // Add an assignment with its outcome value
+    // Add an assignment with its outcome value; all the assignments have the same number of bits
     void addAssignment(const std::vector<bool>& minterm, const Value& outcome);
+    // Add an assignment packed in words, bit b in word b/64; the number of bits is set by reserve or the first assignment
+    void addAssignment(const uint64_t* packed, const Value& outcome);
+    // Reserve the memory of num assignments of numBits bits
+    void reserve(size_t num, int numBits);
     
-    // Getters for assignments and outcomes
-    const std::vector<std::vector<bool>>& getAssignments() const;
+    // Getters for assignments and outcomes; the assignments are unpacked, a copy of all of them
+    std::vector<std::vector<bool>> getAssignments() const;
     const std::vector<Value>& getOutcomes() const;
     
     // Default value handling
@@ -151,8 +232,8 @@ class BRAVE_DD::ExplictFunc {
     // Get number of bits in assignments
     int getNumBits() const;
     
-    // Get specific assignment and outcome
-    const std::vector<bool>& getAssignment(int idx) const;
+    // Get specific assignment (unpacked) and outcome
+    std::vector<bool> getAssignment(int idx) const;
     const Value& getOutcome(int idx) const;
     
     // Convert assignments to char arrays for radix scan
@@ -167,12 +248,159 @@ class BRAVE_DD::ExplictFunc {
     /*-------------------------------------------------------------*/
     private:
     /*-------------------------------------------------------------*/
-    // helper for recursively building edge, idx+1 is the variable level
-    Edge buildEdge(Forest* forest, Level lvl, size_t start, size_t size);
+    inline bool getBit(size_t row, int bit) const {
+        return (rows[row*numWords + bit/64] >> (bit%64)) & 0x01;
+    }
+    // the two-finger partition of the rows order[start, start+size) by their bit; returns the first row with bit 1
+    size_t partition(std::vector<size_t>& order, size_t start, size_t size, int bit) const;
+    // helper for recursively building edge from the rows order[start, start+size), bit lvl-1 is the variable level
+    Edge buildEdge(Forest* forest, Level lvl, std::vector<size_t>& order, size_t start, size_t size) const;
     
-    std::vector<std::vector<bool>>     assignments;
+    int                                numBits;
+    size_t                             numWords;   // per assignment
+    std::vector<uint64_t>              rows;       // assignment i in [i*numWords, (i+1)*numWords)
     std::vector<Value>                 outcomes;
     Value                              defaultVal;
+    friend class Func;
+};
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                       FrozenFunc class                         *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/**
+ * @brief A read-only copy of a Func for repeated evaluations.
+ *
+ * The nodes reachable from the Func are decoded once into a contiguous array, in topological
+ * order (higher levels first). The complement and swap flags are pushed down to the nodes, so
+ * that an edge keeps only its rule, its target and its value; evaluating follows indices in the
+ * array, without the forest or its node manager. The Func may change or be reclaimed afterwards.
+ */
+class BRAVE_DD::FrozenFunc {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    FrozenFunc(const Func& func);
+    ~FrozenFunc();
+
+    /* Number of decoded nodes; a node may appear once per combination of flags reaching it */
+    inline size_t getNumNodes() const {return arcs.size() / numChild;}
+    inline Level getNumVars() const {return numVars;}
+
+    /** The same value as Func::evaluate for the frozen Func.
+     *  Note: the first element of "assignment" (assignment[0]) is not used!
+     */
+    Value evaluate(const std::vector<bool>& assignment) const;
+    Value evaluate(const std::vector<bool>& aFrom, const std::vector<bool>& aTo) const;
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    struct Arc {
+        uint32_t        target;     // the node index for level > 0, the terminal index otherwise
+        Level           level;      // the level of the target node, 0 for terminals
+        ReductionRule   rule;
+        Value           value;      // the edge value, for EV forests
+    };
+
+    Level               numVars;
+    bool                isRel;
+    char                numChild;
+    EncodeMechanism     encode;
+    ValueType           valType;
+    unsigned long       maxRange;
+    Value               ruleValue[2];   // the values at the terminal 0 and 1 of the rules
+    Arc                 root;
+    std::vector<Arc>    arcs;           // the children of node i at [i*numChild, (i+1)*numChild)
+    std::vector<Value>  terminals;      // the terminal values, complemented if needed
+    std::vector<bool>   isEnd;          // the terminal value is the answer, whatever the edge values
+};
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                      FuncIterator class                        *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/**
+ * @brief Enumerates the assignments of a Func with their values, as cubes or as minterms.
+ *
+ * The diagram is walked depth-first with an explicit stack of one frame per level, so the memory
+ * does not depend on the number of assignments, and the enumeration may stop at any time:
+ *
+ *      FuncIterator it(f);
+ *      while (it.next()) use(it.getCube(), it.getValue());
+ *
+ * Levels skipped by a long edge are don't-cares for rule X, and the few disjoint cubes the rule
+ * covers otherwise (EL, EH, AL, AH, and I for relations). With isMinterm, each cube is expanded
+ * into its minterms, one at a time. Unless isAll, the assignments whose value is 0 (for EV+ and
+ * EV%, a special value such as infinity) are not enumerated.
+ *
+ * The Func is kept by the iterator; the forest must not be changed during the enumeration.
+ */
+class BRAVE_DD::FuncIterator {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    FuncIterator(const Func& func, bool isMinterm = 0, bool isAll = 0);
+    ~FuncIterator();
+
+    /* The values of a level in a cube, besides 0 and 1 */
+    static const char DONT_CARE = 2;    // any value
+    static const char SAME = 3;         // for to-variables: the value of the from-variable
+    static const char DIFF = 4;         // for to-variables: the complement of the from-variable
+
+    /* Move to the next cube or minterm; false when there is none left */
+    bool next();
+
+    /** The current cube or minterm, indexed by level (index 0 is not used); for relations,
+     *  the from-variables, and the to-variables with getCubeTo.
+     */
+    inline const std::vector<char>& getCube() const {return (isMinterm) ? minterm : cube;}
+    inline const std::vector<char>& getCubeTo() const {return (isMinterm) ? mintermTo : cubeTo;}
+    inline const Value& getValue() const {return value;}
+    /* The current minterm as Func::evaluate takes it; don't-cares of cubes are 0 */
+    void getAssignment(std::vector<bool>& assignment) const;
+    void getAssignment(std::vector<bool>& aFrom, std::vector<bool>& aTo) const;
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    struct Frame {
+        Edge            edge;       // with the flags of its source node applied
+        Level           top;        // the edge skips the levels top down to its target level+1
+        Value           value;      // the edge values accumulated down to this edge, for EV forests
+        int             pattern;    // the next pattern of the skipped levels
+        char            child;      // the next child of the target, -1 until a pattern is set
+    };
+
+    int numPatterns(const Frame& frame) const;
+    bool setPattern(const Frame& frame, int p);
+    void setAny(Level top, Level bottom);
+    Value endValue(const Frame& frame) const;
+    bool isSkipped(const Value& val) const;
+    void firstMinterm();
+    bool nextMinterm();
+
+    Func                func;
+    Forest*             forest;
+    Level               numVars;
+    bool                isRel;
+    char                numChild;
+    EncodeMechanism     encode;
+    bool                isMinterm;
+    bool                isAll;
+    Value               ruleValue[2];   // the values at the terminal 0 and 1 of the rules
+    std::vector<Frame>  stack;
+    std::vector<char>   cube;
+    std::vector<char>   cubeTo;
+    std::vector<char>   minterm;
+    std::vector<char>   mintermTo;
+    std::vector<int>    freeLevels;     // the don't-cares of the cube being expanded: 2*level+isTo
+    bool                hasMinterm;
+    Value               value;
 };
 
-#endif
\ No newline at end of file
+#endif
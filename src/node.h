@@ -62,6 +62,8 @@ namespace BRAVE_DD {
  *  For 'Values' of child edges if needed:
  *  Node has 1 (or 2 for LONG and DOUBLE) more slot for value if needed;
  *  Mxnode has 3 (or 6 for LONG and DOUBLE) more slots for values if needed.
+ *  For EV* (edge multiply), every child edge keeps its own weight:
+ *  Node has 2 (or 4 for DOUBLE) more slots; Mxnode has 4 (or 8 for DOUBLE) more slots.
  * 
  *  The construction can depend on the forest setting to further compress?
  * 
@@ -365,24 +367,27 @@ class BRAVE_DD::Node {
         }
     }
 
+    /* Set the edge value of the given child, with the value type known at compile time */
+    inline void setEdgeValue(char child, const int ev) {
+        uint32_t temp = static_cast<uint32_t>(ev);
+        info[info.size()-1] = child ? temp : (temp | 1UL << 31);
+    }
+    inline void setEdgeValue(char child, const long ev) {
+        uint64_t temp = static_cast<uint64_t>(ev);
+        info[info.size()-2] = child ? static_cast<uint32_t>(temp >> 32) : (static_cast<uint32_t>(temp >> 32) | 1UL << 31);
+        info[info.size()-1] = static_cast<uint32_t>(temp);
+    }
+
     inline void setEdgeValue(char child, Value& value) {
-        // TODO: simplify this code do we wanna introduce template or union?
         if (value.getType() == INT) {
-            int ev;
-            value.getValueTo(&ev, INT);
-            uint32_t temp = static_cast<uint32_t>(ev);
-            info[info.size()-1] = child ? temp : (temp | 1UL << 31);
+            setEdgeValue(child, value.getValueAs<int>());
         } else if (value.getType() == FLOAT) {
             float ev;
             value.getValueTo(&ev, FLOAT);
             uint32_t temp = static_cast<uint32_t>(ev);
             info[info.size()-1] = child ? temp : (temp | 1UL << 31);
         } else if (value.getType() == LONG) {
-            long ev;
-            value.getValueTo(&ev, LONG);
-            uint64_t temp = static_cast<uint64_t>(ev);
-            info[info.size()-2] = child ? static_cast<uint32_t>(temp >> 32) : (static_cast<uint32_t>(temp >> 32) | 1UL << 31);
-            info[info.size()-1] = static_cast<uint32_t>(temp);
+            setEdgeValue(child, value.getValueAs<long>());
         } else if (value.getType() == DOUBLE) {
             double ev;
             value.getValueTo(&ev, DOUBLE);
@@ -393,7 +398,54 @@ class BRAVE_DD::Node {
             // Maybe for VOID? TBD
         }
     }
-    
+
+    /**
+     * Get the weight of a child edge for EV* nodes. Unlike EV+ nodes, every child edge
+     * has its own weight slot(s) at the end of info, with the raw bits of the FLOAT/DOUBLE.
+     * The given "value" must be initialized with the value type of the forest.
+     *
+     * @param child the index of the child edge: 0 ... 3
+     * @param value Output: the weight
+     * @param isMxd if this node is a Mxnode
+     */
+    inline void edgeMultValue(char child, Value& value, bool isMxd) const {
+        int numChild = isMxd ? 4 : 2;
+        ValueType vt = value.getType();
+        if (vt == FLOAT) {
+            float w;
+            uint32_t bits = info[info.size() - numChild + child];
+            memcpy(&w, &bits, sizeof(float));
+            value = Value(w);
+        } else if (vt == DOUBLE) {
+            double w;
+            uint64_t bits = (static_cast<uint64_t>(info[info.size() - 2*(numChild - child)]) << 32)
+                            | info[info.size() - 2*(numChild - child) + 1];
+            memcpy(&w, &bits, sizeof(double));
+            value = Value(w);
+        }
+    }
+
+    inline void setEdgeMultValue(char child, const Value& value, bool isMxd) {
+        int numChild = isMxd ? 4 : 2;
+        if (value.getType() == FLOAT) {
+            float w;
+            uint32_t bits;
+            value.getValueTo(&w, FLOAT);
+            memcpy(&bits, &w, sizeof(float));
+            info[info.size() - numChild + child] = bits;
+        } else if (value.getType() == DOUBLE) {
+            double w;
+            uint64_t bits;
+            value.getValueTo(&w, DOUBLE);
+            memcpy(&bits, &w, sizeof(double));
+            info[info.size() - 2*(numChild - child)] = static_cast<uint32_t>(bits >> 32);
+            info[info.size() - 2*(numChild - child) + 1] = static_cast<uint32_t>(bits);
+        } else {
+            // INT or LONG weights are not closed under normalization: the forest rejects them
+            throw error(ErrCode::TYPE_MISMATCH, __FILE__, __LINE__);
+        }
+    }
+
     /**
      * Hash this node
      * 
@@ -429,6 +481,8 @@ class BRAVE_DD::Node {
     /*-------------------------------------------------------------*/
     /// ============================================================
     friend class Forest;
+    friend class BddxMaker;
+    friend class ParserBin;
     std::vector<uint32_t>   info;         // Next pointer, edge rules, edge flags, node handles, and levels
 };
 
@@ -14,6 +14,8 @@ namespace BRAVE_DD {
     /* Binary */
     typedef BinaryOperation* (*BinaryBuiltin1)(Forest* arg1, Forest* arg2, Forest* res);
     typedef BinaryOperation* (*BinaryBuiltin2)(Forest* arg1, OpndType arg2, Forest* res);
+    /* Ternary */
+    typedef TernaryOperation* (*TernaryBuiltin)(Forest* arg1, Forest* arg2, Forest* arg3, Forest* res);
     /* Saturation */
     typedef SaturationOperation* (*SaturationBuiltin)(Forest* arg1, Forest* arg2, Forest* res);
 
@@ -35,6 +37,26 @@ namespace BRAVE_DD {
         UnaryOperation* uop = ub(arg.getForest(), OpndType::REAL);
         uop->compute(arg, res);
     }
+    inline void apply(UnaryBuiltin2 ub, const Func& arg, unsigned long& res)
+    {
+        UnaryOperation* uop = ub(arg.getForest(), OpndType::INTEGER);
+        uop->compute(arg, res);
+    }
+    inline void apply(UnaryBuiltin2 ub, const Func& arg, UInt128& res)
+    {
+        UnaryOperation* uop = ub(arg.getForest(), OpndType::HUGEINT);
+        uop->compute(arg, res);
+    }
+    inline void apply(UnaryBuiltin2 ub, const Func& arg, BigCount& res)
+    {
+        UnaryOperation* uop = ub(arg.getForest(), OpndType::HUGEINT);
+        uop->compute(arg, res);
+    }
+    inline void apply(UnaryBuiltin2 ub, const Func& arg, LogCount& res)
+    {
+        UnaryOperation* uop = ub(arg.getForest(), OpndType::REAL);
+        uop->compute(arg, res);
+    }
     // for concretizing with don't care value
     inline void apply(UnaryBuiltin1 ub, const Func& arg0, const Func& arg1, Func& res)
     {
@@ -46,6 +68,12 @@ namespace BRAVE_DD {
         UnaryOperation* uop = ub(arg.getForest(), res.getForest());
         uop->compute(arg, val, res);
     }
+    // for quantifying the variables at the given levels
+    inline void apply(UnaryBuiltin1 ub, const Func& arg, const std::vector<uint16_t>& vars, Func& res)
+    {
+        UnaryOperation* uop = ub(arg.getForest(), res.getForest());
+        uop->compute(arg, vars, res);
+    }
     // ******************************************************************
     // *                         Binary  apply                          *
     // ******************************************************************
@@ -59,6 +87,54 @@ namespace BRAVE_DD {
         BinaryOperation* bop = bb(arg1.getForest(), OpndType::EXPLICIT_FUNC, res.getForest());
         bop->compute(arg1, arg2, res);
     }
+    // image with a visited set: res gets the new states, and visited is updated
+    inline void apply(BinaryBuiltin1 bb, const Func& arg1, const Func& arg2, Func& visited, Func& res)
+    {
+        BinaryOperation* bop = bb(arg1.getForest(), arg2.getForest(), res.getForest());
+        bop->compute(arg1, arg2, visited, res);
+    }
+    // also count the new states, see CountTraits for the count types
+    template <typename N>
+    inline void apply(BinaryBuiltin1 bb, const Func& arg1, const Func& arg2, Func& visited, Func& res, N& num)
+    {
+        apply(bb, arg1, arg2, visited, res);
+        apply(CARDINALITY, res, num);
+    }
+    // relational product: the variables at the given levels are quantified
+    inline void apply(BinaryBuiltin1 bb, const Func& arg1, const Func& arg2, const std::vector<uint16_t>& vars, Func& res)
+    {
+        BinaryOperation* bop = bb(arg1.getForest(), arg2.getForest(), res.getForest());
+        bop->compute(arg1, arg2, vars, res);
+    }
+    // n-ary: Union, Intersection, Minimum or Maximum of all the arguments at once
+    inline void apply(BinaryBuiltin1 bb, const std::vector<Func>& args, Func& res)
+    {
+        Forest* arg = (args.empty()) ? res.getForest() : args[0].getForest();
+        BinaryOperation* bop = bb(arg, arg, res.getForest());
+        bop->compute(args, res);
+    }
+    // batch: res[i] gets the operation on args1[i] and args2[i], in the forest of res[0] (or args1[0])
+    inline void apply(BinaryBuiltin1 bb, const std::vector<Func>& args1, const std::vector<Func>& args2, std::vector<Func>& res)
+    {
+        if (args1.size() != args2.size()) {
+            throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+        }
+        if (args1.empty()) {
+            res.clear();
+            return;
+        }
+        Forest* resForest = (res.empty()) ? args1[0].getForest() : res[0].getForest();
+        BinaryOperation* bop = bb(args1[0].getForest(), args2[0].getForest(), resForest);
+        bop->compute(args1, args2, res);
+    }
+    // ******************************************************************
+    // *                        Ternary  apply                          *
+    // ******************************************************************
+    inline void apply(TernaryBuiltin tb, const Func& arg1, const Func& arg2, const Func& arg3, Func& res)
+    {
+        TernaryOperation* top = tb(arg1.getForest(), arg2.getForest(), arg3.getForest(), res.getForest());
+        top->compute(arg1, arg2, arg3, res);
+    }
     // ******************************************************************
     // *                     Saturation  apply                          *
     // ******************************************************************
@@ -3,6 +3,15 @@
 // #define BRAVE_DD_CACHE_TRACE
 
 using namespace BRAVE_DD;
+
+namespace {
+    /// Flag the pool index of the edge if it is a pooled terminal
+    inline void markPooledEdge(const Edge& edge, std::vector<bool>& used)
+    {
+        EdgeHandle handle = edge.getEdgeHandle();
+        if (isTerminalPooled(handle) && (unpackTarget(handle) < used.size())) used[unpackTarget(handle)] = 1;
+    }
+} // end of anonymous namespace
 // ******************************************************************
 // *                                                                *
 // *                                                                *
@@ -150,6 +159,28 @@ bool ComputeTable::check(const uint16_t lvl, const Edge& a, const Edge& b, bool&
     return 0;
 }
 
+bool ComputeTable::check(const uint16_t lvl, const Edge& a, const Edge& b, const Edge& c, Edge& ans)
+{
+    countCalls++;
+    CacheEntry entry(lvl, a, b, c);
+    uint64_t id = entry.hash() % size;
+    /* probing the entries*/
+    for (size_t s=0; s<probingSteps; s++) {
+        size_t probId = (id + s) % size;
+        if (table[probId].isInUse) {
+            /* Valid entry, then check if match */
+            if ((table[probId].lvl == lvl) && (table[probId].key.size() == 3)
+                && (table[probId].key[0] == a) && (table[probId].key[1] == b) && (table[probId].key[2] == c)) {
+                countHits++;
+                ans = table[probId].res;
+                return 1;
+            }
+        }
+    }
+    /* Not cached */
+    return 0;
+}
+
 bool ComputeTable::check(const uint16_t lvl, const Edge& a, const Edge& b, const Edge& c, const Edge& d, Edge& ans)
 {
     countCalls++;
@@ -389,6 +420,25 @@ void ComputeTable::add(const uint16_t lvl, const Edge& a, const Edge& b, const b
         }
     }
 }
+void ComputeTable::add(const uint16_t lvl, const Edge& a, const Edge& b, const Edge& c, const Edge& ans)
+{
+    CacheEntry entry(lvl, a, b, c);
+    entry.setResult(ans);
+    uint64_t id = entry.hash() % size;
+    for (size_t s=0; s<probingSteps; s++) {
+        size_t probId = (id + s) % size;
+        if (!table[probId].isInUse) {
+            numEntries++;
+            table[probId] = entry;
+            break;
+        } else if (s == probingSteps - 1) {
+            countOverwrite++;
+            table[probId] = entry;
+        } else {
+            continue;
+        }
+    }
+}
 void ComputeTable::add(const uint16_t lvl, const Edge& a, const Edge& b, const Edge& c, const Edge& d, const Edge& ans)
 {
     CacheEntry entry(lvl, a, b, c, d);
@@ -449,7 +499,7 @@ void ComputeTable::add(const uint16_t lvl, const Edge& a, const Edge& b, const E
 
 void ComputeTable::sweep(Forest* forest, int role)
 {
-    // role: 0 for ans, 1 for key0, 2 for key1
+    // role: 0 for ans, 1 for key0, 2 for key1, 3 for key2
     uint16_t lvl = 0;
     NodeHandle target = 0;
     for (size_t i=0; i<table.size(); i++) {
@@ -463,6 +513,10 @@ void ComputeTable::sweep(Forest* forest, int role)
             } else if (role == 2) {
                 lvl = table[i].key[1].getNodeLevel();
                 target = table[i].key[1].getNodeHandle();
+            } else if (role == 3) {
+                if (table[i].key.size() < 3) continue;
+                lvl = table[i].key[2].getNodeLevel();
+                target = table[i].key[2].getNodeHandle();
             } else {
                 std::cout << "[BRAVE_DD] ERROR!\t ComputeTable::sweep(): Unknown role value!" << std::endl;
                 exit(0);
@@ -480,6 +534,38 @@ void ComputeTable::sweep(Forest* forest, int role)
     }
 }
 
+void ComputeTable::sweep(Forest* forest, const std::vector<int>& roles)
+{
+    for (size_t i=0; i<table.size(); i++) {
+        if (!table[i].isInUse) continue;
+        for (size_t r=0; r<roles.size(); r++) {
+            const Edge* target = nullptr;
+            if (roles[r] == 0) {
+                target = &table[i].res;
+            } else if ((roles[r] > 0) && ((size_t)roles[r] <= table[i].key.size())) {
+                target = &table[i].key[roles[r]-1];
+            } else {
+                continue;
+            }
+            // drop the entry once one of its nodes is not marked
+            if ((target->getNodeLevel() > 0) && !forest->getNode(target->getNodeLevel(), target->getNodeHandle()).isMarked()) {
+                table[i].isInUse = 0;
+                numEntries--;
+                break;
+            }
+        }
+    }
+}
+
+void ComputeTable::markPooled(std::vector<bool>& used) const
+{
+    for (size_t i=0; i<table.size(); i++) {
+        if (!table[i].isInUse) continue;
+        markPooledEdge(table[i].res, used);
+        for (size_t k=0; k<table[i].key.size(); k++) markPooledEdge(table[i].key[k], used);
+    }
+}
+
 void ComputeTable::reportStat(std::ostream& out, int format) const
 {
     if (format == 0) {
@@ -524,4 +610,36 @@ void ComputeTable::enlarge(uint64_t newSize)
     }
     // probingSteps = newSize;
     table = std::move(newTable);
-}
\ No newline at end of file
+}
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                   ConversionCache methods                      *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+
+void ConversionCache::sweep(Forest* forest, bool isSource)
+{
+    for (size_t k=0; k<known.size(); k++) {
+        for (size_t slot=0; slot<known[k].size(); slot++) {
+            if (!known[k][slot]) continue;
+            Level lvl = (isSource) ? (Level)(k+1) : edges[k][slot].getNodeLevel();
+            NodeHandle target = (isSource) ? (NodeHandle)(slot / 2) : edges[k][slot].getNodeHandle();
+            if ((lvl > 0) && !forest->getNode(lvl, target).isMarked()) {
+                known[k][slot] = 0;
+                edges[k][slot] = Edge();
+                numEntries--;
+            }
+        }
+    }
+}
+
+void ConversionCache::markPooled(std::vector<bool>& used) const
+{
+    for (size_t k=0; k<known.size(); k++) {
+        for (size_t slot=0; slot<known[k].size(); slot++) {
+            if (known[k][slot]) markPooledEdge(edges[k][slot], used);
+        }
+    }
+}
@@ -8,6 +8,7 @@
 namespace BRAVE_DD {
     class CacheEntry;
     class ComputeTable;
+    class ConversionCache;
 };
 
 // ******************************************************************
@@ -39,6 +40,14 @@ class BRAVE_DD::CacheEntry {
         key[1] = b;
         isInUse = 0;
     }
+    CacheEntry(const Level level, const Edge& a, const Edge& b, const Edge& c) {
+        lvl = level;
+        key = std::vector<Edge>(3);
+        key[0] = a;
+        key[1] = b;
+        key[2] = c;
+        isInUse = 0;
+    }
     CacheEntry(const Level level, const Edge& a, const Edge& b, const Edge& c, const Edge& d) {
         lvl = level;
         key = std::vector<Edge>(4);
@@ -137,6 +146,7 @@ class BRAVE_DD::ComputeTable {
     bool check(const Level lvl, const Edge& a, const Edge& b, Edge& ans);
     bool check(const Level lvl, const Edge& a, const Edge& b, char& ans);
     bool check(const Level lvl, const Edge& a, const Edge& b, bool& ans);
+    bool check(const Level lvl, const Edge& a, const Edge& b, const Edge& c, Edge& ans);
     bool check(const Level lvl, const Edge& a, const Edge& b, const Edge& c, const Edge& d, Edge& ans);
     bool check(const Level lvl, const Edge& a, const Edge& b, const Edge& c, const Edge& d, char& ans);
     bool check(const Level lvl, const Edge& a, const Edge& b, const Edge& c, const Edge& d, bool& ans);
@@ -146,12 +156,17 @@ class BRAVE_DD::ComputeTable {
     void add(const Level lvl, const Edge& a, const Edge& b, const Edge& ans);
     void add(const Level lvl, const Edge& a, const Edge& b, const char& ans);
     void add(const Level lvl, const Edge& a, const Edge& b, const bool& ans);
+    void add(const Level lvl, const Edge& a, const Edge& b, const Edge& c, const Edge& ans);
     void add(const Level lvl, const Edge& a, const Edge& b, const Edge& c, const Edge& d, const Edge& ans);
     void add(const Level lvl, const Edge& a, const Edge& b, const Edge& c, const Edge& d, const char& ans);
     void add(const Level lvl, const Edge& a, const Edge& b, const Edge& c, const Edge& d, const bool& ans);
 
-    // role: 0 for ans; 1 for key0; 2 for key1
+    // role: 0 for ans; 1 for key0; 2 for key1; 3 for key2
     void sweep(Forest* forest, int role);
+    // several roles in one pass over the table
+    void sweep(Forest* forest, const std::vector<int>& roles);
+    /// Flag the pooled terminals of the entries in use, see TerminalPool::sweep
+    void markPooled(std::vector<bool>& used) const;
 
     void reportStat(std::ostream& out, int format=0) const;
 
@@ -167,6 +182,7 @@ class BRAVE_DD::ComputeTable {
 
     friend class UnaryOperation;
     friend class BinaryOperation;
+    friend class TernaryOperation;
     friend class SaturationOperation;
 
     std::vector<CacheEntry>     table;
@@ -180,4 +196,65 @@ class BRAVE_DD::ComputeTable {
 
 };
 
-#endif
\ No newline at end of file
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                    ConversionCache class                       *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/**
+ * Nodes converted from one forest to another: for each source node, reached with
+ * or without the complement bit, the edge of the target forest for its function
+ * (rule X from the level of the node). Unlike the lossy ComputeTable, entries are
+ * never overwritten, so converting a function that shares nodes with one converted
+ * before only converts the new nodes. They are removed by sweep() when the source
+ * or the converted nodes are reclaimed.
+ */
+class BRAVE_DD::ConversionCache {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    ConversionCache():numEntries(0) {}
+    inline bool check(const Level lvl, const NodeHandle node, const bool comp, Edge& ans) const {
+        size_t slot = 2 * (size_t)node + comp;
+        if ((lvl > known.size()) || (slot >= known[lvl-1].size()) || !known[lvl-1][slot]) return 0;
+        ans = edges[lvl-1][slot];
+        return 1;
+    }
+    inline void add(const Level lvl, const NodeHandle node, const bool comp, const Edge& ans) {
+        size_t slot = 2 * (size_t)node + comp;
+        if (lvl > known.size()) {
+            known.resize(lvl);
+            edges.resize(lvl);
+        }
+        if (slot >= known[lvl-1].size()) {
+            // node handles are dense in each level, grow geometrically
+            size_t newSize = (2 * slot > 128) ? 2 * slot : 128;
+            known[lvl-1].resize(newSize, 0);
+            edges[lvl-1].resize(newSize);
+        }
+        if (!known[lvl-1][slot]) numEntries++;
+        known[lvl-1][slot] = 1;
+        edges[lvl-1][slot] = ans;
+    }
+    /// Remove the entries whose source (isSource) or converted node is not marked in the forest
+    void sweep(Forest* forest, bool isSource);
+    /// Flag the pooled terminals of the converted edges, see TerminalPool::sweep
+    void markPooled(std::vector<bool>& used) const;
+    inline void clear() {
+        known.clear();
+        edges.clear();
+        numEntries = 0;
+    }
+    inline size_t size() const {return numEntries;}
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    // indexed by [level-1][2 * node handle + complement bit]
+    std::vector<std::vector<bool> > known;
+    std::vector<std::vector<Edge> > edges;
+    size_t                          numEntries;
+};
+
+#endif
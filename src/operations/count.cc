@@ -0,0 +1,165 @@
+#include "count.h"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace BRAVE_DD;
+
+std::string BRAVE_DD::uint128ToString(UInt128 num)
+{
+    if (num == 0) return "0";
+    std::string digits;
+    while (num != 0) {
+#ifdef __SIZEOF_INT128__
+        digits.push_back((char)('0' + (int)(num % 10)));
+        num /= 10;
+#else
+        digits.push_back((char)('0' + num.divide(10)));
+#endif
+    }
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+}
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                        BigCount methods                        *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+
+BigCount::BigCount(uint64_t num)
+{
+    while (num > 0) {
+        limbs.push_back((uint32_t)num);
+        num >>= 32;
+    }
+}
+
+BigCount BigCount::pow2(unsigned k)
+{
+    BigCount ans;
+    ans.limbs = std::vector<uint32_t>(k/32 + 1, 0);
+    ans.limbs.back() = 0x01u << (k%32);
+    return ans;
+}
+
+BigCount& BigCount::operator+=(const BigCount& num)
+{
+    if (limbs.size() < num.limbs.size()) limbs.resize(num.limbs.size(), 0);
+    uint64_t carry = 0;
+    for (size_t i=0; i<limbs.size(); i++) {
+        uint64_t sum = (uint64_t)limbs[i] + carry + ((i < num.limbs.size()) ? num.limbs[i] : 0);
+        limbs[i] = (uint32_t)sum;
+        carry = sum >> 32;
+        if ((carry == 0) && (i >= num.limbs.size())) break;
+    }
+    if (carry) limbs.push_back((uint32_t)carry);
+    return *this;
+}
+
+BigCount& BigCount::operator-=(const BigCount& num)
+{
+    if (*this < num) {
+        std::cout << "[BRAVE_DD] ERROR!\t BigCount: subtracting a larger number!" << std::endl;
+        exit(0);
+    }
+    int64_t borrow = 0;
+    for (size_t i=0; i<limbs.size(); i++) {
+        int64_t diff = (int64_t)limbs[i] - borrow - ((i < num.limbs.size()) ? (int64_t)num.limbs[i] : 0);
+        borrow = (diff < 0) ? 1 : 0;
+        limbs[i] = (uint32_t)(diff + (borrow << 32));
+        if ((borrow == 0) && (i >= num.limbs.size())) break;
+    }
+    trim();
+    return *this;
+}
+
+BigCount& BigCount::operator<<=(unsigned k)
+{
+    if (isZero() || (k == 0)) return *this;
+    unsigned words = k/32, bits = k%32;
+    std::vector<uint32_t> shifted(limbs.size() + words + 1, 0);
+    for (size_t i=0; i<limbs.size(); i++) {
+        uint64_t v = (uint64_t)limbs[i] << bits;
+        shifted[i+words] |= (uint32_t)v;
+        shifted[i+words+1] |= (uint32_t)(v >> 32);
+    }
+    limbs.swap(shifted);
+    trim();
+    return *this;
+}
+
+bool BigCount::operator<(const BigCount& num) const
+{
+    if (limbs.size() != num.limbs.size()) return limbs.size() < num.limbs.size();
+    for (size_t i=limbs.size(); i>0; i--) {
+        if (limbs[i-1] != num.limbs[i-1]) return limbs[i-1] < num.limbs[i-1];
+    }
+    return 0;
+}
+
+unsigned BigCount::numBits() const
+{
+    if (isZero()) return 0;
+    unsigned bits = 32 * (unsigned)(limbs.size() - 1);
+    for (uint32_t top = limbs.back(); top > 0; top >>= 1) bits++;
+    return bits;
+}
+
+double BigCount::toDouble() const
+{
+    double ans = 0.0;
+    for (size_t i=limbs.size(); i>0; i--) {
+        ans = ans * 4294967296.0 + (double)limbs[i-1];
+    }
+    return ans;
+}
+
+std::string BigCount::toString() const
+{
+    if (isZero()) return "0";
+    // repeatedly divide by 10^9, collecting base 10^9 digits
+    std::vector<uint32_t> rest = limbs;
+    std::vector<uint32_t> chunks;
+    while (!rest.empty()) {
+        uint64_t rem = 0;
+        for (size_t i=rest.size(); i>0; i--) {
+            uint64_t cur = (rem << 32) | rest[i-1];
+            rest[i-1] = (uint32_t)(cur / 1000000000u);
+            rem = cur % 1000000000u;
+        }
+        chunks.push_back((uint32_t)rem);
+        while (!rest.empty() && (rest.back() == 0)) rest.pop_back();
+    }
+    std::string ans = std::to_string(chunks.back());
+    char buffer[16];
+    for (size_t i=chunks.size()-1; i>0; i--) {
+        snprintf(buffer, sizeof(buffer), "%09u", chunks[i-1]);
+        ans += buffer;
+    }
+    return ans;
+}
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                        LogCount methods                        *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+
+std::string LogCount::toString() const
+{
+    if (isZero()) return "0";
+    double exp10 = std::floor(getLog10());
+    double mantissa = std::pow(10.0, getLog10() - exp10);
+    if (mantissa >= 10.0) {
+        mantissa /= 10.0;
+        exp10 += 1.0;
+    }
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.6fe+%.0f", mantissa, exp10);
+    return std::string(buffer);
+}
@@ -0,0 +1,466 @@
+#ifndef BRAVE_DD_COUNT_H
+#define BRAVE_DD_COUNT_H
+
+#include "../defines.h"
+#include "../edge.h"
+#include "../hash_stream.h"
+
+#include <cmath>
+#include <type_traits>
+#include <unordered_map>
+
+namespace BRAVE_DD {
+#ifdef __SIZEOF_INT128__
+    /// Unsigned 128-bit count, exact modulo 2^128
+    typedef unsigned __int128 UInt128;
+#else
+    class UInt128;
+#endif
+    class BigCount;
+    class LogCount;
+    template <typename N> struct CountTraits;
+    template <typename N> class CountCache;
+    template <typename N> class NodeCounts;
+    class CountStore;
+    /// Decimal string of a 128-bit count
+    std::string uint128ToString(UInt128 num);
+};
+
+#ifndef __SIZEOF_INT128__
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                        UInt128 class                           *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/**
+ * Unsigned 128-bit count, exact modulo 2^128, in two 64-bit limbs for the compilers
+ * without unsigned __int128: only the operations used by CountTraits and
+ * uint128ToString.
+ */
+class BRAVE_DD::UInt128 {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    UInt128(uint64_t num = 0):lo(num), hi(0) {}
+
+    inline UInt128 operator+(const UInt128& num) const {
+        UInt128 ans;
+        ans.lo = lo + num.lo;
+        ans.hi = hi + num.hi + (ans.lo < lo);
+        return ans;
+    }
+    inline UInt128 operator-(const UInt128& num) const {
+        UInt128 ans;
+        ans.lo = lo - num.lo;
+        ans.hi = hi - num.hi - (lo < num.lo);
+        return ans;
+    }
+    inline UInt128 operator<<(unsigned k) const {
+        UInt128 ans;
+        if (k >= 128) return ans;
+        if (k >= 64) {
+            ans.hi = lo << (k - 64);
+        } else if (k > 0) {
+            ans.hi = (hi << k) | (lo >> (64 - k));
+            ans.lo = lo << k;
+        } else {
+            ans = *this;
+        }
+        return ans;
+    }
+    inline bool operator==(const UInt128& num) const {return (lo == num.lo) && (hi == num.hi);}
+    inline bool operator!=(const UInt128& num) const {return !(*this == num);}
+    /// Divide by a 32-bit divisor, and return the remainder
+    inline uint32_t divide(uint32_t divisor) {
+        uint64_t rest = 0;
+        uint32_t parts[4] = {(uint32_t)(hi >> 32), (uint32_t)hi, (uint32_t)(lo >> 32), (uint32_t)lo};
+        for (int i=0; i<4; i++) {
+            uint64_t cur = (rest << 32) | parts[i];
+            parts[i] = (uint32_t)(cur / divisor);
+            rest = cur % divisor;
+        }
+        hi = ((uint64_t)parts[0] << 32) | parts[1];
+        lo = ((uint64_t)parts[2] << 32) | parts[3];
+        return (uint32_t)rest;
+    }
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    uint64_t    lo;
+    uint64_t    hi;
+};
+#endif
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                        BigCount class                          *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/**
+ * Arbitrary precision non-negative integer, with the operations needed for
+ * counting: add, subtract a smaller number, and multiply by a power of 2.
+ */
+class BRAVE_DD::BigCount {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    BigCount() {}
+    BigCount(uint64_t num);
+    /// 2^k
+    static BigCount pow2(unsigned k);
+
+    BigCount& operator+=(const BigCount& num);
+    /// Subtract a number not greater than this one
+    BigCount& operator-=(const BigCount& num);
+    /// Multiply by 2^k
+    BigCount& operator<<=(unsigned k);
+    inline bool operator==(const BigCount& num) const {return limbs == num.limbs;}
+    inline bool operator!=(const BigCount& num) const {return limbs != num.limbs;}
+    bool operator<(const BigCount& num) const;
+    inline bool isZero() const {return limbs.empty();}
+
+    /// Number of bits, 0 for zero
+    unsigned numBits() const;
+    double toDouble() const;
+    std::string toString() const;
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    inline void trim() {
+        while (!limbs.empty() && (limbs.back() == 0)) limbs.pop_back();
+    }
+    std::vector<uint32_t>   limbs;      // base 2^32, least significant first, no leading zero
+};
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                        LogCount class                          *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/**
+ * Estimate of a count, stored as its base-2 logarithm: the range has no practical
+ * limit, and the relative error is about the double precision.
+ */
+class BRAVE_DD::LogCount {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    LogCount():log2Num(-INFINITY) {}
+    LogCount(double num):log2Num((num > 0.0) ? std::log2(num) : -INFINITY) {}
+    /// 2^k
+    static inline LogCount pow2(unsigned k) {
+        LogCount ans;
+        ans.log2Num = (double)k;
+        return ans;
+    }
+
+    inline LogCount& operator+=(const LogCount& num) {
+        if (num.isZero()) return *this;
+        if (isZero()) return *this = num;
+        double hi = (log2Num > num.log2Num) ? log2Num : num.log2Num;
+        double lo = (log2Num > num.log2Num) ? num.log2Num : log2Num;
+        log2Num = hi + std::log2(1.0 + std::exp2(lo - hi));
+        return *this;
+    }
+    /// Subtract a number not greater than this one
+    inline LogCount& operator-=(const LogCount& num) {
+        if (num.isZero()) return *this;
+        if (num.log2Num >= log2Num) {
+            log2Num = -INFINITY;
+        } else {
+            log2Num += std::log2(1.0 - std::exp2(num.log2Num - log2Num));
+        }
+        return *this;
+    }
+    /// Multiply by 2^k
+    inline LogCount& operator<<=(unsigned k) {
+        if (!isZero()) log2Num += (double)k;
+        return *this;
+    }
+    inline bool isZero() const {return std::isinf(log2Num) && (log2Num < 0);}
+
+    inline double getLog2() const {return log2Num;}
+    inline double getLog10() const {return log2Num * std::log10(2.0);}
+    /// The count as a double, infinity if it is beyond the double range
+    inline double toDouble() const {return std::exp2(log2Num);}
+    /// Scientific notation "m.mmmmmme+x" of the count, whatever the exponent
+    std::string toString() const;
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    double  log2Num;    // log2 of the count, -inf for zero
+};
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                       CountTraits struct                       *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+namespace BRAVE_DD {
+    /// The type in which the fixed-width count N is computed: unsigned, so that wrapping is defined
+    template <typename N, bool = std::is_integral<N>::value>
+    struct CountBits {typedef N type;};
+    template <typename N>
+    struct CountBits<N, true> {typedef typename std::make_unsigned<N>::type type;};
+};
+/**
+ * Arithmetic of a count type N used by the cardinality operation:
+ *  zero(), pow2(k), add(a, b), sub(a, b) with b <= a, and shl(a, k) = a * 2^k.
+ * The fixed-width integers are exact modulo 2^width, computed unsigned.
+ */
+template <typename N>
+struct BRAVE_DD::CountTraits {
+    typedef typename CountBits<N>::type U;
+    static inline N zero() {return N(0);}
+    static inline N pow2(unsigned k) {return (k < 8*sizeof(N)) ? (N)(U(1) << k) : N(0);}
+    static inline N add(const N& a, const N& b) {return (N)(U(a) + U(b));}
+    static inline N sub(const N& a, const N& b) {return (N)(U(a) - U(b));}
+    static inline N shl(const N& a, unsigned k) {return (k < 8*sizeof(N)) ? (N)(U(a) << k) : N(0);}
+};
+namespace BRAVE_DD {
+    template <>
+    struct CountTraits<double> {
+        static inline double zero() {return 0.0;}
+        static inline double pow2(unsigned k) {return std::ldexp(1.0, (int)k);}
+        static inline double add(const double& a, const double& b) {return a + b;}
+        static inline double sub(const double& a, const double& b) {return a - b;}
+        static inline double shl(const double& a, unsigned k) {return std::ldexp(a, (int)k);}
+    };
+    template <>
+    struct CountTraits<BigCount> {
+        static inline BigCount zero() {return BigCount();}
+        static inline BigCount pow2(unsigned k) {return BigCount::pow2(k);}
+        static inline BigCount add(const BigCount& a, const BigCount& b) {BigCount ans = a; ans += b; return ans;}
+        static inline BigCount sub(const BigCount& a, const BigCount& b) {BigCount ans = a; ans -= b; return ans;}
+        static inline BigCount shl(const BigCount& a, unsigned k) {BigCount ans = a; ans <<= k; return ans;}
+    };
+    template <>
+    struct CountTraits<LogCount> {
+        static inline LogCount zero() {return LogCount();}
+        static inline LogCount pow2(unsigned k) {return LogCount::pow2(k);}
+        static inline LogCount add(const LogCount& a, const LogCount& b) {LogCount ans = a; ans += b; return ans;}
+        static inline LogCount sub(const LogCount& a, const LogCount& b) {LogCount ans = a; ans -= b; return ans;}
+        static inline LogCount shl(const LogCount& a, unsigned k) {LogCount ans = a; ans <<= k; return ans;}
+    };
+    static inline std::ostream& operator<<(std::ostream& out, const BigCount& num) {return out << num.toString();}
+    static inline std::ostream& operator<<(std::ostream& out, const LogCount& num) {return out << num.toString();}
+};
+namespace BRAVE_DD {
+    /**
+     * Count of an edge with the given rule skipping the levels lvl down to nodeLevel+1, from
+     * the count num of its target over the levels up to nodeLevel. bitsPerLevel is 1 for sets
+     * and 2 for relations.
+     */
+    template <typename N>
+    inline N countLongEdge(const N& num, const Level lvl, const Level nodeLevel, const ReductionRule rule, const unsigned bitsPerLevel) {
+        typedef CountTraits<N> CT;
+        unsigned skip = lvl - nodeLevel;
+        if (skip == 0) return num;
+        if (rule == RULE_X) {
+            // every assignment of the skipped levels reaches the target
+            return CT::shl(num, bitsPerLevel*skip);
+        } else if (isRuleEL(rule) || isRuleEH(rule)) {
+            // one assignment reaches the target, the others the rule terminal
+            return hasRuleTerminalOne(rule) ? CT::add(num, CT::sub(CT::pow2(lvl), CT::pow2(nodeLevel))) : num;
+        } else if (isRuleAL(rule) || isRuleAH(rule)) {
+            // all but one assignment reach the target, the last one the rule terminal
+            N ans = CT::sub(CT::shl(num, skip), num);
+            return hasRuleTerminalOne(rule) ? CT::add(ans, CT::pow2(nodeLevel)) : ans;
+        } else if (isRuleI(rule)) {
+            // the identity assignments reach the target, the others the rule terminal
+            N ans = CT::shl(num, skip);
+            if (hasRuleTerminalOne(rule)) {
+                ans = CT::add(ans, CT::shl(CT::sub(CT::pow2(2*skip), CT::pow2(skip)), 2*nodeLevel));
+            }
+            return ans;
+        }
+        return num;
+    }
+};
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                        CountCache class                        *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/**
+ * Counts of nodes, keyed by the edge to the node with rule X, for one count type.
+ * Unlike the lossy ComputeTable, entries are never overwritten, so every node is
+ * counted once in a cardinality call.
+ */
+template <typename N>
+class BRAVE_DD::CountCache {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    CountCache() {}
+    inline bool check(const Edge& node, N& ans) const {
+        typename std::unordered_map<Edge, N, EdgeHash>::const_iterator it = table.find(node);
+        if (it == table.end()) return 0;
+        ans = it->second;
+        return 1;
+    }
+    inline void add(const Edge& node, const N& num) {table[node] = num;}
+    inline void clear() {table.clear();}
+    inline size_t size() const {return table.size();}
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    struct EdgeHash {
+        inline size_t operator()(const Edge& e) const {
+            hash_stream hs;
+            hs.start();
+            hs.push((unsigned)(e.getEdgeHandle() >> 32));
+            hs.push((unsigned)e.getEdgeHandle());
+            int ev = 0;
+            e.getValue().getValueTo(&ev, INT);
+            hs.push(ev);
+            return (size_t)hs.finish64();
+        }
+    };
+    std::unordered_map<Edge, N, EdgeHash>   table;
+};
+
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                        NodeCounts class                        *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/**
+ * Persistent counts of nodes, keyed by (level, handle, complement), for one count
+ * type. The count of a node is that of the node itself, with rule X and without
+ * swap flags, over the levels up to its own; the complemented node is counted on
+ * its own, as subtracting would cancel in floating point types. Entries survive
+ * across cardinality calls, so counting a function that shares nodes with
+ * one counted before only visits the new nodes; they are removed by sweep()
+ * when the nodes are reclaimed.
+ */
+template <typename N>
+class BRAVE_DD::NodeCounts {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    NodeCounts():numEntries(0) {}
+    inline bool check(const Level lvl, const NodeHandle node, const bool comp, N& ans) const {
+        size_t id = 2 * (size_t)node + comp;
+        if ((lvl > known.size()) || (id >= known[lvl-1].size()) || !known[lvl-1][id]) return 0;
+        ans = counts[lvl-1][id];
+        return 1;
+    }
+    inline void add(const Level lvl, const NodeHandle node, const bool comp, const N& num) {
+        size_t id = 2 * (size_t)node + comp;
+        if (lvl > known.size()) {
+            known.resize(lvl);
+            counts.resize(lvl);
+        }
+        if (id >= known[lvl-1].size()) {
+            // node handles are dense in each level, grow geometrically
+            size_t newSize = (2 * id > 64) ? 2 * id : 64;
+            known[lvl-1].resize(newSize, 0);
+            counts[lvl-1].resize(newSize);
+        }
+        if (!known[lvl-1][id]) numEntries++;
+        known[lvl-1][id] = 1;
+        counts[lvl-1][id] = num;
+    }
+    /// Remove the counts of the nodes for which isKept(level, handle) is false
+    template <typename F>
+    inline void sweep(const F& isKept) {
+        for (size_t k=0; k<known.size(); k++) {
+            for (size_t id=0; id<known[k].size(); id++) {
+                if (known[k][id] && !isKept((Level)(k+1), (NodeHandle)(id/2))) {
+                    known[k][id] = 0;
+                    counts[k][id] = N();
+                    numEntries--;
+                }
+            }
+        }
+    }
+    inline void clear() {
+        known.clear();
+        counts.clear();
+        numEntries = 0;
+    }
+    inline size_t size() const {return numEntries;}
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    // indexed by [level-1][2 * node handle + complement]
+    std::vector<std::vector<bool> > known;
+    std::vector<std::vector<N> >    counts;
+    size_t                          numEntries;
+};
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                        CountStore class                        *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/**
+ * Persistent node counts kept by a cardinality operation, one NodeCounts for
+ * each count type.
+ */
+class BRAVE_DD::CountStore {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    CountStore() {}
+    template <typename N>
+    NodeCounts<N>& get();
+    /// Remove the counts of the nodes for which isKept(level, handle) is false
+    template <typename F>
+    inline void sweep(const F& isKept) {
+        longCounts.sweep(isKept);
+        ulongCounts.sweep(isKept);
+        doubleCounts.sweep(isKept);
+        wideCounts.sweep(isKept);
+        bigCounts.sweep(isKept);
+        logCounts.sweep(isKept);
+    }
+    inline void clear() {
+        longCounts.clear();
+        ulongCounts.clear();
+        doubleCounts.clear();
+        wideCounts.clear();
+        bigCounts.clear();
+        logCounts.clear();
+    }
+    inline size_t size() const {
+        return longCounts.size() + ulongCounts.size() + doubleCounts.size()
+                + wideCounts.size() + bigCounts.size() + logCounts.size();
+    }
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    NodeCounts<long>            longCounts;
+    NodeCounts<unsigned long>   ulongCounts;
+    NodeCounts<double>          doubleCounts;
+    NodeCounts<UInt128>         wideCounts;
+    NodeCounts<BigCount>        bigCounts;
+    NodeCounts<LogCount>        logCounts;
+};
+namespace BRAVE_DD {
+    template <> inline NodeCounts<long>& CountStore::get<long>() {return longCounts;}
+    template <> inline NodeCounts<unsigned long>& CountStore::get<unsigned long>() {return ulongCounts;}
+    template <> inline NodeCounts<double>& CountStore::get<double>() {return doubleCounts;}
+    template <> inline NodeCounts<UInt128>& CountStore::get<UInt128>() {return wideCounts;}
+    template <> inline NodeCounts<BigCount>& CountStore::get<BigCount>() {return bigCounts;}
+    template <> inline NodeCounts<LogCount>& CountStore::get<LogCount>() {return logCounts;}
+};
+
+#endif
@@ -48,6 +48,58 @@ thread_local int Trace::depth = 0;
 // static float thresholdsSweep = 0.66f;
 static float thresholdsEnlarge = 0.33f;
 
+using namespace BRAVE_DD;
+
+/* The function in the given forest: itself when it is there already, otherwise its copy by
+ * UOP_COPY, which keeps the functions it copied */
+static Func convertFunc(const Func& source, Forest* forest)
+{
+    if (source.getForest() == forest) return source;
+    UnaryOperation* cp = UOPs.find(UnaryOperationType::UOP_COPY, source.getForest(), forest);
+    if (!cp) {
+        cp = UOPs.add(new UnaryOperation(UnaryOperationType::UOP_COPY, source.getForest(), forest));
+    }
+    Func ans(forest);
+    cp->compute(source, ans);
+    return ans;
+}
+
+/* The element-wise operations that computeElmtWiseMult has terminal cases for, in EV* forests */
+static inline bool hasMultKernel(const BinaryOperationType opType)
+{
+    return (opType == BinaryOperationType::BOP_PLUS) || (opType == BinaryOperationType::BOP_MULTIPLY)
+            || (opType == BinaryOperationType::BOP_MINIMUM) || (opType == BinaryOperationType::BOP_MAXIMUM);
+}
+
+/* The cube of the variables at the given levels (both unprimed and primed for relations), which
+ * is the cache key of the quantified variables. A level is quantified when the cube depends on it,
+ * and the rest of the cube is the child of all ones */
+static Func buildCube(Forest* forest, const std::vector<uint16_t>& vars)
+{
+    Level numVars = forest->getSetting().getNumVars();
+    BinaryOperation* bop = BOPs.find(BinaryOperationType::BOP_INTERSECTION, forest, forest, forest);
+    if (!bop) {
+        bop = BOPs.add(new BinaryOperation(BinaryOperationType::BOP_INTERSECTION, forest, forest, forest));
+    }
+    Func cube(forest);
+    cube.trueFunc();
+    for (uint16_t k : vars) {
+        if ((k == 0) || (k > numVars)) {
+            throw error(ErrCode::INVALID_LEVEL, __FILE__, __LINE__);
+        }
+        Func x(forest);
+        if (forest->getSetting().isRelation()) {
+            x.variable(k, false);
+            bop->compute(cube, x, cube);
+            x.variable(k, true);
+        } else {
+            x.variable(k);
+        }
+        bop->compute(cube, x, cube);
+    }
+    return cube;
+}
+
 using namespace BRAVE_DD;
 // ******************************************************************
 // *                                                                *
@@ -120,12 +172,23 @@ void UnaryOperation::compute(const Func& source, Func& target)
     }
     Level numVars = sourceForest->getSetting().getNumVars();
     Edge ans;
-    // copy to target forest
-    ans = computeCOPY(numVars, source.getEdge());
     if (opType == UnaryOperationType::UOP_COPY) {
+        if ((sourceForest != targetForest)
+            && (sourceForest->getSetting().getEncodeMechanism() == TERMINAL)
+            && (targetForest->getSetting().getEncodeMechanism() == TERMINAL)
+            && (sourceForest->getSetting().isRelation() == targetForest->getSetting().isRelation())) {
+            // only the nodes not converted before
+            convertNodes(source.getEdge());
+            ans = convertEdge(numVars, source.getEdge());
+        } else {
+            ans = computeCOPY(numVars, source.getEdge());
+        }
         target.setEdge(ans);
         return;
-    } else if (opType == UnaryOperationType::UOP_COMPLEMENT) {
+    }
+    // copy to target forest
+    ans = computeCOPY(numVars, source.getEdge());
+    if (opType == UnaryOperationType::UOP_COMPLEMENT) {
         // target forest allows complement flag
         if ((targetForest->getSetting().getCompType() != NO_COMP)
             && (targetForest->getSetting().getEncodeMechanism() == TERMINAL)) {
@@ -148,21 +211,45 @@ void UnaryOperation::compute(const Func& source, Func& target)
 
 void UnaryOperation::compute(const Func& source, long& target)
 {
-    if (!checkForestCompatibility()) {
-        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
-    }
-    Level numVars = sourceForest->getSetting().getNumVars();
-    if (opType == UnaryOperationType::UOP_CARDINALITY) {
-        target = computeCARD(numVars, source.getEdge());
-    }
-    // TBD
+    computeCount(source, target);
+}
+
+void UnaryOperation::compute(const Func& source, unsigned long& target)
+{
+    computeCount(source, target);
 }
 
 void UnaryOperation::compute(const Func& source, double& target)
+{
+    computeCount(source, target);
+}
+
+void UnaryOperation::compute(const Func& source, UInt128& target)
+{
+    computeCount(source, target);
+}
+
+void UnaryOperation::compute(const Func& source, BigCount& target)
+{
+    computeCount(source, target);
+}
+
+void UnaryOperation::compute(const Func& source, LogCount& target)
+{
+    computeCount(source, target);
+}
+
+template <typename N>
+void UnaryOperation::computeCount(const Func& source, N& target)
 {
     if (!checkForestCompatibility()) {
         throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
     }
+    Level numVars = sourceForest->getSetting().getNumVars();
+    if (opType == UnaryOperationType::UOP_CARDINALITY) {
+        CountCache<N> counts;
+        target = computeCARD(numVars, source.getEdge(), counts);
+    }
     // TBD
 }
 
@@ -204,6 +291,20 @@ void UnaryOperation::compute(const Func& source, const Value& val, Func& target)
     target.setEdge(ans);
 }
 
+void UnaryOperation::compute(const Func& source, const std::vector<uint16_t>& vars, Func& target)
+{
+    if (!checkForestCompatibility()
+        || ((opType != UnaryOperationType::UOP_EQUANTIFY) && (opType != UnaryOperationType::UOP_UQUANTIFY))
+        || (targetForest->getSetting().getEncodeMechanism() != TERMINAL)
+        || (sourceForest->getSetting().isRelation() != targetForest->getSetting().isRelation())) {
+        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+    }
+    Level numVars = targetForest->getSetting().getNumVars();
+    Func sourceEqu = convertFunc(source, targetForest);
+    Func cube = buildCube(targetForest, vars);
+    target.setEdge(computeQUANT(numVars, sourceEqu.getEdge(), cube.getEdge()));
+}
+
 bool UnaryOperation::checkForestCompatibility() const
 {
     bool ans = 1;
@@ -274,6 +375,81 @@ Edge UnaryOperation::computeCOPY(const Level lvl, const Edge& source)
     return ans;
 }
 
+void UnaryOperation::convertNodes(const Edge& root)
+{
+    // the nodes reachable from the root and not converted yet, with the complement bit of the
+    // edges reaching them, by level
+    Level top = root.getNodeLevel();
+    std::vector<std::vector<Edge> > fresh(top+1);
+    std::unordered_set<uint64_t> seen;
+    std::vector<Edge> stack;
+    Edge ans;
+    if ((top > 0) && !root.getSwap(0) && !root.getSwap(1)) stack.push_back(root);
+    while (!stack.empty()) {
+        Edge curr = stack.back();
+        stack.pop_back();
+        Level lvl = curr.getNodeLevel();
+        NodeHandle handle = curr.getNodeHandle();
+        if (conversions.check(lvl, handle, curr.getComp(), ans)) continue;
+        if (!seen.insert(((uint64_t)lvl << 33) | ((uint64_t)handle << 1) | curr.getComp()).second) continue;
+        EdgeHandle node = 0;
+        packRule(node, RULE_X);
+        packLevel(node, lvl);
+        packTarget(node, handle);
+        packComp(node, curr.getComp());
+        curr.setEdgeHandle(node);
+        fresh[lvl].push_back(curr);
+        for (char i=0; i<((sourceForest->getSetting().isRelation()) ? 4 : 2); i++) {
+            Edge child = sourceForest->cofact(lvl, curr, i);
+            if ((child.getNodeLevel() > 0) && !child.getSwap(0) && !child.getSwap(1)) stack.push_back(child);
+        }
+    }
+    // from the bottom level, so the children of a node are converted before it
+    std::vector<Edge> childEdges((sourceForest->getSetting().isRelation()) ? 4 : 2);
+    EdgeLabel label = 0;
+    packRule(label, RULE_X);
+    for (Level lvl=1; lvl<=top; lvl++) {
+        for (size_t n=0; n<fresh[lvl].size(); n++) {
+            for (size_t i=0; i<childEdges.size(); i++) {
+                childEdges[i] = convertEdge(lvl-1, sourceForest->cofact(lvl, fresh[lvl][n], (char)i));
+            }
+            conversions.add(lvl, fresh[lvl][n].getNodeHandle(), fresh[lvl][n].getComp(),
+                            targetForest->reduceEdge(lvl, label, lvl, childEdges));
+        }
+    }
+}
+
+Edge UnaryOperation::convertEdge(const Level lvl, const Edge& source)
+{
+    // Terminal case
+    if (source.getNodeLevel() == 0) return computeCOPY(lvl, source);
+    Edge ans;
+    bool isSwap = source.getSwap(0) || source.getSwap(1);
+    Level nodeLvl = source.getNodeLevel();
+    if (!isSwap && (nodeLvl == lvl) && conversions.check(lvl, source.getNodeHandle(), source.getComp(), ans)) {
+        return ans;
+    }
+    // the rule of a long edge, when the target forest has it
+    if (!isSwap && !source.getComp() && (nodeLvl < lvl)
+        && targetForest->getSetting().hasReductionRule(source.getRule())
+        && conversions.check(nodeLvl, source.getNodeHandle(), 0, ans)) {
+        EdgeLabel label = 0;
+        packRule(label, source.getRule());
+        return targetForest->mergeEdge(lvl, nodeLvl, label, ans);
+    }
+    // otherwise one level at a time, as computeCOPY
+    if (caches[0].check(lvl, source, ans)) return ans;
+    std::vector<Edge> childEdges((targetForest->getSetting().isRelation()) ? 4 : 2);
+    for (size_t i=0; i<childEdges.size(); i++) {
+        childEdges[i] = convertEdge(lvl-1, sourceForest->cofact(lvl, source, (char)i));
+    }
+    EdgeLabel label = 0;
+    packRule(label, RULE_X);
+    ans = targetForest->reduceEdge(lvl, label, lvl, childEdges);
+    cacheAdd(0, lvl, source, ans);
+    return ans;
+}
+
 Edge UnaryOperation::computeCOMPLEMENT(const Level lvl, const Edge& source)
 {
     /* Assuming this is within the same target forest
@@ -310,108 +486,65 @@ Edge UnaryOperation::computeCOMPLEMENT(const Level lvl, const Edge& source)
     return ans;
 }
 
-long UnaryOperation::computeCARD(const Level lvl, const Edge& source)
+template <typename N>
+N UnaryOperation::computeCARD(const Level lvl, const Edge& source, CountCache<N>& counts)
 {
-    // base cases:
-    if (lvl == 0) {
-        if (targetForest->getSetting().getEncodeMechanism() == TERMINAL) {
-            if (targetForest->setting.hasNegInf() || targetForest->setting.hasPosInf() || targetForest->setting.hasUnDef()) {
-                if (!isTerminalSpecial(source.getEdgeHandle())) return 1;
-            } else {
-                return source.getComp() ^ isTerminalOne(source.getEdgeHandle());
+    typedef CountTraits<N> CT;
+    const ForestSetting& setting = targetForest->getSetting();
+    // assignments per level: 2 for sets, 4 for relations
+    const unsigned bitsPerLevel = setting.isRelation() ? 2 : 1;
+    bool hasSpecial = setting.hasNegInf() || setting.hasPosInf() || setting.hasUnDef();
+    // base cases: count of the target, over the levels below it
+    N num = CT::zero();
+    Level nodeLevel = source.getNodeLevel();
+    if (nodeLevel == 0) {
+        bool isCounted = 0;
+        if (setting.getEncodeMechanism() == TERMINAL) {
+            if (hasSpecial) {
+                // count path to non-special, whatever the rule
+                return isTerminalSpecial(source.getEdgeHandle()) ? CT::zero() : CT::pow2(bitsPerLevel*lvl);
             }
-            // other value TBD
+            // count path to 1
+            isCounted = source.getComp() ^ isTerminalOne(source.getEdgeHandle());
         } else {
-            if (targetForest->setting.hasNegInf() || targetForest->setting.hasPosInf() || targetForest->setting.hasUnDef()) {
-                if (isTerminalSpecial(SpecialValue::OMEGA, source.getEdgeHandle())) return 1;
-            } else {
-                if (isTerminalSpecial(SpecialValue::OMEGA, source.getEdgeHandle())
-                    && (source.getValue() == Value(1))) { // other value TBD
-                    return 1;
-                }
-            }
+            isCounted = isTerminalSpecial(SpecialValue::OMEGA, source.getEdgeHandle())
+                        && (hasSpecial || (source.getValue() == Value(1)));   // other value TBD
+            return isCounted ? CT::pow2(bitsPerLevel*lvl) : CT::zero();
         }
-    }
-    if (source.getNodeLevel() == 0) {
-        if (targetForest->getSetting().getEncodeMechanism() == TERMINAL) {
-            if (targetForest->setting.hasNegInf() || targetForest->setting.hasPosInf() || targetForest->setting.hasUnDef()) {
-                // count path to non-special
-                if (!isTerminalSpecial(source.getEdgeHandle())) return (targetForest->getSetting().isRelation()) ? (0x01 << (2*lvl)) : (0x01 << lvl);
-                else return 0;
-            } else {
-                // count path to 1
-                if (source.isConstantZero()) {
-                    return 0;
-                } else if (source.isConstantOne()) {
-                    return (targetForest->getSetting().isRelation()) ? (0x01 << (2*lvl)) : (0x01 << lvl);
-                } else if ((source.getRule() == RULE_EL1) || (source.getRule() == RULE_EH1)
-                            || (source.getRule() == RULE_AH0) || (source.getRule() == RULE_AL0)) {
-                    return (0x01 << lvl) - 1;
-                } else if ((source.getRule() == RULE_EL0) || (source.getRule() == RULE_EH0)
-                            || (source.getRule() == RULE_AH1) || (source.getRule() == RULE_AL1)) {
-                    return 1;
-                } else if (source.getRule() == RULE_I0) {
-                    return 0x01 << lvl;
-                } else if (source.getRule() == RULE_I1) {
-                    return (0x01 << (2*lvl)) - (0x01 << lvl);
-                }
+        if (isCounted) num = CT::pow2(0);
+    } else if ((setting.getEncodeMechanism() == TERMINAL) && !hasSpecial) {
+        // the count of the node itself is kept across calls; swapping only
+        // permutes the assignments, so it shares the count
+        NodeCounts<N>& annotations = nodeCounts.get<N>();
+        if (!annotations.check(nodeLevel, source.getNodeHandle(), source.getComp(), num)) {
+            Edge node = source;
+            node.setRule(RULE_X);
+            node.setSwap(0, 0);
+            node.setSwap(0, 1);
+            char numChild = setting.isRelation() ? 4 : 2;
+            for (char i=0; i<numChild; i++) {
+                Edge child = targetForest->cofact(nodeLevel, node, i);
+                num = CT::add(num, computeCARD(nodeLevel-1, child, counts));
             }
-        } else {
-            if (targetForest->setting.hasNegInf() || targetForest->setting.hasPosInf() || targetForest->setting.hasUnDef()) {
-                if (isTerminalSpecial(SpecialValue::OMEGA, source.getEdgeHandle())) return (targetForest->getSetting().isRelation()) ? (0x01 << (2*lvl)) : (0x01 << lvl);
-                else return 0;
-            } else {
-                if (isTerminalSpecial(SpecialValue::OMEGA, source.getEdgeHandle())
-                    && (source.getValue() == Value(1))) {
-                    return (targetForest->getSetting().isRelation()) ? (0x01 << (2*lvl)) : (0x01 << lvl);
-                } else {
-                    return 0;
-                }
+            annotations.add(nodeLevel, source.getNodeHandle(), source.getComp(), num);
+        }
+    } else {
+        // check the result of the target node
+        Edge cacheEdge = source;
+        cacheEdge.setRule(RULE_X);
+        if (!counts.check(cacheEdge, num)) {
+            // compute recursively
+            char numChild = setting.isRelation() ? 4 : 2;
+            for (char i=0; i<numChild; i++) {
+                Edge child = targetForest->cofact(nodeLevel, source, i);
+                num = CT::add(num, computeCARD(nodeLevel-1, child, counts));
             }
+            // save to the cache
+            counts.add(cacheEdge, num);
         }
     }
-    // check the result of the target node
-    Edge cacheEdge = source;
-    cacheEdge.setRule(RULE_X);
-    long num = 0;
-    // protect edge for sweep
-    // ProtectEdge protectSource(targetForest, cacheEdge);
-    if (!caches[0].check(source.getNodeLevel(), cacheEdge, num)) {
-        // compute recursively
-        std::vector<Edge> child;
-        if (targetForest->getSetting().isRelation()) {
-            child = std::vector<Edge>(4);
-        } else {
-            child = std::vector<Edge>(2);
-        }
-        long newNum = 0;
-        for (char i=0; i<(char)child.size(); i++) {
-            child[i] = targetForest->cofact(source.getNodeLevel(), source, i);
-            newNum += computeCARD(source.getNodeLevel()-1, child[i]);
-        }
-        num = newNum;
-        // save to the cache
-        cacheAdd(0, source.getNodeLevel(), cacheEdge, newNum);
-    }
-    // consider the incoming edge rule
-    int multiplier = 1;
-    int adder = 0;
-    if (source.getRule() == RULE_X) {
-        multiplier = (targetForest->getSetting().isRelation()) ? (0x01 << (2*(lvl-source.getNodeLevel()))) : (0x01 << (lvl-source.getNodeLevel()));
-    } else if ((source.getRule() == RULE_EL1) || (source.getRule() == RULE_EH1)) {
-        adder = (0x01 << lvl) - (0x01 << source.getNodeLevel());
-    } else if ((source.getRule() == RULE_AL0) || (source.getRule() == RULE_AH0)) {
-        multiplier = (0x01 << (lvl - source.getNodeLevel())) - 1;
-    } else if ((source.getRule() == RULE_AL1) || (source.getRule() == RULE_AH1)) {
-        multiplier = (0x01 << (lvl - source.getNodeLevel())) - 1;
-        adder = 0x01 << source.getNodeLevel();
-    } else if (source.getRule() == RULE_I0) {
-        multiplier = 0x01 << (lvl - source.getNodeLevel());
-    } else if (source.getRule() == RULE_I1) {
-        multiplier = 0x01 << (lvl - source.getNodeLevel());
-        adder = (0x01 << (2*(lvl-source.getNodeLevel()))) - (0x01 << (lvl-source.getNodeLevel()));
-    }
-    return multiplier * num + adder;
+    // consider the incoming edge rule, skipping d = lvl - nodeLevel levels
+    return countLongEdge(num, lvl, nodeLevel, source.getRule(), bitsPerLevel);
 }
 
 Edge UnaryOperation::computeRST(const Level lvl, const Edge& source, const Edge& dc)
@@ -962,6 +1095,69 @@ Edge UnaryOperation::commonTSM(const Level lvl, const Edge& source1, const Edge&
     return result;
 }
 
+Edge UnaryOperation::computeQUANT(const Level lvl, const Edge& source, const Edge& cube)
+{
+#ifdef BRAVE_DD_OPERATION_TRACE
+    std::cout << "compute " << UOP2String(opType) << ": lvl: " << lvl << "; e: ";
+    source.print(std::cout);
+    std::cout << "; cube: ";
+    cube.print(std::cout);
+    std::cout << std::endl;
+#endif
+    Edge e = targetForest->normalizeEdge(lvl, source);
+    Edge c = targetForest->normalizeEdge(lvl, cube);
+    // nothing left to quantify, or a constant
+    if (c.isConstantOne() || e.isConstantOne() || e.isConstantZero()) return e;
+    bool isRel = targetForest->getSetting().isRelation();
+    Level m = MAX(e.getNodeLevel(), c.getNodeLevel());
+    if (m < lvl) {
+        // the skipped levels are not quantified, and redundant (or identity) in the source;
+        // otherwise, the rule of the source edge is taken apart one level at a time
+        if ((c.getRule() == RULE_X) && ((e.getRule() == RULE_X) || (isRel && (e.getRule() == RULE_I0)))) {
+            Edge ans = computeQUANT(m, e, c);
+            EdgeLabel incoming = 0;
+            packRule(incoming, e.getRule());
+            return targetForest->mergeEdge(lvl, m, incoming, ans);
+        }
+        m = lvl;
+    }
+    // assertion: m == lvl > 0
+    Edge eCache = e;
+    Edge cCache = c;
+    if (e.getNodeLevel() == m) eCache.setRule(RULE_X);
+    if (c.getNodeLevel() == m) cCache.setRule(RULE_X);
+    Edge ans;
+    if (caches[0].check(m, eCache, cCache, ans)) return ans;
+    std::vector<Edge> child((isRel) ? 4 : 2);
+    // the cube depends on the level when it is quantified (zero in the low child)
+    Edge cRest = targetForest->cofact(m, c, (char)(child.size()-1));
+    bool isQuant = (targetForest->cofact(m, c, 0) != cRest);
+    if (isQuant) {
+        // disjunction (conjunction) of the children, until it is one (zero)
+        bool isExist = (opType == UnaryOperationType::UOP_EQUANTIFY);
+        BinaryOperationType bopType = (isExist) ? BinaryOperationType::BOP_UNION : BinaryOperationType::BOP_INTERSECTION;
+        BinaryOperation* bop = BOPs.find(bopType, targetForest, targetForest, targetForest);
+        if (!bop) {
+            bop = BOPs.add(new BinaryOperation(bopType, targetForest, targetForest, targetForest));
+        }
+        Edge merged = computeQUANT(m-1, targetForest->cofact(m, e, 0), cRest);
+        for (size_t i=1; i<child.size(); i++) {
+            if ((isExist) ? merged.isConstantOne() : merged.isConstantZero()) break;
+            merged = bop->computeElmtWise(m-1, merged, computeQUANT(m-1, targetForest->cofact(m, e, (char)i), cRest));
+        }
+        for (size_t i=0; i<child.size(); i++) child[i] = merged;
+    } else {
+        for (size_t i=0; i<child.size(); i++) {
+            child[i] = computeQUANT(m-1, targetForest->cofact(m, e, (char)i), cRest);
+        }
+    }
+    EdgeLabel root = 0;
+    packRule(root, RULE_X);
+    ans = targetForest->reduceEdge(m, root, m, child);
+    cacheAdd(0, m, eCache, cCache, ans);
+    return ans;
+}
+
 // ******************************************************************
 // *                                                                *
 // *                       UnaryList  methods                       *
@@ -972,78 +1168,11 @@ UnaryList::UnaryList(const std::string n)
     reset(n);
 }
 
-UnaryOperation* UnaryList::mtfUnary(const UnaryOperationType opT, const Forest* sourceF, const Forest* targetF)
-{
-    UnaryOperation* prev = front;
-    UnaryOperation* curr = front->next;
-    while (curr) {
-        if ((curr->opType == opT) && (curr->sourceForest == sourceF) && (curr->targetForest == targetF)) {
-            // Move to front
-            prev->next = curr->next;
-            curr->next = front;
-            front = curr;
-            return curr;
-        }
-        prev = curr;
-        curr = curr->next;
-    }
-    return nullptr;
-}
-
-UnaryOperation* UnaryList::mtfUnary(const UnaryOperationType opT, const Forest* sourceF, const OpndType targetT)
-{
-    UnaryOperation* prev = front;
-    UnaryOperation* curr = front->next;
-    while (curr) {
-        if ((curr->opType == opT) && (curr->sourceForest == sourceF) && (curr->targetType == targetT)) {
-            // Move to front
-            prev->next = curr->next;
-            curr->next = front;
-            front = curr;
-            return curr;
-        }
-        prev = curr;
-        curr = curr->next;
-    }
-    return nullptr;
-}
-
-void UnaryList::searchRemove(UnaryOperation* uop)
-{
-    if (!front || !uop) return;
-    UnaryOperation* prev = front;
-    UnaryOperation* curr = front->next;
-    while (curr) {
-        if (curr == uop) {
-            prev->next = curr->next;
-            delete curr;
-            return;
-        }
-        prev = curr;
-        curr = curr->next;
-    }
-}
-
 void UnaryList::searchRemove(Forest* forest)
 {
-    if (!front || !forest) return;
-    // check front first
-    while (front && ((front->sourceForest == forest) || (front->targetForest == forest))) {
-        UnaryOperation* toRemove = front;
-        front = front->next;
-        delete toRemove;
-    }
-    // check the remaining
-    UnaryOperation* curr = front;
-    while (curr && curr->next) {
-        if ((curr->next->sourceForest == forest) || (curr->next->targetForest == forest)) {
-            UnaryOperation* toRemove = curr->next;
-            curr->next = curr->next->next;
-            delete toRemove;
-        } else {
-            curr = curr->next;
-        }
-    }
+    if (!forest) return;
+    std::vector<UnaryOperation*> ops = index.withForest(forest);
+    for (size_t i=0; i<ops.size(); i++) remove(ops[i]);
 }
 
 void UnaryList::searchSweepCache(Forest* forest)
@@ -1058,6 +1187,7 @@ void UnaryList::searchSweepCache(Forest* forest)
             // if opType is COPY, check if it's source or target forest
             if (curr->opType == UnaryOperationType::UOP_COPY) {
                 curr->caches[0].sweep(forest, (isSource) ? 1 : 0);
+                curr->conversions.sweep(forest, isSource);
             } else if (curr->opType == UnaryOperationType::UOP_COMPLEMENT) {
                 if (isTarget) {
                     curr->caches[0].sweep(forest, 0);
@@ -1065,6 +1195,10 @@ void UnaryList::searchSweepCache(Forest* forest)
                 }
             } else if (curr->opType == UnaryOperationType::UOP_CARDINALITY) {
                 curr->caches[0].sweep(forest, 1);
+                // drop the counts of the nodes to be reclaimed
+                curr->nodeCounts.sweep([forest](Level lvl, NodeHandle node) {
+                    return forest->getNode(lvl, node).isMarked();
+                });
             } else if (curr->opType == UnaryOperationType::UOP_CONCRETIZE_RST) {
                 curr->caches[0].sweep(forest, 0);
                 curr->caches[0].sweep(forest, 1);
@@ -1074,6 +1208,12 @@ void UnaryList::searchSweepCache(Forest* forest)
             } else if (curr->opType == UnaryOperationType::UOP_CONCRETIZE_TSM) {
                 curr->caches[0].sweep(forest, 0);
                 curr->caches[0].sweep(forest, 1);
+            } else if ((curr->opType == UnaryOperationType::UOP_EQUANTIFY)
+                        || (curr->opType == UnaryOperationType::UOP_UQUANTIFY)) {
+                // the sources are copied to the target forest, so are the cache entries
+                if (isTarget) {
+                    curr->caches[0].sweep(forest, std::vector<int>{0, 1, 2});
+                }
             } else {
                 // other operations, TBD
                 std::cout << "other operation not implemented" << std::endl;
@@ -1087,6 +1227,14 @@ void UnaryList::searchSweepCache(Forest* forest)
     }
 }
 
+void UnaryList::markPooled(std::vector<bool>& used) const
+{
+    for (UnaryOperation* curr = front; curr; curr = curr->next) {
+        for (size_t i=0; i<curr->caches.size(); i++) curr->caches[i].markPooled(used);
+        curr->conversions.markPooled(used);
+    }
+}
+
 void UnaryList::reportCacheStat(std::ostream& out, int format) const
 {
     UnaryOperation* curr = front;
@@ -1179,38 +1327,53 @@ void BinaryOperation::compute(const Func& source1, const Func& source2, Func& re
     Func source1Equ;
     Func source2Equ;
     Level numVars = resForest->getSetting().getNumVars();
-    // Unary operation to copy from source1 forest to target forest
-    UnaryOperation* cp1 = UOPs.find(UnaryOperationType::UOP_COPY, source1.getForest(), res.getForest());
-    if (!cp1) {
-        cp1 = UOPs.add(new UnaryOperation(UnaryOperationType::UOP_COPY, source1.getForest(), res.getForest()));
-    }
     // copy sources to the same target forest, if they are both set-of-states or relation
     if (source1Forest->getSetting().isRelation() == source2Forest->getSetting().isRelation()) {
-        source1Equ = Func(res.getForest());
-        cp1->compute(source1, source1Equ);
-        source2Equ = Func(res.getForest());
-        UnaryOperation* cp2 = UOPs.find(UnaryOperationType::UOP_COPY, source2.getForest(), res.getForest());
-        if (!cp2) {
-            cp2 = UOPs.add(new UnaryOperation(UnaryOperationType::UOP_COPY, source2.getForest(), res.getForest()));
-        }
-        cp2->compute(source2, source2Equ);
+        source1Equ = convertFunc(source1, res.getForest());
+        source2Equ = convertFunc(source2, res.getForest());
+    }
+    // Xor and Xnor are only for 0/1 functions with terminal encoding
+    if (((opType == BinaryOperationType::BOP_XOR) || (opType == BinaryOperationType::BOP_XNOR))
+        && (resForest->getSetting().getEncodeMechanism() != TERMINAL)) {
+        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
     }
     // compute the result
-    if ((opType == BinaryOperationType::BOP_UNION)
+    if ((opType == BinaryOperationType::BOP_XNOR) && resForest->getSetting().isRelation()) {
+        // merging the skipped levels of relations assumes zero off the diagonal of identity
+        // edges, which does not hold for Xnor; complement the Xor instead
+        BinaryOperation* bop = BOPs.find(BinaryOperationType::BOP_XOR, resForest, resForest, resForest);
+        if (!bop) {
+            bop = BOPs.add(new BinaryOperation(BinaryOperationType::BOP_XOR, resForest, resForest, resForest));
+        }
+        Func ansEqu(resForest, bop->computeElmtWise(numVars, source1Equ.getEdge(), source2Equ.getEdge()));
+        UnaryOperation* comp = UOPs.find(UnaryOperationType::UOP_COMPLEMENT, resForest, resForest);
+        if (!comp) {
+            comp = UOPs.add(new UnaryOperation(UnaryOperationType::UOP_COMPLEMENT, resForest, resForest));
+        }
+        comp->compute(ansEqu, res);
+        return;
+    } else if ((opType == BinaryOperationType::BOP_UNION)
         || (opType == BinaryOperationType::BOP_INTERSECTION)
+        || (opType == BinaryOperationType::BOP_XOR)
+        || (opType == BinaryOperationType::BOP_XNOR)
         || (opType == BinaryOperationType::BOP_MINIMUM)
         || (opType == BinaryOperationType::BOP_MAXIMUM)
-        || (opType == BinaryOperationType::BOP_PLUS)) { // more operations
+        || (opType == BinaryOperationType::BOP_PLUS)
+        || (opType == BinaryOperationType::BOP_MULTIPLY)) { // more operations
         // Separate for efficiency? TBD
-        ans = computeElmtWise(numVars, source1Equ.getEdge(), source2Equ.getEdge());
+        if (resForest->getSetting().getEncodeMechanism() == EDGE_MULT) {
+            if (!hasMultKernel(opType)) throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+            ans = computeElmtWiseMult(numVars, source1Equ.getEdge(), source2Equ.getEdge());
+        } else {
+            ans = computeElmtWise(numVars, source1Equ.getEdge(), source2Equ.getEdge());
+        }
     } else if (opType == BinaryOperationType::BOP_PREIMAGE) {
         if (source1Forest->getSetting().getRangeType() == BOOLEAN) {
             ans = computeImage(numVars, source1.getEdge(), source2.getEdge(), 1);
         } else {
             ans = computeImageDistance(numVars, source1.getEdge(), source2.getEdge(), 1);
         }
-        Func ansEqu(source1.getForest(), ans);
-        cp1->compute(ansEqu, res);
+        res.setEdge(convertFunc(Func(source1.getForest(), ans), res.getForest()).getEdge());
         return;
     } else if (opType == BinaryOperationType::BOP_POSTIMAGE) {
         if (source1Forest->getSetting().getRangeType() == BOOLEAN) {
@@ -1218,8 +1381,7 @@ void BinaryOperation::compute(const Func& source1, const Func& source2, Func& re
         } else {
             ans = computeImageDistance(numVars, source1.getEdge(), source2.getEdge(), 0);
         }
-        Func ansEqu(source1.getForest(), ans);
-        cp1->compute(ansEqu, res);
+        res.setEdge(convertFunc(Func(source1.getForest(), ans), res.getForest()).getEdge());
         return;
     } else if (opType == BinaryOperationType::BOP_DIFFERENCE) {
         // temporary implementation
@@ -1239,6 +1401,169 @@ void BinaryOperation::compute(const Func& source1, const Func& source2, Func& re
     // caches[0].reportStat(std::cout);
 }
 
+void BinaryOperation::compute(const Func& source1, const Func& source2, Func& visited, Func& res)
+{
+    if (!checkForestCompatibility()) {
+        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+    }
+    const ForestSetting& setting = source1Forest->getSetting();
+    if (((opType != BinaryOperationType::BOP_PREIMAGE_NEW) && (opType != BinaryOperationType::BOP_POSTIMAGE_NEW))
+        || (setting.getEncodeMechanism() != TERMINAL) || (setting.getRangeType() != BOOLEAN)
+        || (visited.getForest() != source1Forest)) {
+        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+    }
+    Edge newStates = computeImageNew(setting.getNumVars(), source1.getEdge(), source2.getEdge(), visited.getEdge(),
+                                    opType == BinaryOperationType::BOP_PREIMAGE_NEW);
+    // the new states are disjoint from the visited set, one union adds them
+    BinaryOperation* un = BOPs.find(BinaryOperationType::BOP_UNION, source1Forest, source1Forest, source1Forest);
+    if (!un) {
+        un = BOPs.add(new BinaryOperation(BinaryOperationType::BOP_UNION, source1Forest, source1Forest, source1Forest));
+    }
+    visited.setEdge(un->computeElmtWise(setting.getNumVars(), visited.getEdge(), newStates));
+    res.setEdge(convertFunc(Func(source1Forest, newStates), res.getForest()).getEdge());
+}
+
+void BinaryOperation::compute(const Func& source1, const Func& source2, const std::vector<uint16_t>& vars, Func& res)
+{
+    if (!checkForestCompatibility() || (opType != BinaryOperationType::BOP_ANDEXISTS)
+        || (resForest->getSetting().getEncodeMechanism() != TERMINAL)
+        || (source1Forest->getSetting().isRelation() != resForest->getSetting().isRelation())
+        || (source2Forest->getSetting().isRelation() != resForest->getSetting().isRelation())) {
+        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+    }
+    // copy sources to the result forest
+    Func source1Equ = convertFunc(source1, resForest);
+    Func source2Equ = convertFunc(source2, resForest);
+    Func cube = buildCube(resForest, vars);
+    res.setEdge(computeAndExists(resForest->getSetting().getNumVars(), source1Equ.getEdge(), source2Equ.getEdge(), cube.getEdge()));
+}
+
+void BinaryOperation::compute(const std::vector<Func>& sources, Func& res)
+{
+    if (!checkForestCompatibility()
+        || ((opType != BinaryOperationType::BOP_UNION) && (opType != BinaryOperationType::BOP_INTERSECTION)
+            && (opType != BinaryOperationType::BOP_MINIMUM) && (opType != BinaryOperationType::BOP_MAXIMUM))) {
+        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+    }
+    // the empty union and intersection are the constants
+    if (sources.empty()) {
+        if (opType == BinaryOperationType::BOP_UNION) {
+            res.falseFunc();
+        } else if (opType == BinaryOperationType::BOP_INTERSECTION) {
+            res.trueFunc();
+        } else {
+            throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+        }
+        return;
+    }
+    Level numVars = resForest->getSetting().getNumVars();
+    // copy sources to the result forest
+    std::vector<Edge> edges(sources.size());
+    for (size_t i=0; i<sources.size(); i++) {
+        if (sources[i].getForest()->getSetting().isRelation() != resForest->getSetting().isRelation()) {
+            throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+        }
+        edges[i] = convertFunc(sources[i], resForest).getEdge();
+    }
+    if ((resForest->getSetting().getEncodeMechanism() == EDGE_MULT) && !hasMultKernel(opType)) {
+        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+    }
+    if (resForest->getSetting().getEncodeMechanism() != TERMINAL) {
+        // balanced tree of the binary operation
+        while (edges.size() > 1) {
+            std::vector<Edge> halves((edges.size()+1)/2);
+            for (size_t i=0; i+1<edges.size(); i+=2) {
+                halves[i/2] = (resForest->getSetting().getEncodeMechanism() == EDGE_MULT)
+                              ? computeElmtWiseMult(numVars, edges[i], edges[i+1])
+                              : computeElmtWise(numVars, edges[i], edges[i+1]);
+            }
+            if (edges.size() % 2) halves.back() = edges.back();
+            edges.swap(halves);
+        }
+        res.setEdge(edges[0]);
+        return;
+    }
+    naryCache.resize(numVars+1);
+    Edge ans = computeNary(numVars, edges);
+    for (size_t k=0; k<naryCache.size(); k++) naryCache[k].clear();
+    res.setEdge(ans);
+}
+
+void BinaryOperation::compute(const std::vector<Func>& sources1, const std::vector<Func>& sources2, std::vector<Func>& res)
+{
+    if (!checkForestCompatibility() || (sources1.size() != sources2.size())) {
+        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+    }
+    // the generators of the commutative operations order the forests, see UNION
+    bool isOrdered = (opType == BinaryOperationType::BOP_UNION)
+                    || (opType == BinaryOperationType::BOP_INTERSECTION)
+                    || (opType == BinaryOperationType::BOP_XOR)
+                    || (opType == BinaryOperationType::BOP_XNOR)
+                    || (opType == BinaryOperationType::BOP_ANDEXISTS);
+    if (isOrdered && !sources1.empty() && (source1Forest != source2Forest)
+        && (sources1[0].getForest() == source2Forest) && (sources2[0].getForest() == source1Forest)) {
+        compute(sources2, sources1, res);
+        return;
+    }
+    // every pair is in the forests of this operation
+    for (size_t i=0; i<sources1.size(); i++) {
+        if ((sources1[i].getForest() != source1Forest) || (sources2[i].getForest() != source2Forest)) {
+            throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+        }
+    }
+    res.assign(sources1.size(), Func(resForest));
+    bool isImage = (opType == BinaryOperationType::BOP_PREIMAGE) || (opType == BinaryOperationType::BOP_POSTIMAGE);
+    bool isElmtWise = ((opType == BinaryOperationType::BOP_UNION)
+                        || (opType == BinaryOperationType::BOP_INTERSECTION)
+                        || (opType == BinaryOperationType::BOP_MINIMUM)
+                        || (opType == BinaryOperationType::BOP_MAXIMUM)
+                        || (opType == BinaryOperationType::BOP_PLUS)
+                        || (opType == BinaryOperationType::BOP_MULTIPLY))
+                    && (source1Forest->getSetting().isRelation() == source2Forest->getSetting().isRelation());
+    if (!isImage && !isElmtWise) {
+        for (size_t i=0; i<sources1.size(); i++) compute(sources1[i], sources2[i], res[i]);
+        return;
+    }
+    if (isElmtWise && (resForest->getSetting().getEncodeMechanism() == EDGE_MULT) && !hasMultKernel(opType)) {
+        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+    }
+    // the edges of different forests are not comparable
+    bool isCommutative = (opType != BinaryOperationType::BOP_PREIMAGE) && (opType != BinaryOperationType::BOP_POSTIMAGE)
+                        && (source1Forest == source2Forest);
+    Level numVars = resForest->getSetting().getNumVars();
+    // index in res of the first occurrence of each pair
+    std::unordered_map<std::vector<Edge>, size_t, EdgesHash> done;
+    std::vector<Edge> key(2);
+    for (size_t i=0; i<sources1.size(); i++) {
+        key[0] = sources1[i].getEdge();
+        key[1] = sources2[i].getEdge();
+        if (isCommutative && (key[0].getEdgeHandle() > key[1].getEdgeHandle())) SWAP(key[0], key[1]);
+        std::unordered_map<std::vector<Edge>, size_t, EdgesHash>::const_iterator it = done.find(key);
+        if (it != done.end()) {
+            res[i] = res[it->second];
+            continue;
+        }
+        done[key] = i;
+        if (isImage) {
+            bool isPre = (opType == BinaryOperationType::BOP_PREIMAGE);
+            Edge ans = (source1Forest->getSetting().getRangeType() == BOOLEAN)
+                        ? computeImage(numVars, sources1[i].getEdge(), sources2[i].getEdge(), isPre)
+                        : computeImageDistance(numVars, sources1[i].getEdge(), sources2[i].getEdge(), isPre);
+            // the images are in the source forest
+            res[i] = convertFunc(Func(source1Forest, ans), resForest);
+            continue;
+        }
+        // the sources in the result forest, as for a single pair
+        Func source1Equ = convertFunc(sources1[i], resForest);
+        Func source2Equ = convertFunc(sources2[i], resForest);
+        if (resForest->getSetting().getEncodeMechanism() == EDGE_MULT) {
+            res[i].setEdge(computeElmtWiseMult(numVars, source1Equ.getEdge(), source2Equ.getEdge()));
+        } else {
+            res[i].setEdge(computeElmtWise(numVars, source1Equ.getEdge(), source2Equ.getEdge()));
+        }
+    }
+}
+
 void BinaryOperation::compute(const Func& source1, const ExplictFunc& source2, Func& res)
 {
     // convert ExplictFunc to Func in source2Forest
@@ -1287,19 +1612,13 @@ Edge BinaryOperation::computeElmtWise(const Level lvl, const Edge& source1, cons
     #endif
         if (e1.isComplementTo(e2)) {
             if (opType == BinaryOperationType::BOP_UNION) {
-                EdgeHandle constant = makeTerminal(INT, 1);
-                if (resForest->getSetting().getValType() == FLOAT) {
-                    constant = makeTerminal(FLOAT, 1.0f);
-                }
+                EdgeHandle constant = resForest->makeBoolTerminal(1);
                 packRule(constant, RULE_X);
                 ans.setEdgeHandle(constant);
                 ans = resForest->normalizeEdge(lvl, ans);
                 return ans;
             } else {
-                EdgeHandle constant = makeTerminal(INT, 0);
-                if (resForest->getSetting().getValType() == FLOAT) {
-                    constant = makeTerminal(FLOAT, 0.0f);
-                }
+                EdgeHandle constant = resForest->makeBoolTerminal(0);
                 packRule(constant, RULE_X);
                 ans.setEdgeHandle(constant);
                 ans = resForest->normalizeEdge(lvl, ans);
@@ -1312,10 +1631,7 @@ Edge BinaryOperation::computeElmtWise(const Level lvl, const Edge& source1, cons
     #endif
         if (e1.isConstantOne() || e2.isConstantOne()) {
             if (opType == BinaryOperationType::BOP_UNION) {
-                EdgeHandle constant = makeTerminal(INT, 1);
-                if (resForest->getSetting().getValType() == FLOAT) {
-                    constant = makeTerminal(FLOAT, 1.0f);
-                }
+                EdgeHandle constant = resForest->makeBoolTerminal(1);
                 packRule(constant, RULE_X);
                 ans.setEdgeHandle(constant);
                 ans = resForest->normalizeEdge(lvl, ans);
@@ -1334,10 +1650,7 @@ Edge BinaryOperation::computeElmtWise(const Level lvl, const Edge& source1, cons
             if (opType == BinaryOperationType::BOP_UNION) {
                 return (e1.isConstantZero()) ? e2 : e1;
             } else if (opType == BinaryOperationType::BOP_INTERSECTION) {
-                EdgeHandle constant = makeTerminal(INT, 0);
-                if (resForest->getSetting().getValType() == FLOAT) {
-                    constant = makeTerminal(FLOAT, 0.0f);
-                }
+                EdgeHandle constant = resForest->makeBoolTerminal(0);
                 packRule(constant, RULE_X);
                 ans.setEdgeHandle(constant);
                 ans = resForest->normalizeEdge(lvl, ans);
@@ -1347,6 +1660,63 @@ Edge BinaryOperation::computeElmtWise(const Level lvl, const Edge& source1, cons
             }
         }
     /* -------------------------------------------------------------------------------------------------
+    * Xor and Xnor operations
+    * ------------------------------------------------------------------------------------------------*/
+    } else if ((opType == BinaryOperationType::BOP_XOR) || (opType == BinaryOperationType::BOP_XNOR)) {
+        bool isXor = (opType == BinaryOperationType::BOP_XOR);
+        bool isComp = (resForest->getSetting().getCompType() != NO_COMP);
+        /* Base case 1: two edges are the same, or complemented */
+    #ifdef BRAVE_DD_OPERATION_TRACE
+        std::cout << "\tchecking base case 1\n";
+    #endif
+        if ((e1 == e2) || e1.isComplementTo(e2)) {
+            EdgeHandle constant = resForest->makeBoolTerminal((e1 == e2) != isXor);
+            packRule(constant, RULE_X);
+            ans.setEdgeHandle(constant);
+            ans = resForest->normalizeEdge(lvl, ans);
+            return ans;
+        }
+        /* Base case 2: one edge is constant; the other one, or its complement when the forest has complement bits */
+    #ifdef BRAVE_DD_OPERATION_TRACE
+        std::cout << "\tchecking base case 2\n";
+    #endif
+        if (e1.isConstantOne() || e1.isConstantZero() || e2.isConstantOne() || e2.isConstantZero()) {
+            bool isConst1 = e1.isConstantOne() || e1.isConstantZero();
+            ans = (isConst1) ? e2 : e1;
+            bool isConstOne = (isConst1) ? e1.isConstantOne() : e2.isConstantOne();
+            if (isConstOne == !isXor) return ans;
+            if (isComp) {
+                ans.complement();
+                if (!resForest->getSetting().hasReductionRule(ans.getRule())) {
+                    ans = resForest->normalizeEdge(lvl, ans);
+                }
+                return ans;
+            }
+        }
+        /* Complement bits: !a ^ b = !(a ^ b), so the regular edges share the cache */
+    #ifdef BRAVE_DD_OPERATION_TRACE
+        std::cout << "\tchecking complement bits\n";
+    #endif
+        if (isComp) {
+            bool isAnsComp = 0;
+            if (e1.getComp() && resForest->getSetting().hasReductionRule(compRule(e1.getRule()))) {
+                e1.complement();
+                isAnsComp = !isAnsComp;
+            }
+            if (e2.getComp() && resForest->getSetting().hasReductionRule(compRule(e2.getRule()))) {
+                e2.complement();
+                isAnsComp = !isAnsComp;
+            }
+            if (isAnsComp) {
+                ans = computeElmtWise(lvl, e1, e2);
+                ans.complement();
+                if (!resForest->getSetting().hasReductionRule(ans.getRule())) {
+                    ans = resForest->normalizeEdge(lvl, ans);
+                }
+                return ans;
+            }
+        }
+    /* -------------------------------------------------------------------------------------------------
     * Minimum and Maximum operations
     * ------------------------------------------------------------------------------------------------*/
     } else if ((opType == BinaryOperationType::BOP_MINIMUM) || (opType == BinaryOperationType::BOP_MAXIMUM)) {
@@ -1468,7 +1838,27 @@ Edge BinaryOperation::computeElmtWise(const Level lvl, const Edge& source1, cons
     * Multiply operations
     * ------------------------------------------------------------------------------------------------*/
     } else if (opType == BinaryOperationType::BOP_MULTIPLY) {
-        //
+        /* Base case 0: one edge is constant*/
+    #ifdef BRAVE_DD_OPERATION_TRACE
+        std::cout << "\tchecking base case 0\n";
+    #endif
+        if (e1.isConstantZero() || e2.isConstantZero()) {
+            return (e1.isConstantZero()) ? e1 : e2;
+        }
+        if (isTerminal(e1.getEdgeHandle()) && isTerminal(e2.getEdgeHandle())
+            && !isTerminalSpecial(e1.getEdgeHandle()) && !isTerminalSpecial(e2.getEdgeHandle())) {
+            // for MT
+            Value tv1 = getTerminalValue(e1.getEdgeHandle());
+            Value tv2 = getTerminalValue(e2.getEdgeHandle());
+            EdgeHandle constant = makeTerminal(tv1 * tv2);
+            packRule(constant, RULE_X);
+            ans.setEdgeHandle(constant);
+            ans = resForest->normalizeEdge(lvl, ans);
+            return ans;
+        }
+        if (e1.isConstantOne() || e2.isConstantOne()) {
+            return (e1.isConstantOne()) ? e2 : e1;
+        }
     } else {
         //
     }
@@ -1482,6 +1872,9 @@ Edge BinaryOperation::computeElmtWise(const Level lvl, const Edge& source1, cons
         SWAP(e1, e2);
         SWAP(m1, m2);
     }
+    // two terminal edges of a relation but not a base case (e.g., Xor of the identity and
+    // constant one without complement bits): go down level by level
+    if ((m1 == 0) && resForest->getSetting().isRelation()) m1 = lvl;
     /* -------------------------------------------------------------------------------------------------
     * Check cache
     * ------------------------------------------------------------------------------------------------*/
@@ -1657,6 +2050,110 @@ Edge BinaryOperation::computeElmtWise(const Level lvl, const Edge& source1, cons
     }
 }
 
+Edge BinaryOperation::computeElmtWiseMult(const Level lvl, const Edge& source1, const Edge& source2)
+{
+#ifdef BRAVE_DD_OPERATION_TRACE
+    std::cout << "compute elementwise EV*(" << BOP2String(opType) << "): lvl: " << lvl << "; e1: ";
+    source1.print(std::cout);
+    std::cout << "; e2: ";
+    source2.print(std::cout);
+    std::cout << std::endl;
+#endif
+    // the final answer
+    Edge ans;
+    Edge e1, e2;
+    e1 = resForest->normalizeEdge(lvl, source1);
+    e2 = resForest->normalizeEdge(lvl, source2);
+    double w1 = resForest->multWeight(e1.getValue());
+    double w2 = resForest->multWeight(e2.getValue());
+    bool isOmega1 = e1.isConstantOmega() || (w1 == 0.0);
+    bool isOmega2 = e2.isConstantOmega() || (w2 == 0.0);
+    bool isNNReal = resForest->getSetting().getRangeType() == NNREAL;
+    /* =================================================================================================
+    * Terminal cases: weight 0 is the constant 0 whatever the target is
+    * ================================================================================================*/
+    if (opType == BinaryOperationType::BOP_MULTIPLY) {
+        if ((w1 == 0.0) || (w2 == 0.0)) return resForest->multZeroEdge(lvl);
+        if (e1.isConstantOmega()) {
+            ans = e2;
+            ans.setValue(resForest->multValue(w1 * w2));
+            return ans;
+        }
+        if (e2.isConstantOmega()) {
+            ans = e1;
+            ans.setValue(resForest->multValue(w1 * w2));
+            return ans;
+        }
+    } else if (opType == BinaryOperationType::BOP_PLUS) {
+        if (w1 == 0.0) return e2;
+        if (w2 == 0.0) return e1;
+        if (e1.getEdgeHandle() == e2.getEdgeHandle()) {
+            if (w1 + w2 == 0.0) return resForest->multZeroEdge(lvl);
+            ans = e1;
+            ans.setValue(resForest->multValue(w1 + w2));
+            return ans;
+        }
+    } else if ((opType == BinaryOperationType::BOP_MINIMUM) || (opType == BinaryOperationType::BOP_MAXIMUM)) {
+        bool isMin = (opType == BinaryOperationType::BOP_MINIMUM);
+        if (e1 == e2) return e1;
+        if (isOmega1 && isOmega2) {
+            return ((w1 < w2) == isMin) ? e1 : e2;
+        }
+        // same function scaled by nonnegative weights, when the function is nonnegative
+        if ((e1.getEdgeHandle() == e2.getEdgeHandle()) && isNNReal && (w1 > 0.0) && (w2 > 0.0)) {
+            return ((w1 < w2) == isMin) ? e1 : e2;
+        }
+    } else {
+        // no terminal cases: the recursion would not stop at the terminals
+        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+    }
+    /* -------------------------------------------------------------------------------------------------
+    * Factor out the weight of e1, so that the cached operands are normalized:
+    *       PLUS, MULTIPLY:     f(a*x, b*y) = a * f(x, (b/a)*y)
+    *       MIN, MAX:           the same only if a > 0
+    * ------------------------------------------------------------------------------------------------*/
+    double factor = 1.0;
+    if ((opType == BinaryOperationType::BOP_MULTIPLY)) {
+        factor = w1 * w2;
+        e1.setValue(resForest->multValue(1.0));
+        e2.setValue(resForest->multValue(1.0));
+    } else if ((w1 != 0.0) && ((opType == BinaryOperationType::BOP_PLUS) || (w1 > 0.0))) {
+        factor = w1;
+        e1.setValue(resForest->multValue(1.0));
+        e2.setValue(resForest->multValue(w2 / w1));
+    }
+    // commutative: order the operands for cache hits, only when both weights are 1
+    if ((e1.getValue() == e2.getValue()) && (e1.getEdgeHandle() > e2.getEdgeHandle())) SWAP(e1, e2);
+    /* -------------------------------------------------------------------------------------------------
+    * Check cache
+    * ------------------------------------------------------------------------------------------------*/
+    if (caches[0].check(lvl, e1, e2, ans)) {
+        double w = resForest->multWeight(ans.getValue()) * factor;
+        if (w == 0.0) return resForest->multZeroEdge(lvl);
+        ans.setValue(resForest->multValue(w));
+        return ans;
+    }
+    /* -------------------------------------------------------------------------------------------------
+    * Compute: only long X edges in EV* forests, so expand the top node level
+    * ------------------------------------------------------------------------------------------------*/
+    Level m1 = e1.getNodeLevel();
+    Level m2 = e2.getNodeLevel();
+    Level m = (m1 > m2) ? m1 : m2;
+    std::vector<Edge> child(2);
+    for (char i=0; i<(char)child.size(); i++) {
+        child[i] = computeElmtWiseMult(m-1, resForest->cofact(m, e1, i), resForest->cofact(m, e2, i));
+    }
+    EdgeLabel root = 0;
+    packRule(root, RULE_X);
+    ans = resForest->reduceEdge(lvl, root, m, child);
+    // save to cache
+    cacheAdd(0, lvl, e1, e2, ans);
+    double w = resForest->multWeight(ans.getValue()) * factor;
+    if (w == 0.0) return resForest->multZeroEdge(lvl);
+    ans.setValue(resForest->multValue(w));
+    return ans;
+}
+
 Edge BinaryOperation::computeUnion(const Level lvl, const Edge& source1, const Edge& source2)
 {
     Edge ans;
@@ -1670,10 +2167,7 @@ Edge BinaryOperation::computeUnion(const Level lvl, const Edge& source1, const E
     // Base case 2: two edges are complemented
     // Base case 3: one edge is constant ONE edge
     if (e1.isComplementTo(e2) || e1.isConstantOne() || e2.isConstantOne()) {
-        EdgeHandle constant = makeTerminal(INT, 1);
-        if (resForest->getSetting().getValType() == FLOAT) {
-            constant = makeTerminal(FLOAT, 1.0f);
-        }
+        EdgeHandle constant = resForest->makeBoolTerminal(1);
         packRule(constant, RULE_X);
         ans.setEdgeHandle(constant);
         ans = resForest->normalizeEdge(lvl, ans);
@@ -1763,10 +2257,7 @@ Edge BinaryOperation::computeIntersection(const Level lvl, const Edge& source1,
     // Base case 2: two edges are complemented
     // Base case 3: one edge is constant ZERO edge
     if (e1.isComplementTo(e2) || e1.isConstantZero() || e2.isConstantZero()) {
-        EdgeHandle constant = makeTerminal(INT, 0);
-        if (resForest->getSetting().getValType() == FLOAT) {
-            constant = makeTerminal(FLOAT, 0.0f);
-        }
+        EdgeHandle constant = resForest->makeBoolTerminal(0);
         packRule(constant, RULE_X);
         ans.setEdgeHandle(constant);
         ans = resForest->normalizeEdge(lvl, ans);
@@ -1884,10 +2375,7 @@ Edge BinaryOperation::computeImage(const Level lvl, const Edge& source1, const E
     std::cout << "\t\tbase case 1\n";
 #endif
         if (source1Forest->setting.getEncodeMechanism() == TERMINAL) {
-            EdgeHandle constant = makeTerminal(INT, 0);
-            if (source1Forest->getSetting().getValType() == FLOAT) {
-                constant = makeTerminal(FLOAT, 0.0f);
-            }
+            EdgeHandle constant = source1Forest->makeBoolTerminal(0);
             packRule(constant, RULE_X);
             ans.setEdgeHandle(constant);
         } else {
@@ -1914,10 +2402,7 @@ Edge BinaryOperation::computeImage(const Level lvl, const Edge& source1, const E
     std::cout << "\t\tbase case 2: redundant\n";
 #endif
         if (source1Forest->setting.getEncodeMechanism() == TERMINAL) {
-            EdgeHandle constant = makeTerminal(INT, 1);
-            if (source1Forest->getSetting().getValType() == FLOAT) {
-                constant = makeTerminal(FLOAT, 1.0f);
-            }
+            EdgeHandle constant = source1Forest->makeBoolTerminal(1);
             packRule(constant, RULE_X);
             ans.setEdgeHandle(constant);
         } else {
@@ -1950,10 +2435,7 @@ Edge BinaryOperation::computeImage(const Level lvl, const Edge& source1, const E
         // -----------------------------------------------------------
         // not cached, computing needed
         std::vector<Edge> child(2);
-        EdgeHandle constant = makeTerminal(INT, 0);
-        if (source1Forest->getSetting().getValType() == FLOAT) {
-            constant = makeTerminal(FLOAT, 0.0f);
-        }
+        EdgeHandle constant = source1Forest->makeBoolTerminal(0);
         if (source1Forest->setting.getEncodeMechanism() != TERMINAL) {
             constant = makeTerminal(VOID, SpecialValue::OMEGA);
         }
@@ -1965,11 +2447,11 @@ Edge BinaryOperation::computeImage(const Level lvl, const Edge& source1, const E
         if ((m > r.getNodeLevel()) && (r.getRule() == RULE_I0)) {
             Edge rr = r;
             if (m-r.getNodeLevel() == 1) rr.setRule(RULE_X);
-            child[0] = computeImage(m-1, source1Forest->cofact(m, s, 0), rr);
+            child[0] = computeImage(m-1, source1Forest->cofact(m, s, 0), rr, isPre);
             // protectChild.push_back(child[0]);
             // source1Forest->registerEdge(child[0]);
 
-            child[1] = computeImage(m-1, source1Forest->cofact(m, s, 1), rr);
+            child[1] = computeImage(m-1, source1Forest->cofact(m, s, 1), rr, isPre);
             // protectChild.push_back(child[1]);
             // source1Forest->registerEdge(child[1]);
         } else {
@@ -1999,43 +2481,330 @@ Edge BinaryOperation::computeImage(const Level lvl, const Edge& source1, const E
                 // protectChild.push_back(child[s1Idx]);
                 // source1Forest->registerEdge(child[s1Idx]);
 #ifdef BRAVE_DD_OPERATION_TRACE
-    std::cout << "after union child[" << (int)s1Idx << "]: ";
-    child[s1Idx].print(std::cout);
-    std::cout << std::endl;
+    std::cout << "after union child[" << (int)s1Idx << "]: ";
+    child[s1Idx].print(std::cout);
+    std::cout << std::endl;
+#endif
+            }
+        }
+        EdgeLabel root = 0;
+        packRule(root, RULE_X);
+        ans = source1Forest->reduceEdge(m, root, m, child);
+        // ----------------------------------------------------------- 
+        // // protect ans
+        // ProtectEdge protectAns(resForest, ans);
+        // // unprotect edges
+        // for (size_t i=0; i<protectChild.size(); i++) {
+        //     source1Forest->deregisterEdge(protectChild[i]);
+        // }
+        // for (size_t i=0; i<protectRec.size(); i++) {
+        //     source1Forest->deregisterEdge(protectRec[i]);
+        // }
+        // -----------------------------------------------------------
+        // cache
+        cacheAdd(0, m, sCache, rCache, ans);
+    }
+    // merge with the incoming edge rule
+    EdgeLabel incoming = 0;
+    packRule(incoming, (r.getRule() == RULE_I0)?s.getRule():RULE_X);    // TBD for rex
+    ans = source1Forest->mergeEdge(lvl, m, incoming, ans);
+#ifdef BRAVE_DD_OPERATION_TRACE
+    std::cout << "after " << ((isPre)?"Pre":"Post") << "IMAGE: lvl: " << lvl << "; s: ";
+    source1.print(std::cout);
+    std::cout << "; r: ";
+    trans.print(std::cout);
+    std::cout << std::endl;
+    std::cout << "\tresult: ";
+    ans.print(std::cout);
+    std::cout << std::endl;
+#endif
+    return ans;
+}
+
+Edge BinaryOperation::computeImageNew(const Level lvl, const Edge& source1, const Edge& trans, const Edge& visited, bool isPre)
+{
+#ifdef BRAVE_DD_OPERATION_TRACE
+    std::cout << ((isPre)?"Pre":"Post") << "IMAGE NEW: lvl: " << (Level)lvl << "; s: ";
+    source1.print(std::cout);
+    std::cout << "; r: ";
+    trans.print(std::cout);
+    std::cout << "; v: ";
+    visited.print(std::cout);
+    std::cout << std::endl;
+#endif
+    // normalize edges
+    Edge s = source1Forest->normalizeEdge(lvl, source1);
+    Edge r = source2Forest->normalizeEdge(lvl, trans);
+    Edge v = source1Forest->normalizeEdge(lvl, visited);
+    EdgeHandle constant = source1Forest->makeBoolTerminal(0);
+    packRule(constant, RULE_X);
+    Edge ans;
+
+    // Base case 1: empty states or relation, or everything visited: nothing new
+    if (s.isConstantZero() || r.isConstantZero() || v.isConstantOne()) {
+        ans.setEdgeHandle(constant);
+        return source1Forest->normalizeEdge(lvl, ans);
+    }
+    // Base case 2: nothing visited, the new states are the whole image
+    if (v.isConstantZero()) {
+        BinaryOperationType imageType = (isPre) ? BinaryOperationType::BOP_PREIMAGE : BinaryOperationType::BOP_POSTIMAGE;
+        BinaryOperation* image = BOPs.find(imageType, source1Forest, source2Forest, source1Forest);
+        if (!image) {
+            image = BOPs.add(new BinaryOperation(imageType, source1Forest, source2Forest, source1Forest));
+        }
+        return image->computeImage(lvl, s, r, isPre);
+    }
+
+    Level m = MAX(MAX(s.getNodeLevel(), r.getNodeLevel()), v.getNodeLevel());
+    if (m < lvl) {
+        // the skipped levels are redundant in the result, when they are in the states and
+        // the visited set, and redundant or identity in the relation; otherwise, go one level down
+        if ((s.getRule() == RULE_X) && (v.getRule() == RULE_X)
+            && ((r.getRule() == RULE_X) || (r.getRule() == RULE_I0))) {
+            ans = computeImageNew(m, s, r, v, isPre);
+            EdgeLabel incoming = 0;
+            packRule(incoming, RULE_X);
+            return source1Forest->mergeEdge(lvl, m, incoming, ans);
+        }
+        m = lvl;
+    }
+    // assertion: m == lvl > 0
+    Edge sCache = s;
+    Edge rCache = r;
+    Edge vCache = v;
+    if (s.getNodeLevel() == m) sCache.setRule(RULE_X);
+    if (r.getNodeLevel() == m) rCache.setRule(RULE_X);
+    if (v.getNodeLevel() == m) vCache.setRule(RULE_X);
+    // check cache
+    if (caches[0].check(m, sCache, rCache, vCache, ans)) {
+        return ans;
+    }
+    std::vector<Edge> childVisited(2), child(2);
+    for (char j=0; j<2; j++) {
+        childVisited[j] = source1Forest->cofact(m, v, j);
+        child[j].setEdgeHandle(constant);
+        child[j] = source1Forest->normalizeEdge(m-1, child[j]);
+    }
+    if ((m > r.getNodeLevel()) && (r.getRule() == RULE_I0)) {
+        // identity at this level, the states stay in their child
+        Edge rr = r;
+        if (m-r.getNodeLevel() == 1) rr.setRule(RULE_X);
+        for (char j=0; j<2; j++) {
+            child[j] = computeImageNew(m-1, source1Forest->cofact(m, s, j), rr, childVisited[j], isPre);
+        }
+    } else {
+        // each part of the image into a child is pruned by the visited set of that child
+        BinaryOperation* un = BOPs.find(BinaryOperationType::BOP_UNION, source1Forest, source1Forest, source1Forest);
+        if (!un) {
+            un = BOPs.add(new BinaryOperation(BinaryOperationType::BOP_UNION, source1Forest, source1Forest, source1Forest));
+        }
+        for (char i=0; i<4; i++) {
+            char s0Idx = (isPre) ? (i&(0x01)) : ((i&(0x01<<1))>>1);
+            char s1Idx = (isPre) ? ((i&(0x01<<1))>>1) : (i&(0x01));
+            Edge sRec = source1Forest->cofact(m, s, s0Idx);
+            Edge rRec = source2Forest->cofact(m, r, i);
+            Edge resRec = computeImageNew(m-1, sRec, rRec, childVisited[s1Idx], isPre);
+            child[s1Idx] = un->computeElmtWise(m-1, child[s1Idx], resRec);
+        }
+    }
+    EdgeLabel root = 0;
+    packRule(root, RULE_X);
+    ans = source1Forest->reduceEdge(m, root, m, child);
+    // cache
+    cacheAdd(0, m, sCache, rCache, vCache, ans);
+#ifdef BRAVE_DD_OPERATION_TRACE
+    std::cout << "after " << ((isPre)?"Pre":"Post") << "IMAGE NEW: lvl: " << lvl << "; result: ";
+    ans.print(std::cout);
+    std::cout << std::endl;
+#endif
+    return ans;
+}
+
+Edge BinaryOperation::computeAndExists(const Level lvl, const Edge& source1, const Edge& source2, const Edge& cube)
+{
+#ifdef BRAVE_DD_OPERATION_TRACE
+    std::cout << "AND EXISTS: lvl: " << lvl << "; e1: ";
+    source1.print(std::cout);
+    std::cout << "; e2: ";
+    source2.print(std::cout);
+    std::cout << "; cube: ";
+    cube.print(std::cout);
+    std::cout << std::endl;
+#endif
+    Edge e1 = resForest->normalizeEdge(lvl, source1);
+    Edge e2 = resForest->normalizeEdge(lvl, source2);
+    Edge c = resForest->normalizeEdge(lvl, cube);
+    Edge ans;
+    // Base case 1: the conjunction is empty
+    if (e1.isConstantZero() || e2.isConstantZero() || e1.isComplementTo(e2)) {
+        EdgeHandle constant = resForest->makeBoolTerminal(0);
+        packRule(constant, RULE_X);
+        ans.setEdgeHandle(constant);
+        return resForest->normalizeEdge(lvl, ans);
+    }
+    // Base case 2: the conjunction is one of the operands
+    if (e1.isConstantOne()) e1 = e2;
+    if (e2.isConstantOne()) e2 = e1;
+    if ((e1 == e2) && e1.isConstantOne()) return e1;
+    // Base case 3: nothing left to quantify
+    if (c.isConstantOne()) {
+        BinaryOperation* bop = BOPs.find(BinaryOperationType::BOP_INTERSECTION, resForest, resForest, resForest);
+        if (!bop) {
+            bop = BOPs.add(new BinaryOperation(BinaryOperationType::BOP_INTERSECTION, resForest, resForest, resForest));
+        }
+        return bop->computeElmtWise(lvl, e1, e2);
+    }
+    // commutative
+    if (e1.getEdgeHandle() > e2.getEdgeHandle()) SWAP(e1, e2);
+
+    bool isRel = resForest->getSetting().isRelation();
+    Level m = MAX(MAX(e1.getNodeLevel(), e2.getNodeLevel()), c.getNodeLevel());
+    if (m < lvl) {
+        // the skipped levels are not quantified, and redundant (or identity) in the operands, so
+        // are they in the conjunction; otherwise, the rules are taken apart one level at a time
+        bool isSkip1 = (e1.getRule() == RULE_X) || (isRel && (e1.getRule() == RULE_I0));
+        bool isSkip2 = (e2.getRule() == RULE_X) || (isRel && (e2.getRule() == RULE_I0));
+        if ((c.getRule() == RULE_X) && isSkip1 && isSkip2) {
+            ans = computeAndExists(m, e1, e2, c);
+            EdgeLabel incoming = 0;
+            packRule(incoming, (e1.getRule() == RULE_X) ? e2.getRule() : e1.getRule());
+            return resForest->mergeEdge(lvl, m, incoming, ans);
+        }
+        m = lvl;
+    }
+    // assertion: m == lvl > 0
+    Edge e1Cache = e1;
+    Edge e2Cache = e2;
+    Edge cCache = c;
+    if (e1.getNodeLevel() == m) e1Cache.setRule(RULE_X);
+    if (e2.getNodeLevel() == m) e2Cache.setRule(RULE_X);
+    if (c.getNodeLevel() == m) cCache.setRule(RULE_X);
+    if (caches[0].check(m, e1Cache, e2Cache, cCache, ans)) return ans;
+    std::vector<Edge> child((isRel) ? 4 : 2);
+    // the cube depends on the level when it is quantified (zero in the low child)
+    Edge cRest = resForest->cofact(m, c, (char)(child.size()-1));
+    bool isQuant = (resForest->cofact(m, c, 0) != cRest);
+    if (isQuant) {
+        // disjunction of the children, until it is one
+        BinaryOperation* un = BOPs.find(BinaryOperationType::BOP_UNION, resForest, resForest, resForest);
+        if (!un) {
+            un = BOPs.add(new BinaryOperation(BinaryOperationType::BOP_UNION, resForest, resForest, resForest));
+        }
+        Edge merged = computeAndExists(m-1, resForest->cofact(m, e1, 0), resForest->cofact(m, e2, 0), cRest);
+        for (size_t i=1; (i<child.size()) && !merged.isConstantOne(); i++) {
+            Edge rec = computeAndExists(m-1, resForest->cofact(m, e1, (char)i), resForest->cofact(m, e2, (char)i), cRest);
+            merged = un->computeElmtWise(m-1, merged, rec);
+        }
+        for (size_t i=0; i<child.size(); i++) child[i] = merged;
+    } else {
+        for (size_t i=0; i<child.size(); i++) {
+            child[i] = computeAndExists(m-1, resForest->cofact(m, e1, (char)i), resForest->cofact(m, e2, (char)i), cRest);
+        }
+    }
+    EdgeLabel root = 0;
+    packRule(root, RULE_X);
+    ans = resForest->reduceEdge(m, root, m, child);
+    cacheAdd(0, m, e1Cache, e2Cache, cCache, ans);
+    return ans;
+}
+
+/* The largest number of operands recursed on at once; more are split in a balanced tree */
+static const size_t NARY_ARITY = 16;
+
+Edge BinaryOperation::computeNary(const Level lvl, const std::vector<Edge>& sources)
+{
+#ifdef BRAVE_DD_OPERATION_TRACE
+    std::cout << "compute n-ary(" << BOP2String(opType) << "): lvl: " << lvl << "; " << sources.size() << " edges" << std::endl;
 #endif
+    bool isUnion = (opType == BinaryOperationType::BOP_UNION);
+    bool isInter = (opType == BinaryOperationType::BOP_INTERSECTION);
+    Edge ans;
+    // Base case 1: a constant absorbs the others (one for union, zero for intersection), or is
+    // neutral and dropped
+    std::vector<Edge> opnds;
+    opnds.reserve(sources.size());
+    for (size_t i=0; i<sources.size(); i++) {
+        Edge e = resForest->normalizeEdge(lvl, sources[i]);
+        if ((isUnion && e.isConstantOne()) || (isInter && e.isConstantZero())) return e;
+        if ((isUnion && e.isConstantZero()) || (isInter && e.isConstantOne())) continue;
+        opnds.push_back(e);
+    }
+    // Base case 2: the same operands once, in a canonical order
+    std::sort(opnds.begin(), opnds.end(), [](const Edge& a, const Edge& b) {
+        return a.getEdgeHandle() < b.getEdgeHandle();
+    });
+    opnds.erase(std::unique(opnds.begin(), opnds.end()), opnds.end());
+    // Base case 3: complemented operands
+    if ((isUnion || isInter) && (resForest->getSetting().getCompType() != NO_COMP)) {
+        for (size_t i=0; i<opnds.size(); i++) {
+            for (size_t j=i+1; j<opnds.size(); j++) {
+                if (opnds[i].isComplementTo(opnds[j])) {
+                    EdgeHandle constant = resForest->makeBoolTerminal(isUnion);
+                    packRule(constant, RULE_X);
+                    ans.setEdgeHandle(constant);
+                    return resForest->normalizeEdge(lvl, ans);
+                }
             }
         }
-        EdgeLabel root = 0;
-        packRule(root, RULE_X);
-        ans = source1Forest->reduceEdge(m, root, m, child);
-        // ----------------------------------------------------------- 
-        // // protect ans
-        // ProtectEdge protectAns(resForest, ans);
-        // // unprotect edges
-        // for (size_t i=0; i<protectChild.size(); i++) {
-        //     source1Forest->deregisterEdge(protectChild[i]);
-        // }
-        // for (size_t i=0; i<protectRec.size(); i++) {
-        //     source1Forest->deregisterEdge(protectRec[i]);
-        // }
-        // -----------------------------------------------------------
-        // cache
-        cacheAdd(0, m, sCache, rCache, ans);
     }
-    // merge with the incoming edge rule
-    EdgeLabel incoming = 0;
-    packRule(incoming, (r.getRule() == RULE_I0)?s.getRule():RULE_X);    // TBD for rex
-    ans = source1Forest->mergeEdge(lvl, m, incoming, ans);
-#ifdef BRAVE_DD_OPERATION_TRACE
-    std::cout << "after " << ((isPre)?"Pre":"Post") << "IMAGE: lvl: " << lvl << "; s: ";
-    source1.print(std::cout);
-    std::cout << "; r: ";
-    trans.print(std::cout);
-    std::cout << std::endl;
-    std::cout << "\tresult: ";
-    ans.print(std::cout);
-    std::cout << std::endl;
-#endif
+    // Base case 4: the neutral constant, one operand, or the binary operation and its cache
+    if (opnds.empty()) {
+        EdgeHandle constant = resForest->makeBoolTerminal(isInter);
+        packRule(constant, RULE_X);
+        ans.setEdgeHandle(constant);
+        return resForest->normalizeEdge(lvl, ans);
+    }
+    if (opnds.size() == 1) return opnds[0];
+    if (opnds.size() == 2) return computeElmtWise(lvl, opnds[0], opnds[1]);
+    // too many operands: the two halves, then the binary operation
+    if (opnds.size() > NARY_ARITY) {
+        size_t half = opnds.size() / 2;
+        Edge low = computeNary(lvl, std::vector<Edge>(opnds.begin(), opnds.begin()+half));
+        Edge high = computeNary(lvl, std::vector<Edge>(opnds.begin()+half, opnds.end()));
+        return computeElmtWise(lvl, low, high);
+    }
+
+    bool isRel = resForest->getSetting().isRelation();
+    Level m = 0;
+    for (size_t i=0; i<opnds.size(); i++) m = MAX(m, opnds[i].getNodeLevel());
+    // Base case 5: the terminal values
+    if (m == 0) {
+        ans = opnds[0];
+        for (size_t i=1; i<opnds.size(); i++) ans = computeElmtWise(0, ans, opnds[i]);
+        return ans;
+    }
+    if (m < lvl) {
+        // the skipped levels are redundant (or identity) in every operand, so are they in the result;
+        // otherwise, the rules are taken apart one level at a time
+        bool isSkip = (opnds[0].getRule() == RULE_X) || (isRel && (opnds[0].getRule() == RULE_I0));
+        for (size_t i=1; isSkip && (i<opnds.size()); i++) {
+            isSkip = (opnds[i].getRule() == opnds[0].getRule());
+        }
+        if (isSkip) {
+            ans = computeNary(m, opnds);
+            EdgeLabel incoming = 0;
+            packRule(incoming, opnds[0].getRule());
+            return resForest->mergeEdge(lvl, m, incoming, ans);
+        }
+        m = lvl;
+    }
+    // assertion: m == lvl > 0
+    std::vector<Edge> key = opnds;
+    for (size_t i=0; i<key.size(); i++) {
+        if (key[i].getNodeLevel() == m) key[i].setRule(RULE_X);
+    }
+    std::unordered_map<std::vector<Edge>, Edge, EdgesHash>::const_iterator it = naryCache[m].find(key);
+    if (it != naryCache[m].end()) return it->second;
+    std::vector<Edge> child((isRel) ? 4 : 2);
+    std::vector<Edge> cofacts(opnds.size());
+    for (size_t c=0; c<child.size(); c++) {
+        for (size_t i=0; i<opnds.size(); i++) cofacts[i] = resForest->cofact(m, opnds[i], (char)c);
+        child[c] = computeNary(m-1, cofacts);
+    }
+    EdgeLabel root = 0;
+    packRule(root, RULE_X);
+    ans = resForest->reduceEdge(m, root, m, child);
+    naryCache[m][key] = ans;
     return ans;
 }
 
@@ -2342,78 +3111,11 @@ BinaryList::BinaryList(const std::string n)
     reset(n);
 }
 
-BinaryOperation* BinaryList::mtfBinary(const BinaryOperationType opT, const Forest* source1F, const Forest* source2F, const Forest* resF)
-{
-    BinaryOperation* prev = front;
-    BinaryOperation* curr = front->next;
-    while (curr) {
-        if ((curr->opType == opT) && (curr->source1Forest == source1F) && (curr->source2Forest == source2F) && (curr->resForest == resF)) {
-            // Move to front
-            prev->next = curr->next;
-            curr->next = front;
-            front = curr;
-            return curr;
-        }
-        prev = curr;
-        curr = curr->next;
-    }
-    return nullptr;
-}
-
-BinaryOperation* BinaryList::mtfBinary(const BinaryOperationType opT, const Forest* source1F, const OpndType source2T, const Forest* resF)
-{
-    BinaryOperation* prev = front;
-    BinaryOperation* curr = front->next;
-    while (curr) {
-        if ((curr->opType == opT) && (curr->source1Forest == source1F) && (curr->source2Type == source2T) && (curr->resForest == resF)) {
-            // Move to front
-            prev->next = curr->next;
-            curr->next = front;
-            front = curr;
-            return curr;
-        }
-        prev = curr;
-        curr = curr->next;
-    }
-    return nullptr;
-}
-
-void BinaryList::searchRemove(BinaryOperation* bop)
-{
-    if (!front) return;
-    BinaryOperation* prev = front;
-    BinaryOperation* curr = front->next;
-    while (curr) {
-        if (curr == bop) {
-            prev->next = curr->next;
-            delete curr;
-            return;
-        }
-        prev = curr;
-        curr = curr->next;
-    }
-}
-
 void BinaryList::searchRemove(Forest* forest)
 {
-    if (!front || !forest) return;
-    // check front first
-    while (front && ((front->source1Forest == forest) || (front->source2Forest == forest) || (front->resForest == forest))) {
-        BinaryOperation* toRemove = front;
-        front = front->next;
-        delete toRemove;
-    }
-    // check the remaining
-    BinaryOperation* curr = front;
-    while (curr && curr->next) {
-        if ((curr->next->source1Forest == forest) || (curr->next->source2Forest == forest) || (curr->next->resForest == forest)) {
-            BinaryOperation* toRemove = curr->next;
-            curr->next = curr->next->next;
-            delete toRemove;
-        } else {
-            curr = curr->next;
-        }
-    }
+    if (!forest) return;
+    std::vector<BinaryOperation*> ops = index.withForest(forest);
+    for (size_t i=0; i<ops.size(); i++) remove(ops[i]);
 }
 
 void BinaryList::searchSweepCache(Forest* forest)
@@ -2435,12 +3137,30 @@ void BinaryList::searchSweepCache(Forest* forest)
                     curr->caches[0].sweep(forest, 2);
                 }
 
+            } else if ((curr->opType == BinaryOperationType::BOP_PREIMAGE_NEW) || (curr->opType == BinaryOperationType::BOP_POSTIMAGE_NEW)) {
+                // one pass for all the roles of this forest
+                std::vector<int> roles;
+                if (isSource1) {
+                    roles.push_back(0);
+                    roles.push_back(1);
+                    roles.push_back(3);
+                }
+                if (isSource2) roles.push_back(2);
+                curr->caches[0].sweep(forest, roles);
+            } else if (curr->opType == BinaryOperationType::BOP_ANDEXISTS) {
+                // the sources are copied to the result forest, so are the cache entries
+                if (isRes) {
+                    curr->caches[0].sweep(forest, std::vector<int>{0, 1, 2, 3});
+                }
             } else if ((curr->opType == BinaryOperationType::BOP_UNION)
                         || (curr->opType == BinaryOperationType::BOP_INTERSECTION)
+                        || (curr->opType == BinaryOperationType::BOP_XOR)
+                        || (curr->opType == BinaryOperationType::BOP_XNOR)
                         || (curr->opType == BinaryOperationType::BOP_MINIMUM)
                         || (curr->opType == BinaryOperationType::BOP_MAXIMUM)
                         || (curr->opType == BinaryOperationType::BOP_PLUS)
-                        || (curr->opType == BinaryOperationType::BOP_MINUS)) {
+                        || (curr->opType == BinaryOperationType::BOP_MINUS)
+                        || (curr->opType == BinaryOperationType::BOP_MULTIPLY)) {
                 if (isRes) {
                     curr->caches[0].sweep(forest, 0);
                     curr->caches[0].sweep(forest, 1);
@@ -2458,6 +3178,13 @@ void BinaryList::searchSweepCache(Forest* forest)
     }
 }
 
+void BinaryList::markPooled(std::vector<bool>& used) const
+{
+    for (BinaryOperation* curr = front; curr; curr = curr->next) {
+        for (size_t i=0; i<curr->caches.size(); i++) curr->caches[i].markPooled(used);
+    }
+}
+
 void BinaryList::reportCacheStat(std::ostream& out, int format) const
 {
     BinaryOperation* curr = front;
@@ -2477,6 +3204,227 @@ void BinaryList::reportCacheStat(std::ostream& out, int format) const
 }
 
 
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                 TernaryOperation  methods                      *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+TernaryOperation::TernaryOperation(TernaryOperationType type, Forest* source1, Forest* source2, Forest* source3, Forest* res)
+:opType(type)
+{
+    source1Forest = source1;
+    source2Forest = source2;
+    source3Forest = source3;
+    resForest = res;
+    caches.resize(1);
+}
+TernaryOperation::~TernaryOperation()
+{
+    caches.clear();
+    source1Forest = nullptr;
+    source2Forest = nullptr;
+    source3Forest = nullptr;
+    resForest = nullptr;
+}
+
+void TernaryOperation::sweepAndEnlarge(const size_t cacheID)
+{
+    // first check if number of entries reach to the thresholds
+    double ratio = static_cast<double>(caches[cacheID].numEntries) / caches[cacheID].size;
+    // it's time to enlarge?
+    if ((ratio > thresholdsEnlarge) && (caches[cacheID].size < (uint64_t)0x01 << 62)) {
+        caches[cacheID].size *= 2;
+        caches[cacheID].enlarge(caches[cacheID].size);
+    }
+}
+
+void TernaryOperation::compute(const Func& source1, const Func& source2, const Func& source3, Func& res)
+{
+    if (!checkForestCompatibility()) {
+        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+    }
+    Level numVars = resForest->getSetting().getNumVars();
+    // copy sources to the target forest
+    Func sourcesEqu[3] = {convertFunc(source1, resForest), convertFunc(source2, resForest), convertFunc(source3, resForest)};
+    // compute the result
+    Edge ans;
+    if (opType == TernaryOperationType::TOP_ITE) {
+        ans = computeITE(numVars, sourcesEqu[0].getEdge(), sourcesEqu[1].getEdge(), sourcesEqu[2].getEdge());
+    } else {
+        // TBD
+        std::cerr << "[BraveDD] Warning: Operation \"" << TOP2String(opType) << "\" is not supported yet." << std::endl;
+        exit(1);
+    }
+    // passing result
+    res.setEdge(ans);
+}
+
+bool TernaryOperation::checkForestCompatibility() const
+{
+    // 0/1 functions with terminal encoding, all sets or all relations
+    const ForestSetting& setting = resForest->getSetting();
+    if (setting.getEncodeMechanism() != TERMINAL) return 0;
+    return (source1Forest->getSetting().isRelation() == setting.isRelation())
+            && (source2Forest->getSetting().isRelation() == setting.isRelation())
+            && (source3Forest->getSetting().isRelation() == setting.isRelation());
+}
+
+Edge TernaryOperation::computeBinary(const BinaryOperationType type, const Level lvl, const Edge& e1, const Edge& e2)
+{
+    BinaryOperation* bop = BOPs.find(type, resForest, resForest, resForest);
+    if (!bop) {
+        bop = BOPs.add(new BinaryOperation(type, resForest, resForest, resForest));
+    }
+    return bop->computeElmtWise(lvl, e1, e2);
+}
+
+Edge TernaryOperation::computeITE(const Level lvl, const Edge& source1, const Edge& source2, const Edge& source3)
+{
+#ifdef BRAVE_DD_OPERATION_TRACE
+    std::cout << "compute ITE: lvl: " << lvl << "; f: ";
+    source1.print(std::cout);
+    std::cout << "; g: ";
+    source2.print(std::cout);
+    std::cout << "; h: ";
+    source3.print(std::cout);
+    std::cout << std::endl;
+#endif
+    Edge ans;
+    Edge f = resForest->normalizeEdge(lvl, source1);
+    Edge g = resForest->normalizeEdge(lvl, source2);
+    Edge h = resForest->normalizeEdge(lvl, source3);
+    /* Base cases */
+    if (f.isConstantOne()) return g;
+    if (f.isConstantZero()) return h;
+    if (g == h) return g;
+    /* Standard triples: f is known in each branch */
+    if (f == g) {
+        g.setEdgeHandle(resForest->makeBoolTerminal(1));
+        g.setRule(RULE_X);
+        g = resForest->normalizeEdge(lvl, g);
+    } else if (f.isComplementTo(g)) {
+        g.setEdgeHandle(resForest->makeBoolTerminal(0));
+        g.setRule(RULE_X);
+        g = resForest->normalizeEdge(lvl, g);
+    }
+    if (f == h) {
+        h.setEdgeHandle(resForest->makeBoolTerminal(0));
+        h.setRule(RULE_X);
+        h = resForest->normalizeEdge(lvl, h);
+    } else if (f.isComplementTo(h)) {
+        h.setEdgeHandle(resForest->makeBoolTerminal(1));
+        h.setRule(RULE_X);
+        h = resForest->normalizeEdge(lvl, h);
+    }
+    if (g == h) return g;
+    if (g.isConstantOne() && h.isConstantZero()) return f;
+    /* The binary cases, they share the caches of the Boolean operators */
+    if (g.isConstantOne()) return computeBinary(BinaryOperationType::BOP_UNION, lvl, f, h);
+    if (h.isConstantZero()) return computeBinary(BinaryOperationType::BOP_INTERSECTION, lvl, f, g);
+    if (g.isComplementTo(h)) return computeBinary(BinaryOperationType::BOP_XOR, lvl, f, h);
+    /* Complement bit of f: ITE(!f, g, h) = ITE(f, h, g) */
+    if ((resForest->getSetting().getCompType() != NO_COMP) && f.getComp()
+        && resForest->getSetting().hasReductionRule(compRule(f.getRule()))) {
+        f.complement();
+        SWAP(g, h);
+    }
+    Level m = MAX(MAX(f.getNodeLevel(), g.getNodeLevel()), h.getNodeLevel());
+    if (m < lvl) {
+        // the skipped levels are redundant (or identity) in all the operands, so in the result;
+        // otherwise, go one level down
+        ReductionRule rule = f.getRule();
+        if ((g.getRule() == rule) && (h.getRule() == rule)
+            && ((rule == RULE_X) || ((rule == RULE_I0) && resForest->getSetting().isRelation()))) {
+            ans = computeITE(m, f, g, h);
+            EdgeLabel incoming = 0;
+            packRule(incoming, rule);
+            return resForest->mergeEdge(lvl, m, incoming, ans);
+        }
+        m = lvl;
+    }
+    // assertion: m == lvl > 0
+    Edge fCache = f;
+    Edge gCache = g;
+    Edge hCache = h;
+    if (f.getNodeLevel() == m) fCache.setRule(RULE_X);
+    if (g.getNodeLevel() == m) gCache.setRule(RULE_X);
+    if (h.getNodeLevel() == m) hCache.setRule(RULE_X);
+    // check cache
+    if (caches[0].check(m, fCache, gCache, hCache, ans)) {
+        return ans;
+    }
+    std::vector<Edge> child((resForest->getSetting().isRelation()) ? 4 : 2);
+    for (size_t i=0; i<child.size(); i++) {
+        child[i] = computeITE(m-1, resForest->cofact(m, f, i), resForest->cofact(m, g, i), resForest->cofact(m, h, i));
+    }
+    EdgeLabel root = 0;
+    packRule(root, RULE_X);
+    ans = resForest->reduceEdge(m, root, m, child);
+    // cache
+    cacheAdd(0, m, fCache, gCache, hCache, ans);
+#ifdef BRAVE_DD_OPERATION_TRACE
+    std::cout << "after ITE: lvl: " << lvl << "; result: ";
+    ans.print(std::cout);
+    std::cout << std::endl;
+#endif
+    return ans;
+}
+
+// ******************************************************************
+// *                                                                *
+// *                       TernaryList  methods                     *
+// *                                                                *
+// ******************************************************************
+TernaryList::TernaryList(const std::string n)
+{
+    reset(n);
+}
+
+void TernaryList::searchRemove(Forest* forest)
+{
+    if (!forest) return;
+    std::vector<TernaryOperation*> ops = index.withForest(forest);
+    for (size_t i=0; i<ops.size(); i++) remove(ops[i]);
+}
+
+void TernaryList::searchSweepCache(Forest* forest)
+{
+    if (!front || !forest) return;
+    // the operands are copied to the result forest, so are the cache entries
+    std::vector<int> roles = {0, 1, 2, 3};
+    for (TernaryOperation* curr = front; curr; curr = curr->next) {
+        if (curr->resForest == forest) curr->caches[0].sweep(forest, roles);
+    }
+}
+
+void TernaryList::markPooled(std::vector<bool>& used) const
+{
+    for (TernaryOperation* curr = front; curr; curr = curr->next) {
+        for (size_t i=0; i<curr->caches.size(); i++) curr->caches[i].markPooled(used);
+    }
+}
+
+void TernaryList::reportCacheStat(std::ostream& out, int format) const
+{
+    TernaryOperation* curr = front;
+    uint64_t n = 0;
+    out << "TernaryList:\n";
+    while (curr) {
+        out << "CT " << n << " =============================\n";
+        out << "Source1 Forest: " << curr->source1Forest->getSetting().getName() << "\n";
+        out << "Source2 Forest: " << curr->source2Forest->getSetting().getName() << "\n";
+        out << "Source3 Forest: " << curr->source3Forest->getSetting().getName() << "\n";
+        out << "Result Forest: " << curr->resForest->getSetting().getName() << "\n";
+        out << "Operation Type: " << TOP2String(curr->opType) << "\n";
+        out << "----------------------------------\n";
+        curr->caches[0].reportStat(out, format);
+        curr = curr->next;
+        n++;
+    }
+}
+
 // // ******************************************************************
 // // *                                                                *
 // // *                                                                *
@@ -2496,12 +3444,13 @@ void BinaryList::reportCacheStat(std::ostream& out, int format) const
 // *                                                                *
 // *                                                                *
 // ******************************************************************
-SaturationOperation::SaturationOperation(Forest* source1, Forest* source2, Forest* res)
+SaturationOperation::SaturationOperation(Forest* source1, Forest* source2, Forest* res, const bool dir):isPre(dir)
 {
     source1Forest = source1;
     source2Forest = source2;
     resForest = res;
-    isPre = 0;
+    unionOp = nullptr;
+    plusOp = nullptr;
     caches.resize(2);
 }
 
@@ -2511,7 +3460,6 @@ SaturationOperation::~SaturationOperation()
     source1Forest = nullptr;
     source2Forest = nullptr;
     resForest = nullptr;
-    isPre = 0;
 }
 
 void SaturationOperation::setRelations(const std::vector<Func>& rels)
@@ -2520,11 +3468,6 @@ void SaturationOperation::setRelations(const std::vector<Func>& rels)
     sortRelations();
 }
 
-void SaturationOperation::setDirection(const bool dir)
-{
-    isPre = dir;
-}
-
 void SaturationOperation::sweepAndEnlarge(const size_t cacheID)
 {
     // first check if number of entries reach to the thresholds
@@ -2590,6 +3533,23 @@ void SaturationOperation::compute(const Func& source1, Func& res)
     if (!cp1) {
         cp1 = UOPs.add(new UnaryOperation(UnaryOperationType::UOP_COPY, source1.getForest(), res.getForest()));
     }
+    // the operations used at each firing: Union (Maximum for edge-valued forests), or Minimum
+    // and Plus for distances
+    if (resForest->setting.getRangeType() == BOOLEAN) {
+        BinaryOperationType unionType = BinaryOperationType::BOP_UNION;
+        if (source1Forest->setting.getEncodeMechanism() != TERMINAL) unionType = BinaryOperationType::BOP_MAXIMUM;
+        unionOp = BOPs.find(unionType, source1Forest, source1Forest, source1Forest);
+        if (!unionOp) unionOp = BOPs.add(new BinaryOperation(unionType, source1Forest, source1Forest, source1Forest));
+    } else {
+        unionOp = BOPs.find(BinaryOperationType::BOP_MINIMUM, source1Forest, source1Forest, source1Forest);
+        if (!unionOp) {
+            unionOp = BOPs.add(new BinaryOperation(BinaryOperationType::BOP_MINIMUM, source1Forest, source1Forest, source1Forest));
+        }
+        plusOp = BOPs.find(BinaryOperationType::BOP_PLUS, source1Forest, source1Forest, source1Forest);
+        if (!plusOp) {
+            plusOp = BOPs.add(new BinaryOperation(BinaryOperationType::BOP_PLUS, source1Forest, source1Forest, source1Forest));
+        }
+    }
     // compute the result
     /* Note: perhaps changing the relation functions of THIS operation will be called later.
 
@@ -2753,13 +3713,8 @@ Edge SaturationOperation::computeSaturation(const Level lvl, const Edge& source1
     std::cout << "\tfiring\n";
 #endif
         size_t nextBegin = fires.size() + begin;
-        // Union of BDDs operation required
-        BinaryOperationType unionType = BinaryOperationType::BOP_UNION;
-        if (source1Forest->setting.getEncodeMechanism() != TERMINAL) unionType = BinaryOperationType::BOP_MAXIMUM;
-        BinaryOperation* un = BOPs.find(unionType, source1Forest, source1Forest, source1Forest);
-        if (!un) {
-            un = BOPs.add(new BinaryOperation(unionType, source1Forest, source1Forest, source1Forest));
-        }
+        // Union of BDDs operation, found once per compute
+        BinaryOperation* un = unionOp;
 #ifdef BRAVE_DD_SAT_STRATEGY_1
         // child edges firing enough
         bool must0 = !(child[0].isConstantZero() || (child[0].isConstantOmega() && (child[0].getValue() == Value(0))));
@@ -3077,16 +4032,9 @@ Edge SaturationOperation::computeSaturationDistance(const Level lvl, const Edge&
                 });
     if (fires.size() > 0) {
         size_t nextBegin = fires.size() + begin;
-        // Union of BDDs operation required
-        BinaryOperation* un = BOPs.find(BinaryOperationType::BOP_MINIMUM, source1Forest, source1Forest, source1Forest);
-        if (!un) {
-            un = BOPs.add(new BinaryOperation(BinaryOperationType::BOP_MINIMUM, source1Forest, source1Forest, source1Forest));
-        }
-        // Plus 1 operation required
-        BinaryOperation* pls = BOPs.find(BinaryOperationType::BOP_PLUS, source1Forest, source1Forest, source1Forest);
-        if (!pls) {
-            pls = BOPs.add(new BinaryOperation(BinaryOperationType::BOP_PLUS, source1Forest, source1Forest, source1Forest));
-        }
+        // Minimum and Plus 1 operations, found once per compute
+        BinaryOperation* un = unionOp;
+        BinaryOperation* pls = plusOp;
         // make constant one edge
         Edge constantOne;
         if (source1Forest->setting.getEncodeMechanism() == TERMINAL) {
@@ -3355,10 +4303,7 @@ Edge SaturationOperation::computeImageSat(const Level lvl, const Edge& source1,
     std::cout << "\t\tbase case 1\n";
 #endif
         if (em == TERMINAL) {
-            EdgeHandle constant = makeTerminal(INT, 0);
-            if (source1Forest->getSetting().getValType() == FLOAT) {
-                constant = makeTerminal(FLOAT, 0.0f);
-            }
+            EdgeHandle constant = source1Forest->makeBoolTerminal(0);
             packRule(constant, RULE_X);
             ans.setEdgeHandle(constant);
         } else {
@@ -3389,10 +4334,7 @@ Edge SaturationOperation::computeImageSat(const Level lvl, const Edge& source1,
     std::cout << "\t\tbase case 2: redundant\n";
 #endif
             if (em == TERMINAL) {
-                EdgeHandle constant = makeTerminal(INT, 1);
-                if (source1Forest->getSetting().getValType() == FLOAT) {
-                    constant = makeTerminal(FLOAT, 1.0f);
-                }
+                EdgeHandle constant = source1Forest->makeBoolTerminal(1);
                 packRule(constant, RULE_X);
                 ans.setEdgeHandle(constant);
             } else {
@@ -3430,10 +4372,7 @@ Edge SaturationOperation::computeImageSat(const Level lvl, const Edge& source1,
         // ------------------------------------------------
         // not cached, computing needed
         std::vector<Edge> child(2);
-        EdgeHandle constant = makeTerminal(INT, 0);
-        if (source1Forest->getSetting().getValType() == FLOAT) {
-            constant = makeTerminal(FLOAT, 0.0f);
-        }
+        EdgeHandle constant = source1Forest->makeBoolTerminal(0);
         if (em != TERMINAL) {
             constant = makeTerminal(VOID, SpecialValue::OMEGA);
         }
@@ -3459,13 +4398,8 @@ Edge SaturationOperation::computeImageSat(const Level lvl, const Edge& source1,
 #ifdef BRAVE_DD_OPERATION_TRACE
     std::cout << "\trecursive computing\n";
 #endif
-            // Union of BDDs operation required
-            BinaryOperationType unionType = BinaryOperationType::BOP_UNION;
-            if (source1Forest->setting.getEncodeMechanism() != TERMINAL) unionType = BinaryOperationType::BOP_MAXIMUM;
-            BinaryOperation* un = BOPs.find(unionType, source1Forest, source1Forest, source1Forest);
-            if (!un) {
-                un = BOPs.add(new BinaryOperation(unionType, source1Forest, source1Forest, source1Forest));
-            }
+            // Union of BDDs operation, found once per compute
+            BinaryOperation* un = unionOp;
             for (char i=0; i<4; i++) {
                 // if ((r.getRule() == RULE_I0) && (s.getNodeLevel() > m) && (i == 1 || i == 2)) continue;
                 char s0Idx = (isPre) ? (i&(0x01)) : ((i&(0x01<<1))>>1);
@@ -3651,11 +4585,8 @@ Edge SaturationOperation::computeImageSatDistance(const Level lvl, const Edge& s
 #ifdef BRAVE_DD_OPERATION_TRACE
     std::cout << "recursive computing\n";
 #endif
-            // Minimum of BDDs operation required
-            BinaryOperation* un = BOPs.find(BinaryOperationType::BOP_MINIMUM, source1Forest, source1Forest, source1Forest);
-            if (!un) {
-                un = BOPs.add(new BinaryOperation(BinaryOperationType::BOP_MINIMUM, source1Forest, source1Forest, source1Forest));
-            }
+            // Minimum of BDDs operation, found once per compute
+            BinaryOperation* un = unionOp;
             for (char i=0; i<4; i++) {
                 // if ((r.getRule() == RULE_I0) && (s.getNodeLevel() > m) && (i == 1 || i == 2)) continue;
                 char s0Idx = (isPre) ? (i&(0x01)) : ((i&(0x01<<1))>>1);
@@ -3735,60 +4666,11 @@ SaturationList::SaturationList(const std::string n)
     reset(n);
 }
 
-SaturationOperation* SaturationList::mtfSaturation(const Forest* source1F, const Forest* source2F, const Forest* resF)
-{
-    SaturationOperation* prev = front;
-    SaturationOperation* curr = front->next;
-    while (curr) {
-        if ((curr->source1Forest == source1F) && (curr->source2Forest == source2F) && (curr->resForest == resF)) {
-            // Move to front
-            prev->next = curr->next;
-            curr->next = front;
-            front = curr;
-            return curr;
-        }
-        prev = curr;
-        curr = curr->next;
-    }
-    return nullptr;
-}
-
-void SaturationList::searchRemove(SaturationOperation* bop)
-{
-    if (!front) return;
-    SaturationOperation* prev = front;
-    SaturationOperation* curr = front->next;
-    while (curr) {
-        if (curr == bop) {
-            prev->next = curr->next;
-            delete curr;
-            return;
-        }
-        prev = curr;
-        curr = curr->next;
-    }
-}
-
 void SaturationList::searchRemove(Forest* forest)
 {
-    if (!front) return;
-    // check front first
-    while (front && ((front->source1Forest == forest) || (front->source2Forest == forest) || (front->resForest == forest))) {
-        SaturationOperation* toRemove = front;
-        front = front->next;
-        delete toRemove;
-    }
-    // check the remaining
-    SaturationOperation* curr = front;
-    while (curr && curr->next) {
-        if ((curr->next->source1Forest == forest) || (curr->next->source2Forest == forest) || (curr->next->resForest == forest)) {
-            SaturationOperation* toRemove = curr->next;
-            curr->next = curr->next->next;
-            delete toRemove;
-        } else {
-            curr = curr->next;
-        }
-    }
+    if (!forest) return;
+    std::vector<SaturationOperation*> ops = index.withForest(forest);
+    for (size_t i=0; i<ops.size(); i++) remove(ops[i]);
 }
 
 void SaturationList::searchSweepCache(Forest* forest)
@@ -3820,6 +4702,13 @@ void SaturationList::searchSweepCache(Forest* forest)
     }
 }
 
+void SaturationList::markPooled(std::vector<bool>& used) const
+{
+    for (SaturationOperation* curr = front; curr; curr = curr->next) {
+        for (size_t i=0; i<curr->caches.size(); i++) curr->caches[i].markPooled(used);
+    }
+}
+
 void SaturationList::reportCacheStat(std::ostream& out, int format) const
 {
     SaturationOperation* curr = front;
@@ -4,9 +4,12 @@
 #include "../defines.h"
 #include "../forest.h"
 #include "compute_table.h"
+#include "count.h"
 
 namespace BRAVE_DD {
     class Operation;
+    struct OperationKey;
+    template <class OP> class OperationIndex;
     /// Argument and result types for apply operations.
     enum class OpndType {
         FOREST          = 0,
@@ -58,6 +61,12 @@ namespace BRAVE_DD {
         case UnaryOperationType::UOP_LOWEST:
             optype = "Lowest";
             break;
+        case UnaryOperationType::UOP_EQUANTIFY:
+            optype = "Exists";
+            break;
+        case UnaryOperationType::UOP_UQUANTIFY:
+            optype = "ForAll";
+            break;
         
         default:
             optype = "Unknown";
@@ -72,6 +81,8 @@ namespace BRAVE_DD {
         BOP_UNION,
         BOP_INTERSECTION,
         BOP_DIFFERENCE,
+        BOP_XOR,
+        BOP_XNOR,
         BOP_MINIMUM,
         BOP_MAXIMUM,
         BOP_PLUS,
@@ -89,6 +100,9 @@ namespace BRAVE_DD {
         BOP_POSTPLUS,
         BOP_PREIMAGE,
         BOP_POSTIMAGE,
+        BOP_PREIMAGE_NEW,
+        BOP_POSTIMAGE_NEW,
+        BOP_ANDEXISTS,
         BOP_VM,
         BOP_MV,
         BOP_MM
@@ -103,6 +117,12 @@ namespace BRAVE_DD {
         case BinaryOperationType::BOP_INTERSECTION:
             optype = "Intersection";
             break;
+        case BinaryOperationType::BOP_XOR:
+            optype = "Xor";
+            break;
+        case BinaryOperationType::BOP_XNOR:
+            optype = "Xnor";
+            break;
         case BinaryOperationType::BOP_MINIMUM:
             optype = "Minimum";
             break;
@@ -145,6 +165,15 @@ namespace BRAVE_DD {
         case BinaryOperationType::BOP_POSTIMAGE:
             optype = "PostImage";
             break;
+        case BinaryOperationType::BOP_PREIMAGE_NEW:
+            optype = "PreImage New";
+            break;
+        case BinaryOperationType::BOP_POSTIMAGE_NEW:
+            optype = "PostImage New";
+            break;
+        case BinaryOperationType::BOP_ANDEXISTS:
+            optype = "AndExists";
+            break;
         
         default:
             optype = "Unknown";
@@ -154,6 +183,26 @@ namespace BRAVE_DD {
     }
     class BinaryOperation;
     class BinaryList;
+    /// Built-in Ternary operation type
+    enum class TernaryOperationType{
+        TOP_ITE
+    };
+    static inline std::string TOP2String(TernaryOperationType top) {
+        std::string optype;
+        switch (top)
+        {
+        case TernaryOperationType::TOP_ITE:
+            optype = "IfThenElse";
+            break;
+
+        default:
+            optype = "Unknown";
+            break;
+        }
+        return optype;
+    }
+    class TernaryOperation;
+    class TernaryList;
 
     /// Numerical operation
     // class NumericalOperation;
@@ -165,6 +214,7 @@ namespace BRAVE_DD {
 
     extern UnaryList        UOPs;
     extern BinaryList       BOPs;
+    extern TernaryList      TOPs;
     extern SaturationList   SOPs;
 };
 
@@ -216,6 +266,12 @@ class BRAVE_DD::Operation {
         // add to cache
         caches[cacheID].add(lvl, a, b, ans);
     }
+    void cacheAdd(const size_t cacheID, const Level lvl, const Edge& a, const Edge& b, const Edge& c, const Edge& ans) {
+        // check if sweep and enlarg, and do it
+        sweepAndEnlarge(cacheID);
+        // add to cache
+        caches[cacheID].add(lvl, a, b, c, ans);
+    }
     void cacheAdd(const size_t cacheID, const Level lvl, const Edge& a, const Edge& b, const Edge& c, const Edge& d, const Edge& ans) {
         // check if sweep and enlarg, and do it
         sweepAndEnlarge(cacheID);
@@ -243,6 +299,109 @@ class BRAVE_DD::Operation {
     /*-------------------------------------------------------------*/
 };
 
+// ******************************************************************
+// *                                                                *
+// *                       OperationKey  struct                     *
+// *                                                                *
+// ******************************************************************
+/**
+ * What identifies an operation in its list: the operation type, its forests (up to four,
+ * unused ones are null) and the type of an operand that is not a forest.
+ */
+struct BRAVE_DD::OperationKey {
+    int             type;
+    const Forest*   forests[4];
+    int             opnd;
+    OperationKey():type(0), forests{nullptr, nullptr, nullptr, nullptr}, opnd(0) {}
+    OperationKey(int t, const Forest* f0, const Forest* f1, const Forest* f2, const Forest* f3, int o)
+    :type(t), forests{f0, f1, f2, f3}, opnd(o) {}
+    inline bool operator==(const OperationKey& key) const {
+        return (type == key.type) && (opnd == key.opnd)
+                && (forests[0] == key.forests[0]) && (forests[1] == key.forests[1])
+                && (forests[2] == key.forests[2]) && (forests[3] == key.forests[3]);
+    }
+    struct Hash {
+        inline size_t operator()(const OperationKey& key) const {
+            hash_stream hs;
+            hs.start();
+            hs.push((unsigned)key.type, (unsigned)key.opnd);
+            for (int i=0; i<4; i++) {
+                uint64_t f = (uint64_t)(uintptr_t)key.forests[i];
+                hs.push((unsigned)(f >> 32), (unsigned)f);
+            }
+            return (size_t)hs.finish64();
+        }
+    };
+};
+
+// ******************************************************************
+// *                                                                *
+// *                      OperationIndex  class                     *
+// *                                                                *
+// ******************************************************************
+/**
+ * Index of the operations of a list, by key and by forest: finding an operation is a hash
+ * lookup, and the operations of a destroyed forest are found without scanning the list.
+ * The index does not own the operations.
+ */
+template <class OP>
+class BRAVE_DD::OperationIndex {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    inline OP* find(const OperationKey& key) const {
+        typename std::unordered_map<OperationKey, OP*, OperationKey::Hash>::const_iterator it = byKey.find(key);
+        return (it == byKey.end()) ? nullptr : it->second;
+    }
+    inline void add(const OperationKey& key, OP* op) {
+        // the first operation added with a key is the one found
+        byKey.emplace(key, op);
+        keys[op] = key;
+        for (int i=0; i<4; i++) {
+            if (!key.forests[i] || isRepeated(key, i)) continue;
+            byForest[key.forests[i]].push_back(op);
+        }
+    }
+    /// Remove the operation, return 0 if it is not in the index
+    inline bool remove(OP* op) {
+        typename std::unordered_map<const OP*, OperationKey>::iterator it = keys.find(op);
+        if (it == keys.end()) return 0;
+        const OperationKey& key = it->second;
+        typename std::unordered_map<OperationKey, OP*, OperationKey::Hash>::iterator found = byKey.find(key);
+        if ((found != byKey.end()) && (found->second == op)) byKey.erase(found);
+        for (int i=0; i<4; i++) {
+            if (!key.forests[i] || isRepeated(key, i)) continue;
+            std::vector<OP*>& ops = byForest[key.forests[i]];
+            ops.erase(std::find(ops.begin(), ops.end(), op));
+            if (ops.empty()) byForest.erase(key.forests[i]);
+        }
+        keys.erase(it);
+        return 1;
+    }
+    /// The operations with the given forest among their forests
+    inline std::vector<OP*> withForest(const Forest* forest) const {
+        typename std::unordered_map<const Forest*, std::vector<OP*> >::const_iterator it = byForest.find(forest);
+        return (it == byForest.end()) ? std::vector<OP*>() : it->second;
+    }
+    inline void clear() {
+        byKey.clear();
+        keys.clear();
+        byForest.clear();
+    }
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    static inline bool isRepeated(const OperationKey& key, int i) {
+        for (int j=0; j<i; j++) {
+            if (key.forests[j] == key.forests[i]) return 1;
+        }
+        return 0;
+    }
+    std::unordered_map<OperationKey, OP*, OperationKey::Hash>   byKey;
+    std::unordered_map<const OP*, OperationKey>                 keys;
+    std::unordered_map<const Forest*, std::vector<OP*> >        byForest;
+};
+
 // ******************************************************************
 // *                                                                *
 // *                    UnaryOperation  class                       *
@@ -260,11 +419,17 @@ class BRAVE_DD::UnaryOperation : public Operation {
     /* Main part: check forest comatability and then calls corresponding op compute */
     void compute(const Func& source, Func& target);
     void compute(const Func& source, long& target);
-    void compute(const Func& source, unsigned long& target);    // for large numbers? TBD
+    void compute(const Func& source, unsigned long& target);
     void compute(const Func& source, double& target);
+    // counts beyond 64 bits: exact modulo 2^128, exact, and log-domain estimate
+    void compute(const Func& source, UInt128& target);
+    void compute(const Func& source, BigCount& target);
+    void compute(const Func& source, LogCount& target);
     // for concretizing
     void compute(const Func& source, const Func& dc, Func& target);
     void compute(const Func& source, const Value& val, Func& target);
+    // quantifying the variables at the given levels, both unprimed and primed for relations
+    void compute(const Func& source, const std::vector<uint16_t>& vars, Func& target);
     /*-------------------------------------------------------------*/
     protected:
     /*-------------------------------------------------------------*/
@@ -277,9 +442,17 @@ class BRAVE_DD::UnaryOperation : public Operation {
     /// Helper Methods ==============================================
     bool checkForestCompatibility() const;
     Edge computeCOPY(const Level lvl, const Edge& source);
+    // converting between forests with terminal encoding, node by node from the bottom level,
+    // see conversions
+    void convertNodes(const Edge& root);
+    Edge convertEdge(const Level lvl, const Edge& source);
     Edge computeCOMPLEMENT(const Level lvl, const Edge& source);
-    long computeCARD(const Level lvl, const Edge& source);
-    unsigned long computeCARD64(const Level lvl, const Edge& source);
+    /// Cardinality in count type N, see CountTraits; "counts" holds the node counts
+    /// for this call, when they can not be kept in nodeCounts
+    template <typename N>
+    void computeCount(const Func& source, N& target);
+    template <typename N>
+    N computeCARD(const Level lvl, const Edge& source, CountCache<N>& counts);
     // concretizing
     Edge computeRST(const Level lvl, const Edge& source, const Edge& dc);
     Edge computeRST(const Level lvl, const Edge& source, const Value& val);
@@ -294,14 +467,21 @@ class BRAVE_DD::UnaryOperation : public Operation {
     bool hasCommonTSM(const Edge& source1, const Edge& source2, const Value& val);
     Edge commonTSM(const Level lvl, const Edge& source1, const Edge& source2, const Edge& d1, const Edge& d2);
     Edge commonTSM(const Level lvl, const Edge& source1, const Edge& source2, const Value& val);
+    // quantifying the variables in the cube
+    Edge computeQUANT(const Level lvl, const Edge& source, const Edge& cube);
     // list
     friend class UnaryList;
+    UnaryOperation*     prev;
     UnaryOperation*     next;
     // arguments
     Forest*             sourceForest;
     Forest*             targetForest;
     OpndType            targetType;
     UnaryOperationType  opType;
+    // node counts kept across cardinality calls, swept with the forest
+    CountStore          nodeCounts;
+    // source nodes converted by UOP_COPY, kept across calls and swept with both forests
+    ConversionCache     conversions;
 };
 
 // ******************************************************************
@@ -313,55 +493,56 @@ class BRAVE_DD::UnaryOperation : public Operation {
 class BRAVE_DD::UnaryList {
     std::string name;
     UnaryOperation* front;
+    OperationIndex<UnaryOperation> index;
     /*-------------------------------------------------------------*/
     public:
     /*-------------------------------------------------------------*/
     UnaryList(const std::string n = "");
     inline void reset(const std::string n) {
         front = nullptr;
+        index.clear();
         name = n;
     }
     inline std::string getName() const {return name;}
     inline bool isEmpty() const {return !front;}
     inline UnaryOperation* add(UnaryOperation* uop) {
         if (uop) {
+            uop->prev = nullptr;
             uop->next = front;
+            if (front) front->prev = uop;
             front = uop;
+            index.add(keyOf(uop), uop);
         }
         return uop;
     }
     inline void remove(UnaryOperation* uop) {
-        if (front == uop) {
-            UnaryOperation* toRemove = front;
-            front = front->next;
-            delete toRemove;
-            return;
-        }
-        searchRemove(uop);
+        if (!uop || !index.remove(uop)) return;
+        if (uop->prev) uop->prev->next = uop->next;
+        else front = uop->next;
+        if (uop->next) uop->next->prev = uop->prev;
+        delete uop;
     }
     // find and remove the operation including the given forest
     inline void remove(Forest* forest) { searchRemove(forest); }
     inline UnaryOperation* find(const UnaryOperationType opT, const Forest* sourceF, const Forest* targetF) {
-        if (!front) return nullptr;
-        if ((front->opType == opT) && (front->sourceForest == sourceF) && (front->targetForest == targetF)) return front;
-        return mtfUnary(opT, sourceF, targetF);
+        return index.find(OperationKey((int)opT, sourceF, targetF, nullptr, nullptr, (int)OpndType::FOREST));
     }
     inline UnaryOperation* find(const UnaryOperationType opT, const Forest* sourceF, const OpndType targetT) {
-        if (!front) return nullptr;
-        if ((front->opType == opT) && (front->sourceForest == sourceF) && (front->targetType == targetT)) return front;
-        return mtfUnary(opT, sourceF, targetT);
+        // the target forest of these operations is the source forest
+        return index.find(OperationKey((int)opT, sourceF, sourceF, nullptr, nullptr, (int)targetT));
     }
     inline void sweepCache(Forest* forest) { searchSweepCache(forest); }
+    /// Flag the pooled terminals held by the caches, see TerminalPool::sweep
+    void markPooled(std::vector<bool>& used) const;
     void reportCacheStat(std::ostream& out, int format=0) const;
     /*-------------------------------------------------------------*/
     private:
     /*-------------------------------------------------------------*/
-    void searchRemove(UnaryOperation* uop);
+    static inline OperationKey keyOf(const UnaryOperation* uop) {
+        return OperationKey((int)uop->opType, uop->sourceForest, uop->targetForest, nullptr, nullptr, (int)uop->targetType);
+    }
     void searchRemove(Forest* forest);
     void searchSweepCache(Forest* forest);
-    UnaryOperation* mtfUnary(const UnaryOperationType opT, const Forest* sourceF, const Forest* targetF);
-    UnaryOperation* mtfUnary(const UnaryOperationType opT, const Forest* sourceF, const OpndType targetT);
-
 };
 
 // ******************************************************************
@@ -380,6 +561,18 @@ class BRAVE_DD::BinaryOperation : public Operation {
     /* Main part: computation */
     void compute(const Func& source1, const Func& source2, Func& res);
     void compute(const Func& source1, const ExplictFunc& source2, Func& res);
+    /* Image of source1 by source2 pruned by the visited set:
+     * res gets the image states not in visited, and visited gets them added */
+    void compute(const Func& source1, const Func& source2, Func& visited, Func& res);
+    /* Conjunction of source1 and source2 with the variables at the given levels quantified
+     * existentially, without building the conjunction */
+    void compute(const Func& source1, const Func& source2, const std::vector<uint16_t>& vars, Func& res);
+    /* Union, Intersection, Minimum or Maximum of all the sources, recursing on all of them at once
+     * instead of folding the binary operation over them */
+    void compute(const std::vector<Func>& sources, Func& res);
+    /* The operation on every pair (sources1[i], sources2[i]) in one pass: the copy operations are
+     * found once, and the repeated pairs are computed once */
+    void compute(const std::vector<Func>& sources1, const std::vector<Func>& sources2, std::vector<Func>& res);
     /*-------------------------------------------------------------*/
     protected:
     /*-------------------------------------------------------------*/
@@ -392,10 +585,14 @@ class BRAVE_DD::BinaryOperation : public Operation {
     /// Helper Methods ==============================================
     bool checkForestCompatibility() const;
     Edge computeElmtWise(const Level lvl, const Edge& source1, const Edge& source2);
+    Edge computeElmtWiseMult(const Level lvl, const Edge& source1, const Edge& source2);
     Edge computeUnion(const Level lvl, const Edge& source1, const Edge& source2);
     Edge computeIntersection(const Level lvl, const Edge& source1, const Edge& source2);
     Edge computeImage(const Level lvl, const Edge& source1, const Edge& trans, bool isPre = 0);
     Edge computeImageDistance(const Level lvl, const Edge& source1, const Edge& trans, bool isPre = 0);
+    Edge computeImageNew(const Level lvl, const Edge& source1, const Edge& trans, const Edge& visited, bool isPre = 0);
+    Edge computeAndExists(const Level lvl, const Edge& source1, const Edge& source2, const Edge& cube);
+    Edge computeNary(const Level lvl, const std::vector<Edge>& sources);
     Edge computePlus(const Level lvl, const Edge& source1, const Edge& source2);
     // elementwise related
     Edge operateLL(const Level lvl, const Edge& e1, const Edge& e2);
@@ -403,8 +600,10 @@ class BRAVE_DD::BinaryOperation : public Operation {
     Edge operateLH(const Level lvl, const Edge& e1, const Edge& e2);
     // list
     friend class BinaryList;
+    BinaryOperation*    prev;
     BinaryOperation*    next;
     friend class UnaryOperation;
+    friend class TernaryOperation;
     friend class SaturationOperation;
     // arguments
     Forest*             source1Forest;
@@ -412,6 +611,20 @@ class BRAVE_DD::BinaryOperation : public Operation {
     OpndType            source2Type;
     Forest*             resForest;
     BinaryOperationType opType;
+    // results of computeNary in one compute call, per level; the operand lists do not fit the
+    // compute table entries
+    struct EdgesHash {
+        inline size_t operator()(const std::vector<Edge>& edges) const {
+            hash_stream hs;
+            hs.start();
+            for (size_t i=0; i<edges.size(); i++) {
+                hs.push((unsigned)(edges[i].getEdgeHandle() >> 32));
+                hs.push((unsigned)edges[i].getEdgeHandle());
+            }
+            return (size_t)hs.finish64();
+        }
+    };
+    std::vector<std::unordered_map<std::vector<Edge>, Edge, EdgesHash> >  naryCache;
 };
 
 // ******************************************************************
@@ -423,54 +636,154 @@ class BRAVE_DD::BinaryOperation : public Operation {
 class BRAVE_DD::BinaryList {
     std::string name;
     BinaryOperation* front;
+    OperationIndex<BinaryOperation> index;
     /*-------------------------------------------------------------*/
     public:
     /*-------------------------------------------------------------*/
     BinaryList(const std::string n = "");
     inline void reset(const std::string n) {
         front = nullptr;
+        index.clear();
         name = n;
     }
     inline std::string getName() const {return name;}
     inline bool isEmpty() const {return !front;}
     inline BinaryOperation* add(BinaryOperation* bop) {
         if (bop) {
+            bop->prev = nullptr;
             bop->next = front;
+            if (front) front->prev = bop;
             front = bop;
+            index.add(keyOf(bop), bop);
         }
         return bop;
     }
     inline void remove(BinaryOperation* bop) {
-        if (front == bop) {
-            BinaryOperation* toRemove = front;
-            front = front->next;
-            delete toRemove;
-            return;
-        }
-        searchRemove(bop);
+        if (!bop || !index.remove(bop)) return;
+        if (bop->prev) bop->prev->next = bop->next;
+        else front = bop->next;
+        if (bop->next) bop->next->prev = bop->prev;
+        delete bop;
     }
     // find and remove the operation including the given forest
     inline void remove(Forest* forest) { searchRemove(forest); }
     inline BinaryOperation* find(const BinaryOperationType opT, const Forest* source1F, const Forest* source2F, const Forest* resF) {
-        if (!front) return nullptr;
-        if ((front->opType == opT) && (front->source1Forest == source1F) && (front->source2Forest == source2F) && (front->resForest == resF)) return front;
-        return mtfBinary(opT, source1F, source2F, resF);
+        return index.find(OperationKey((int)opT, source1F, source2F, resF, nullptr, (int)OpndType::FOREST));
     }
     inline BinaryOperation* find(const BinaryOperationType opT, const Forest* source1F, const OpndType source2T, const Forest* resF) {
-        if (!front) return nullptr;
-        if ((front->opType == opT) && (front->source1Forest == source1F) && (front->source2Type == source2T) && (front->resForest == resF)) return front;
-        return mtfBinary(opT, source1F, source2T, resF);
+        // the second source forest of these operations is the first one
+        return index.find(OperationKey((int)opT, source1F, source1F, resF, nullptr, (int)source2T));
     }
     inline void sweepCache(Forest* forest) { searchSweepCache(forest); }
+    /// Flag the pooled terminals held by the caches, see TerminalPool::sweep
+    void markPooled(std::vector<bool>& used) const;
     void reportCacheStat(std::ostream& out, int format=0) const;
     /*-------------------------------------------------------------*/
     private:
     /*-------------------------------------------------------------*/
-    void searchRemove(BinaryOperation* bop);
+    static inline OperationKey keyOf(const BinaryOperation* bop) {
+        return OperationKey((int)bop->opType, bop->source1Forest, bop->source2Forest, bop->resForest, nullptr,
+                            (int)bop->source2Type);
+    }
+    void searchRemove(Forest* forest);
+    void searchSweepCache(Forest* forest);
+};
+
+// ******************************************************************
+// *                                                                *
+// *                  TernaryOperation  class                       *
+// *                                                                *
+// ******************************************************************
+
+class BRAVE_DD::TernaryOperation : public Operation {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    TernaryOperation(TernaryOperationType type, Forest* source1, Forest* source2, Forest* source3, Forest* res);
+
+    /* Main part: computation */
+    void compute(const Func& source1, const Func& source2, const Func& source3, Func& res);
+    /*-------------------------------------------------------------*/
+    protected:
+    /*-------------------------------------------------------------*/
+    virtual ~TernaryOperation();
+    void sweepAndEnlarge(const size_t cacheID) override;
+
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    /// Helper Methods ==============================================
+    bool checkForestCompatibility() const;
+    Edge computeITE(const Level lvl, const Edge& source1, const Edge& source2, const Edge& source3);
+    // the cases of ITE that are binary operations, computed by their kernels and caches
+    Edge computeBinary(const BinaryOperationType type, const Level lvl, const Edge& e1, const Edge& e2);
+    // list
+    friend class TernaryList;
+    TernaryOperation*       prev;
+    TernaryOperation*       next;
+    // arguments
+    Forest*                 source1Forest;
+    Forest*                 source2Forest;
+    Forest*                 source3Forest;
+    Forest*                 resForest;
+    TernaryOperationType    opType;
+};
+
+// ******************************************************************
+// *                                                                *
+// *                       TernaryList  class                       *
+// *                                                                *
+// ******************************************************************
+
+class BRAVE_DD::TernaryList {
+    std::string name;
+    TernaryOperation* front;
+    OperationIndex<TernaryOperation> index;
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    TernaryList(const std::string n = "");
+    inline void reset(const std::string n) {
+        front = nullptr;
+        index.clear();
+        name = n;
+    }
+    inline std::string getName() const {return name;}
+    inline bool isEmpty() const {return !front;}
+    inline TernaryOperation* add(TernaryOperation* top) {
+        if (top) {
+            top->prev = nullptr;
+            top->next = front;
+            if (front) front->prev = top;
+            front = top;
+            index.add(keyOf(top), top);
+        }
+        return top;
+    }
+    inline void remove(TernaryOperation* top) {
+        if (!top || !index.remove(top)) return;
+        if (top->prev) top->prev->next = top->next;
+        else front = top->next;
+        if (top->next) top->next->prev = top->prev;
+        delete top;
+    }
+    // find and remove the operation including the given forest
+    inline void remove(Forest* forest) { searchRemove(forest); }
+    inline TernaryOperation* find(const TernaryOperationType opT, const Forest* source1F, const Forest* source2F, const Forest* source3F, const Forest* resF) {
+        return index.find(OperationKey((int)opT, source1F, source2F, source3F, resF, 0));
+    }
+    inline void sweepCache(Forest* forest) { searchSweepCache(forest); }
+    /// Flag the pooled terminals held by the caches, see TerminalPool::sweep
+    void markPooled(std::vector<bool>& used) const;
+    void reportCacheStat(std::ostream& out, int format=0) const;
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    static inline OperationKey keyOf(const TernaryOperation* top) {
+        return OperationKey((int)top->opType, top->source1Forest, top->source2Forest, top->source3Forest, top->resForest, 0);
+    }
     void searchRemove(Forest* forest);
     void searchSweepCache(Forest* forest);
-    BinaryOperation* mtfBinary(const BinaryOperationType opT, const Forest* source1F, const Forest* source2F, const Forest* resF);
-    BinaryOperation* mtfBinary(const BinaryOperationType opT, const Forest* source1F, const OpndType source2T, const Forest* resF);
 };
 
 // ******************************************************************
@@ -505,12 +818,11 @@ class BRAVE_DD::SaturationOperation : public Operation {
     /*-------------------------------------------------------------*/
     public:
     /*-------------------------------------------------------------*/
-    SaturationOperation(Forest* source1, Forest* source2, Forest* res);
+    /* the direction (isPre: backward) is fixed, as SaturationList keys the operation on it */
+    SaturationOperation(Forest* source1, Forest* source2, Forest* res, const bool dir = 0);
 
     /* set relations */
     void setRelations(const std::vector<Func>& rels);
-    /* set direction */
-    void setDirection(const bool dir);
     /* Main part: computation */
     void compute(const Func& source1, Func& res);
 
@@ -536,13 +848,17 @@ class BRAVE_DD::SaturationOperation : public Operation {
     int indexOfTopLessThan(const Level k);
     // list
     friend class SaturationList;
+    SaturationOperation*    prev;
     SaturationOperation*    next;
     // arguments
     Forest*                 source1Forest;
     Forest*                 source2Forest;
     Forest*                 resForest;
     std::vector<Func>       relations;
-    bool                    isPre;
+    const bool              isPre;
+    // the operations used at each firing, set by compute
+    BinaryOperation*        unionOp;
+    BinaryOperation*        plusOp;
 };
 
 // ******************************************************************
@@ -554,50 +870,54 @@ class BRAVE_DD::SaturationOperation : public Operation {
 class BRAVE_DD::SaturationList {
     std::string name;
     SaturationOperation* front;
+    OperationIndex<SaturationOperation> index;
     /*-------------------------------------------------------------*/
     public:
     /*-------------------------------------------------------------*/
     SaturationList(const std::string n = "");
     inline void reset(const std::string n) {
         front = nullptr;
+        index.clear();
         name = n;
     }
     inline std::string getName() const {return name;}
     inline bool isEmpty() const {return !front;}
     inline SaturationOperation* add(SaturationOperation* sop) {
         if (sop) {
+            sop->prev = nullptr;
             sop->next = front;
+            if (front) front->prev = sop;
             front = sop;
+            index.add(keyOf(sop), sop);
         }
         return sop;
     }
     inline void remove(SaturationOperation* sop) {
-        if (front == sop) {
-            SaturationOperation* toRemove = front;
-            front = front->next;
-            delete toRemove;
-            return;
-        }
-        searchRemove(sop);
+        if (!sop || !index.remove(sop)) return;
+        if (sop->prev) sop->prev->next = sop->next;
+        else front = sop->next;
+        if (sop->next) sop->next->prev = sop->prev;
+        delete sop;
     }
     // find and remove the operation including the given forest
     inline void remove(Forest* forest) { searchRemove(forest); }
     inline SaturationOperation* find(const Forest* source1F, const Forest* source2F, const Forest* resF, const bool dir = 0) {
-        if (!front) return nullptr;
-        if ((front->source1Forest == source1F) && (front->source2Forest == source2F) && (front->resForest == resF) && (front->isPre == dir)) return front;
-        return mtfSaturation(source1F, source2F, resF);
+        return index.find(OperationKey((int)dir, source1F, source2F, resF, nullptr, 0));
     }
     inline void sweepCache(Forest* forest) { searchSweepCache(forest); }
+    /// Flag the pooled terminals held by the caches, see TerminalPool::sweep
+    void markPooled(std::vector<bool>& used) const;
     void reportCacheStat(std::ostream& out, int format=0) const;
 
     /*-------------------------------------------------------------*/
     private:
     /*-------------------------------------------------------------*/
     /// Helper Methods ==============================================
-    void searchRemove(SaturationOperation* bop);
+    static inline OperationKey keyOf(const SaturationOperation* sop) {
+        return OperationKey((int)sop->isPre, sop->source1Forest, sop->source2Forest, sop->resForest, nullptr, 0);
+    }
     void searchRemove(Forest* forest);
     void searchSweepCache(Forest* forest);
-    SaturationOperation* mtfSaturation(const Forest* source1F, const Forest* source2F, const Forest* resF);
 };
 
 #endif
\ No newline at end of file
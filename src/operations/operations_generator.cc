@@ -3,6 +3,7 @@
 namespace BRAVE_DD {
     UnaryList       UOPs;
     BinaryList      BOPs;
+    TernaryList     TOPs;
     SaturationList  SOPs;
 }
 
@@ -59,6 +60,50 @@ UnaryOperation* BRAVE_DD::CONCRETIZE_TSM(Forest* arg, Forest* res)
     return UOPs.add(new UnaryOperation(UnaryOperationType::UOP_CONCRETIZE_TSM, arg, res));
 }
 
+UnaryOperation* BRAVE_DD::EQUANTIFY(Forest* arg, Forest* res)
+{
+    if (!arg) return nullptr;
+    UnaryOperation* uop = UOPs.find(UnaryOperationType::UOP_EQUANTIFY, arg, res);
+    if (uop) return uop;
+    return UOPs.add(new UnaryOperation(UnaryOperationType::UOP_EQUANTIFY, arg, res));
+}
+UnaryOperation* BRAVE_DD::UQUANTIFY(Forest* arg, Forest* res)
+{
+    if (!arg) return nullptr;
+    UnaryOperation* uop = UOPs.find(UnaryOperationType::UOP_UQUANTIFY, arg, res);
+    if (uop) return uop;
+    return UOPs.add(new UnaryOperation(UnaryOperationType::UOP_UQUANTIFY, arg, res));
+}
+
+
+BinaryOperation* BRAVE_DD::PRE_IMAGE_NEW(Forest* arg1, Forest* arg2, Forest* res)
+{
+    if (!arg1 || !arg2) return nullptr;
+    BinaryOperation* bop = BOPs.find(BinaryOperationType::BOP_PREIMAGE_NEW, arg1, arg2, res);
+    if (bop) return bop;
+    bop = new BinaryOperation(BinaryOperationType::BOP_PREIMAGE_NEW, arg1, arg2, res);
+    return BOPs.add(bop);
+}
+
+BinaryOperation* BRAVE_DD::POST_IMAGE_NEW(Forest* arg1, Forest* arg2, Forest* res)
+{
+    if (!arg1 || !arg2) return nullptr;
+    BinaryOperation* bop = BOPs.find(BinaryOperationType::BOP_POSTIMAGE_NEW, arg1, arg2, res);
+    if (bop) return bop;
+    bop = new BinaryOperation(BinaryOperationType::BOP_POSTIMAGE_NEW, arg1, arg2, res);
+    return BOPs.add(bop);
+}
+
+BinaryOperation* BRAVE_DD::AND_EXISTS(Forest* arg1, Forest* arg2, Forest* res)
+{
+    if (!arg1 || !arg2) return nullptr;
+    // commute
+    if (arg1 > arg2) SWAP(arg1, arg2);
+    BinaryOperation* bop = BOPs.find(BinaryOperationType::BOP_ANDEXISTS, arg1, arg2, res);
+    if (bop) return bop;
+    bop = new BinaryOperation(BinaryOperationType::BOP_ANDEXISTS, arg1, arg2, res);
+    return BOPs.add(bop);
+}
 
 // ... TBD
 
@@ -94,6 +139,28 @@ BinaryOperation* BRAVE_DD::DIFFERENCE(Forest* arg1, Forest* arg2, Forest* res)
 }
 
 
+BinaryOperation* BRAVE_DD::XOR(Forest* arg1, Forest* arg2, Forest* res)
+{
+    if (!arg1 || !arg2) return nullptr;
+    // commute
+    if (arg1 > arg2) SWAP(arg1, arg2);
+    BinaryOperation* bop = BOPs.find(BinaryOperationType::BOP_XOR, arg1, arg2, res);
+    if (bop) return bop;
+    bop = new BinaryOperation(BinaryOperationType::BOP_XOR, arg1, arg2, res);
+    return BOPs.add(bop);
+}
+
+BinaryOperation* BRAVE_DD::XNOR(Forest* arg1, Forest* arg2, Forest* res)
+{
+    if (!arg1 || !arg2) return nullptr;
+    // commute
+    if (arg1 > arg2) SWAP(arg1, arg2);
+    BinaryOperation* bop = BOPs.find(BinaryOperationType::BOP_XNOR, arg1, arg2, res);
+    if (bop) return bop;
+    bop = new BinaryOperation(BinaryOperationType::BOP_XNOR, arg1, arg2, res);
+    return BOPs.add(bop);
+}
+
 BinaryOperation* BRAVE_DD::MINIMUM(Forest* arg1, Forest* arg2, Forest* res)
 {
     if (!arg1) return nullptr;
@@ -240,6 +307,16 @@ BinaryOperation* BRAVE_DD::POST_IMAGE(Forest* arg1, Forest* arg2, Forest* res)
 
 // ... TBD
 
+// Ternary operation
+TernaryOperation* BRAVE_DD::ITE(Forest* arg1, Forest* arg2, Forest* arg3, Forest* res)
+{
+    if (!arg1 || !arg2 || !arg3) return nullptr;
+    TernaryOperation* top = TOPs.find(TernaryOperationType::TOP_ITE, arg1, arg2, arg3, res);
+    if (top) return top;
+    top = new TernaryOperation(TernaryOperationType::TOP_ITE, arg1, arg2, arg3, res);
+    return TOPs.add(top);
+}
+
 // Saturation operation
 SaturationOperation* BRAVE_DD::SATURATE(Forest* set, Forest* relations, Forest* res)
 {
@@ -255,7 +332,6 @@ SaturationOperation* BRAVE_DD::PRE_SATURATE(Forest* set, Forest* relations, Fore
     if (!set || !relations) return nullptr;
     SaturationOperation* sop = SOPs.find(set, relations, res, 1);
     if (sop) return sop;
-    sop = new SaturationOperation(set, relations, res);
-    sop->setDirection(1);
+    sop = new SaturationOperation(set, relations, res, 1);
     return SOPs.add(sop);
 }
\ No newline at end of file
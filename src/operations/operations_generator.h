@@ -6,6 +6,11 @@
 #include "../function.h"
 #include "operation.h"
 
+/*
+ * Each generator returns the operation for its type and forests, creating it the first time.
+ * The operation is kept until one of its forests is destroyed, so it can be held and its
+ * compute called directly in a loop, without finding it again at each apply.
+ */
 namespace BRAVE_DD {
     // ******************************************************************
     // *                                                                *
@@ -23,8 +28,12 @@ namespace BRAVE_DD {
     UnaryOperation* CONCRETIZE_RST(Forest* arg, Forest* res);
     UnaryOperation* CONCRETIZE_OSM(Forest* arg, Forest* res);
     UnaryOperation* CONCRETIZE_TSM(Forest* arg, Forest* res);
-    UnaryOperation* EQUANTIFY(Forest* arg, std::vector<uint16_t> val, Forest* res);  // 2-L?
-    UnaryOperation* UQUANTIFY(Forest* arg, std::vector<uint16_t> val, Forest* res);
+    /**
+     * @brief Existential and universal quantification of the variables at the given levels
+     * (see apply), both unprimed and primed ones for relations. Only for terminal encoding.
+     */
+    UnaryOperation* EQUANTIFY(Forest* arg, Forest* res);
+    UnaryOperation* UQUANTIFY(Forest* arg, Forest* res);
 
     UnaryOperation* REORDER(Forest* arg, Forest* res);
 
@@ -38,6 +47,8 @@ namespace BRAVE_DD {
     BinaryOperation* UNION(Forest* arg1, Forest* arg2, Forest* res);
     BinaryOperation* INTERSECTION(Forest* arg1, Forest* arg2, Forest* res);
     BinaryOperation* DIFFERENCE(Forest* arg1, Forest* arg2, Forest* res);
+    BinaryOperation* XOR(Forest* arg1, Forest* arg2, Forest* res);
+    BinaryOperation* XNOR(Forest* arg1, Forest* arg2, Forest* res);
     BinaryOperation* MINIMUM(Forest* arg1, Forest* arg2, Forest* res);
     BinaryOperation* MINIMUM(Forest* arg1, OpndType arg2, Forest* res);
     BinaryOperation* MAXIMUM(Forest* arg1, Forest* arg2, Forest* res);
@@ -70,6 +81,19 @@ namespace BRAVE_DD {
     BinaryOperation* POST_PLUS(Forest* arg1, Forest* arg2, Forest* res);
     BinaryOperation* PRE_IMAGE(Forest* arg1, Forest* arg2, Forest* res);
     BinaryOperation* POST_IMAGE(Forest* arg1, Forest* arg2, Forest* res);
+    /**
+     * @brief Image of arg1 by arg2 together with a visited set in arg1: the image is
+     * pruned by the visited set while it is built, the result is the states not visited
+     * yet, and the visited set gets them. Only for Boolean forests with terminal encoding.
+     */
+    BinaryOperation* PRE_IMAGE_NEW(Forest* arg1, Forest* arg2, Forest* res);
+    BinaryOperation* POST_IMAGE_NEW(Forest* arg1, Forest* arg2, Forest* res);
+    /**
+     * @brief Relational product: the conjunction of arg1 and arg2 with the variables at the
+     * given levels (see apply) quantified existentially, computed in one pass without building
+     * the conjunction. Only for terminal encoding.
+     */
+    BinaryOperation* AND_EXISTS(Forest* arg1, Forest* arg2, Forest* res);
 
     BinaryOperation* VM_MULTIPLY(Forest* arg1, Forest* arg2, Forest* res);
     BinaryOperation* MV_MULTIPLY(Forest* arg1, Forest* arg2, Forest* res);
@@ -77,6 +101,19 @@ namespace BRAVE_DD {
 
 
 
+    // ******************************************************************
+    // *                                                                *
+    // *                       Ternary operations                       *
+    // *                                                                *
+    // ******************************************************************
+
+    /**
+     * @brief If-then-else of Boolean functions: res = (arg1 & arg2) | (!arg1 & arg3).
+     * The cases that are binary operations (e.g., ITE(f, 1, h) = f | h) are computed
+     * by the Boolean operators, so they share the caches.
+     */
+    TernaryOperation* ITE(Forest* arg1, Forest* arg2, Forest* arg3, Forest* res);
+
     // ******************************************************************
     // *                                                                *
     // *                       Numerical operations                     *
@@ -46,12 +46,8 @@ namespace BRAVE_DD {
     }
     Func operator^(const Func &f1, const Func &f2)
     {
-        // A xor B = (A or B) and not (A and B)
-        Func out1, out2, out;
-        out1 = f1 | f2;
-        out2 = f1 & f2;
-        out2 = !out2;
-        out = out1 & out2;
+        Func out(f1.getForest());
+        apply(XOR, f1, f2, out);
         return out;
     }
     Func operator!(const Func &e)
@@ -94,7 +90,8 @@ namespace BRAVE_DD {
     }
     Func operator^=(Func &f1, const Func &f2)
     {
-        return f1 ^ f2;
+        apply(XOR, f1, f2, f1);
+        return f1;
     }
 
     Func operator<(Func &f1, const Func &f2)
@@ -117,6 +114,14 @@ namespace BRAVE_DD {
         apply(GREATER_THAN_EQUAL, f1, f2, f1);
         return f1;
     }
+
+    Func ite(const Func &f, const Func &g, const Func &h)
+    {
+        Func out(f.getForest());
+        apply(ITE, f, g, h, out);
+        return out;
+    }
+
     /* These will let us do C++ style output, with our output class */
     inline Output& operator<<(Output &s, const ForestSetting &setting)
     {
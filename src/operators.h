@@ -33,6 +33,9 @@ namespace BRAVE_DD {
     Func operator<=(Func &f1, const Func &f2);
     Func operator>=(Func &f1, const Func &f2);
 
+    /* If-then-else of Boolean Funcs, in the forest of f */
+    Func ite(const Func &f, const Func &g, const Func &h);
+
     // Func operator!=(Func &f1, const Func &f2);
     // Func operator==(Func &f1, const Func &f2);
 
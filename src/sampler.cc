@@ -0,0 +1,187 @@
+#include "sampler.h"
+#include "forest.h"
+#include "error.h"
+
+using namespace BRAVE_DD;
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                      FuncSampler methods                       *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+FuncSampler::FuncSampler(const Func& f, const uint64_t seed)
+:func(f), gen(seed)
+{
+    forest = func.getForest();
+    const ForestSetting& setting = forest->getSetting();
+    // the members are the paths to terminal 1, as for the cardinality
+    if ((setting.getEncodeMechanism() != TERMINAL) || setting.hasNegInf() || setting.hasPosInf() || setting.hasUnDef()) {
+        throw error(ErrCode::INVALID_OPERATION, __FILE__, __LINE__);
+    }
+    numVars = setting.getNumVars();
+    isRel = setting.isRelation();
+    count = edgeCount(numVars, func.getEdge());
+}
+FuncSampler::~FuncSampler()
+{
+    //
+}
+
+bool FuncSampler::sample(std::vector<bool>& assignment)
+{
+    std::vector<bool> to;
+    return sample(assignment, to);
+}
+
+bool FuncSampler::sample(std::vector<bool>& aFrom, std::vector<bool>& aTo)
+{
+    if (isEmpty()) return 0;
+    aFrom.assign(numVars+1, 0);
+    aTo.assign((isRel) ? numVars+1 : 0, 0);
+    draw(aFrom, aTo);
+    return 1;
+}
+
+bool FuncSampler::sample(const size_t num, std::vector<std::vector<uint64_t> >& samples)
+{
+    std::vector<std::vector<uint64_t> > to;
+    return sample(num, samples, to);
+}
+
+bool FuncSampler::sample(const size_t num, std::vector<std::vector<uint64_t> >& aFrom, std::vector<std::vector<uint64_t> >& aTo)
+{
+    if (isEmpty()) return 0;
+    size_t numWords = (num + 63) / 64;
+    aFrom.assign(numVars+1, std::vector<uint64_t>(numWords, 0));
+    aTo.assign((isRel) ? numVars+1 : 0, std::vector<uint64_t>(numWords, 0));
+    std::vector<bool> from(numVars+1, 0), to((isRel) ? numVars+1 : 0, 0);
+    for (size_t n=0; n<num; n++) {
+        draw(from, to);
+        for (Level k=1; k<=numVars; k++) {
+            if (from[k]) aFrom[k][n/64] |= uint64_t(1) << (n%64);
+            if (isRel && to[k]) aTo[k][n/64] |= uint64_t(1) << (n%64);
+        }
+    }
+    return 1;
+}
+
+/* The members below a node with rule X, over the levels up to its own */
+LogCount FuncSampler::nodeCount(const Edge& node)
+{
+    Level lvl = node.getNodeLevel();
+    if (lvl == 0) return (node.getComp() ^ isTerminalOne(node.getEdgeHandle())) ? LogCount::pow2(0) : LogCount();
+    LogCount num;
+    if (counts.check(lvl, node.getNodeHandle(), node.getComp(), num)) return num;
+    // swapping only permutes the assignments, so it shares the count
+    char numChild = (isRel) ? 4 : 2;
+    for (char c=0; c<numChild; c++) num += edgeCount(lvl-1, func.childEdge(node, c));
+    counts.add(lvl, node.getNodeHandle(), node.getComp(), num);
+    return num;
+}
+
+/* The members below an edge, over the levels up to lvl */
+LogCount FuncSampler::edgeCount(const Level lvl, const Edge& edge)
+{
+    return countLongEdge(nodeCount(edge), lvl, edge.getNodeLevel(), edge.getRule(), (isRel) ? 2 : 1);
+}
+
+/* An index drawn with the probability of its weight, given as log2 */
+size_t FuncSampler::choose(const std::vector<double>& log2Weights)
+{
+    double max = -INFINITY;
+    for (size_t i=0; i<log2Weights.size(); i++) max = (log2Weights[i] > max) ? log2Weights[i] : max;
+    double sum = 0.0;
+    for (size_t i=0; i<log2Weights.size(); i++) sum += std::exp2(log2Weights[i] - max);
+    double r = std::ldexp((double)(gen() >> 11), -53) * sum;
+    size_t last = 0;
+    for (size_t i=0; i<log2Weights.size(); i++) {
+        double w = std::exp2(log2Weights[i] - max);
+        if (w == 0.0) continue;
+        if (r < w) return i;
+        r -= w;
+        last = i;
+    }
+    // rounding
+    return last;
+}
+
+/*
+ *  The levels skipped by a long edge with rule EL, EH, AL or AH are all equal to some value v
+ *  (pattern 0), or equal to v down to the first level i that is not (pattern p, i = top-p+1),
+ *  the levels below i being free. One of the two reaches the target, the other the terminal of
+ *  the rule. For rule I on relations, v means "from and to are the same".
+ */
+void FuncSampler::draw(std::vector<bool>& aFrom, std::vector<bool>& aTo)
+{
+    Edge current = func.getEdge();
+    Level top = numVars;
+    while (true) {
+        Level m = current.getNodeLevel();
+        ReductionRule rule = current.getRule();
+        Level skip = top - m;
+        if ((skip > 0) && ((rule == RULE_X) || (isRel && !isRuleI(rule)))) {
+            drawAny(top, m+1, aFrom, aTo);
+        } else if (skip > 0) {
+            double num = nodeCount(current).getLog2();
+            bool isOne = hasRuleTerminalOne(rule);
+            bool isUniformEnd = isRuleAL(rule) || isRuleAH(rule);
+            bool v = isRuleEL(rule) || isRuleAH(rule);
+            weights.assign(skip+1, -INFINITY);
+            for (Level p=0; p<=skip; p++) {
+                Level i = (p == 0) ? 0 : top - p + 1;
+                if (isRel) {
+                    // the same levels have 2 choices, the first different 2, the free 4
+                    if (p == 0) weights[p] = num + skip;
+                    else if (isOne) weights[p] = (top - i) + 1 + 2*(i-1);
+                } else {
+                    bool isEnd = (p == 0) == isUniformEnd;
+                    Level free = (p == 0) ? 0 : i-1-m;
+                    if (!isEnd) weights[p] = num + free;
+                    else if (isOne) weights[p] = free + m;
+                }
+            }
+            Level p = (Level)choose(weights);
+            Level i = (p == 0) ? 0 : top - p + 1;
+            for (Level k=top; k>m; k--) {
+                if (k < i) {
+                    drawAny(k, k, aFrom, aTo);
+                } else if (isRel) {
+                    aFrom[k] = gen() & 0x01;
+                    aTo[k] = (k == i) ? !aFrom[k] : aFrom[k];
+                } else {
+                    aFrom[k] = (k == i) ? !v : v;
+                }
+            }
+            if ((p == 0) == isUniformEnd) {
+                // the rule terminal: every assignment below is a member
+                drawAny(m, 1, aFrom, aTo);
+                return;
+            }
+        }
+        if (m == 0) return;
+        /* a child with the probability of its count */
+        char numChild = (isRel) ? 4 : 2;
+        weights.assign(numChild, -INFINITY);
+        for (char c=0; c<numChild; c++) weights[c] = edgeCount(m-1, func.childEdge(current, c)).getLog2();
+        char c = (char)choose(weights);
+        if (isRel) {
+            aFrom[m] = c >> 1;
+            aTo[m] = c & 0x01;
+        } else {
+            aFrom[m] = c;
+        }
+        current = func.childEdge(current, c);
+        top = m-1;
+    }
+}
+
+void FuncSampler::drawAny(Level top, Level bottom, std::vector<bool>& aFrom, std::vector<bool>& aTo)
+{
+    for (Level k=top; k>=bottom; k--) {
+        uint64_t bits = gen();
+        aFrom[k] = bits & 0x01;
+        if (isRel) aTo[k] = bits & 0x02;
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef BRAVE_DD_SAMPLER_H
+#define BRAVE_DD_SAMPLER_H
+
+#include "defines.h"
+#include "edge.h"
+#include "function.h"
+#include "operations/count.h"
+
+#include <random>
+
+namespace BRAVE_DD {
+    class FuncSampler;
+    class Forest;
+};
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                       FuncSampler class                        *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/**
+ * @brief Uniformly random members of the set (or relation) of a Func with terminal encoding.
+ *
+ * The number of members below each node is counted once, in the log domain as the cardinality
+ * operation does with LogCount, so the sets may be of any size. A sample then goes down from
+ * the root in O(levels): at each node a child is chosen with the probability of its count, and
+ * the levels skipped by a long edge are chosen according to its rule (EL, EH, AL, AH, and I for
+ * relations), weighting the assignments that reach the target and those that reach the rule
+ * terminal. The probabilities are exact up to the double precision of the counts.
+ *
+ * The Func is kept by the sampler; the forest must not be changed while sampling.
+ */
+class BRAVE_DD::FuncSampler {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    FuncSampler(const Func& func, const uint64_t seed = 0);
+    ~FuncSampler();
+
+    /* The number of members sampled from */
+    inline LogCount getCount() const {return count;}
+    inline bool isEmpty() const {return count.isZero();}
+
+    /** Draw a member; false if the set is empty.
+     *  Note: the first element of "assignment" (assignment[0]) is not used!
+     */
+    bool sample(std::vector<bool>& assignment);
+    bool sample(std::vector<bool>& aFrom, std::vector<bool>& aTo);
+    /**
+     * Draw num members, bit-packed by variable as for the batched Func::evaluate: bit n%64 of
+     * word n/64 of samples[k] is the variable k of the member n. False if the set is empty.
+     */
+    bool sample(const size_t num, std::vector<std::vector<uint64_t> >& samples);
+    bool sample(const size_t num, std::vector<std::vector<uint64_t> >& aFrom, std::vector<std::vector<uint64_t> >& aTo);
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    LogCount nodeCount(const Edge& node);
+    LogCount edgeCount(const Level lvl, const Edge& edge);
+    size_t choose(const std::vector<double>& log2Weights);
+    void draw(std::vector<bool>& aFrom, std::vector<bool>& aTo);
+    void drawAny(Level top, Level bottom, std::vector<bool>& aFrom, std::vector<bool>& aTo);
+
+    Func                    func;
+    Forest*                 forest;
+    Level                   numVars;
+    bool                    isRel;
+    NodeCounts<LogCount>    counts;     // of the nodes with rule X, by (level, handle, complement)
+    LogCount                count;      // of the root edge
+    std::mt19937_64         gen;
+    std::vector<double>     weights;    // reused by choose
+};
+
+#endif
@@ -153,6 +153,18 @@ ForestSetting::ForestSetting(const PredefForest type, const unsigned numVals, co
         // Effectively this will act as if there is no mu
         // User will have to set mod value in order to benefit from it
         range.setMaxRange(std::numeric_limits<unsigned long>::max());
+    } else if (type == PredefForest::EVSTARQBDD) {
+        // setting for EV*QBDD
+        reductions = Reductions(QUASI);
+        name = "EV*QBDD";
+        encodingType = EDGE_MULT;
+        range = Range(RangeType::REAL,DOUBLE);
+    } else if (type == PredefForest::EVSTARFBDD) {
+        // setting for EV*FBDD
+        reductions = Reductions(FULLY);
+        name = "EV*FBDD";
+        encodingType = EDGE_MULT;
+        range = Range(RangeType::REAL,DOUBLE);
     } else if (type == PredefForest::EVQBMXD) {
         // setting for EVQBMxD
     } else if (type == PredefForest::EVFBMXDs) {
@@ -267,8 +279,12 @@ ForestSetting::ForestSetting(const std::string& bdd, const unsigned numVals, con
         name = "MTBDD";
         encodingType = TERMINAL;
         range = Range(RangeType::NNINTEGER,INT);
-    } else if (bddLower == "ev*qbdd") {
+    } else if (bddLower == "ev*qbdd" || bddLower == "evstarqbdd") {
         // setting for EV*QBDD
+        reductions = Reductions(QUASI);
+        name = "EV*QBDD";
+        encodingType = EDGE_MULT;
+        range = Range(RangeType::REAL,DOUBLE);
     } else if (bddLower == "evfbdd" || bddLower == "ev+fbdd") {
         // setting for EV+FBDD
         reductions = Reductions(FULLY);
@@ -291,6 +307,12 @@ ForestSetting::ForestSetting(const std::string& bdd, const unsigned numVals, con
         // Effectively this will act as if there is no mu
         // User will have to set mod value in order to benefit from it
         range.setMaxRange(std::numeric_limits<unsigned long>::max());
+    } else if (bddLower == "ev*fbdd" || bddLower == "evstarfbdd") {
+        // setting for EV*FBDD
+        reductions = Reductions(FULLY);
+        name = "EV*FBDD";
+        encodingType = EDGE_MULT;
+        range = Range(RangeType::REAL,DOUBLE);
     }
     // MxDs
     else if (bddLower == "qbmxd") {
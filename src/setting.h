@@ -28,7 +28,9 @@ namespace BRAVE_DD {
         EVMODQBDD,
         EVMODFBDD,
         EVQBMXD,
-        EVFBMXDs
+        EVFBMXDs,
+        EVSTARQBDD,
+        EVSTARFBDD
     };
     /// Encoding mechanism
     enum EncodeMechanism{
@@ -179,6 +181,14 @@ class BRAVE_DD::ForestSetting {
         inline int getReductionSize() const {return reductions.getNumRules();}
         /// Check if the given ReductionRule is applied 
         inline bool hasReductionRule(ReductionRule rule) const {return reductions.hasRule(rule);}
+        /// Get the applied reduction rules as a bit mask, bit k for ReductionRule k
+        inline uint16_t getReductionMask() const {return reductions.getRuleMask();}
+        /// Get the rule of an AL/AH edge skipping one level
+        inline ReductionRule getOneLevelRule(ReductionRule rule) const {return reductions.getOneLevelRule(rule);}
+        /// Get the rule of a long edge to constant 0/1, RULE_X if only X can represent it
+        inline ReductionRule getConstantRule(bool one) const {return reductions.getConstantRule(one);}
+        /// Get the rule of a bottom variable node with low child 0/1, RULE_X if none
+        inline ReductionRule getBottomRule(bool low) const {return reductions.getBottomRule(low);}
         /* Swap =========================================================================*/
         /// Get the type of swap flag applied
         inline SwapSet getSwapType() const {return flags.getSwapType();}
@@ -250,7 +260,11 @@ class BRAVE_DD::ForestSetting {
             if (reductionSize>0) lvlSlots = isRel ? 2 : 1;
             // check if this node needs value info; if so, what is the size
             ValueType valType = getValType();
-            if (encodingType != TERMINAL) {
+            if (encodingType == EDGE_MULT) {
+                // one weight per child edge, since both may differ from 1 (e.g., 0)
+                int valSlots = (valType==LONG || valType==DOUBLE) ? 2 : 1;
+                infoSize = isRel ? 6+4*valSlots : 4+2*valSlots;
+            } else if (encodingType != TERMINAL) {
                 if (valType==LONG || valType==DOUBLE) {
                     infoSize = isRel ? 6+3*2 : 4+2;
                 } else if (valType==INT || valType==FLOAT) {
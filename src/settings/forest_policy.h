@@ -0,0 +1,121 @@
+#ifndef BRAVE_DD_FOREST_POLICY_H
+#define BRAVE_DD_FOREST_POLICY_H
+
+#include "../defines.h"
+#include "../setting.h"
+
+namespace BRAVE_DD {
+    /// Reduction engine used by a forest
+    enum class ForestEngine {
+        GENERIC,            // runtime checks of the ForestSetting
+        REXBDD,             // compile-time settings of PredefForest::REXBDD
+        FBDD,               // compile-time settings of PredefForest::FBDD
+        CFBDD,              // compile-time settings of PredefForest::CFBDD
+        ESRBDD,             // compile-time settings of PredefForest::ESRBDD
+        QBMXD               // compile-time settings of PredefForest::QBMXD
+    };
+    static inline std::string forestEngine2String(ForestEngine fe) {
+        std::string engine;
+        if (fe == ForestEngine::GENERIC) engine = "Generic";
+        else if (fe == ForestEngine::REXBDD) engine = "RexBDD";
+        else if (fe == ForestEngine::FBDD) engine = "FBDD";
+        else if (fe == ForestEngine::CFBDD) engine = "CFBDD";
+        else if (fe == ForestEngine::ESRBDD) engine = "ESRBDD";
+        else if (fe == ForestEngine::QBMXD) engine = "QBMxD";
+        else engine = "Unknown";
+        return engine;
+    }
+    class DynamicPolicy;
+    template <bool REL, SwapSet SWAP, CompSet COMP, uint16_t RULES, int NUM_RULES, MergeType MERGE>
+    class StaticPolicy;
+    /* Reduction rules as bit masks, bit k is ReductionRule k, see Reductions::getRuleMask */
+    const uint16_t RULES_NONE = 0x0000;
+    const uint16_t RULES_FULLY = 0x0001 << RULE_X;
+    const uint16_t RULES_REX = 0x00FF | (0x0001 << RULE_X);
+    const uint16_t RULES_ESR = (0x0001 << RULE_X) | (0x0001 << RULE_EL0) | (0x0001 << RULE_EH0);
+    /* Policies of the predefined forests with specialized engines */
+    typedef StaticPolicy<false, ONE, COMP, RULES_REX, 9, PUSH_UP>         RexBDDPolicy;
+    typedef StaticPolicy<false, NO_SWAP, NO_COMP, RULES_FULLY, 1, NO_MERGE> FBDDPolicy;
+    typedef StaticPolicy<false, NO_SWAP, COMP, RULES_FULLY, 1, NO_MERGE>  CFBDDPolicy;
+    typedef StaticPolicy<false, NO_SWAP, NO_COMP, RULES_ESR, 3, PUSH_UP>  ESRBDDPolicy;
+    typedef StaticPolicy<true, NO_SWAP, NO_COMP, RULES_NONE, 0, NO_MERGE> QBMXDPolicy;
+}
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                      DynamicPolicy class                       *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/**
+ * The settings that the reduction engine branches on, read from a ForestSetting
+ * at runtime. This is the generic path for any user-configured forest.
+ */
+class BRAVE_DD::DynamicPolicy {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    DynamicPolicy(const ForestSetting& s):setting(s) {}
+    inline bool isRelation() const {return setting.isRelation();}
+    inline SwapSet getSwapType() const {return setting.getSwapType();}
+    inline CompSet getCompType() const {return setting.getCompType();}
+    inline EncodeMechanism getEncodeMechanism() const {return setting.getEncodeMechanism();}
+    inline ValueType getValType() const {return setting.getValType();}
+    inline int getReductionSize() const {return setting.getReductionSize();}
+    inline bool hasReductionRule(ReductionRule rule) const {return setting.hasReductionRule(rule);}
+    inline ReductionRule getOneLevelRule(ReductionRule rule) const {return setting.getOneLevelRule(rule);}
+    inline ReductionRule getConstantRule(bool one) const {return setting.getConstantRule(one);}
+    inline ReductionRule getBottomRule(bool low) const {return setting.getBottomRule(low);}
+    inline MergeType getMergeType() const {return setting.getMergeType();}
+    /*-------------------------------------------------------------*/
+    private:
+    /*-------------------------------------------------------------*/
+    const ForestSetting& setting;
+};
+
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                       StaticPolicy class                       *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+/**
+ * The same queries as DynamicPolicy, answered by template arguments, so that the
+ * compiler folds the branches of the reduction engine for a predefined forest.
+ * Only Boolean forests with terminal encoding and INT terminals are covered.
+ */
+template <bool REL, BRAVE_DD::SwapSet SWAP, BRAVE_DD::CompSet COMP, uint16_t RULES, int NUM_RULES, BRAVE_DD::MergeType MERGE>
+class BRAVE_DD::StaticPolicy {
+    /*-------------------------------------------------------------*/
+    public:
+    /*-------------------------------------------------------------*/
+    StaticPolicy() {}
+    inline bool isRelation() const {return REL;}
+    inline SwapSet getSwapType() const {return SWAP;}
+    inline CompSet getCompType() const {return COMP;}
+    inline EncodeMechanism getEncodeMechanism() const {return TERMINAL;}
+    inline ValueType getValType() const {return INT;}
+    inline int getReductionSize() const {return NUM_RULES;}
+    inline bool hasReductionRule(ReductionRule rule) const {return (RULES >> rule) & 0x01;}
+    inline ReductionRule getOneLevelRule(ReductionRule rule) const {return oneLevelRuleOf(RULES, rule);}
+    inline ReductionRule getConstantRule(bool one) const {return one ? constantRuleOf(RULES, 1) : constantRuleOf(RULES, 0);}
+    inline ReductionRule getBottomRule(bool low) const {return low ? bottomRuleOf(RULES, 1) : bottomRuleOf(RULES, 0);}
+    inline MergeType getMergeType() const {return MERGE;}
+
+    /**
+     * @brief Check if the given setting is exactly the one this policy encodes.
+     *
+     * @param s             The forest setting.
+     * @return true         - if the specialized engine can be used.
+     */
+    static inline bool matches(const ForestSetting& s) {
+        if ((s.isRelation() != REL) || (s.getSwapType() != SWAP) || (s.getCompType() != COMP)
+            || (s.getEncodeMechanism() != TERMINAL) || (s.getValType() != INT)
+            || (s.getMergeType() != MERGE) || (s.getRangeType() != BOOLEAN)) return false;
+        return s.getReductionMask() == RULES;
+    }
+};
+
+#endif
@@ -16,6 +16,7 @@ Reductions::Reductions()
     rules = std::vector<bool>(11,1);
     rules[RULE_I0] = 0;
     rules[RULE_I1] = 0;
+    buildTables();
 }
 Reductions::Reductions(const ReductionType reductionType)
 {
@@ -24,8 +25,28 @@ Reductions::Reductions(const ReductionType reductionType)
 Reductions::Reductions(const std::vector<bool> &ruleSet)
 {
     dimension = 1;
+    setRules(ruleSet);
 }
 Reductions::~Reductions()
 {
     //
-}
\ No newline at end of file
+}
+
+void Reductions::buildTables()
+{
+    ruleMask = 0;
+    numRules = 0;
+    for (size_t k=0; k<rules.size(); k++) {
+        if (rules[k]) {
+            ruleMask |= (0x01 << k);
+            numRules++;
+        }
+    }
+    for (int r=0; r<16; r++) {
+        oneLevelRules[r] = oneLevelRuleOf(ruleMask, r);
+    }
+    for (int b=0; b<2; b++) {
+        constantRules[b] = constantRuleOf(ruleMask, b);
+        bottomRules[b] = bottomRuleOf(ruleMask, b);
+    }
+}
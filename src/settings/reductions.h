@@ -78,79 +78,110 @@ namespace BRAVE_DD {
         RULE_X   = 9,
         RULE_I1  = 10
     } ReductionRule;
+    /// Rule properties, as bit flags
+    const uint16_t RULE_PROP_EL         = 0x0001;   // EL0 or EL1
+    const uint16_t RULE_PROP_EH         = 0x0002;   // EH0 or EH1
+    const uint16_t RULE_PROP_AL         = 0x0004;   // AL0 or AL1
+    const uint16_t RULE_PROP_AH         = 0x0008;   // AH0 or AH1
+    const uint16_t RULE_PROP_I          = 0x0010;   // I0 or I1
+    const uint16_t RULE_PROP_PATTERN_L  = 0x0020;   // skipped nodes hang below the low edge
+    const uint16_t RULE_PROP_PATTERN_H  = 0x0040;   // skipped nodes hang below the high edge
+    const uint16_t RULE_PROP_MERGEABLE  = 0x0080;   // two long edges of this rule merge into one
+    /* Generators of the rule tables below, following the bit layout above */
+    constexpr uint16_t rulePropertiesOf(int r) {
+        return (r >= RULE_I0)
+                ? ((r == RULE_I0 || r == RULE_I1) ? (RULE_PROP_I | RULE_PROP_MERGEABLE)
+                    : ((r == RULE_X) ? RULE_PROP_MERGEABLE : 0))
+                : (((r & 0x01) ? ((r & 0x04) ? RULE_PROP_AH : RULE_PROP_AL)
+                                : ((r & 0x04) ? RULE_PROP_EH : RULE_PROP_EL) | RULE_PROP_MERGEABLE)
+                    | ((((r & 0x01) != 0) == ((r & 0x04) != 0)) ? RULE_PROP_PATTERN_L : RULE_PROP_PATTERN_H));
+    }
+    constexpr ReductionRule compRuleOf(int r) {
+        return (ReductionRule)((r == RULE_X || r > RULE_I1) ? r : (r ^ 0x02));
+    }
+    constexpr ReductionRule swapRuleOf(int r) {
+        return (ReductionRule)((r < RULE_I0) ? (r ^ 0x04) : r);
+    }
+    /// Lookup tables indexed by the 4-bit rule field; entries above RULE_I1 are unused
+    constexpr uint16_t RULE_PROPERTIES[16] = {
+        rulePropertiesOf(0), rulePropertiesOf(1), rulePropertiesOf(2), rulePropertiesOf(3),
+        rulePropertiesOf(4), rulePropertiesOf(5), rulePropertiesOf(6), rulePropertiesOf(7),
+        rulePropertiesOf(8), rulePropertiesOf(9), rulePropertiesOf(10), 0, 0, 0, 0, 0
+    };
+    constexpr ReductionRule COMP_RULES[16] = {
+        compRuleOf(0), compRuleOf(1), compRuleOf(2), compRuleOf(3),
+        compRuleOf(4), compRuleOf(5), compRuleOf(6), compRuleOf(7),
+        compRuleOf(8), compRuleOf(9), compRuleOf(10), compRuleOf(11),
+        compRuleOf(12), compRuleOf(13), compRuleOf(14), compRuleOf(15)
+    };
+    constexpr ReductionRule SWAP_RULES[16] = {
+        swapRuleOf(0), swapRuleOf(1), swapRuleOf(2), swapRuleOf(3),
+        swapRuleOf(4), swapRuleOf(5), swapRuleOf(6), swapRuleOf(7),
+        swapRuleOf(8), swapRuleOf(9), swapRuleOf(10), swapRuleOf(11),
+        swapRuleOf(12), swapRuleOf(13), swapRuleOf(14), swapRuleOf(15)
+    };
+    static_assert((COMP_RULES[RULE_EL0] == RULE_EL1) && (COMP_RULES[RULE_AH1] == RULE_AH0)
+                    && (COMP_RULES[RULE_I0] == RULE_I1) && (COMP_RULES[RULE_X] == RULE_X), "complement rule table");
+    static_assert((SWAP_RULES[RULE_AL0] == RULE_AH0) && (SWAP_RULES[RULE_EH1] == RULE_EL1)
+                    && (SWAP_RULES[RULE_I1] == RULE_I1), "swap rule table");
+    static_assert((RULE_PROPERTIES[RULE_AH0] & RULE_PROP_PATTERN_L) && (RULE_PROPERTIES[RULE_AL1] & RULE_PROP_PATTERN_H)
+                    && !(RULE_PROPERTIES[RULE_AL0] & RULE_PROP_MERGEABLE), "rule property table");
+
     static inline ReductionRule compRule(ReductionRule rule) {
-        switch (rule) {
-            case RULE_EL0: return RULE_EL1;
-            case RULE_AL0: return RULE_AL1;
-            case RULE_EL1: return RULE_EL0;
-            case RULE_AL1: return RULE_AL0;
-            case RULE_EH0: return RULE_EH1;
-            case RULE_AH0: return RULE_AH1;
-            case RULE_EH1: return RULE_EH0;
-            case RULE_AH1: return RULE_AH0;
-            case RULE_I0:  return RULE_I1;
-            case RULE_X:   return RULE_X;
-            case RULE_I1:  return RULE_I0;
-            default: 
-                std::cout << "[BRAVE_DD] ERROR!\t Complement unknown reduction rule!" << std::endl;
-                exit(0);
+        if (rule > RULE_I1) {
+            std::cout << "[BRAVE_DD] ERROR!\t Complement unknown reduction rule!" << std::endl;
+            exit(0);
         }
+        return COMP_RULES[rule];
     }
     static inline ReductionRule swapRule(ReductionRule rule) {
-        switch (rule) {
-            case RULE_EL0: return RULE_EH0;
-            case RULE_AL0: return RULE_AH0;
-            case RULE_EL1: return RULE_EH1;
-            case RULE_AL1: return RULE_AH1;
-            case RULE_EH0: return RULE_EL0;
-            case RULE_AH0: return RULE_AL0;
-            case RULE_EH1: return RULE_EL1;
-            case RULE_AH1: return RULE_AL1;
-            case RULE_I0:  return RULE_I0;  // swap-from_to
-            case RULE_X:   return RULE_X;
-            case RULE_I1:  return RULE_I1;  // swap-from_to
-            default: 
-                std::cout << "[BRAVE_DD] ERROR!\t Complement unknown reduction rule!" << std::endl;
-                exit(0);
+        if (rule > RULE_I1) {
+            std::cout << "[BRAVE_DD] ERROR!\t Complement unknown reduction rule!" << std::endl;
+            exit(0);
         }
+        return SWAP_RULES[rule];
     }
     static inline bool hasRuleTerminalOne(ReductionRule rule) {
         return (bool)(rule & (0x01 << 1));
     }
     static inline bool isRuleEL(ReductionRule rule) {
-        return (rule == RULE_EL0 || rule == RULE_EL1);
+        return RULE_PROPERTIES[rule & 0x0F] & RULE_PROP_EL;
     }
     static inline bool isRuleEH(ReductionRule rule) {
-        return (rule == RULE_EH0 || rule == RULE_EH1);
+        return RULE_PROPERTIES[rule & 0x0F] & RULE_PROP_EH;
     }
     static inline bool isRuleAL(ReductionRule rule) {
-        return (rule == RULE_AL0 || rule == RULE_AL1);
+        return RULE_PROPERTIES[rule & 0x0F] & RULE_PROP_AL;
     }
     static inline bool isRuleAH(ReductionRule rule) {
-        return (rule == RULE_AH0 || rule == RULE_AH1);
+        return RULE_PROPERTIES[rule & 0x0F] & RULE_PROP_AH;
     }
     static inline bool isRuleI(ReductionRule rule) {
-        return (rule == RULE_I0 || rule == RULE_I1);
+        return RULE_PROPERTIES[rule & 0x0F] & RULE_PROP_I;
+    }
+    static inline bool isRuleMergeable(ReductionRule rule) {
+        return RULE_PROPERTIES[rule & 0x0F] & RULE_PROP_MERGEABLE;
     }
     static inline char rulePattern(ReductionRule rule) {
-        char type;
-        switch (rule) {
-            case RULE_EL0:
-            case RULE_EL1:
-            case RULE_AH0:
-            case RULE_AH1:
-                type = 'L';
-                break;
-            case RULE_EH0:
-            case RULE_EH1:
-            case RULE_AL0:
-            case RULE_AL1:
-                type = 'H';
-                break;
-            default:
-                type = 'U';
-        }
-        return type;
+        uint16_t prop = RULE_PROPERTIES[rule & 0x0F];
+        return (prop & RULE_PROP_PATTERN_L) ? 'L' : ((prop & RULE_PROP_PATTERN_H) ? 'H' : 'U');
+    }
+    /* Generators of the per-setting tables, "mask" has bit k set if ReductionRule k is allowed */
+    /// Rule of an AL/AH edge skipping one level: the EL/EH rule if allowed, the same rule otherwise
+    constexpr ReductionRule oneLevelRuleOf(uint16_t mask, int r) {
+        return ((r < RULE_I0) && (r & 0x01) && ((mask >> (r - 1)) & 0x01)) ? (ReductionRule)(r - 1) : (ReductionRule)r;
+    }
+    /// First allowed rule, other than X, of a long edge to constant "one"; RULE_X if none
+    constexpr ReductionRule constantRuleOf(uint16_t mask, bool one, int r = 0) {
+        return (r > RULE_I1) ? RULE_X
+                : (((r != RULE_X) && ((mask >> r) & 0x01) && (((r & 0x02) != 0) == one))
+                    ? (ReductionRule)r : constantRuleOf(mask, one, r + 1));
+    }
+    /// First allowed EL/AL/EH/AH rule of a bottom variable node whose low child is constant "low"; RULE_X if none
+    constexpr ReductionRule bottomRuleOf(uint16_t mask, bool low, int r = 0) {
+        return (r >= RULE_I0) ? RULE_X
+                : ((((mask >> r) & 0x01) && ((((r & 0x02) != 0) == low) == (r < RULE_EH0)))
+                    ? (ReductionRule)r : bottomRuleOf(mask, low, r + 1));
     }
     static inline std::string rule2String(ReductionRule rule) {
         switch (rule) {
@@ -225,10 +256,18 @@ class BRAVE_DD::Reductions {
         /// Get the type of reduction
         inline ReductionType getType() const {return type;}
         /// Get the size of reduction rules set
-        inline int getNumRules() const {return std::count(rules.begin(),rules.end(), 1);}
+        inline int getNumRules() const {return numRules;}
         inline std::vector<bool> getRules() const {return rules; }
+        /// Get the set of reduction rules as a bit mask, bit k for ReductionRule k
+        inline uint16_t getRuleMask() const {return ruleMask;}
         /// Check if the given ReductionRule has been set
-        inline bool hasRule(const ReductionRule rule) const {return rules[rule];}
+        inline bool hasRule(const ReductionRule rule) const {return (ruleMask >> rule) & 0x01;}
+        /// Rule of an AL/AH edge skipping one level, see oneLevelRuleOf
+        inline ReductionRule getOneLevelRule(const ReductionRule rule) const {return oneLevelRules[rule & 0x0F];}
+        /// Rule of a long edge to a constant, see constantRuleOf
+        inline ReductionRule getConstantRule(const bool one) const {return constantRules[one];}
+        /// Rule of a bottom variable node, see bottomRuleOf
+        inline ReductionRule getBottomRule(const bool low) const {return bottomRules[low];}
         inline ReductionType rules2Type(const std::vector<bool>& ruleSet) const {
             ReductionType ans = USER_DEFINED;
             int numOnes = std::count(ruleSet.begin(),ruleSet.end(), 1);
@@ -307,30 +346,42 @@ class BRAVE_DD::Reductions {
                 <<" Please check your input or add preferred rules by calling \"addReductionRule([PREFERRED RULE])\""<< std::endl;
                 throw error(ErrCode::UNINITIALIZED, __FILE__, __LINE__);
             }
+            buildTables();
         }
         inline void addRule(const ReductionRule rule) {
             // This will automatically switch the type to USER_DEFINED, if rule is not allowed before
             if (rules[rule]) return;
             rules[rule] = 1;
             type = rules2Type(rules);   // update type
+            buildTables();
         }
         inline void delRule(const ReductionRule rule) {
             // This will automatically switch the type to USER_DEFINED, if rule is allowed before
             if (!rules[rule]) return;
             rules[rule] = 0;
             type = rules2Type(rules);   // update type
+            buildTables();
         }
         inline void setRules(const std::vector<bool>& ruleSet) {
             type = rules2Type(ruleSet);
             rules = ruleSet;
+            buildTables();
         }
         
     /*-------------------------------------------------------------*/
     private:
     /*-------------------------------------------------------------*/
+        /// Rebuild the rule mask and the lookup tables after the rules change
+        void buildTables();
+
         int                 dimension;  // 1: set/vector function; 2: relation/matrix function
         ReductionType       type;       // type of reductions
         std::vector<bool>   rules;      // set of allowed reduction rules
+        uint16_t            ruleMask;   // the same set as a bit mask
+        int                 numRules;   // number of allowed reduction rules
+        ReductionRule       oneLevelRules[16];  // rule of an AL/AH edge skipping one level
+        ReductionRule       constantRules[2];   // rule of a long edge to constant 0/1
+        ReductionRule       bottomRules[2];     // rule of a bottom variable node with low child 0/1
 };
 
 
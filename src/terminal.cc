@@ -0,0 +1,150 @@
+#include "terminal.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace BRAVE_DD;
+// ******************************************************************
+// *                                                                *
+// *                                                                *
+// *                      TerminalPool  methods                     *
+// *                                                                *
+// *                                                                *
+// ******************************************************************
+
+TerminalPool& BRAVE_DD::terminalPool()
+{
+    static TerminalPool pool;
+    return pool;
+}
+
+// the constants at the fixed indices, never reclaimed
+static const uint32_t NUM_POOL_CONSTANTS = 4;
+
+uint32_t TerminalPool::intern(const long value)
+{
+    std::lock_guard<std::mutex> lock(guard);
+    return add(static_cast<uint64_t>(value), Value(value), longIndex);
+}
+
+uint32_t TerminalPool::intern(const double value)
+{
+    // one representative for 0.0/-0.0 and for NaNs
+    double canonical = value;
+    if (canonical == 0.0) canonical = 0.0;
+    if (std::isnan(canonical)) canonical = std::nan("");
+    uint64_t key;
+    memcpy(&key, &canonical, sizeof(double));
+    std::lock_guard<std::mutex> lock(guard);
+    return add(key, Value(canonical), doubleIndex);
+}
+
+Value TerminalPool::value(const uint32_t index) const
+{
+    std::lock_guard<std::mutex> lock(guard);
+    if ((index >= values.size()) || isFree[index]) {
+        std::cout << "[BRAVE_DD] ERROR!\t TerminalPool::value(): index " << index << " out of range!"<< std::endl;
+        throw error(ErrCode::INVALID_BOUND, __FILE__, __LINE__);
+    }
+    return values[index];
+}
+
+size_t TerminalPool::size() const
+{
+    std::lock_guard<std::mutex> lock(guard);
+    return values.size() - freeSlots.size();
+}
+
+size_t TerminalPool::capacity() const
+{
+    std::lock_guard<std::mutex> lock(guard);
+    return values.size();
+}
+
+void TerminalPool::attach()
+{
+    std::lock_guard<std::mutex> lock(guard);
+    numForests++;
+}
+
+void TerminalPool::detach()
+{
+    std::lock_guard<std::mutex> lock(guard);
+    numForests--;
+    if (numForests == 0) reset();
+}
+
+size_t TerminalPool::sweep(const std::vector<bool>& used)
+{
+    std::lock_guard<std::mutex> lock(guard);
+    if (numForests != 1) return 0;
+    size_t num = 0;
+    for (uint32_t i=NUM_POOL_CONSTANTS; (i<values.size()) && (i<used.size()); i++) {
+        if (isFree[i] || used[i]) continue;
+        if (values[i].getType() == LONG) longIndex.erase(keys[i]);
+        else doubleIndex.erase(keys[i]);
+        isFree[i] = 1;
+        num++;
+    }
+    if (num == 0) return 0;
+    // give back the free slots at the end, and list the others for reuse
+    while (isFree.back()) {
+        values.pop_back();
+        keys.pop_back();
+        isFree.pop_back();
+    }
+    freeSlots.clear();
+    for (uint32_t i=NUM_POOL_CONSTANTS; i<values.size(); i++) {
+        if (isFree[i]) freeSlots.push_back(i);
+    }
+    if (freeSlots.empty()) {
+        values.shrink_to_fit();
+        keys.shrink_to_fit();
+        isFree.shrink_to_fit();
+    }
+    return num;
+}
+
+uint32_t TerminalPool::add(const uint64_t key, const Value& val, std::unordered_map<uint64_t, uint32_t>& index)
+{
+    std::unordered_map<uint64_t, uint32_t>::const_iterator it = index.find(key);
+    if (it != index.end()) return it->second;
+    uint32_t idx;
+    if (!freeSlots.empty()) {
+        idx = freeSlots.back();
+        freeSlots.pop_back();
+        values[idx] = val;
+        keys[idx] = key;
+        isFree[idx] = 0;
+    } else {
+        if (values.size() >= NODE_MASK) {
+            std::cout << "[BRAVE_DD] ERROR!\t TerminalPool::intern(): too many distinct terminal values!"<< std::endl;
+            throw error(ErrCode::VALUE_OVERFLOW, __FILE__, __LINE__);
+        }
+        idx = static_cast<uint32_t>(values.size());
+        values.push_back(val);
+        keys.push_back(key);
+        isFree.push_back(0);
+    }
+    index.emplace(key, idx);
+    return idx;
+}
+
+void TerminalPool::reset()
+{
+    for (uint32_t i=NUM_POOL_CONSTANTS; i<values.size(); i++) {
+        if (isFree[i]) continue;
+        if (values[i].getType() == LONG) longIndex.erase(keys[i]);
+        else doubleIndex.erase(keys[i]);
+    }
+    longIndex.rehash(0);
+    doubleIndex.rehash(0);
+    values.resize(NUM_POOL_CONSTANTS);
+    keys.resize(NUM_POOL_CONSTANTS);
+    isFree.resize(NUM_POOL_CONSTANTS);
+    values.shrink_to_fit();
+    keys.shrink_to_fit();
+    isFree.shrink_to_fit();
+    freeSlots.clear();
+    freeSlots.shrink_to_fit();
+}
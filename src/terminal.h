@@ -4,7 +4,81 @@
 #include "defines.h"
 #include "edge.h"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace BRAVE_DD {
+    // ******************************************************************
+    // *                                                                *
+    // *                      Terminal Value Pool                       *
+    // *                                                                *
+    // ******************************************************************
+    /**
+     * Hash-consed table of the terminal values that do not fit in the 32-bit
+     * nodeIdx of an EdgeHandle: LONG and DOUBLE. Each value is stored once, and a
+     * pooled terminal handle keeps its index as the target, so two pooled terminals
+     * are the same value iff their handles are equal.
+     * 
+     * Terminal handles are not bound to a forest (they are copied between forests by
+     * COPY and conversions), so the pool is shared by all forests and guarded by a
+     * mutex. The LONG/DOUBLE forests attach to it: Forest::markSweep reclaims the
+     * values no longer used when it is the only one attached, and the pool is back
+     * to its constants once the last one is detached. Interning more than NODE_MASK
+     * distinct values throws VALUE_OVERFLOW.
+     */
+    class TerminalPool {
+        public:
+        TerminalPool() {
+            numForests = 0;
+            // fixed indices of the constants, see TERMINAL_LONG_ZERO ... TERMINAL_DOUBLE_ONE
+            intern(0L);
+            intern(1L);
+            intern(0.0);
+            intern(1.0);
+        }
+        /**
+         * @brief Get the index of the given value, adding it if it's new.
+         * Note: -0.0 is stored as 0.0, and all NaNs share one index.
+         */
+        uint32_t intern(const long value);
+        uint32_t intern(const double value);
+        /// The value stored at the given index.
+        Value value(const uint32_t index) const;
+        /// Number of distinct pooled values.
+        size_t size() const;
+        /// Number of slots, the bound of the indices to flag for sweep.
+        size_t capacity() const;
+
+        /// A LONG/DOUBLE forest starts or stops using the pool.
+        void attach();
+        void detach();
+        /**
+         * @brief Reclaim the values whose index is not flagged in "used"; the indices
+         * past the end of "used" and the constants are kept. Nothing is reclaimed
+         * unless exactly one forest is attached, since the roots of the others are not
+         * known. The reclaimed indices are given to the next new values.
+         * 
+         * @return size_t       - Output: the number of values reclaimed.
+         */
+        size_t sweep(const std::vector<bool>& used);
+
+        private:
+        uint32_t add(const uint64_t key, const Value& val, std::unordered_map<uint64_t, uint32_t>& index);
+        /// Drop all values but the constants.
+        void reset();
+
+        mutable std::mutex                      guard;
+        std::vector<Value>                      values;
+        std::vector<uint64_t>                   keys;       // key of each slot in its index
+        std::vector<bool>                       isFree;
+        std::vector<uint32_t>                   freeSlots;
+        std::unordered_map<uint64_t, uint32_t>  longIndex;
+        std::unordered_map<uint64_t, uint32_t>  doubleIndex;
+        int                                     numForests;
+    };
+    /// The terminal pool shared by all forests.
+    TerminalPool& terminalPool();
+
     // ******************************************************************
     // *                                                                *
     // *                        Terminal Handle                         *
@@ -13,10 +87,12 @@ namespace BRAVE_DD {
     /**
      * EdgeHandle pointing to terminal nodes
      * Assuming terminal value can only be:
-     *          INT, FLOAT, -∞, +∞, UNDEF, OMEGA.
+     *          INT, FLOAT, LONG, DOUBLE, -∞, +∞, UNDEF, OMEGA.
      * header (9 bits): bit 63: 1: if terminal is float value;
      *                  bit 62: 1: if terminal is int value;
      *                  bit 61: 1: if terminal is special value;
+     *                  bit 63 and 62: 1: if terminal is long or double value, stored in
+     *                                    the terminal pool at index nodeIdx;
      * 
      * In Node storage: informatin in target NodeHandle, ForestSetting tells the meaning
      * 
@@ -40,7 +116,10 @@ namespace BRAVE_DD {
         NodeHandle data = unpackTarget(handle);
         
         // Check if any type flag is set
-        if (handle & FLOAT_VALUE_FLAG_MASK) {
+        if ((handle & POOL_VALUE_FLAG_MASK) == POOL_VALUE_FLAG_MASK) {
+            // long or double value
+            val = terminalPool().value(data);
+        } else if (handle & FLOAT_VALUE_FLAG_MASK) {
             // float valueo';p
             float value = *reinterpret_cast<float*>(&data);
             val.setValue(value, FLOAT);
@@ -75,48 +154,34 @@ namespace BRAVE_DD {
         return false;
     }
 
+    static inline bool isTerminalPooled(const EdgeHandle& edgeHnd) {
+        if (unpackLevel(edgeHnd) == 0) return ((edgeHnd & POOL_VALUE_FLAG_MASK) == POOL_VALUE_FLAG_MASK);
+        return false;
+    }
+
     static inline bool isTerminalSpecial(const EdgeHandle& edgeHnd) {
         if (unpackLevel(edgeHnd) == 0) return (edgeHnd & SPECIAL_VALUE_FLAG_MASK);
         return false;
     }
 
     static inline bool isTerminalSpecial(const SpecialValue sp, const EdgeHandle& handle) {
-        return isTerminalSpecial(handle) 
-                && ((SpecialValue)unpackTarget(handle) == sp);
+        return (handle & TERMINAL_VALUE_MASK) == (SPECIAL_VALUE_FLAG_MASK | (EdgeHandle)sp);
     }
     
+    /*
+     * Constant 0/1 checks compare the terminal part of the handle (header, level, target)
+     * with the constant handles of every value type; no Value is constructed.
+     */
     static inline bool isTerminalOne(const EdgeHandle& handle) {
-        Value val = getTerminalValue(handle);
-        bool ans = 0;
-        union {
-            int valInt;
-            float valFloat;
-        };
-        if (val.getType() == INT) {
-            val.getValueTo(&valInt, INT);
-            ans = (valInt == 1);
-        } else if (val.getType() == FLOAT) {
-            val.getValueTo(&valFloat, FLOAT);
-            ans = (valFloat == 1.0f);
-        }
-        return ans;
+        const EdgeHandle term = handle & TERMINAL_VALUE_MASK;
+        return (term == TERMINAL_INT_ONE) || (term == TERMINAL_FLOAT_ONE)
+                || (term == TERMINAL_LONG_ONE) || (term == TERMINAL_DOUBLE_ONE);
     }
 
     static inline bool isTerminalZero(const EdgeHandle& handle) {
-        Value val = getTerminalValue(handle);
-        bool ans = 0;
-        union {
-            int valInt;
-            float valFloat;
-        };
-        if (val.getType() == INT) {
-            val.getValueTo(&valInt, INT);
-            ans = (valInt == 0);
-        } else if (val.getType() == FLOAT) {
-            val.getValueTo(&valFloat, FLOAT);
-            ans = (valFloat == 0.0f);
-        }
-        return ans;
+        const EdgeHandle term = handle & TERMINAL_VALUE_MASK;
+        return (term == TERMINAL_INT_ZERO) || (term == TERMINAL_FLOAT_ZERO) || (term == TERMINAL_FLOAT_NEG_ZERO)
+                || (term == TERMINAL_LONG_ZERO) || (term == TERMINAL_DOUBLE_ZERO);
     }
 
     /**
@@ -126,13 +191,13 @@ namespace BRAVE_DD {
      *       process, please make sure that the "type" used is consistent with the ValueType supported 
      *       by the working forest, otherwise unpredictable results will occur.
      * 
-     * @param type          The value type of terminal value: INT, FLOAT, or VOID for special value.
+     * @param type          The value type of terminal value: INT, FLOAT, LONG, DOUBLE, or VOID for special value.
      * @param value         The terminal value.
      * @return EdgeHandle   - Output plain EdgeHandle without rule or flags initialied.
      */
     static inline EdgeHandle makeTerminal(const ValueType type, const void* value) {
-        if (type != INT && type != FLOAT && type != VOID) {
-            std::cout << "[BRAVE_DD] ERROR!\t makeTerminal(ValueType, void*): Unsupported data type! It can only be INT, FLOAT, or VOID."<< std::endl;
+        if (type != INT && type != FLOAT && type != LONG && type != DOUBLE && type != VOID) {
+            std::cout << "[BRAVE_DD] ERROR!\t makeTerminal(ValueType, void*): Unsupported data type! It can only be INT, FLOAT, LONG, DOUBLE, or VOID."<< std::endl;
             exit(0);
         }
         EdgeHandle handle = 0;
@@ -145,6 +210,12 @@ namespace BRAVE_DD {
             handle |= FLOAT_VALUE_FLAG_MASK;
             float target = *((float*) value);
             node = *reinterpret_cast<NodeHandle*>(&target);
+        } else if (type == LONG) {
+            handle |= POOL_VALUE_FLAG_MASK;
+            node = terminalPool().intern(*((const long*) value));
+        } else if (type == DOUBLE) {
+            handle |= POOL_VALUE_FLAG_MASK;
+            node = terminalPool().intern(*((const double*) value));
         } else if (type == VOID){
             handle |= SPECIAL_VALUE_FLAG_MASK;
             SpecialValue target = *((SpecialValue*) value);
@@ -178,6 +249,14 @@ namespace BRAVE_DD {
         return makeTerminal(FLOAT, value);
     }
 
+    static inline EdgeHandle makeTerminal(const long value) {
+        return makeTerminal(LONG, value);
+    }
+
+    static inline EdgeHandle makeTerminal(const double value) {
+        return makeTerminal(DOUBLE, value);
+    }
+
     static inline EdgeHandle makeTerminal(const SpecialValue value) {
         return makeTerminal(VOID, value);
     }
@@ -191,12 +270,20 @@ namespace BRAVE_DD {
             float term;
             value.getValueTo(&term, FLOAT);
             return makeTerminal(term);
+        } else if (value.getType() == LONG) {
+            long term;
+            value.getValueTo(&term, LONG);
+            return makeTerminal(term);
+        } else if (value.getType() == DOUBLE) {
+            double term;
+            value.getValueTo(&term, DOUBLE);
+            return makeTerminal(term);
         } else if (value.getType() == VOID) {
             SpecialValue term;
             value.getValueTo(&term, VOID);
             return makeTerminal(term);
         } else {
-            std::cout << "[BRAVE_DD] ERROR!\t makeTerminal(): Unsupported data type! It can only be INT, FLOAT, or VOID."<< std::endl;
+            std::cout << "[BRAVE_DD] ERROR!\t makeTerminal(): Unsupported data type! It can only be INT, FLOAT, LONG, DOUBLE, or VOID."<< std::endl;
             exit(0);
         }
     }
@@ -95,5 +95,28 @@ int main(int argc, char** argv) {
         std::cerr << "[Error]: name" << std::endl;
         hasError = 1;
     }
+    // rule tables follow the rule set
+    if ((setting1.getReductionMask() != (0x01 << RULE_X)) || (setting1.getReductionSize() != 1)
+        || (setting1.getOneLevelRule(RULE_AL0) != RULE_AL0) || (setting1.getConstantRule(1) != RULE_X)) {
+        std::cerr << "[Error]: rule tables" << std::endl;
+        hasError = 1;
+    }
+    setting1.addReductionRule(RULE_EL0);
+    setting1.addReductionRule(RULE_AH1);
+    if ((setting1.getReductionSize() != 3) || (setting1.getOneLevelRule(RULE_AL0) != RULE_EL0)
+        || (setting1.getOneLevelRule(RULE_AH1) != RULE_AH1) || (setting1.getConstantRule(0) != RULE_EL0)
+        || (setting1.getConstantRule(1) != RULE_AH1) || (setting1.getBottomRule(0) != RULE_EL0)
+        || (setting1.getBottomRule(1) != RULE_X)) {
+        std::cerr << "[Error]: rule tables after adding rules" << std::endl;
+        hasError = 1;
+    }
+    for (int r=0; r<=RULE_I1; r++) {
+        ReductionRule rule = (ReductionRule)r;
+        if ((compRule(compRule(rule)) != rule) || (swapRule(swapRule(rule)) != rule)
+            || (isRuleEL(rule) + isRuleEH(rule) + isRuleAL(rule) + isRuleAH(rule) + isRuleI(rule) + (rule == RULE_X) != 1)) {
+            std::cerr << "[Error]: rule table of " << rule2String(rule) << std::endl;
+            hasError = 1;
+        }
+    }
     return hasError;
 }
\ No newline at end of file
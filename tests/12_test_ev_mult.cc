@@ -0,0 +1,230 @@
+#include "brave_dd.h"
+
+#include "cstdlib"
+#include "cstdio"
+#include <cmath>
+
+long seed =123456789;
+
+using namespace BRAVE_DD;
+
+/* Random function generating value between 0 and 1 */
+double random01()
+{
+  const long MODULUS = 2147483647L;
+  const long MULTIPLIER = 48271L;
+  const long Q = MODULUS / MULTIPLIER;
+  const long R = MODULUS % MULTIPLIER;
+
+  long t = MULTIPLIER * (seed % Q) - R * (seed / Q);
+  if (t > 0) {
+    seed = t;
+  } else {
+    seed = t + MODULUS;
+  }
+  return ((double) seed / MODULUS);
+}
+
+void decimalToAssignment(long long decimal, std::vector<bool>& assignment)
+{
+    for (size_t k=1; k<=assignment.size()-1; k++) {
+        assignment[k] = decimal & (1<<(k-1));
+    }
+}
+
+double toDouble(const Value& val)
+{
+    double ans = 0.0;
+    val.getValueTo(&ans, DOUBLE);
+    return ans;
+}
+
+bool isClose(double a, double b)
+{
+    return std::fabs(a - b) <= 1e-9 * (1.0 + std::fabs(a) + std::fabs(b));
+}
+
+/*
+ *  Build the product distribution prod_k (x_k ? p_k : 1-p_k), the weighted
+ *  sum sum_k x_k*w_k, and check MULTIPLY/PLUS/MINIMUM/MAXIMUM on them.
+ */
+bool testOperation(uint16_t num, PredefForest bdd)
+{
+    ForestSetting setting(bdd, num);
+    Forest* forest = new Forest(setting);
+
+    std::vector<double> prob(num+1), weight(num+1);
+    for (uint16_t k=1; k<=num; k++) {
+        prob[k] = random01();
+        weight[k] = (double)(1 + (int)(random01() * 8.0));
+    }
+
+    Func dist(forest), sum(forest);
+    dist.trueFunc();
+    sum.constant(0.0);
+    for (uint16_t k=1; k<=num; k++) {
+        Func x(forest), y(forest);
+        x.variable(k, Value(1.0 - prob[k]), Value(prob[k]));
+        y.variable(k, Value(0.0), Value(weight[k]));
+        apply(MULTIPLY, dist, x, dist);
+        apply(PLUS, sum, y, sum);
+    }
+    Func prod(forest), total(forest), lo(forest), hi(forest);
+    apply(MULTIPLY, dist, sum, prod);
+    apply(PLUS, dist, sum, total);
+    apply(MINIMUM, dist, sum, lo);
+    apply(MAXIMUM, dist, sum, hi);
+
+    bool isPass = 1;
+    std::vector<bool> assignment(num+1, 0);
+    for (long long i=0; i<(0x01LL<<num); i++) {
+        decimalToAssignment(i, assignment);
+        double d = 1.0, s = 0.0;
+        for (uint16_t k=1; k<=num; k++) {
+            d *= assignment[k] ? prob[k] : 1.0 - prob[k];
+            s += assignment[k] ? weight[k] : 0.0;
+        }
+        if (!isClose(toDouble(dist.evaluate(assignment)), d)
+            || !isClose(toDouble(sum.evaluate(assignment)), s)
+            || !isClose(toDouble(prod.evaluate(assignment)), d*s)
+            || !isClose(toDouble(total.evaluate(assignment)), d+s)
+            || !isClose(toDouble(lo.evaluate(assignment)), (d<s)?d:s)
+            || !isClose(toDouble(hi.evaluate(assignment)), (d>s)?d:s)) {
+            std::cout << "result evaluation failed at assignment " << i << std::endl;
+            isPass = 0;
+            break;
+        }
+    }
+    if (isPass) {
+        // product distribution in EV*: one node per level
+        if ((bdd == PredefForest::EVSTARFBDD) && (dist.numNodes() != num)) {
+            std::cout << "unexpected number of nodes: " << dist.numNodes() << std::endl;
+            isPass = 0;
+        }
+    }
+    delete forest;
+    return isPass;
+}
+
+/*
+ *  The element-wise operations without an EV* kernel must be rejected, alone, n-ary and batched.
+ */
+bool testUnsupported(uint16_t num, PredefForest bdd)
+{
+    ForestSetting setting(bdd, num);
+    Forest* forest = new Forest(setting);
+    Func a(forest), b(forest), c(forest);
+    a.variable(1);
+    b.variable(2);
+    bool isPass = 1;
+    BinaryBuiltin1 ops[] = {UNION, INTERSECTION};
+    for (BinaryBuiltin1 op : ops) {
+        int numThrown = 0;
+        try {
+            apply(op, a, b, c);
+        } catch (const error& e) {
+            numThrown++;
+        }
+        try {
+            std::vector<Func> args = {a, b};
+            apply(op, args, c);
+        } catch (const error& e) {
+            numThrown++;
+        }
+        try {
+            std::vector<Func> args1 = {a}, args2 = {b}, res;
+            apply(op, args1, args2, res);
+        } catch (const error& e) {
+            numThrown++;
+        }
+        if (numThrown != 3) {
+            std::cout << ((op == UNION) ? "UNION" : "INTERSECTION") << " was not rejected" << std::endl;
+            isPass = 0;
+        }
+    }
+    delete forest;
+    return isPass;
+}
+
+/*
+ *  EV* forests only take real weights: INT and LONG value types must be rejected.
+ */
+bool testValueType(uint16_t num, PredefForest bdd)
+{
+    ValueType types[] = {INT, LONG, FLOAT, DOUBLE};
+    for (ValueType vt : types) {
+        ForestSetting setting(bdd, num);
+        setting.setValType(vt);
+        bool isRejected = 0;
+        try {
+            Forest* forest = new Forest(setting);
+            delete forest;
+        } catch (const error& e) {
+            isRejected = 1;
+        }
+        if (isRejected != ((vt == INT) || (vt == LONG))) {
+            std::cout << "value type " << vt << " was " << ((isRejected) ? "rejected" : "accepted") << std::endl;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ *  Products of special values keep them, and products of values of different types are rejected.
+ */
+bool testValueProduct()
+{
+    Value omega(SpecialValue::OMEGA), inf(SpecialValue::POS_INF);
+    bool isPass = ((omega * omega) == omega) && ((inf * Value(2.0f)) == inf) && ((Value(2.0f) * inf) == inf);
+    isPass = isPass && ((Value(2.0f) * Value(3.0f)) == Value(6.0f));
+    Value mixed[][2] = {{Value(2), Value(3.0f)}, {Value(2.0f), Value(3.0)}, {omega, Value(2.0f)},
+                        {omega, Value(SpecialValue::UNDEF)}};
+    for (auto& pair : mixed) {
+        bool isRejected = 0;
+        try {
+            pair[0] * pair[1];
+        } catch (const error& e) {
+            isRejected = 1;
+        }
+        isPass = isPass && isRejected;
+    }
+    if (!isPass) std::cout << "wrong product of values" << std::endl;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 20;
+    uint16_t numVals = 8;
+    if (argc == 2) {
+        printf("Usage: ./test_ev_mult [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate EV* functions to test MULTIPLY, PLUS, MINIMUM and MAXIMUM\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = testValueProduct();
+    PredefForest bdds[] = {PredefForest::EVSTARFBDD, PredefForest::EVSTARQBDD};
+    for (PredefForest bdd : bdds) {
+        if (!isPass) break;
+        ForestSetting setting(bdd, numVals);
+        setting.output(std::cout);
+        for (int test=0; test<TESTS; test++) {
+            isPass = testOperation(numVals, bdd);
+            if (!isPass) break;
+        }
+        if (!isPass) break;
+        isPass = testUnsupported(numVals, bdd) && testValueType(numVals, bdd);
+        if (!isPass) break;
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
@@ -0,0 +1,259 @@
+#include "brave_dd.h"
+
+#include "cstdlib"
+#include "cstdio"
+#include <cmath>
+
+long seed =123456789;
+
+using namespace BRAVE_DD;
+
+/* Random function generating value between 0 and 1 */
+double random01()
+{
+  const long MODULUS = 2147483647L;
+  const long MULTIPLIER = 48271L;
+  const long Q = MODULUS / MULTIPLIER;
+  const long R = MODULUS % MULTIPLIER;
+
+  long t = MULTIPLIER * (seed % Q) - R * (seed / Q);
+  if (t > 0) {
+    seed = t;
+  } else {
+    seed = t + MODULUS;
+  }
+  return ((double) seed / MODULUS);
+}
+
+void decimalToAssignment(long long decimal, std::vector<bool>& assignment)
+{
+    for (size_t k=1; k<=assignment.size()-1; k++) {
+        assignment[k] = decimal & (1<<(k-1));
+    }
+}
+
+bool testHandles()
+{
+    bool isPass = 1;
+    // equal values share one handle
+    if ((makeTerminal(0.25) != makeTerminal(DOUBLE, 0.25))
+        || (makeTerminal(0.0) != makeTerminal(-0.0))
+        || (makeTerminal(3000000000L) != makeTerminal(Value(3000000000L)))) {
+        std::cout << "equal terminal values got different handles" << std::endl;
+        isPass = 0;
+    }
+    // different values, or the same bits of different types, do not
+    if ((makeTerminal(0.25) == makeTerminal(0.5))
+        || (makeTerminal(1L) == makeTerminal(1.0))) {
+        std::cout << "different terminal values share a handle" << std::endl;
+        isPass = 0;
+    }
+    // values survive the round trip, including those wider than 32 bits
+    long l = 0;
+    double d = 0.0;
+    getTerminalValue(makeTerminal(3000000000L)).getValueTo(&l, LONG);
+    getTerminalValue(makeTerminal(1e300)).getValueTo(&d, DOUBLE);
+    if ((l != 3000000000L) || (d != 1e300)) {
+        std::cout << "terminal value round trip failed" << std::endl;
+        isPass = 0;
+    }
+    // constant checks by bitmask, whatever the rule and flags are
+    EdgeHandle ones[] = {makeTerminal(1), makeTerminal(1.0f), makeTerminal(1L), makeTerminal(1.0)};
+    EdgeHandle zeros[] = {makeTerminal(0), makeTerminal(0.0f), makeTerminal(-0.0f), makeTerminal(0L), makeTerminal(-0.0)};
+    for (EdgeHandle h : ones) {
+        packRule(h, RULE_EL1);
+        packComp(h, 1);
+        if (!isTerminalOne(h) || isTerminalZero(h)) isPass = 0;
+    }
+    for (EdgeHandle h : zeros) {
+        packRule(h, RULE_AH0);
+        if (isTerminalOne(h) || !isTerminalZero(h)) isPass = 0;
+    }
+    if (isTerminalOne(makeTerminal(2)) || isTerminalZero(makeTerminal(0.5))
+        || !isTerminalSpecial(SpecialValue::OMEGA, makeTerminal(SpecialValue::OMEGA))
+        || isTerminalSpecial(SpecialValue::POS_INF, makeTerminal(SpecialValue::OMEGA))) {
+        isPass = 0;
+    }
+    if (!isPass) std::cout << "terminal constant checks failed" << std::endl;
+    return isPass;
+}
+
+/*
+ *  Build sum_k x_k*w_k (with weights beyond 32 bits for LONG) and prod_k (x_k ? p_k : 1-p_k)
+ *  in an MTBDD with the given value type, and check the evaluation.
+ */
+bool testOperation(uint16_t num, ValueType vt)
+{
+    ForestSetting setting(PredefForest::MTBDD, num);
+    setting.setValType(vt);
+    if (vt == DOUBLE) setting.setRangeType(RangeType::NNREAL);
+    Forest* forest = new Forest(setting);
+
+    std::vector<double> prob(num+1);
+    std::vector<long> weight(num+1);
+    for (uint16_t k=1; k<=num; k++) {
+        prob[k] = random01();
+        weight[k] = (long)(random01() * 1000.0) * 10000000L;
+    }
+
+    Func sum(forest), dist(forest), lo(forest), hi(forest);
+    sum.constant(0L);
+    dist.constant(1.0);
+    for (uint16_t k=1; k<=num; k++) {
+        Func x(forest), y(forest);
+        if (vt == DOUBLE) {
+            x.variable(k, Value(1.0 - prob[k]), Value(prob[k]));
+        } else {
+            x.variable(k, Value(1L), Value(2L));
+        }
+        y.variable(k, Value(0L), Value(weight[k]));
+        apply(MULTIPLY, dist, x, dist);
+        apply(PLUS, sum, y, sum);
+    }
+    apply(MINIMUM, dist, sum, lo);
+    apply(MAXIMUM, dist, sum, hi);
+
+    bool isPass = 1;
+    std::vector<bool> assignment(num+1, 0);
+    for (long long i=0; i<(0x01LL<<num); i++) {
+        decimalToAssignment(i, assignment);
+        double d = 1.0;
+        long s = 0;
+        for (uint16_t k=1; k<=num; k++) {
+            if (vt == DOUBLE) {
+                d *= assignment[k] ? prob[k] : 1.0 - prob[k];
+            } else {
+                d *= assignment[k] ? 2.0 : 1.0;
+            }
+            s += assignment[k] ? weight[k] : 0;
+        }
+        double dv = 0.0, lov = 0.0, hiv = 0.0;
+        long sv = 0;
+        dist.evaluate(assignment).getValueTo(&dv, DOUBLE);
+        sum.evaluate(assignment).getValueTo(&sv, LONG);
+        lo.evaluate(assignment).getValueTo(&lov, DOUBLE);
+        hi.evaluate(assignment).getValueTo(&hiv, DOUBLE);
+        double sd = (double)s;
+        if ((std::fabs(dv - d) > 1e-12) || (sv != s)
+            || (std::fabs(lov - ((d<sd)?d:sd)) > 1e-12)
+            || (std::fabs(hiv - ((d>sd)?d:sd)) > 1e-6 * sd)) {
+            std::cout << "result evaluation failed at assignment " << i << std::endl;
+            isPass = 0;
+            break;
+        }
+    }
+    // the weighted sum has one terminal per subset sum, so the pool must dedup them
+    if (isPass) {
+        Func again(forest);
+        again.constant(0L);
+        for (uint16_t k=1; k<=num; k++) {
+            Func y(forest);
+            y.variable(k, Value(0L), Value(weight[k]));
+            apply(PLUS, y, again, again);
+        }
+        if (!(again == sum)) {
+            std::cout << "rebuilt function is not the same edge" << std::endl;
+            isPass = 0;
+        }
+    }
+    delete forest;
+    return isPass;
+}
+
+/*
+ *  The values of a LONG MTBDD that is not marked are reclaimed by markSweep, once no other
+ *  LONG/DOUBLE forest exists, and the marked ones keep their values; the pool is back to the
+ *  constants when the forest is deleted.
+ */
+bool testSweep(uint16_t num)
+{
+    ForestSetting setting(PredefForest::MTBDD, num);
+    setting.setValType(LONG);
+    Forest* forest = new Forest(setting);
+    std::vector<long> weight(num+1);
+    for (uint16_t k=1; k<=num; k++) weight[k] = (long)(random01() * 1000.0) * 10000000L + 1;
+
+    Func sum(forest), big(forest), tmp(forest);
+    sum.constant(0L);
+    big.constant(3000000000L);
+    for (uint16_t k=1; k<=num; k++) {
+        Func y(forest);
+        y.variable(k, Value(0L), Value(weight[k]));
+        apply(PLUS, sum, y, sum);
+    }
+    apply(PLUS, sum, big, tmp);
+    size_t numBuilt = terminalPool().size();
+
+    // another forest of pooled values: nothing is reclaimed
+    Forest* other = new Forest(setting);
+    forest->unmark();
+    forest->markNodes(sum);
+    forest->markNodes(big);
+    forest->markSweep();
+    bool isPass = terminalPool().size() == numBuilt;
+    delete other;
+    forest->unmark();
+    forest->markNodes(sum);
+    forest->markNodes(big);
+    forest->markSweep();
+    isPass = isPass && (terminalPool().size() < numBuilt);
+    if (!isPass) std::cout << "pool size " << terminalPool().size() << " after sweep, " << numBuilt << " before" << std::endl;
+
+    std::vector<bool> assignment(num+1, 0);
+    for (long long i=0; isPass && (i<(0x01LL<<num)); i++) {
+        decimalToAssignment(i, assignment);
+        long s = 0, sv = 0, bv = 0;
+        for (uint16_t k=1; k<=num; k++) s += assignment[k] ? weight[k] : 0;
+        sum.evaluate(assignment).getValueTo(&sv, LONG);
+        big.evaluate(assignment).getValueTo(&bv, LONG);
+        isPass = (sv == s) && (bv == 3000000000L);
+    }
+    // the reclaimed slots are reused
+    Func again(forest);
+    apply(PLUS, sum, big, again);
+    for (long long i=0; isPass && (i<(0x01LL<<num)); i++) {
+        decimalToAssignment(i, assignment);
+        long s = 3000000000L, av = 0;
+        for (uint16_t k=1; k<=num; k++) s += assignment[k] ? weight[k] : 0;
+        again.evaluate(assignment).getValueTo(&av, LONG);
+        isPass = av == s;
+    }
+    isPass = isPass && (terminalPool().capacity() <= numBuilt);
+    if (!isPass) std::cout << "values changed by the pool sweep" << std::endl;
+    delete forest;
+    if (isPass && (terminalPool().size() != 4)) {
+        std::cout << "pool not emptied with its last forest" << std::endl;
+        isPass = 0;
+    }
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 10;
+    uint16_t numVals = 8;
+    if (argc == 2) {
+        printf("Usage: ./test_terminal_pool [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate LONG and DOUBLE MTBDDs to test pooled terminals\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = testHandles();
+    ValueType types[] = {DOUBLE, LONG};
+    for (ValueType vt : types) {
+        for (int test=0; isPass && (test<TESTS); test++) {
+            isPass = testOperation(numVals, vt);
+        }
+    }
+    isPass = isPass && testSweep(numVals);
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
@@ -0,0 +1,98 @@
+#include "gen_random_functions.h"
+
+/*
+ *  Build the same random functions, and their union and intersection, in a forest
+ *  with the specialized engine and in one forced to the generic engine. The two
+ *  forests allocate nodes in the same order, so the results must be identical edges.
+ */
+bool testEngine(uint16_t num, PredefForest bdd)
+{
+    ForestSetting setting(bdd, num);
+    Forest* special = new Forest(setting);
+    Forest* generic = new Forest(setting);
+    generic->useGenericEngine();
+    if (special->getEngine() == ForestEngine::GENERIC) {
+        std::cout << "no specialized engine for " << setting.getName() << std::endl;
+        delete special;
+        delete generic;
+        return 0;
+    }
+
+    bool isRel = setting.isRelation();
+    size_t size = 0x01ULL << (isRel ? 2*num : num);
+    std::vector<bool> fun1(size), fun2(size);
+    for (size_t i=0; i<size; i++) {
+        fun1[i] = random01() < 0.5;
+        fun2[i] = random01() < 0.5;
+    }
+
+    Forest* forests[] = {special, generic};
+    Func res[2][4];
+    for (int f=0; f<2; f++) {
+        Edge e1 = isRel ? buildRelEdge(forests[f], num, fun1, 0, size-1) : buildSetEdge(forests[f], num, fun1, 0, size-1);
+        Edge e2 = isRel ? buildRelEdge(forests[f], num, fun2, 0, size-1) : buildSetEdge(forests[f], num, fun2, 0, size-1);
+        res[f][0] = Func(forests[f], e1);
+        res[f][1] = Func(forests[f], e2);
+        res[f][2] = res[f][0] | res[f][1];
+        res[f][3] = res[f][0] & res[f][1];
+    }
+
+    bool isPass = 1;
+    for (int k=0; k<4; k++) {
+        if ((res[0][k].getEdge().getEdgeHandle() != res[1][k].getEdge().getEdgeHandle())
+            || (special->getNodeManUsed(res[0][k]) != generic->getNodeManUsed(res[1][k]))) {
+            std::cout << "engines differ on function " << k << " in " << setting.getName() << std::endl;
+            isPass = 0;
+            break;
+        }
+    }
+    if (isPass && !isRel) {
+        std::vector<bool> assignment(num+1, 0);
+        for (size_t i=0; i<size; i++) {
+            decimalToAssignment(i, assignment);
+            Value val = res[0][2].evaluate(assignment);
+            int v = 0;
+            val.getValueTo(&v, INT);
+            if (v != (int)(fun1[i] || fun2[i])) {
+                std::cout << "union evaluation failed at assignment " << i << std::endl;
+                isPass = 0;
+                break;
+            }
+        }
+    }
+    delete special;
+    delete generic;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 20;
+    uint16_t numVals = 6;
+    if (argc == 2) {
+        printf("Usage: ./test_engine [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate functions to compare the specialized and generic reduction engines\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest bdds[] = {PredefForest::REXBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                           PredefForest::ESRBDD, PredefForest::QBMXD};
+    for (PredefForest bdd : bdds) {
+        uint16_t num = (bdd == PredefForest::QBMXD) ? (numVals+1)/2 : numVals;
+        for (int test=0; isPass && (test<TESTS); test++) {
+            isPass = testEngine(num, bdd);
+        }
+        if (!isPass) break;
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
@@ -0,0 +1,137 @@
+#include "brave_dd.h"
+
+#include "cstdlib"
+#include "cstdio"
+#include <cmath>
+
+using namespace BRAVE_DD;
+
+bool isClose(double a, double b)
+{
+    return std::fabs(a - b) <= 1e-9 * std::fabs(b);
+}
+
+/* Check the count of "func" in every count type against the exact "expect" */
+bool checkCount(const Func& func, const BigCount& expect, const std::string& name)
+{
+    BigCount big;
+    UInt128 wide = 0;
+    LogCount est;
+    double real = 0.0;
+    apply(CARDINALITY, func, big);
+    apply(CARDINALITY, func, wide);
+    apply(CARDINALITY, func, est);
+    apply(CARDINALITY, func, real);
+    bool isPass = (big == expect) && isClose(est.toDouble(), expect.toDouble()) && isClose(real, expect.toDouble());
+    if (expect.numBits() <= 128) {
+        isPass = isPass && (uint128ToString(wide) == expect.toString());
+    }
+    if (!isPass) {
+        std::cout << name << ": expected " << expect << ", got " << big << ", "
+                  << uint128ToString(wide) << ", " << est << ", " << real << std::endl;
+    }
+    return isPass;
+}
+
+/* Sets over num variables: true, x_1, x_1 & ... & x_num, x_1 | ... | x_num, and x_1 ^ ... ^ x_num */
+bool testSet(uint16_t num, PredefForest bdd)
+{
+    ForestSetting setting(bdd, num);
+    Forest* forest = new Forest(setting);
+    Func all(forest), one(forest), conj(forest), disj(forest), parity(forest);
+    all.trueFunc();
+    one.variable(1);
+    conj.trueFunc();
+    disj.falseFunc();
+    parity.falseFunc();
+    for (uint16_t k=1; k<=num; k++) {
+        Func x(forest);
+        x.variable(k);
+        conj &= x;
+        disj |= x;
+        parity = (parity & (!x)) | ((!parity) & x);
+    }
+    BigCount none = BigCount::pow2(num);
+    none -= BigCount(1);
+    bool isPass = checkCount(all, BigCount::pow2(num), setting.getName() + " true")
+                && checkCount(one, BigCount::pow2(num-1), setting.getName() + " x_1")
+                && checkCount(conj, BigCount(1), setting.getName() + " conjunction")
+                && checkCount(disj, none, setting.getName() + " disjunction")
+                && checkCount(parity, BigCount::pow2(num-1), setting.getName() + " parity");
+    // reclaim all but the parity nodes, the handles are reused by the new functions
+    forest->markNodes(parity);
+    forest->markSweep();
+    conj.trueFunc();
+    disj.falseFunc();
+    for (uint16_t k=num; k>=1; k--) {
+        Func x(forest);
+        x.variable(k);
+        conj &= !x;
+        disj |= !x;
+    }
+    isPass = isPass && checkCount(conj, BigCount(1), setting.getName() + " conjunction after sweep")
+                && checkCount(disj, none, setting.getName() + " disjunction after sweep")
+                && checkCount(parity, BigCount::pow2(num-1), setting.getName() + " parity after sweep");
+    delete forest;
+    return isPass;
+}
+
+/* Relations over num levels: identity, its complement, and true */
+bool testRelation(uint16_t num, PredefForest bdd)
+{
+    ForestSetting setting(bdd, num);
+    Forest* forest = new Forest(setting);
+    Func all(forest), id(forest);
+    all.trueFunc();
+    std::vector<bool> dependance(num+1, 0);
+    id.identity(dependance);
+    Func notId = !id;
+    BigCount offDiag = BigCount::pow2(2*num);
+    offDiag -= BigCount::pow2(num);
+    bool isPass = checkCount(all, BigCount::pow2(2*num), setting.getName() + " true")
+                && checkCount(id, BigCount::pow2(num), setting.getName() + " identity")
+                && checkCount(notId, offDiag, setting.getName() + " non-identity");
+    delete forest;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    uint16_t numVals = 150;
+    if (argc == 2) {
+        printf("Usage: ./test_wide_card [num_val] [num_rel_val]\n");
+        printf("\tThis will count sets and relations beyond 64 bits in every count type\n");
+        exit(0);
+    }
+    uint16_t numRelVals = 40;
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        numRelVals = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest sets[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                           PredefForest::ZBDD, PredefForest::ESRBDD, PredefForest::CESRBDD};
+    for (PredefForest bdd : sets) {
+        isPass = isPass && testSet(numVals, bdd);
+    }
+    PredefForest relations[] = {PredefForest::QBMXD, PredefForest::FBMXD, PredefForest::IBMXD};
+    for (PredefForest bdd : relations) {
+        isPass = isPass && testRelation(numRelVals, bdd);
+    }
+    // the arithmetic itself
+    BigCount big = BigCount::pow2(200);
+    big += BigCount(12345);
+    big -= BigCount::pow2(100);
+    big <<= 3;
+    if (big.toString() != "12855504354071922204335696738719159615375798115050369056866760") {
+        std::cout << "BigCount arithmetic failed: " << big << std::endl;
+        isPass = 0;
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
@@ -0,0 +1,103 @@
+#include "gen_random_functions.h"
+
+/* Value of a Boolean function at the assignment of index i */
+bool evaluateAt(const Func& func, uint16_t num, long long i)
+{
+    std::vector<bool> assignment(num+1, 0);
+    decimalToAssignment(i, assignment);
+    int v = 0;
+    func.evaluate(assignment).getValueTo(&v, INT);
+    return v;
+}
+
+/*
+ *  Random states, visited set and relation: the fused image must give the visited set
+ *  with the image added, and the image states not in the visited set, for both
+ *  the post-image and the pre-image. The visited set is empty, full, or random.
+ */
+bool testImageNew(uint16_t num, PredefForest bdd, PredefForest bmxd, int kind)
+{
+    ForestSetting settingS(bdd, num);
+    Forest* forestS = new Forest(settingS);
+    ForestSetting settingR(bmxd, num);
+    Forest* forestR = new Forest(settingR);
+    long long size = 0x01LL << num;
+    std::vector<bool> funS(size), funV(size), funR(size*size);
+    for (long long i=0; i<size; i++) {
+        funS[i] = random01() < 0.3;
+        funV[i] = (kind == 0) ? 0 : ((kind == 1) ? 1 : (random01() < 0.5));
+    }
+    for (long long i=0; i<size*size; i++) {
+        funR[i] = random01() < 0.2;
+    }
+    Func states(forestS, buildSetEdge(forestS, num, funS, 0, size-1));
+    Func relation(forestR, buildRelEdge(forestR, num, funR, 0, size*size-1));
+
+    bool isPass = 1;
+    for (int isPre=0; isPass && (isPre<2); isPre++) {
+        Func visited(forestS, buildSetEdge(forestS, num, funV, 0, size-1));
+        Func found(forestS);
+        if (isPre) {
+            apply(PRE_IMAGE_NEW, states, relation, visited, found);
+        } else {
+            apply(POST_IMAGE_NEW, states, relation, visited, found);
+        }
+        // the image by enumeration; buildRelEdge puts the "from" bit of each level above the "to" bit
+        std::vector<bool> image(size, 0);
+        for (long long from=0; from<size; from++) {
+            for (long long to=0; to<size; to++) {
+                long long index = 0;
+                for (uint16_t k=num; k>=1; k--) {
+                    index = (index << 2) | (((from >> (k-1)) & 0x01) << 1) | ((to >> (k-1)) & 0x01);
+                }
+                if (!funR[index]) continue;
+                if (isPre && funS[to]) image[from] = 1;
+                if (!isPre && funS[from]) image[to] = 1;
+            }
+        }
+        for (long long i=0; i<size; i++) {
+            if ((evaluateAt(visited, num, i) != (funV[i] || image[i]))
+                || (evaluateAt(found, num, i) != (image[i] && !funV[i]))) {
+                std::cout << ((isPre) ? "pre" : "post") << "-image failed at assignment " << i
+                          << " in " << settingS.getName() << " and " << settingR.getName() << std::endl;
+                isPass = 0;
+                break;
+            }
+        }
+    }
+    delete forestS;
+    delete forestR;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 50;
+    uint16_t numVals = 4;
+    if (argc == 2) {
+        printf("Usage: ./test_image_new [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate states, visited sets and relations to test the fused image\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest bdds[] = {PredefForest::REXBDD, PredefForest::FBDD, PredefForest::QBDD,
+                           PredefForest::ESRBDD, PredefForest::FBDD};
+    PredefForest bmxds[] = {PredefForest::ESRBMXD, PredefForest::IBMXD, PredefForest::QBMXD,
+                            PredefForest::ESRBMXD, PredefForest::FBMXD};
+    for (size_t t=0; isPass && (t<sizeof(bdds)/sizeof(bdds[0])); t++) {
+        for (int test=0; isPass && (test<TESTS); test++) {
+            isPass = testImageNew(numVals, bdds[t], bmxds[t], test % 3);
+        }
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
@@ -0,0 +1,113 @@
+#include "gen_random_functions.h"
+
+/* Value of a Boolean function at the index n of its truth table */
+bool evaluateAt(const Func& func, uint16_t num, unsigned long n)
+{
+    std::vector<bool> assignment(num+1, 0);
+    std::vector<bool> assignmentTo(num+1, 0);
+    Value val;
+    if (func.getForest()->getSetting().isRelation()) {
+        for (uint16_t l=1; l<=num; l++) {
+            assignment[l] = n & (0x01UL << (2*l-1));
+            assignmentTo[l] = n & (0x01UL << (2*l-2));
+        }
+        val = func.evaluate(assignment, assignmentTo);
+    } else {
+        decimalToAssignment(n, assignment);
+        val = func.evaluate(assignment);
+    }
+    int v = 0;
+    val.getValueTo(&v, INT);
+    return v;
+}
+
+/*
+ *  Random functions f, g and h: Xor, Xnor and ITE must agree with their truth tables.
+ *  Some tests tie g or h to f (the same, or the complement) for the standard triples.
+ */
+bool testITE(uint16_t num, PredefForest bdd, int kind)
+{
+    ForestSetting setting(bdd, num);
+    Forest* forest = new Forest(setting);
+    bool isRel = setting.isRelation();
+    unsigned long size = (isRel) ? 0x01UL<<(2*num) : 0x01UL<<(num);
+    std::vector<bool> funF(size), funG(size), funH(size);
+    for (unsigned long i=0; i<size; i++) {
+        funF[i] = random01() < 0.5;
+        funG[i] = random01() < 0.3;
+        funH[i] = random01() < 0.7;
+    }
+    if (kind == 1) funG = funF;
+    if (kind == 2) funH.flip();
+    if (kind == 3) {
+        funH = funF;
+        funH.flip();
+    }
+    if (kind == 4) {
+        funH = funG;
+        funH.flip();
+    }
+    Func f(forest), g(forest), h(forest);
+    if (isRel) {
+        f.setEdge(buildRelEdge(forest, num, funF, 0, size-1));
+        g.setEdge(buildRelEdge(forest, num, funG, 0, size-1));
+        h.setEdge(buildRelEdge(forest, num, funH, 0, size-1));
+    } else {
+        f.setEdge(buildSetEdge(forest, num, funF, 0, size-1));
+        g.setEdge(buildSetEdge(forest, num, funG, 0, size-1));
+        h.setEdge(buildSetEdge(forest, num, funH, 0, size-1));
+    }
+    Func resXor = g ^ h;
+    Func resXnor(forest);
+    apply(XNOR, g, h, resXnor);
+    Func resIte = ite(f, g, h);
+    Func resAcc = f;
+    resAcc ^= g;
+
+    bool isPass = 1;
+    for (unsigned long n=0; n<size; n++) {
+        bool valIte = funF[n] ? funG[n] : funH[n];
+        if ((evaluateAt(resXor, num, n) != (funG[n] != funH[n]))
+            || (evaluateAt(resXnor, num, n) != (funG[n] == funH[n]))
+            || (evaluateAt(resIte, num, n) != valIte)
+            || (evaluateAt(resAcc, num, n) != (funF[n] != funG[n]))) {
+            std::cout << "failed at assignment " << n << " in " << setting.getName()
+                      << " with test kind " << kind << std::endl;
+            isPass = 0;
+            break;
+        }
+    }
+    delete forest;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 20;
+    uint16_t numVals = 5;
+    if (argc == 2) {
+        printf("Usage: ./test_ite [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate functions to test Xor, Xnor and if-then-else\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest bdds[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                           PredefForest::ZBDD, PredefForest::ESRBDD, PredefForest::CESRBDD,
+                           PredefForest::QBMXD, PredefForest::FBMXD, PredefForest::IBMXD, PredefForest::ESRBMXD};
+    for (PredefForest bdd : bdds) {
+        for (int test=0; isPass && (test<TESTS); test++) {
+            isPass = testITE(numVals, bdd, test % 5);
+        }
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
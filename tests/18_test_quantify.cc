@@ -0,0 +1,112 @@
+#include "gen_random_functions.h"
+
+/* Value of a Boolean function at the index n of its truth table */
+bool evaluateAt(const Func& func, uint16_t num, unsigned long n)
+{
+    std::vector<bool> assignment(num+1, 0);
+    std::vector<bool> assignmentTo(num+1, 0);
+    Value val;
+    if (func.getForest()->getSetting().isRelation()) {
+        for (uint16_t l=1; l<=num; l++) {
+            assignment[l] = n & (0x01UL << (2*l-1));
+            assignmentTo[l] = n & (0x01UL << (2*l-2));
+        }
+        val = func.evaluate(assignment, assignmentTo);
+    } else {
+        decimalToAssignment(n, assignment);
+        val = func.evaluate(assignment);
+    }
+    int v = 0;
+    val.getValueTo(&v, INT);
+    return v;
+}
+
+/*
+ *  Random functions f and g, and a random set of levels: Exists, ForAll and AndExists must agree
+ *  with their truth tables. For relations, both the unprimed and primed variables are quantified.
+ */
+bool testQuantify(uint16_t num, PredefForest bdd)
+{
+    ForestSetting setting(bdd, num);
+    Forest* forest = new Forest(setting);
+    bool isRel = setting.isRelation();
+    unsigned long size = (isRel) ? 0x01UL<<(2*num) : 0x01UL<<(num);
+    std::vector<bool> funF(size), funG(size);
+    for (unsigned long i=0; i<size; i++) {
+        funF[i] = random01() < 0.4;
+        funG[i] = random01() < 0.6;
+    }
+    std::vector<uint16_t> vars;
+    unsigned long mask = 0;
+    for (uint16_t k=1; k<=num; k++) {
+        if (random01() < 0.5) {
+            vars.push_back(k);
+            mask |= (isRel) ? (0x03UL << (2*k-2)) : (0x01UL << (k-1));
+        }
+    }
+    Func f(forest), g(forest);
+    if (isRel) {
+        f.setEdge(buildRelEdge(forest, num, funF, 0, size-1));
+        g.setEdge(buildRelEdge(forest, num, funG, 0, size-1));
+    } else {
+        f.setEdge(buildSetEdge(forest, num, funF, 0, size-1));
+        g.setEdge(buildSetEdge(forest, num, funG, 0, size-1));
+    }
+    Func exist(forest), forall(forest), relProd(forest);
+    apply(EQUANTIFY, f, vars, exist);
+    apply(UQUANTIFY, f, vars, forall);
+    apply(AND_EXISTS, f, g, vars, relProd);
+
+    bool isPass = 1;
+    for (unsigned long n=0; isPass && (n<size); n++) {
+        bool valExist = 0, valForall = 1, valRelProd = 0;
+        // every assignment of the quantified variables
+        unsigned long sub = 0;
+        do {
+            unsigned long i = (n & ~mask) | sub;
+            valExist = valExist || funF[i];
+            valForall = valForall && funF[i];
+            valRelProd = valRelProd || (funF[i] && funG[i]);
+            sub = (sub - mask) & mask;
+        } while (sub != 0);
+        if ((evaluateAt(exist, num, n) != valExist)
+            || (evaluateAt(forall, num, n) != valForall)
+            || (evaluateAt(relProd, num, n) != valRelProd)) {
+            std::cout << "failed at assignment " << n << " in " << setting.getName() << std::endl;
+            isPass = 0;
+        }
+    }
+    delete forest;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 10;
+    uint16_t numVals = 5;
+    if (argc == 2) {
+        printf("Usage: ./test_quantify [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate functions and variables to test quantification\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest bdds[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                           PredefForest::ZBDD, PredefForest::ESRBDD, PredefForest::CESRBDD,
+                           PredefForest::QBMXD, PredefForest::FBMXD, PredefForest::IBMXD, PredefForest::ESRBMXD};
+    for (PredefForest bdd : bdds) {
+        for (int test=0; isPass && (test<TESTS); test++) {
+            isPass = testQuantify(numVals, bdd);
+        }
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
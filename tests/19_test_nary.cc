@@ -0,0 +1,169 @@
+#include "gen_random_functions.h"
+
+/* Value of a function at the index n of its truth table */
+int evaluateAt(const Func& func, uint16_t num, unsigned long n)
+{
+    std::vector<bool> assignment(num+1, 0);
+    std::vector<bool> assignmentTo(num+1, 0);
+    Value val;
+    if (func.getForest()->getSetting().isRelation()) {
+        for (uint16_t l=1; l<=num; l++) {
+            assignment[l] = n & (0x01UL << (2*l-1));
+            assignmentTo[l] = n & (0x01UL << (2*l-2));
+        }
+        val = func.evaluate(assignment, assignmentTo);
+    } else {
+        decimalToAssignment(n, assignment);
+        val = func.evaluate(assignment);
+    }
+    int v = 0;
+    val.getValueTo(&v, INT);
+    return v;
+}
+
+/* Multi-terminal function with the given integer values */
+Edge buildMtSetEdge(Forest* forest, uint16_t lvl, std::vector<int>& fun, int start, int end)
+{
+    std::vector<Edge> child(2);
+    EdgeLabel label = 0;
+    packRule(label, RULE_X);
+    if (lvl == 1) {
+        child[0].setEdgeHandle(makeTerminal(INT, fun[start]));
+        child[1].setEdgeHandle(makeTerminal(INT, fun[end]));
+        child[0].setRule(RULE_X);
+        child[1].setRule(RULE_X);
+        return forest->reduceEdge(lvl, label, lvl, child);
+    }
+    child[0] = buildMtSetEdge(forest, lvl-1, fun, start, start+(1<<(lvl-1))-1);
+    child[1] = buildMtSetEdge(forest, lvl-1, fun, start+(1<<(lvl-1)), end);
+    return forest->reduceEdge(lvl, label, lvl, child);
+}
+
+/*
+ *  k random Boolean functions, some of them repeated or complemented: the n-ary Union and
+ *  Intersection must agree with their truth tables.
+ */
+bool testUnionIntersection(uint16_t num, PredefForest bdd, int k)
+{
+    ForestSetting setting(bdd, num);
+    Forest* forest = new Forest(setting);
+    bool isRel = setting.isRelation();
+    unsigned long size = (isRel) ? 0x01UL<<(2*num) : 0x01UL<<(num);
+    std::vector<std::vector<bool> > funs(k, std::vector<bool>(size));
+    std::vector<Func> args(k, Func(forest));
+    for (int j=0; j<k; j++) {
+        double density = (random01() < 0.5) ? 0.1 : 0.9;
+        for (unsigned long i=0; i<size; i++) funs[j][i] = random01() < density;
+        if ((j > 0) && (random01() < 0.2)) funs[j] = funs[j-1];
+        if ((j > 0) && (random01() < 0.1)) {
+            funs[j] = funs[j-1];
+            funs[j].flip();
+        }
+        if (isRel) {
+            args[j].setEdge(buildRelEdge(forest, num, funs[j], 0, size-1));
+        } else {
+            args[j].setEdge(buildSetEdge(forest, num, funs[j], 0, size-1));
+        }
+    }
+    Func resUnion(forest), resInter(forest);
+    apply(UNION, args, resUnion);
+    apply(INTERSECTION, args, resInter);
+
+    bool isPass = 1;
+    for (unsigned long n=0; n<size; n++) {
+        bool valUnion = 0, valInter = 1;
+        for (int j=0; j<k; j++) {
+            valUnion = valUnion || funs[j][n];
+            valInter = valInter && funs[j][n];
+        }
+        if ((evaluateAt(resUnion, num, n) != valUnion) || (evaluateAt(resInter, num, n) != valInter)) {
+            std::cout << "failed at assignment " << n << " in " << setting.getName()
+                      << " with " << k << " functions" << std::endl;
+            isPass = 0;
+            break;
+        }
+    }
+    delete forest;
+    return isPass;
+}
+
+/*
+ *  k random integer functions: the n-ary Minimum and Maximum must agree with their truth tables.
+ */
+bool testMinMax(uint16_t num, PredefForest bdd, int k)
+{
+    ForestSetting setting(bdd, num);
+    Forest* forest = new Forest(setting);
+    unsigned long size = 0x01UL<<(num);
+    std::vector<std::vector<int> > funs(k, std::vector<int>(size));
+    std::vector<Func> args(k, Func(forest));
+    for (int j=0; j<k; j++) {
+        std::vector<Value> vals(size);
+        for (unsigned long i=0; i<size; i++) {
+            funs[j][i] = random06(gen) % 6;
+            vals[i] = funs[j][i];
+        }
+        if (setting.getEncodeMechanism() == TERMINAL) {
+            args[j].setEdge(buildMtSetEdge(forest, num, funs[j], 0, size-1));
+        } else {
+            args[j].setEdge(buildEvSetEdge(forest, num, vals, 0, size-1));
+        }
+    }
+    Func resMin(forest), resMax(forest);
+    apply(MINIMUM, args, resMin);
+    apply(MAXIMUM, args, resMax);
+
+    bool isPass = 1;
+    for (unsigned long n=0; n<size; n++) {
+        int valMin = funs[0][n], valMax = funs[0][n];
+        for (int j=1; j<k; j++) {
+            valMin = MIN(valMin, funs[j][n]);
+            valMax = MAX(valMax, funs[j][n]);
+        }
+        if ((evaluateAt(resMin, num, n) != valMin) || (evaluateAt(resMax, num, n) != valMax)) {
+            std::cout << "failed at assignment " << n << " in " << setting.getName()
+                      << " with " << k << " functions" << std::endl;
+            isPass = 0;
+            break;
+        }
+    }
+    delete forest;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 8;
+    uint16_t numVals = 5;
+    if (argc == 2) {
+        printf("Usage: ./test_nary [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate lists of functions to test the n-ary operations\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest bdds[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                           PredefForest::ZBDD, PredefForest::ESRBDD, PredefForest::CESRBDD,
+                           PredefForest::QBMXD, PredefForest::FBMXD, PredefForest::IBMXD, PredefForest::ESRBMXD};
+    for (PredefForest bdd : bdds) {
+        for (int test=0; isPass && (test<TESTS); test++) {
+            isPass = testUnionIntersection(numVals, bdd, 1 + (test*3) % 13);
+        }
+    }
+    PredefForest mdds[] = {PredefForest::MTBDD, PredefForest::EVFBDD};
+    for (PredefForest mdd : mdds) {
+        for (int test=0; isPass && (test<TESTS); test++) {
+            isPass = testMinMax(numVals, mdd, 2 + (test*3) % 11);
+        }
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
@@ -0,0 +1,119 @@
+#include "gen_random_functions.h"
+
+/*
+ *  A batch of random pairs, some of them repeated: every result of the batched apply must be
+ *  the result of the apply on its pair alone.
+ */
+bool testBatch(uint16_t num, PredefForest bdd, PredefForest bmxd, int k)
+{
+    ForestSetting settingS(bdd, num);
+    Forest* forestS = new Forest(settingS);
+    ForestSetting settingR(bmxd, num);
+    Forest* forestR = new Forest(settingR);
+    unsigned long sizeS = 0x01UL<<(num);
+    unsigned long sizeR = 0x01UL<<(2*num);
+    std::vector<Func> sets1(k, Func(forestS)), sets2(k, Func(forestS)), rels(k, Func(forestR));
+    for (int j=0; j<k; j++) {
+        std::vector<bool> funS1(sizeS), funS2(sizeS), funR(sizeR);
+        for (unsigned long i=0; i<sizeS; i++) {
+            funS1[i] = random01() < 0.5;
+            funS2[i] = random01() < 0.5;
+        }
+        for (unsigned long i=0; i<sizeR; i++) funR[i] = random01() < 0.1;
+        sets1[j].setEdge(buildSetEdge(forestS, num, funS1, 0, sizeS-1));
+        sets2[j].setEdge(buildSetEdge(forestS, num, funS2, 0, sizeS-1));
+        rels[j].setEdge(buildRelEdge(forestR, num, funR, 0, sizeR-1));
+        // repeated pairs, also in the other order
+        if ((j > 0) && (random01() < 0.3)) {
+            sets1[j] = sets2[j-1];
+            sets2[j] = sets1[j-1];
+            rels[j] = rels[j-1];
+        }
+    }
+    std::vector<Func> unions, inters, images;
+    apply(UNION, sets1, sets2, unions);
+    apply(INTERSECTION, sets1, sets2, inters);
+    apply(POST_IMAGE, sets1, rels, images);
+    // pairs across forests: the second sets in another forest, and the images in it
+    ForestSetting settingT((bdd == PredefForest::FBDD) ? PredefForest::QBDD : PredefForest::FBDD, num);
+    Forest* forestT = new Forest(settingT);
+    std::vector<Func> setsT(k, Func(forestT));
+    for (int j=0; j<k; j++) apply(UNION, sets2[j], sets2[j], setsT[j]);
+    std::vector<Func> crossUnions, swappedUnions(1, Func(forestS)), crossImages(1, Func(forestT));
+    apply(UNION, sets1, setsT, crossUnions);
+    // and the other way around: UNION keeps one operation for both orders of the forests
+    apply(UNION, setsT, sets1, swappedUnions);
+    apply(POST_IMAGE, sets1, rels, crossImages);
+
+    // batches of different sizes are rejected, also when one is empty
+    int numThrown = 0;
+    std::vector<Func> shorter(sets2.begin(), sets2.end()-1), none, res;
+    try {
+        apply(UNION, sets1, shorter, res);
+    } catch (const error& e) {
+        numThrown++;
+    }
+    try {
+        apply(UNION, sets1, none, res);
+    } catch (const error& e) {
+        numThrown++;
+    }
+    try {
+        apply(UNION, none, sets2, res);
+    } catch (const error& e) {
+        numThrown++;
+    }
+
+    bool isPass = (numThrown == 3) && (unions.size() == (size_t)k) && (inters.size() == (size_t)k) && (images.size() == (size_t)k)
+                    && (crossUnions.size() == (size_t)k) && (swappedUnions.size() == (size_t)k) && (crossImages.size() == (size_t)k);
+    for (int j=0; isPass && (j<k); j++) {
+        Func resUnion(forestS), resInter(forestS), resImage(forestS), resCrossImage(forestT);
+        apply(UNION, sets1[j], sets2[j], resUnion);
+        apply(INTERSECTION, sets1[j], sets2[j], resInter);
+        apply(POST_IMAGE, sets1[j], rels[j], resImage);
+        apply(POST_IMAGE, sets1[j], rels[j], resCrossImage);
+        if (!(unions[j] == resUnion) || !(inters[j] == resInter) || !(images[j] == resImage)
+            || !(crossUnions[j] == resUnion) || !(swappedUnions[j] == resUnion) || !(crossImages[j] == resCrossImage)) {
+            std::cout << "failed at pair " << j << " in " << settingS.getName()
+                      << " and " << settingR.getName() << std::endl;
+            isPass = 0;
+        }
+    }
+    delete forestT;
+    delete forestS;
+    delete forestR;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 5;
+    uint16_t numVals = 5;
+    if (argc == 2) {
+        printf("Usage: ./test_batch [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate batches of pairs to test the batched apply\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest bdds[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                           PredefForest::ZBDD, PredefForest::ESRBDD, PredefForest::CESRBDD};
+    PredefForest bmxds[] = {PredefForest::FBMXD, PredefForest::IBMXD};
+    for (PredefForest bdd : bdds) {
+        for (PredefForest bmxd : bmxds) {
+            for (int test=0; isPass && (test<TESTS); test++) {
+                isPass = testBatch(numVals, bdd, bmxd, 1 + test*4);
+            }
+        }
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
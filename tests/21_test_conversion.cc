@@ -0,0 +1,125 @@
+#include "gen_random_functions.h"
+
+/* Value of a function at the index n of its truth table */
+int evaluateAt(const Func& func, uint16_t num, unsigned long n)
+{
+    std::vector<bool> assignment(num+1, 0);
+    std::vector<bool> assignmentTo(num+1, 0);
+    Value val;
+    if (func.getForest()->getSetting().isRelation()) {
+        for (uint16_t l=1; l<=num; l++) {
+            assignment[l] = n & (0x01UL << (2*l-1));
+            assignmentTo[l] = n & (0x01UL << (2*l-2));
+        }
+        val = func.evaluate(assignment, assignmentTo);
+    } else {
+        decimalToAssignment(n, assignment);
+        val = func.evaluate(assignment);
+    }
+    int v = 0;
+    val.getValueTo(&v, INT);
+    return v;
+}
+
+bool isSameFunction(const Func& f, const Func& g, uint16_t num, unsigned long size)
+{
+    for (unsigned long n=0; n<size; n++) {
+        if (evaluateAt(f, num, n) != evaluateAt(g, num, n)) return 0;
+    }
+    return 1;
+}
+
+/*
+ *  Random functions copied from one forest to another: first f, then f | !g which shares nodes
+ *  with f, then again after the nodes of f are reclaimed in both forests. The copies must be
+ *  the same functions, and copying again or copying back must give the same edges.
+ */
+bool testConversion(uint16_t num, PredefForest from, PredefForest to)
+{
+    ForestSetting settingFrom(from, num);
+    ForestSetting settingTo(to, num);
+    Forest* forestFrom = new Forest(settingFrom);
+    Forest* forestTo = new Forest(settingTo);
+    bool isRel = settingFrom.isRelation();
+    unsigned long size = (isRel) ? 0x01UL<<(2*num) : 0x01UL<<(num);
+    std::vector<bool> funF(size), funG(size), funFG(size);
+    for (unsigned long i=0; i<size; i++) {
+        funF[i] = random01() < 0.3;
+        funG[i] = random01() < 0.1;
+        funFG[i] = funF[i] || !funG[i];
+    }
+    Func f(forestFrom), g(forestFrom), fg(forestFrom);
+    if (isRel) {
+        f.setEdge(buildRelEdge(forestFrom, num, funF, 0, size-1));
+        g.setEdge(buildRelEdge(forestFrom, num, funG, 0, size-1));
+        fg.setEdge(buildRelEdge(forestFrom, num, funFG, 0, size-1));
+    } else {
+        f.setEdge(buildSetEdge(forestFrom, num, funF, 0, size-1));
+        g.setEdge(buildSetEdge(forestFrom, num, funG, 0, size-1));
+        fg.setEdge(buildSetEdge(forestFrom, num, funFG, 0, size-1));
+    }
+    bool isPass = 1;
+    Func copyF(forestTo), copyFG(forestTo), again(forestTo), back(forestFrom);
+    apply(COPY, f, copyF);
+    apply(COPY, fg, copyFG);
+    isPass = isSameFunction(f, copyF, num, size) && isSameFunction(fg, copyFG, num, size);
+    apply(COPY, fg, again);
+    apply(COPY, copyFG, back);
+    isPass = isPass && (again.getEdge() == copyFG.getEdge()) && (back.getEdge() == fg.getEdge());
+    // reclaim the nodes only used by f in both forests, and copy again
+    forestFrom->markNodes(fg);
+    forestFrom->markNodes(g);
+    forestFrom->markSweep();
+    forestTo->markNodes(copyFG);
+    forestTo->markSweep();
+    Func copyG(forestTo);
+    apply(COPY, g, copyG);
+    apply(COPY, fg, copyFG);
+    isPass = isPass && isSameFunction(g, copyG, num, size) && isSameFunction(fg, copyFG, num, size);
+    if (!isPass) {
+        std::cout << "failed from " << settingFrom.getName() << " to " << settingTo.getName() << std::endl;
+    }
+    delete forestFrom;
+    delete forestTo;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 2;
+    uint16_t numVals = 5;
+    if (argc == 2) {
+        printf("Usage: ./test_conversion [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate functions to test the conversion between forests\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest bdds[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                           PredefForest::ZBDD, PredefForest::ESRBDD, PredefForest::CESRBDD};
+    for (PredefForest from : bdds) {
+        for (PredefForest to : bdds) {
+            for (int test=0; isPass && (test<TESTS); test++) {
+                if (from != to) isPass = testConversion(numVals, from, to);
+            }
+        }
+    }
+    PredefForest bmxds[] = {PredefForest::QBMXD, PredefForest::FBMXD, PredefForest::IBMXD, PredefForest::ESRBMXD};
+    for (PredefForest from : bmxds) {
+        for (PredefForest to : bmxds) {
+            for (int test=0; isPass && (test<TESTS); test++) {
+                if (from != to) isPass = testConversion(numVals, from, to);
+            }
+        }
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
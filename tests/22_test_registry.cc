@@ -0,0 +1,90 @@
+#include "brave_dd.h"
+
+using namespace BRAVE_DD;
+
+/* x1 | !x2 built by the operators, checked on its truth table */
+bool testOperators(Forest* forest)
+{
+    Func x1(forest), x2(forest);
+    x1.variable(1);
+    x2.variable(2);
+    Func f = x1 | !x2;
+    std::vector<bool> assignment(forest->getSetting().getNumVars()+1, 0);
+    for (int n=0; n<4; n++) {
+        assignment[1] = n & 0x01;
+        assignment[2] = n & 0x02;
+        int v = 0;
+        f.evaluate(assignment).getValueTo(&v, INT);
+        if (v != (assignment[1] || !assignment[2])) return 0;
+    }
+    return 1;
+}
+
+/*
+ *  Operations of many forests: the same one must be found for the same type and forests,
+ *  kept while its forests live, and gone with them, including when a new forest gets the
+ *  address of a destroyed one.
+ */
+int main(int argc, char** argv){
+    int numForests = 8;
+    if ((argc == 2) && (std::string(argv[1]) == "-h")) {
+        printf("Usage: ./test_registry [num_forests]\n");
+        printf("\tThis will create and destroy forests to test the lists of operations\n");
+        exit(0);
+    }
+    if (argc >= 2) numForests = atoi(argv[1]);
+
+    bool isPass = 1;
+    PredefForest types[] = {PredefForest::REXBDD, PredefForest::FBDD, PredefForest::CFBDD, PredefForest::ZBDD};
+    std::vector<Forest*> forests(numForests);
+    for (int i=0; i<numForests; i++) forests[i] = new Forest(ForestSetting(types[i % 4], 4));
+    Forest* rels = new Forest(ForestSetting(PredefForest::FBMXD, 4));
+
+    std::vector<BinaryOperation*> unions(numForests);
+    std::vector<UnaryOperation*> copies(numForests);
+    for (int i=0; i<numForests; i++) {
+        Forest* other = forests[(i+1) % numForests];
+        unions[i] = UNION(forests[i], forests[i], forests[i]);
+        copies[i] = COPY(forests[i], other);
+        if ((UNION(forests[i], forests[i], forests[i]) != unions[i])
+            || (COPY(forests[i], other) != copies[i])
+            || (UNION(forests[i], other, forests[i]) != UNION(other, forests[i], forests[i]))
+            || (INTERSECTION(forests[i], forests[i], forests[i]) == unions[i])
+            || (CARDINALITY(forests[i], OpndType::INTEGER) != CARDINALITY(forests[i], OpndType::INTEGER))
+            || (CARDINALITY(forests[i], OpndType::INTEGER) == CARDINALITY(forests[i], OpndType::REAL))
+            || (SATURATE(forests[i], rels, forests[i]) != SATURATE(forests[i], rels, forests[i]))
+            || (PRE_SATURATE(forests[i], rels, forests[i]) != PRE_SATURATE(forests[i], rels, forests[i]))
+            || (PRE_SATURATE(forests[i], rels, forests[i]) == SATURATE(forests[i], rels, forests[i]))) {
+            std::cout << "failed finding the operations of forest " << i << std::endl;
+            isPass = 0;
+        }
+    }
+    // destroy the odd forests; the operations of the even ones that do not use them are kept
+    for (int i=1; i<numForests; i+=2) {
+        delete forests[i];
+        forests[i] = nullptr;
+    }
+    for (int i=0; isPass && (i<numForests); i+=2) {
+        if ((UNION(forests[i], forests[i], forests[i]) != unions[i]) || !testOperators(forests[i])) {
+            std::cout << "failed keeping the operations of forest " << i << std::endl;
+            isPass = 0;
+        }
+    }
+    // new forests, maybe at the addresses of the destroyed ones
+    for (int i=1; isPass && (i<numForests); i+=2) {
+        forests[i] = new Forest(ForestSetting(types[(i+1) % 4], 4));
+        if (!testOperators(forests[i])) {
+            std::cout << "failed with the new forest " << i << std::endl;
+            isPass = 0;
+        }
+    }
+    for (int i=0; i<numForests; i++) delete forests[i];
+    delete rels;
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
@@ -0,0 +1,131 @@
+#include "gen_random_functions.h"
+
+/* Value of a function at the index n of its truth table */
+bool evaluateAt(const Func& func, uint16_t num, unsigned long n)
+{
+    std::vector<bool> assignment(num+1, 0);
+    std::vector<bool> assignmentTo(num+1, 0);
+    Value val;
+    if (func.getForest()->getSetting().isRelation()) {
+        for (uint16_t l=1; l<=num; l++) {
+            assignment[l] = n & (0x01UL << (2*l-1));
+            assignmentTo[l] = n & (0x01UL << (2*l-2));
+        }
+        val = func.evaluate(assignment, assignmentTo);
+    } else {
+        decimalToAssignment(n, assignment);
+        val = func.evaluate(assignment);
+    }
+    int v = 0;
+    val.getValueTo(&v, INT);
+    return v;
+}
+
+bool isFunction(const Func& f, const std::vector<bool>& fun, uint16_t num)
+{
+    for (unsigned long n=0; n<fun.size(); n++) {
+        if (evaluateAt(f, num, n) != fun[n]) return 0;
+    }
+    return 1;
+}
+
+/*
+ *  Random expressions over random functions, some of them repeated, complemented, constant, or
+ *  in another forest: the lazy expression must give the function of the truth tables.
+ */
+bool testExpression(uint16_t num, PredefForest type, PredefForest other, int numLeaves, int numOps)
+{
+    ForestSetting setting(type, num);
+    Forest* forest = new Forest(setting);
+    Forest* otherForest = new Forest(ForestSetting(other, num));
+    bool isRel = setting.isRelation();
+    unsigned long size = (isRel) ? 0x01UL<<(2*num) : 0x01UL<<(num);
+
+    std::vector<std::vector<bool> > funs;
+    std::vector<Func> leaves;
+    std::vector<Expression> lazy;
+    for (int k=0; k<numLeaves; k++) {
+        std::vector<bool> fun(size);
+        double density = random01();
+        for (unsigned long i=0; i<size; i++) fun[i] = random01() < density;
+        if (k % 4 == 3) {
+            // the complement of another leaf, or a constant
+            fun = funs[k-1];
+            fun.flip();
+            if (k % 8 == 7) fun.assign(size, k % 16 == 7);
+        }
+        Forest* f = (k == numLeaves-1) ? otherForest : forest;
+        Func leaf(f);
+        leaf.setEdge((isRel) ? buildRelEdge(f, num, fun, 0, size-1) : buildSetEdge(f, num, fun, 0, size-1));
+        leaves.push_back(leaf);
+        funs.push_back(fun);
+        lazy.push_back(Expression(leaf));
+    }
+    for (int k=0; k<numOps; k++) {
+        size_t a = (size_t)(random01() * funs.size());
+        size_t b = (size_t)(random01() * funs.size());
+        int op = (int)(random01() * 4);
+        std::vector<bool> fun(size);
+        for (unsigned long i=0; i<size; i++) {
+            fun[i] = (op == 0) ? (funs[a][i] && funs[b][i])
+                    : (op == 1) ? (funs[a][i] || funs[b][i])
+                    : (op == 2) ? (funs[a][i] != funs[b][i])
+                    : !funs[a][i];
+        }
+        funs.push_back(fun);
+        if (op == 0) {
+            lazy.push_back(lazy[a] & lazy[b]);
+        } else if (op == 1) {
+            lazy.push_back((b < (size_t)numLeaves) ? (lazy[a] | leaves[b]) : (lazy[a] | lazy[b]));
+        } else if (op == 2) {
+            lazy.push_back(lazy[a] ^ lazy[b]);
+        } else {
+            lazy.push_back(!lazy[a]);
+        }
+    }
+    Func res = lazy.back();
+    bool isPass = (res.getForest() == lazy.back().getForest()) && isFunction(res, funs.back(), num);
+    if (!isPass) {
+        std::cout << "failed in " << setting.getName() << " with " << numLeaves << " leaves and "
+                  << numOps << " operators" << std::endl;
+    }
+    delete forest;
+    delete otherForest;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 5;
+    uint16_t numVals = 5;
+    if (argc == 2) {
+        printf("Usage: ./test_expression [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate expressions to test their lazy computation\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest bdds[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                           PredefForest::ZBDD, PredefForest::ESRBDD, PredefForest::CESRBDD};
+    for (PredefForest bdd : bdds) {
+        for (int test=0; isPass && (test<TESTS); test++) {
+            isPass = testExpression(numVals, bdd, PredefForest::FBDD, 2 + test % 6, 1 + 3*test);
+        }
+    }
+    PredefForest bmxds[] = {PredefForest::QBMXD, PredefForest::FBMXD, PredefForest::IBMXD, PredefForest::ESRBMXD};
+    for (PredefForest bmxd : bmxds) {
+        for (int test=0; isPass && (test<TESTS); test++) {
+            isPass = testExpression(numVals, bmxd, PredefForest::FBMXD, 2 + test % 6, 1 + 3*test);
+        }
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
@@ -0,0 +1,85 @@
+#include "gen_random_functions.h"
+
+/*
+ *  A random function and a batch of random assignments, bit-packed by variable: every value of
+ *  the batched evaluation must be the value of the assignment evaluated alone.
+ */
+bool testEvaluateBatch(uint16_t num, PredefForest type, size_t numAssignments)
+{
+    ForestSetting setting(type, num);
+    Forest* forest = new Forest(setting);
+    bool isRel = setting.isRelation();
+    unsigned long size = (isRel) ? 0x01UL<<(2*num) : 0x01UL<<(num);
+    std::vector<bool> fun(size);
+    double density = random01();
+    for (unsigned long i=0; i<size; i++) fun[i] = random01() < density;
+    Func f(forest);
+    f.setEdge((isRel) ? buildRelEdge(forest, num, fun, 0, size-1) : buildSetEdge(forest, num, fun, 0, size-1));
+
+    size_t numWords = (numAssignments + 63) / 64;
+    std::vector<std::vector<uint64_t> > from(num+1, std::vector<uint64_t>(numWords, 0));
+    std::vector<std::vector<uint64_t> > to(num+1, std::vector<uint64_t>(numWords, 0));
+    std::vector<std::vector<bool> > assignments(numAssignments, std::vector<bool>(num+1, 0));
+    std::vector<std::vector<bool> > assignmentsTo(numAssignments, std::vector<bool>(num+1, 0));
+    for (size_t n=0; n<numAssignments; n++) {
+        // some assignments are the identity, for the relations
+        bool isIdent = random01() < 0.3;
+        for (uint16_t k=1; k<=num; k++) {
+            assignments[n][k] = random01() < 0.5;
+            assignmentsTo[n][k] = (isIdent) ? assignments[n][k] : (random01() < 0.5);
+            if (assignments[n][k]) from[k][n/64] |= 0x01UL << (n%64);
+            if (assignmentsTo[n][k]) to[k][n/64] |= 0x01UL << (n%64);
+        }
+    }
+    std::vector<Value> values;
+    if (isRel) {
+        f.evaluate(from, to, numAssignments, values);
+    } else {
+        f.evaluate(from, numAssignments, values);
+    }
+    bool isPass = (values.size() == numAssignments);
+    for (size_t n=0; isPass && (n<numAssignments); n++) {
+        Value val = (isRel) ? f.evaluate(assignments[n], assignmentsTo[n]) : f.evaluate(assignments[n]);
+        int expected = 0, v = 0;
+        val.getValueTo(&expected, INT);
+        values[n].getValueTo(&v, INT);
+        if (v != expected) {
+            std::cout << "failed at assignment " << n << " in " << setting.getName() << std::endl;
+            isPass = 0;
+        }
+    }
+    delete forest;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 5;
+    uint16_t numVals = 6;
+    if (argc == 2) {
+        printf("Usage: ./test_evaluate_batch [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate functions and assignments to test the batched evaluation\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest types[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                            PredefForest::SFBDD, PredefForest::CSFBDD, PredefForest::ZBDD,
+                            PredefForest::ESRBDD, PredefForest::CESRBDD,
+                            PredefForest::QBMXD, PredefForest::FBMXD, PredefForest::IBMXD, PredefForest::ESRBMXD};
+    for (PredefForest type : types) {
+        for (int test=0; isPass && (test<TESTS); test++) {
+            isPass = testEvaluateBatch(numVals, type, 1 + test*97);
+        }
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
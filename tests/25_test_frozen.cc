@@ -0,0 +1,123 @@
+#include "gen_random_functions.h"
+
+/* Every assignment of the function must have the same value frozen */
+bool isSame(const Func& f, uint16_t num)
+{
+    FrozenFunc frozen(f);
+    bool isRel = f.getForest()->getSetting().isRelation();
+    unsigned long size = (isRel) ? 0x01UL<<(2*num) : 0x01UL<<(num);
+    std::vector<bool> assignment(num+1, 0);
+    std::vector<bool> assignmentTo(num+1, 0);
+    for (unsigned long n=0; n<size; n++) {
+        Value expected, val;
+        if (isRel) {
+            for (uint16_t l=1; l<=num; l++) {
+                assignment[l] = n & (0x01UL << (2*l-1));
+                assignmentTo[l] = n & (0x01UL << (2*l-2));
+            }
+            expected = f.evaluate(assignment, assignmentTo);
+            val = frozen.evaluate(assignment, assignmentTo);
+        } else {
+            decimalToAssignment(n, assignment);
+            expected = f.evaluate(assignment);
+            val = frozen.evaluate(assignment);
+        }
+        if (val != expected) {
+            std::cout << "failed at assignment " << n << " in " << f.getForest()->getSetting().getName() << std::endl;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* A random Boolean function, or relation */
+bool testBoolean(uint16_t num, PredefForest type)
+{
+    ForestSetting setting(type, num);
+    Forest* forest = new Forest(setting);
+    bool isRel = setting.isRelation();
+    unsigned long size = (isRel) ? 0x01UL<<(2*num) : 0x01UL<<(num);
+    std::vector<bool> fun(size);
+    double density = random01();
+    for (unsigned long i=0; i<size; i++) fun[i] = random01() < density;
+    Func f(forest);
+    f.setEdge((isRel) ? buildRelEdge(forest, num, fun, 0, size-1) : buildSetEdge(forest, num, fun, 0, size-1));
+    bool isPass = isSame(f, num);
+    delete forest;
+    return isPass;
+}
+
+/* A random EV+ or EV% function, with some infinite values */
+bool testEvPlus(uint16_t num, PredefForest type, unsigned long mod)
+{
+    ForestSetting setting(type, num);
+    setting.setValType(INT);
+    if (mod > 0) setting.setMaxRange(mod);
+    Forest* forest = new Forest(setting);
+    std::vector<Value> fun(0x01UL<<num);
+    for (size_t i=0; i<fun.size(); i++) {
+        if (random01() < 0.2) continue;
+        fun[i] = Value((int)(random01() * 32.0));
+    }
+    Func f(forest);
+    f.setEdge(buildEvSetEdge(forest, num, fun, 0, fun.size()-1));
+    bool isPass = isSame(f, num);
+    delete forest;
+    return isPass;
+}
+
+/* A product distribution with some zero probabilities, in EV* */
+bool testEvMult(uint16_t num, PredefForest type)
+{
+    ForestSetting setting(type, num);
+    Forest* forest = new Forest(setting);
+    Func dist(forest);
+    dist.trueFunc();
+    for (uint16_t k=1; k<=num; k++) {
+        double prob = (random01() < 0.2) ? 1.0 : random01();
+        Func x(forest);
+        x.variable(k, Value(1.0 - prob), Value(prob));
+        apply(MULTIPLY, dist, x, dist);
+    }
+    bool isPass = isSame(dist, num);
+    delete forest;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 5;
+    uint16_t numVals = 6;
+    if (argc == 2) {
+        printf("Usage: ./test_frozen [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate functions to test their frozen evaluation\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest bools[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                            PredefForest::SFBDD, PredefForest::CSFBDD, PredefForest::ZBDD,
+                            PredefForest::ESRBDD, PredefForest::CESRBDD,
+                            PredefForest::QBMXD, PredefForest::FBMXD, PredefForest::IBMXD, PredefForest::ESRBMXD};
+    for (PredefForest type : bools) {
+        for (int test=0; isPass && (test<TESTS); test++) isPass = testBoolean(numVals, type);
+    }
+    for (int test=0; isPass && (test<TESTS); test++) {
+        isPass = testEvPlus(numVals, PredefForest::EVQBDD, 0)
+                && testEvPlus(numVals, PredefForest::EVFBDD, 0)
+                && testEvPlus(numVals, PredefForest::EVMODQBDD, 7)
+                && testEvPlus(numVals, PredefForest::EVMODFBDD, 7)
+                && testEvMult(numVals, PredefForest::EVSTARQBDD)
+                && testEvMult(numVals, PredefForest::EVSTARFBDD);
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
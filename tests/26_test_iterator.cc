@@ -0,0 +1,175 @@
+#include "gen_random_functions.h"
+
+/* The assignment at the index n of the truth table */
+void assignmentAt(unsigned long n, bool isRel, std::vector<bool>& aFrom, std::vector<bool>& aTo)
+{
+    for (size_t l=1; l<aFrom.size(); l++) {
+        if (isRel) {
+            aFrom[l] = n & (0x01UL << (2*l-1));
+            aTo[l] = n & (0x01UL << (2*l-2));
+        } else {
+            aFrom[l] = n & (0x01UL << (l-1));
+        }
+    }
+}
+
+bool isMatch(char c, bool val, bool from)
+{
+    return (c == FuncIterator::DONT_CARE) || ((c == FuncIterator::SAME) && (val == from))
+            || ((c == FuncIterator::DIFF) && (val != from)) || ((c == 0) && !val) || ((c == 1) && val);
+}
+
+/* Zero, or a special value for EV+ */
+bool isSkipped(const Value& val, EncodeMechanism encode)
+{
+    if ((encode == EDGE_PLUS) || (encode == EDGE_PLUSMOD)) return val.getType() == VOID;
+    double d = 1.0;
+    if (val.getType() != VOID) val.getValueTo(&d, DOUBLE);
+    return d == 0.0;
+}
+
+/*
+ *  The cubes (or minterms) of the iterator must cover every assignment with a nonzero value
+ *  (every assignment with isAll) exactly once, with the value of Func::evaluate.
+ */
+bool isEnumerated(const Func& f, uint16_t num, bool isMinterm, bool isAll)
+{
+    const ForestSetting& setting = f.getForest()->getSetting();
+    bool isRel = setting.isRelation();
+    unsigned long size = (isRel) ? 0x01UL<<(2*num) : 0x01UL<<(num);
+    std::vector<Value> values(size);
+    std::vector<int> covered(size, 0);
+    std::vector<bool> aFrom(num+1, 0), aTo(num+1, 0);
+    for (unsigned long n=0; n<size; n++) {
+        assignmentAt(n, isRel, aFrom, aTo);
+        values[n] = (isRel) ? f.evaluate(aFrom, aTo) : f.evaluate(aFrom);
+    }
+    FuncIterator it(f, isMinterm, isAll);
+    while (it.next()) {
+        const std::vector<char>& cube = it.getCube();
+        const std::vector<char>& cubeTo = it.getCubeTo();
+        for (uint16_t l=1; isMinterm && (l<=num); l++) {
+            if ((cube[l] > 1) || (isRel && (cubeTo[l] > 1))) return 0;
+        }
+        for (unsigned long n=0; n<size; n++) {
+            assignmentAt(n, isRel, aFrom, aTo);
+            bool isIn = 1;
+            for (uint16_t l=1; isIn && (l<=num); l++) {
+                isIn = isMatch(cube[l], aFrom[l], 0) && (!isRel || isMatch(cubeTo[l], aTo[l], aFrom[l]));
+            }
+            if (!isIn) continue;
+            covered[n]++;
+            if (values[n] != it.getValue()) {
+                std::cout << "wrong value at assignment " << n << " in " << setting.getName() << std::endl;
+                return 0;
+            }
+        }
+    }
+    for (unsigned long n=0; n<size; n++) {
+        if (covered[n] != ((isAll || !isSkipped(values[n], setting.getEncodeMechanism())) ? 1 : 0)) {
+            std::cout << "assignment " << n << " covered " << covered[n] << " times in " << setting.getName() << std::endl;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+bool isEnumerated(const Func& f, uint16_t num)
+{
+    return isEnumerated(f, num, 0, 0) && isEnumerated(f, num, 1, 0) && isEnumerated(f, num, 0, 1);
+}
+
+/* A random Boolean function, or relation */
+bool testBoolean(uint16_t num, PredefForest type)
+{
+    ForestSetting setting(type, num);
+    Forest* forest = new Forest(setting);
+    bool isRel = setting.isRelation();
+    unsigned long size = (isRel) ? 0x01UL<<(2*num) : 0x01UL<<(num);
+    std::vector<bool> fun(size);
+    double density = random01();
+    for (unsigned long i=0; i<size; i++) fun[i] = random01() < density;
+    Func f(forest);
+    f.setEdge((isRel) ? buildRelEdge(forest, num, fun, 0, size-1) : buildSetEdge(forest, num, fun, 0, size-1));
+    bool isPass = isEnumerated(f, num);
+    // stop early
+    FuncIterator it(f, 1);
+    for (int k=0; k<3; k++) it.next();
+    delete forest;
+    return isPass;
+}
+
+/* A random EV+ or EV% function, with some infinite values */
+bool testEvPlus(uint16_t num, PredefForest type, unsigned long mod)
+{
+    ForestSetting setting(type, num);
+    setting.setValType(INT);
+    if (mod > 0) setting.setMaxRange(mod);
+    Forest* forest = new Forest(setting);
+    std::vector<Value> fun(0x01UL<<num);
+    for (size_t i=0; i<fun.size(); i++) {
+        if (random01() < 0.2) continue;
+        fun[i] = Value((int)(random01() * 32.0));
+    }
+    Func f(forest);
+    f.setEdge(buildEvSetEdge(forest, num, fun, 0, fun.size()-1));
+    bool isPass = isEnumerated(f, num);
+    delete forest;
+    return isPass;
+}
+
+/* A product distribution with some zero probabilities, in EV* */
+bool testEvMult(uint16_t num, PredefForest type)
+{
+    ForestSetting setting(type, num);
+    Forest* forest = new Forest(setting);
+    Func dist(forest);
+    dist.trueFunc();
+    for (uint16_t k=1; k<=num; k++) {
+        double prob = (random01() < 0.2) ? 1.0 : random01();
+        Func x(forest);
+        x.variable(k, Value(1.0 - prob), Value(prob));
+        apply(MULTIPLY, dist, x, dist);
+    }
+    bool isPass = isEnumerated(dist, num);
+    delete forest;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 5;
+    uint16_t numVals = 5;
+    if (argc == 2) {
+        printf("Usage: ./test_iterator [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate functions to test the enumeration of their cubes and minterms\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest bools[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                            PredefForest::SFBDD, PredefForest::CSFBDD, PredefForest::ZBDD,
+                            PredefForest::ESRBDD, PredefForest::CESRBDD,
+                            PredefForest::QBMXD, PredefForest::FBMXD, PredefForest::IBMXD, PredefForest::ESRBMXD};
+    for (PredefForest type : bools) {
+        for (int test=0; isPass && (test<TESTS); test++) isPass = testBoolean(numVals, type);
+    }
+    for (int test=0; isPass && (test<TESTS); test++) {
+        isPass = testEvPlus(numVals, PredefForest::EVQBDD, 0)
+                && testEvPlus(numVals, PredefForest::EVFBDD, 0)
+                && testEvPlus(numVals, PredefForest::EVMODQBDD, 7)
+                && testEvPlus(numVals, PredefForest::EVMODFBDD, 7)
+                && testEvMult(numVals, PredefForest::EVSTARQBDD)
+                && testEvMult(numVals, PredefForest::EVSTARFBDD);
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
@@ -0,0 +1,99 @@
+#include "gen_random_functions.h"
+
+/*
+ *  A random set or relation: every sample must be a member, and the members must be drawn
+ *  uniformly, each about numSamples/count times.
+ */
+bool testSample(uint16_t num, PredefForest type, int numSamples)
+{
+    ForestSetting setting(type, num);
+    Forest* forest = new Forest(setting);
+    bool isRel = setting.isRelation();
+    unsigned long size = (isRel) ? 0x01UL<<(2*num) : 0x01UL<<(num);
+    std::vector<bool> fun(size);
+    double density = random01();
+    // some functions are empty or full
+    if (density < 0.1) density = 0.0;
+    if (density > 0.9) density = 1.0;
+    unsigned long count = 0;
+    for (unsigned long i=0; i<size; i++) {
+        fun[i] = random01() < density;
+        count += fun[i];
+    }
+    Func f(forest);
+    f.setEdge((isRel) ? buildRelEdge(forest, num, fun, 0, size-1) : buildSetEdge(forest, num, fun, 0, size-1));
+
+    FuncSampler sampler(f, 1 + count);
+    bool isPass = (sampler.getCount().toDouble() > count - 0.5) && (sampler.getCount().toDouble() < count + 0.5);
+    std::vector<std::vector<uint64_t> > from, to;
+    bool isDrawn = (isRel) ? sampler.sample(numSamples, from, to) : sampler.sample(numSamples, from);
+    if (count == 0) {
+        isPass = isPass && !isDrawn;
+    } else {
+        std::vector<int> drawn(size, 0);
+        for (int n=0; isPass && (n<numSamples); n++) {
+            unsigned long index = 0;
+            for (uint16_t l=1; l<=num; l++) {
+                bool x = (from[l][n/64] >> (n%64)) & 0x01;
+                if (!isRel) {
+                    index |= (unsigned long)x << (l-1);
+                } else {
+                    bool y = (to[l][n/64] >> (n%64)) & 0x01;
+                    index |= ((unsigned long)x << (2*l-1)) | ((unsigned long)y << (2*l-2));
+                }
+            }
+            isPass = fun[index];
+            drawn[index]++;
+        }
+        // more than 8 standard deviations away is a failure
+        double expected = (double)numSamples / count;
+        for (unsigned long i=0; isPass && (i<size); i++) {
+            if (fun[i]) isPass = std::abs(drawn[i] - expected) < 8.0 * std::sqrt(expected) + 1.0;
+        }
+        // one by one
+        std::vector<bool> aFrom, aTo;
+        for (int n=0; isPass && (n<10); n++) {
+            isPass = (isRel) ? sampler.sample(aFrom, aTo) : sampler.sample(aFrom);
+            Value val = (isRel) ? f.evaluate(aFrom, aTo) : f.evaluate(aFrom);
+            int v = 0;
+            val.getValueTo(&v, INT);
+            isPass = isPass && v;
+        }
+    }
+    if (!isPass) std::cout << "failed in " << setting.getName() << " with " << count << " members" << std::endl;
+    delete forest;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 5;
+    uint16_t numVals = 4;
+    if (argc == 2) {
+        printf("Usage: ./test_sample [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate functions to test the uniform sampling of their members\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest bdds[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                           PredefForest::SFBDD, PredefForest::CSFBDD, PredefForest::ZBDD,
+                           PredefForest::ESRBDD, PredefForest::CESRBDD};
+    for (PredefForest type : bdds) {
+        for (int test=0; isPass && (test<TESTS); test++) isPass = testSample(2*numVals, type, 20000);
+    }
+    PredefForest bmxds[] = {PredefForest::QBMXD, PredefForest::FBMXD, PredefForest::IBMXD, PredefForest::ESRBMXD};
+    for (PredefForest type : bmxds) {
+        for (int test=0; isPass && (test<TESTS); test++) isPass = testSample(numVals, type, 20000);
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
@@ -0,0 +1,102 @@
+#include "gen_random_functions.h"
+
+/*
+ *  Random assignments, some of them repeated, added unpacked and packed: the Funcs built must
+ *  give the outcome added last for each assignment, and the default value for the others.
+ */
+bool testBuild(uint16_t num, PredefForest type, size_t numAssignments)
+{
+    ForestSetting setting(type, num);
+    Forest* forest = new Forest(setting);
+    unsigned long size = 0x01UL << num;
+    bool isMt = (type == PredefForest::MTBDD);
+    std::vector<int> expected(size, 0);
+    ExplictFunc unpacked, packed;
+    packed.reserve(numAssignments, num);
+    std::vector<uint64_t> words((num + 63) / 64);
+    for (size_t n=0; n<numAssignments; n++) {
+        unsigned long index = (unsigned long)(random01() * size);
+        int outcome = (isMt) ? (int)(random01() * 5) : (random01() < 0.8);
+        expected[index] = outcome;
+        // bit b of the assignment is the level b+1
+        std::vector<bool> assignment(num);
+        for (uint16_t b=0; b<num; b++) assignment[b] = index & (0x01UL << b);
+        unpacked.addAssignment(assignment, Value(outcome));
+        words[0] = index | (~0x00UL << num);    // the bits beyond num are ignored
+        packed.addAssignment(words.data(), Value(outcome));
+    }
+    bool isPass = (unpacked.size() == numAssignments) && (packed.size() == numAssignments)
+                    && (unpacked.getNumBits() == num) && (packed.getAssignment(0) == unpacked.getAssignment(0));
+    Func f = unpacked.buildFunc(forest);
+    Func g = packed.buildFunc(forest);
+    isPass = isPass && (f.getEdge() == g.getEdge());
+    std::vector<bool> assignment(num+1, 0);
+    for (unsigned long i=0; isPass && (i<size); i++) {
+        decimalToAssignment(i, assignment);
+        int v = 0;
+        f.evaluate(assignment).getValueTo(&v, INT);
+        if (v != expected[i]) {
+            std::cout << "failed at assignment " << i << " in " << setting.getName() << std::endl;
+            isPass = 0;
+        }
+    }
+    delete forest;
+    return isPass;
+}
+
+/*
+ *  Assignments of another number of bits, or packed before the number of bits is known, are
+ *  rejected instead of dropped.
+ */
+bool testRejected(uint16_t num)
+{
+    ExplictFunc ef;
+    ef.addAssignment(std::vector<bool>(num), Value(1));
+    int numThrown = 0;
+    try {
+        ef.addAssignment(std::vector<bool>(num+1), Value(1));
+    } catch (const error& e) {
+        numThrown++;
+    }
+    ExplictFunc empty;
+    uint64_t word = 0;
+    try {
+        empty.addAssignment(&word, Value(1));
+    } catch (const error& e) {
+        numThrown++;
+    }
+    bool isPass = (numThrown == 2) && (ef.size() == 1) && (empty.size() == 0);
+    if (!isPass) std::cout << "an assignment of a wrong size was not rejected" << std::endl;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 5;
+    uint16_t numVals = 8;
+    if (argc == 2) {
+        printf("Usage: ./test_explict_build [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate assignments to test building their Func\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest types[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::ZBDD,
+                            PredefForest::ESRBDD, PredefForest::MTBDD};
+    for (PredefForest type : types) {
+        for (int test=0; isPass && (test<TESTS); test++) {
+            isPass = testBuild(numVals, type, 1 + test * (0x01UL << numVals) / 4);
+        }
+    }
+    isPass = isPass && testRejected(numVals);
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
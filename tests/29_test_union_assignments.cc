@@ -0,0 +1,78 @@
+#include "gen_random_functions.h"
+
+/*
+ *  A random set, and random assignments added in a batch, some of them already members: the
+ *  Func must then be the union of the two, whichever of the two assignment layouts is used.
+ */
+bool testUnion(uint16_t num, PredefForest type, size_t numAssignments)
+{
+    ForestSetting setting(type, num);
+    Forest* forest = new Forest(setting);
+    unsigned long size = 0x01UL << num;
+    std::vector<bool> fun(size);
+    double density = random01();
+    // some sets are empty or full
+    if (density < 0.1) density = 0.0;
+    if (density > 0.9) density = 1.0;
+    for (unsigned long i=0; i<size; i++) fun[i] = random01() < density;
+    Func f(forest), g(forest);
+    f.setEdge(buildSetEdge(forest, num, fun, 0, size-1));
+    g.setEdge(f.getEdge());
+
+    // with the first element unused, as for evaluate; or bit k-1 is the variable k
+    ExplictFunc unused, packed;
+    std::vector<bool> expected(fun);
+    std::vector<bool> assignment(num+1, 0);
+    for (size_t n=0; n<numAssignments; n++) {
+        unsigned long index = (unsigned long)(random01() * size);
+        expected[index] = 1;
+        decimalToAssignment(index, assignment);
+        unused.addAssignment(assignment, Value(1));
+        packed.addAssignment(std::vector<bool>(assignment.begin()+1, assignment.end()), Value(0));
+    }
+    f.unionAssignments(unused);
+    g.unionAssignments(packed);
+    bool isPass = (f.getEdge() == g.getEdge());
+    for (unsigned long i=0; isPass && (i<size); i++) {
+        decimalToAssignment(i, assignment);
+        int v = 0;
+        f.evaluate(assignment).getValueTo(&v, INT);
+        if ((bool)v != expected[i]) {
+            std::cout << "failed at assignment " << i << " in " << setting.getName() << std::endl;
+            isPass = 0;
+        }
+    }
+    delete forest;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 5;
+    uint16_t numVals = 8;
+    if (argc == 2) {
+        printf("Usage: ./test_union_assignments [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate sets and assignments to test their union\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest types[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                            PredefForest::SFBDD, PredefForest::CSFBDD, PredefForest::ZBDD,
+                            PredefForest::ESRBDD, PredefForest::CESRBDD};
+    for (PredefForest type : types) {
+        for (int test=0; isPass && (test<TESTS); test++) {
+            isPass = testUnion(numVals, type, 1 + test * (0x01UL << numVals) / 8);
+        }
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
@@ -0,0 +1,102 @@
+#include "gen_random_functions.h"
+
+/* A random cube, with about a third of don't-cares */
+Cube randomCube(uint16_t num)
+{
+    Cube c(num);
+    for (uint16_t k=1; k<=num; k++) {
+        double r = random01();
+        if (r < 0.33) continue;
+        c.set(k, r < 0.66);
+    }
+    return c;
+}
+
+bool isIn(const Cube& c, unsigned long index)
+{
+    for (uint16_t k=1; k<=c.getNumVars(); k++) {
+        if (!c.isDontCare(k) && (c.get(k) != (bool)(index & (0x01UL << (k-1))))) return 0;
+    }
+    return 1;
+}
+
+/*
+ *  Random cubes built directly must be the sets of their minterms; and a random set
+ *  united with a batch of them must have their members added.
+ */
+bool testCube(uint16_t num, PredefForest type, size_t numCubes)
+{
+    ForestSetting setting(type, num);
+    Forest* forest = new Forest(setting);
+    unsigned long size = 0x01UL << num;
+    bool isPass = 1;
+    std::vector<Cube> cubes;
+    for (size_t n=0; isPass && (n<numCubes); n++) {
+        cubes.push_back(randomCube(num));
+        Func f(forest);
+        f.cube(cubes.back());
+        std::vector<bool> fun(size);
+        for (unsigned long i=0; i<size; i++) fun[i] = isIn(cubes.back(), i);
+        isPass = (f.getEdge() == buildSetEdge(forest, num, fun, 0, size-1));
+        if (!isPass) std::cout << "wrong cube in " << setting.getName() << std::endl;
+    }
+    // the same cubes from PLA lines
+    for (size_t n=0; isPass && (n<numCubes); n++) {
+        std::string line(num, '-');
+        for (uint16_t k=1; k<=num; k++) {
+            if (!cubes[n].isDontCare(k)) line[k-1] = '0' + cubes[n].get(k);
+        }
+        Cube c(line);
+        for (uint16_t k=1; isPass && (k<=num); k++) isPass = (c.get(k) == cubes[n].get(k));
+    }
+
+    std::vector<bool> fun(size);
+    double density = (random01() < 0.3) ? 0.0 : random01();
+    for (unsigned long i=0; i<size; i++) fun[i] = random01() < density;
+    Func f(forest);
+    f.setEdge(buildSetEdge(forest, num, fun, 0, size-1));
+    f.unionCubes(cubes);
+    std::vector<bool> assignment(num+1, 0);
+    for (unsigned long i=0; isPass && (i<size); i++) {
+        bool expected = fun[i];
+        for (size_t n=0; !expected && (n<cubes.size()); n++) expected = isIn(cubes[n], i);
+        decimalToAssignment(i, assignment);
+        int v = 0;
+        f.evaluate(assignment).getValueTo(&v, INT);
+        if ((bool)v != expected) {
+            std::cout << "failed at assignment " << i << " in " << setting.getName() << std::endl;
+            isPass = 0;
+        }
+    }
+    delete forest;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 5;
+    uint16_t numVals = 8;
+    if (argc == 2) {
+        printf("Usage: ./test_cube [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate cubes to test building them and their union\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest types[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                            PredefForest::SFBDD, PredefForest::CSFBDD, PredefForest::ZBDD,
+                            PredefForest::ESRBDD, PredefForest::CESRBDD};
+    for (PredefForest type : types) {
+        for (int test=0; isPass && (test<TESTS); test++) isPass = testCube(numVals, type, 1 + 4*test);
+    }
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
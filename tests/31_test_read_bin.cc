@@ -0,0 +1,191 @@
+#include "gen_random_functions.h"
+#include "IO/out_bddx.h"
+#include "IO/parser.h"
+
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+
+/*
+ *  Random functions written with BddxMaker::buildBin and loaded into a new forest of the same
+ *  setting with ParserBin: the loaded Funcs must evaluate as the written ones, and a second load
+ *  into the same forest must give the same edges.
+ */
+bool testReadBin(uint16_t num, PredefForest type, ValueType valType, int numFuncs)
+{
+    ForestSetting setting(type, num);
+    setting.setValType(valType);
+    Forest* forest = new Forest(setting);
+    bool isRel = setting.isRelation();
+    bool isTerminal = setting.getEncodeMechanism() == TERMINAL;
+    unsigned long size = (isRel) ? 0x01UL<<(2*num) : 0x01UL<<(num);
+    std::vector<Func> funcs;
+    for (int n=0; n<numFuncs; n++) {
+        if (isTerminal && (valType == INT)) {
+            std::vector<bool> fun(size);
+            double density = random01();
+            for (unsigned long i=0; i<size; i++) fun[i] = random01() < density;
+            Func f(forest);
+            f.setEdge((isRel) ? buildRelEdge(forest, num, fun, 0, size-1) : buildSetEdge(forest, num, fun, 0, size-1));
+            funcs.push_back(f);
+        } else {
+            // multi-valued, with some values repeated
+            ExplictFunc ef;
+            ef.setDefaultValue((valType == LONG) ? Value(0L) : Value(0));
+            std::vector<bool> assignment(num);
+            for (unsigned long i=0; i<size; i++) {
+                for (uint16_t b=0; b<num; b++) assignment[b] = i & (0x01UL << b);
+                long v = (long)(random01() * 6) << 33;
+                if (valType == LONG) ef.addAssignment(assignment, Value(v));
+                else ef.addAssignment(assignment, Value((int)(random01() * 6)));
+            }
+            funcs.push_back(ef.buildFunc(forest));
+        }
+    }
+    std::string path = "31_test_read_bin_" + std::to_string((int)type) + ".bin";
+    BddxMaker maker(forest);
+    maker.buildBin(funcs, path.substr(0, path.size()-4));
+
+    Forest* loaded = new Forest(setting);
+    ParserBin parser(path);
+    bool isPass = !parser.parse(loaded) && (parser.getNumRoots() == (uint64_t)numFuncs);
+    std::vector<bool> from(num+1, 0), to(num+1, 0);
+    for (int n=0; isPass && (n<numFuncs); n++) {
+        Func g = parser.getRoot(n+1);
+        for (unsigned long i=0; isPass && (i<size); i++) {
+            if (isRel) {
+                for (uint16_t k=1; k<=num; k++) {
+                    from[k] = i & (0x01UL << (2*k-1));
+                    to[k] = i & (0x01UL << (2*k-2));
+                }
+            } else {
+                decimalToAssignment(i, from);
+            }
+            Value expected = (isRel) ? funcs[n].evaluate(from, to) : funcs[n].evaluate(from);
+            Value actual = (isRel) ? g.evaluate(from, to) : g.evaluate(from);
+            isPass = expected == actual;
+        }
+    }
+    ParserBin again(path);
+    isPass = isPass && !again.parse(loaded);
+    for (int n=0; isPass && (n<numFuncs); n++) isPass = parser.getRoot(n+1).getEdge() == again.getRoot(n+1).getEdge();
+    if (!isPass) std::cout << "failed in " << setting.getName() << std::endl;
+    remove(path.c_str());
+    delete loaded;
+    delete forest;
+    return isPass;
+}
+
+/* Write "bytes" to "path" and load it into a new forest: true if the parser rejects it */
+bool isRejected(const ForestSetting& setting, const std::string& path, const std::string& bytes)
+{
+    std::ofstream out(path, std::ios::out | std::ios::binary);
+    out.write(bytes.data(), bytes.size());
+    out.close();
+    Forest* forest = new Forest(setting);
+    bool ans;
+    {
+        ParserBin parser(path);
+        ans = parser.parse(forest);
+    }
+    delete forest;
+    return ans;
+}
+
+template <typename T>
+void patch(std::string& bytes, size_t offset, T value)
+{
+    memcpy(&bytes[offset], &value, sizeof(T));
+}
+
+/*
+ *  Truncated and corrupted files must be rejected, without reading past their end: counts that
+ *  wrap around when multiplied by the record size, counts that do not add up to the nodes of the
+ *  header, and nodes of another size.
+ */
+bool testCorrupted(uint16_t num, PredefForest type)
+{
+    ForestSetting setting(type, num);
+    Forest* forest = new Forest(setting);
+    unsigned long size = 0x01UL<<(num);
+    std::vector<bool> fun(size);
+    for (unsigned long i=0; i<size; i++) fun[i] = random01() < 0.5;
+    Func f(forest);
+    f.setEdge(buildSetEdge(forest, num, fun, 0, size-1));
+    std::string name = "31_test_read_bin_corrupted";
+    std::string path = name + ".bin";
+    BddxMaker maker(forest);
+    maker.buildBin(f, name);
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    in.close();
+    const std::string good = ss.str();
+
+    bool isPass = !isRejected(setting, path, good);
+    for (size_t len=0; isPass && (len<good.size()); len+=7) isPass = isRejected(setting, path, good.substr(0, len));
+    size_t counts = sizeof(BinHeader);
+    std::string bad = good;
+    // a level count that wraps around size_t when multiplied by the record size
+    patch(bad, counts, (uint64_t)0x01 << 62);
+    isPass = isPass && isRejected(setting, path, bad);
+    uint64_t numNodes, count1;
+    memcpy(&numNodes, &good[offsetof(BinHeader, numNodes)], sizeof(numNodes));
+    memcpy(&count1, &good[counts], sizeof(count1));
+    // the same, with the nodes of the header adding up
+    bad = good;
+    patch(bad, offsetof(BinHeader, numNodes), numNodes - count1 + ((uint64_t)0x01 << 62));
+    patch(bad, counts, (uint64_t)0x01 << 62);
+    isPass = isPass && isRejected(setting, path, bad);
+    bad = good;
+    patch(bad, offsetof(BinHeader, numPooled), (uint64_t)0x01 << 61);
+    isPass = isPass && isRejected(setting, path, bad);
+    // counts that do not add up
+    bad = good;
+    patch(bad, offsetof(BinHeader, numNodes), numNodes + 1);
+    isPass = isPass && isRejected(setting, path, bad);
+    bad = good;
+    patch(bad, offsetof(BinHeader, nodeSize), (uint32_t)setting.nodeSize() + 1);
+    isPass = isPass && isRejected(setting, path, bad);
+    if (!isPass) std::cout << "corrupted file accepted in " << setting.getName() << std::endl;
+    remove(path.c_str());
+    delete forest;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 5;
+    uint16_t numVals = 4;
+    if (argc == 2) {
+        printf("Usage: ./test_read_bin [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate functions to test writing and reading them in binary BDDX\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest bdds[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                           PredefForest::SFBDD, PredefForest::CSFBDD, PredefForest::ZBDD,
+                           PredefForest::ESRBDD, PredefForest::CESRBDD};
+    for (PredefForest type : bdds) {
+        for (int test=0; isPass && (test<TESTS); test++) isPass = testReadBin(2*numVals, type, INT, 4);
+    }
+    PredefForest bmxds[] = {PredefForest::QBMXD, PredefForest::FBMXD, PredefForest::IBMXD, PredefForest::ESRBMXD};
+    for (PredefForest type : bmxds) {
+        for (int test=0; isPass && (test<TESTS); test++) isPass = testReadBin(numVals, type, INT, 4);
+    }
+    // pooled terminals, and edge values
+    for (int test=0; isPass && (test<TESTS); test++) isPass = testReadBin(2*numVals, PredefForest::MTBDD, LONG, 4);
+    for (int test=0; isPass && (test<TESTS); test++) isPass = testReadBin(2*numVals, PredefForest::EVQBDD, INT, 4);
+    isPass = isPass && testCorrupted(2*numVals, PredefForest::REXBDD) && testCorrupted(2*numVals, PredefForest::QBDD);
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}
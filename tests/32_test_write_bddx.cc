@@ -0,0 +1,148 @@
+#include "gen_random_functions.h"
+#include "IO/out_bddx.h"
+#include "IO/parser.h"
+
+#include <unistd.h>
+
+/*
+ *  Random functions written with BddxMaker::buildBddx, as text and compressed with xz, and
+ *  loaded into a new forest of the same setting with ParserBddx: the loaded Funcs must evaluate
+ *  as the written ones.
+ */
+bool testWriteBddx(uint16_t num, PredefForest type, int numFuncs, const char compress)
+{
+    ForestSetting setting(type, num);
+    Forest* forest = new Forest(setting);
+    bool isRel = setting.isRelation();
+    unsigned long size = (isRel) ? 0x01UL<<(2*num) : 0x01UL<<(num);
+    std::vector<Func> funcs;
+    for (int n=0; n<numFuncs; n++) {
+        std::vector<bool> fun(size);
+        double density = random01();
+        for (unsigned long i=0; i<size; i++) fun[i] = random01() < density;
+        Func f(forest);
+        f.setEdge((isRel) ? buildRelEdge(forest, num, fun, 0, size-1) : buildSetEdge(forest, num, fun, 0, size-1));
+        funcs.push_back(f);
+    }
+    std::string name = "32_test_write_bddx_" + std::to_string((int)type);
+    std::string path = name + ".bddx" + ((compress == 'x') ? ".xz" : "");
+    BddxMaker maker(forest);
+    if (compress == ' ') {
+        maker.buildBddx(funcs, name, compress);
+    } else {
+        // the file name is not given to a shell
+        std::string quoted = name + "_'$(false)'";
+        maker.buildBddx(funcs, quoted, compress);
+        rename((quoted + ".bddx.xz").c_str(), path.c_str());
+    }
+
+    Forest* loaded = new Forest(setting);
+    ParserBddx parser(path);
+    bool isPass = !parser.parse(loaded) && (parser.getNumRoots() == (uint64_t)numFuncs)
+                    && (parser.getNumNodes() == forest->getNodeManUsed(funcs));
+    std::vector<bool> from(num+1, 0), to(num+1, 0);
+    for (int n=0; isPass && (n<numFuncs); n++) {
+        Func g = parser.getRoot(n+1);
+        for (unsigned long i=0; isPass && (i<size); i++) {
+            if (isRel) {
+                for (uint16_t k=1; k<=num; k++) {
+                    from[k] = i & (0x01UL << (2*k-1));
+                    to[k] = i & (0x01UL << (2*k-2));
+                }
+            } else {
+                decimalToAssignment(i, from);
+            }
+            Value expected = (isRel) ? funcs[n].evaluate(from, to) : funcs[n].evaluate(from);
+            Value actual = (isRel) ? g.evaluate(from, to) : g.evaluate(from);
+            isPass = expected == actual;
+        }
+    }
+    if (!isPass) std::cout << "failed in " << setting.getName() << std::endl;
+    remove(path.c_str());
+    delete loaded;
+    delete forest;
+    return isPass;
+}
+
+/* Run "build" and tell whether it threw */
+template <typename F>
+bool isThrown(F build)
+{
+    try {
+        build();
+    } catch (const error& e) {
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ *  Failed writes are errors, not a truncated file: an unknown compress, a compressor that is not
+ *  found (which must not kill the process by SIGPIPE), and a full device for the text and the
+ *  binary files.
+ */
+bool testWriteErrors(uint16_t num)
+{
+    ForestSetting setting(PredefForest::REXBDD, num);
+    Forest* forest = new Forest(setting);
+    unsigned long size = 0x01UL<<(num);
+    std::vector<bool> fun(size);
+    for (unsigned long i=0; i<size; i++) fun[i] = random01() < 0.5;
+    Func f(forest);
+    f.setEdge(buildSetEdge(forest, num, fun, 0, size-1));
+    // large enough to fill the pipe to the compressor
+    std::vector<Func> funcs(4096, f);
+    BddxMaker maker(forest);
+    std::string name = "32_test_write_bddx_error";
+    bool isPass = isThrown([&]() {maker.buildBddx(f, name, 'z');});
+    const char* path = getenv("PATH");
+    std::string oldPath = (path) ? path : "";
+    setenv("PATH", "/nonexistent", 1);
+    isPass = isPass && isThrown([&]() {maker.buildBddx(funcs, name, 'x');});
+    setenv("PATH", oldPath.c_str(), 1);
+    remove((name + ".bddx.xz").c_str());
+    if (access("/dev/full", W_OK) == 0) {
+        isPass = isPass && !symlink("/dev/full", (name + ".bddx").c_str()) && !symlink("/dev/full", (name + ".bin").c_str());
+        isPass = isPass && isThrown([&]() {maker.buildBddx(f, name);});
+        isPass = isPass && isThrown([&]() {maker.buildBin(f, name);});
+        remove((name + ".bddx").c_str());
+        remove((name + ".bin").c_str());
+    }
+    if (!isPass) std::cout << "a failed write was not reported" << std::endl;
+    delete forest;
+    return isPass;
+}
+
+int main(int argc, char** argv){
+    int TESTS = 5;
+    uint16_t numVals = 4;
+    if (argc == 2) {
+        printf("Usage: ./test_write_bddx [num_val] [num_tests]\n");
+        printf("\tThis will randomly generate functions to test writing and reading them in text BDDX\n");
+        exit(0);
+    }
+    if (argc >= 3) {
+        numVals = atoi(argv[1]);
+        TESTS = atoi(argv[2]);
+    }
+
+    bool isPass = 1;
+    PredefForest bdds[] = {PredefForest::REXBDD, PredefForest::QBDD, PredefForest::FBDD, PredefForest::CFBDD,
+                           PredefForest::SFBDD, PredefForest::CSFBDD, PredefForest::ZBDD,
+                           PredefForest::ESRBDD, PredefForest::CESRBDD};
+    for (PredefForest type : bdds) {
+        for (int test=0; isPass && (test<TESTS); test++) isPass = testWriteBddx(2*numVals, type, 4, (test % 2) ? 'x' : ' ');
+    }
+    PredefForest bmxds[] = {PredefForest::QBMXD, PredefForest::FBMXD, PredefForest::IBMXD, PredefForest::ESRBMXD};
+    for (PredefForest type : bmxds) {
+        for (int test=0; isPass && (test<TESTS); test++) isPass = testWriteBddx(numVals, type, 4, (test % 2) ? 'x' : ' ');
+    }
+    isPass = isPass && testWriteErrors(2*numVals);
+
+    if (!isPass) {
+        std::cout << "Test Failed!" << std::endl;
+    } else {
+        std::cout << "Test Pass!" << std::endl;
+    }
+    return !isPass;
+}